@@ -134,7 +134,23 @@ bool atIsECCFamily(ATCADeviceType device_type);
 ATCA_STATUS isATCAError(uint8_t *data);
 
 
+/** \name Values of ATCA_CRC_TABLE, trading flash for CRC speed
+   @{ */
+#define ATCA_CRC_TABLE_NONE     0   //!< one bit at a time, no table
+#define ATCA_CRC_TABLE_NIBBLE   1   //!< one nibble at a time, 32 byte table
+#define ATCA_CRC_TABLE_BYTE     2   //!< one byte at a time, 512 byte table
+/** @} */
+
+#ifndef ATCA_CRC_TABLE
+#define ATCA_CRC_TABLE          ATCA_CRC_TABLE_BYTE
+#endif
+
+//! Initial value of a running CRC for atCrcUpdate()
+#define ATCA_CRC_INIT           ((uint16_t)0x0000)
+
 // command helpers
+uint16_t atCrcUpdate(uint16_t crc, size_t length, const uint8_t *data);
+void atCrcFinal(uint16_t crc, uint8_t *crc_le);
 void atCRC(size_t length, const uint8_t *data, uint8_t *crc_le);
 void atCalcCrc(ATCAPacket *pkt);
 ATCA_STATUS atCheckCrc(const uint8_t *response);
@@ -28,18 +28,46 @@
 #ifndef SHA2_ROUTINES_H
 #define SHA2_ROUTINES_H
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define SHA256_DIGEST_SIZE (32)
 #define SHA256_BLOCK_SIZE  (64)
 
+/** \brief Set to 0 to always use the portable implementation instead of the
+ *         x86 SHA extensions or the ARMv8 cryptography extension */
+#ifndef ATCA_SHA256_HW_ACCEL
+#define ATCA_SHA256_HW_ACCEL    (1)
+#endif
+
+#if ATCA_SHA256_HW_ACCEL && (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SHA256_SHANI        (1)     //!< SHA extensions, selected at run time when the CPU has them
+#else
+#define SHA256_SHANI        (0)
+#endif
+
+#if ATCA_SHA256_HW_ACCEL && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#define SHA256_ARMV8_CE     (1)     //!< Cryptography extension, the target is built with it
+#else
+#define SHA256_ARMV8_CE     (0)
+#endif
+
+#define SHA256_MB_MAX_LANES (16)    //!< Most messages sw_sha256_multi() hashes in lockstep
+
+#if ATCA_SHA256_HW_ACCEL && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__) || defined(__ARM_NEON))
+#define SHA256_MB_SIMD      (1)     //!< Multi-buffer hashing with SSE2/AVX2/AVX-512 or NEON vectors
+#else
+#define SHA256_MB_SIMD      (0)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 typedef struct
 {
-    uint32_t total_msg_size;                //!< Total number of message bytes processed
+    uint32_t total_msg_size;                //!< Total number of message bytes, lower 32 bits
+    uint32_t total_msg_size_hi;             //!< Total number of message bytes, upper 32 bits
     uint32_t block_size;                    //!< Number of bytes in current block
     uint8_t  block[SHA256_BLOCK_SIZE * 2];  //!< Unprocessed message storage
     uint32_t hash[8];                       //!< Hash state
@@ -53,6 +81,10 @@ void sw_sha256_final(sw_sha256_ctx * ctx, uint8_t digest[SHA256_DIGEST_SIZE]);
 
 void sw_sha256(const uint8_t * message, unsigned int len, uint8_t digest[SHA256_DIGEST_SIZE]);
 
+uint32_t sw_sha256_multi_lanes(void);
+
+void sw_sha256_multi(size_t count, const uint8_t* const msgs[], const size_t msg_sizes[], uint8_t* digests);
+
 #ifdef __cplusplus
 }
 #endif
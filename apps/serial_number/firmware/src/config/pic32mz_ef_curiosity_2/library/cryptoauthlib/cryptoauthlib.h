@@ -105,6 +105,8 @@
 #include "calib/calib_basic.h"
 #include "calib/calib_command.h"
 #include "calib/calib_aes_gcm.h"
+#include "calib/calib_async.h"
+#include "calib/calib_pool.h"
 #endif
 
 #if ATCA_TA_SUPPORT
@@ -35,9 +35,11 @@
 atca_plib_i2c_api_t i2c1_plib_i2c_api = {
     .read = I2C1_Read,
     .write = I2C1_Write,
+    .write_read = I2C1_WriteRead,
     .is_busy = I2C1_IsBusy,
     .error_get = I2C1_ErrorGet,
-    .transfer_setup = I2C1_TransferSetup
+    .transfer_setup = I2C1_TransferSetup,
+    .callback_register = I2C1_CallbackRegister
 };
 
 
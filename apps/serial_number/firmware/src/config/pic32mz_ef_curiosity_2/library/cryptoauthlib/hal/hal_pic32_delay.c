@@ -97,4 +97,27 @@ void atca_delay_ms_internal(uint32_t delay)
 
 }
 
+/**
+ * \brief Retrieve a free running timestamp in microseconds derived from the
+ *        CP0 core timer. The core timer wraps every 2^32 / us_SCALE us so the
+ *        function has to be called at least once within that period. Only
+ *        differences between two values are meaningful.
+ *
+ * \return timestamp in microseconds
+ */
+uint32_t hal_timestamp_us(void)
+{
+    static uint32_t timestamp_us;
+    static uint32_t remainder_count;
+    static uint32_t last_count;
+    uint32_t count = _CP0_GET_COUNT();
+
+    remainder_count += count - last_count;
+    last_count = count;
+    timestamp_us += remainder_count / us_SCALE;
+    remainder_count %= us_SCALE;
+
+    return timestamp_us;
+}
+
 /** @} */
\ No newline at end of file
@@ -131,6 +131,81 @@ typedef struct ATCA_PACKED _atecc608a_config
 #pragma pack(pop)
 #endif
 
+#ifdef ATCA_CONFIG_CACHE
+#define ATCA_CONFIG_CACHE_SIZE  (128)   //!< Largest configuration zone of the CryptoAuth devices
+
+/** \brief Host copy of the configuration zone of a device. Config zone reads
+ *         are served from it while it is enabled. */
+typedef struct
+{
+    uint8_t  enabled;                       //!< Reads of the config zone are served from the cache
+    uint8_t  valid;                         //!< data holds the current config zone
+    uint8_t  data[ATCA_CONFIG_CACHE_SIZE];  //!< Config zone contents
+    uint32_t hits;                          //!< Reads served from data
+    uint32_t misses;                        //!< Reads that went to the device
+} atca_config_cache_t;
+#endif
+
+#ifdef ATCA_DATA_CACHE
+#ifndef ATCA_DATA_CACHE_ENTRIES
+#define ATCA_DATA_CACHE_ENTRIES (16)    //!< Blocks and public keys held by the data cache of a device
+#endif
+
+/** \brief One cached data zone read or public key of the data cache */
+typedef struct
+{
+    uint8_t  kind;      //!< Free, block, word or public key entry
+    uint8_t  slot;      //!< Slot the data belongs to
+    uint8_t  block;     //!< 32 byte block index within the slot
+    uint8_t  offset;    //!< 4 byte word index within the block for _WORD entries
+    uint32_t used;      //!< Value of the use clock at the last access, for eviction
+    uint8_t  data[64];  //!< Block, word or X and Y of the public key
+} atca_data_cache_entry_t;
+
+/** \brief Host copies of data zone reads and computed public keys of a
+ *         device, see calib_data_cache_policy(). */
+typedef struct
+{
+    uint16_t data_slots;    //!< Slots whose data zone reads are cached, never secret slots
+    uint16_t pubkey_slots;  //!< Slots whose GenKey public keys are cached
+    uint32_t clock;         //!< Use clock for least recently used eviction
+    uint32_t hits;          //!< Reads served from the cache
+    uint32_t misses;        //!< Cacheable reads that went to the device
+    atca_data_cache_entry_t entries[ATCA_DATA_CACHE_ENTRIES];
+} atca_data_cache_t;
+#endif
+
+#if !defined(ATCA_NO_POLL) && !defined(ATCA_NO_ADAPTIVE_POLL)
+/** \brief Number of (device type, clock divider, opcode, mode) combinations
+ *         the adaptive polling scheduler keeps execution times for per device */
+#ifndef ATCA_POLLING_ADAPT_ENTRIES
+#define ATCA_POLLING_ADAPT_ENTRIES          (16)
+#endif
+
+/** \brief Learned execution time of a command, used by the adaptive polling
+ *         scheduler to sleep until just before the command completes */
+typedef struct
+{
+    uint8_t  dt;            //!< ATCADeviceType the entry was learned on
+    uint8_t  clock_divider; //!< ChipMode clock divider the entry was learned with
+    uint8_t  opcode;        //!< Command opcode
+    uint8_t  mode;          //!< Command mode (param1)
+    uint16_t samples;       //!< Number of completions observed (saturates)
+    uint32_t used;          //!< Value of the use clock at the last access, for eviction
+    uint32_t avg_us;        //!< Moving average of the completion time in us
+    uint32_t dev_us;        //!< Moving average of the absolute deviation in us
+} calib_poll_entry_t;
+
+/** \brief Learned execution times of the commands of a device, see
+ *         calib_poll_timing(). */
+typedef struct
+{
+    uint32_t clock;         //!< Use clock for least recently used eviction
+    uint8_t  count;         //!< Entries in use
+    calib_poll_entry_t entries[ATCA_POLLING_ADAPT_ENTRIES];
+} atca_poll_table_t;
+#endif
+
 /** \brief atca_device is the C object backing ATCADevice.  See the atca_device.h file for
  * details on the ATCADevice methods
  */
@@ -144,6 +219,23 @@ struct atca_device
     uint16_t    session_key_id;     /**< Key ID used for a secure sesison */
     uint8_t*    session_key;        /**< Session Key */
     uint8_t     session_key_len;    /**< Length of key used for the session in bytes */
+
+    uint8_t     wake_depth;         /**< Nesting count of open wake sessions */
+    uint8_t     wake_active;        /**< Device was woken inside a wake session and has not been idled since */
+    uint16_t    wake_budget_msec;   /**< Watchdog budget of a single wake, 0 selects ATCA_WATCHDOG_BUDGET_MSEC */
+    uint32_t    wake_timestamp_us;  /**< hal_timestamp_us() value of the last wake inside a wake session */
+
+    void*       async_ctx;          /**< Asynchronous operation in progress on the device (calib_async_ctx_t) */
+
+#ifdef ATCA_CONFIG_CACHE
+    atca_config_cache_t config_cache;   /**< Copy of the config zone, see calib_config_cache_enable() */
+#endif
+#ifdef ATCA_DATA_CACHE
+    atca_data_cache_t   data_cache;     /**< Data zone reads and public keys, see calib_data_cache_policy() */
+#endif
+#if !defined(ATCA_NO_POLL) && !defined(ATCA_NO_ADAPTIVE_POLL)
+    atca_poll_table_t   poll_table;     /**< Learned command execution times, see calib_poll_timing() */
+#endif
 };
 
 typedef struct atca_device * ATCADevice;
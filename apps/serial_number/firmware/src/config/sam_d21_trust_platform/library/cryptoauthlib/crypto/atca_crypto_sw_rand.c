@@ -25,7 +25,509 @@
  * THIS SOFTWARE.
  */
 
+#include "cryptoauthlib.h"
 #include "atca_crypto_sw_rand.h"
+#include "atca_crypto_sw_sha2.h"
+
+#if defined(ATCA_MBEDTLS) || defined(ATCA_OPENSSL) || defined(ATCA_WOLFSSL) || ATCA_ENABLE_SHA256_IMPL
+
+/** \brief Default DRBG used by atcac_sw_random() */
+static atcac_drbg_ctx g_atcac_sw_drbg;
+
+/** \brief HMAC_DRBG update function (SP 800-90A 10.1.2.2). Provided data is
+ *         passed as up to three pieces so callers don't have to concatenate.
+ */
+static ATCA_STATUS atcac_drbg_update(atcac_drbg_ctx* ctx, const uint8_t* p1, size_t p1_len,
+                                     const uint8_t* p2, size_t p2_len, const uint8_t* p3, size_t p3_len)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    atcac_hmac_sha256_ctx hmac;
+    size_t digest_len;
+    uint8_t round;
+
+    for (round = 0; round < 2 && ATCA_SUCCESS == status; round++)
+    {
+        /* K = HMAC(K, V || round || provided_data) */
+        digest_len = sizeof(ctx->key);
+        if (ATCA_SUCCESS == (status = atcac_sha256_hmac_init(&hmac, ctx->key, sizeof(ctx->key))))
+        {
+            (void)atcac_sha256_hmac_update(&hmac, ctx->v, sizeof(ctx->v));
+            (void)atcac_sha256_hmac_update(&hmac, &round, 1);
+            if (p1_len)
+            {
+                (void)atcac_sha256_hmac_update(&hmac, p1, p1_len);
+            }
+            if (p2_len)
+            {
+                (void)atcac_sha256_hmac_update(&hmac, p2, p2_len);
+            }
+            if (p3_len)
+            {
+                (void)atcac_sha256_hmac_update(&hmac, p3, p3_len);
+            }
+            status = atcac_sha256_hmac_finish(&hmac, ctx->key, &digest_len);
+        }
+
+        /* V = HMAC(K, V) */
+        if (ATCA_SUCCESS == status)
+        {
+            digest_len = sizeof(ctx->v);
+            if (ATCA_SUCCESS == (status = atcac_sha256_hmac_init(&hmac, ctx->key, sizeof(ctx->key))))
+            {
+                (void)atcac_sha256_hmac_update(&hmac, ctx->v, sizeof(ctx->v));
+                status = atcac_sha256_hmac_finish(&hmac, ctx->v, &digest_len);
+            }
+        }
+
+        /* The second round only runs when there is provided data */
+        if (!p1_len && !p2_len && !p3_len)
+        {
+            break;
+        }
+    }
+
+    memset(&hmac, 0, sizeof(hmac));
+    return status;
+}
+
+/** \brief Continuous health test on an entropy input. Rejects an input that
+ *         repeats the previous one or that is a single repeated 32 bit word,
+ *         which covers stuck output and the fixed pattern a device returns
+ *         while its configuration zone is unlocked.
+ */
+static ATCA_STATUS atcac_drbg_check_entropy(atcac_drbg_ctx* ctx, const uint8_t* entropy)
+{
+    size_t i;
+
+    for (i = 4; i < ATCAC_DRBG_SEED_SIZE; i++)
+    {
+        if (entropy[i] != entropy[i % 4])
+        {
+            break;
+        }
+    }
+
+    if (ATCAC_DRBG_SEED_SIZE == i || 0 == memcmp(entropy, ctx->last_entropy, ATCAC_DRBG_SEED_SIZE))
+    {
+        ctx->health_failures++;
+        return ATCA_HEALTH_TEST_ERROR;
+    }
+
+    memcpy(ctx->last_entropy, entropy, ATCAC_DRBG_SEED_SIZE);
+    return ATCA_SUCCESS;
+}
+
+/** \brief Fetch a fresh entropy input and run the continuous health test on it */
+static ATCA_STATUS atcac_drbg_get_entropy(atcac_drbg_ctx* ctx, uint8_t* entropy)
+{
+    ATCA_STATUS status = ctx->entropy(ctx->entropy_ctx, entropy, ATCAC_DRBG_SEED_SIZE);
+
+    if (ATCA_SUCCESS == status)
+    {
+        status = atcac_drbg_check_entropy(ctx, entropy);
+    }
+    return status;
+}
+
+/** \brief Instantiate an HMAC_DRBG (SP 800-90A 10.1.2.3) from the supplied
+ *         entropy source. The source is also used for every later reseed.
+ *
+ * \param[out] ctx          DRBG context to instantiate
+ * \param[in]  entropy      Entropy source callback, e.g. atcac_drbg_device_entropy
+ * \param[in]  entropy_ctx  Context passed to the entropy source
+ * \param[in]  pers         Optional personalization string, may be NULL
+ * \param[in]  pers_len     Length of the personalization string
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcac_drbg_init(atcac_drbg_ctx* ctx, atcac_drbg_entropy_cb entropy, void* entropy_ctx, const uint8_t* pers, size_t pers_len)
+{
+    ATCA_STATUS status;
+    uint8_t seed[ATCAC_DRBG_SEED_SIZE + ATCAC_DRBG_NONCE_SIZE];
+
+    if (!ctx || !entropy || (!pers && pers_len))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->entropy = entropy;
+    ctx->entropy_ctx = entropy_ctx;
+    ctx->reseed_interval = ATCAC_DRBG_RESEED_INTERVAL;
+    memset(ctx->v, 0x01, sizeof(ctx->v));
+
+    if (ATCA_SUCCESS == (status = atcac_drbg_get_entropy(ctx, seed)))
+    {
+        status = entropy(entropy_ctx, &seed[ATCAC_DRBG_SEED_SIZE], ATCAC_DRBG_NONCE_SIZE);
+    }
+
+    if (ATCA_SUCCESS == status)
+    {
+        status = atcac_drbg_update(ctx, seed, sizeof(seed), pers, pers_len, NULL, 0);
+    }
+
+    if (ATCA_SUCCESS == status)
+    {
+        ctx->reseed_counter = 1;
+        ctx->instantiated = true;
+    }
+
+    memset(seed, 0, sizeof(seed));
+    return status;
+}
+
+/** \brief Reseed the DRBG with fresh entropy (SP 800-90A 10.1.2.4)
+ *
+ * \param[in] ctx             Instantiated DRBG context
+ * \param[in] additional      Optional additional input, may be NULL
+ * \param[in] additional_len  Length of the additional input
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcac_drbg_reseed(atcac_drbg_ctx* ctx, const uint8_t* additional, size_t additional_len)
+{
+    ATCA_STATUS status;
+    uint8_t seed[ATCAC_DRBG_SEED_SIZE];
+
+    if (!ctx || (!additional && additional_len))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (!ctx->instantiated)
+    {
+        return ATCA_NOT_INITIALIZED;
+    }
+
+    if (ATCA_SUCCESS == (status = atcac_drbg_get_entropy(ctx, seed)))
+    {
+        status = atcac_drbg_update(ctx, seed, sizeof(seed), additional, additional_len, NULL, 0);
+    }
+
+    if (ATCA_SUCCESS == status)
+    {
+        ctx->reseed_counter = 1;
+        ctx->reseeds++;
+    }
+
+    memset(seed, 0, sizeof(seed));
+    return status;
+}
+
+/** \brief Generate random bytes directly from the DRBG (SP 800-90A 10.1.2.5).
+ *         A reseed is performed first once the reseed interval has been
+ *         reached. Requests larger than ATCAC_DRBG_MAX_REQUEST are split.
+ *
+ * \param[in]  ctx        Instantiated DRBG context
+ * \param[out] data       Random bytes are returned here
+ * \param[in]  data_size  Number of bytes to generate
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcac_drbg_generate(atcac_drbg_ctx* ctx, uint8_t* data, size_t data_size)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    atcac_hmac_sha256_ctx hmac;
+    size_t digest_len;
+
+    if (!ctx || (!data && data_size))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (!ctx->instantiated)
+    {
+        return ATCA_NOT_INITIALIZED;
+    }
+
+    while (data_size && ATCA_SUCCESS == status)
+    {
+        size_t request = (data_size > ATCAC_DRBG_MAX_REQUEST) ? ATCAC_DRBG_MAX_REQUEST : data_size;
+
+        data_size -= request;
+
+        if (ctx->reseed_counter > ctx->reseed_interval)
+        {
+            if (ATCA_SUCCESS != (status = atcac_drbg_reseed(ctx, NULL, 0)))
+            {
+                break;
+            }
+        }
+
+        while (request && ATCA_SUCCESS == status)
+        {
+            size_t copy_size = (request > sizeof(ctx->v)) ? sizeof(ctx->v) : request;
+
+            /* V = HMAC(K, V) */
+            digest_len = sizeof(ctx->v);
+            if (ATCA_SUCCESS == (status = atcac_sha256_hmac_init(&hmac, ctx->key, sizeof(ctx->key))))
+            {
+                (void)atcac_sha256_hmac_update(&hmac, ctx->v, sizeof(ctx->v));
+                status = atcac_sha256_hmac_finish(&hmac, ctx->v, &digest_len);
+            }
+
+            if (ATCA_SUCCESS == status)
+            {
+                memcpy(data, ctx->v, copy_size);
+                data += copy_size;
+                request -= copy_size;
+            }
+        }
+
+        if (ATCA_SUCCESS == status)
+        {
+            status = atcac_drbg_update(ctx, NULL, 0, NULL, 0, NULL, 0);
+            ctx->reseed_counter++;
+        }
+    }
+
+    memset(&hmac, 0, sizeof(hmac));
+    return status;
+}
+
+/** \brief Return random bytes, serving as much as possible from the pool
+ *         filled by atcac_drbg_idle() and generating the rest on demand.
+ *
+ * \param[in]  ctx        Instantiated DRBG context
+ * \param[out] data       Random bytes are returned here
+ * \param[in]  data_size  Number of bytes requested
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcac_drbg_random(atcac_drbg_ctx* ctx, uint8_t* data, size_t data_size)
+{
+    size_t copy_size;
+
+    if (!ctx || (!data && data_size))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    /* Pooled bytes are handed out from the end and wiped once used */
+    copy_size = (data_size > ctx->pool_len) ? ctx->pool_len : data_size;
+    if (copy_size)
+    {
+        ctx->pool_len -= copy_size;
+        memcpy(data, &ctx->pool[ctx->pool_len], copy_size);
+        memset(&ctx->pool[ctx->pool_len], 0, copy_size);
+    }
+
+    return atcac_drbg_generate(ctx, &data[copy_size], data_size - copy_size);
+}
+
+/** \brief Background maintenance for the DRBG, intended to be called when the
+ *         application is idle. Reseeds from the entropy source once the reseed
+ *         interval has been reached and refills the output pool so later
+ *         requests don't pay for either.
+ *
+ * \param[in] ctx  Instantiated DRBG context
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcac_drbg_idle(atcac_drbg_ctx* ctx)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    if (!ctx)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (!ctx->instantiated)
+    {
+        return ATCA_NOT_INITIALIZED;
+    }
+
+    if (ctx->reseed_counter >= ctx->reseed_interval)
+    {
+        status = atcac_drbg_reseed(ctx, NULL, 0);
+    }
+
+    if (ATCA_SUCCESS == status && ctx->pool_len < sizeof(ctx->pool))
+    {
+        if (ATCA_SUCCESS == (status = atcac_drbg_generate(ctx, &ctx->pool[ctx->pool_len], sizeof(ctx->pool) - ctx->pool_len)))
+        {
+            ctx->pool_len = sizeof(ctx->pool);
+        }
+    }
+
+    return status;
+}
+
+/** \brief Uninstantiate the DRBG and wipe its state
+ *
+ * \param[in] ctx  DRBG context
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcac_drbg_free(atcac_drbg_ctx* ctx)
+{
+    if (!ctx)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    return ATCA_SUCCESS;
+}
+
+/** \brief Known answer source used by atcac_drbg_health_test() */
+typedef struct
+{
+    const uint8_t* data;
+    size_t         offset;
+} atcac_drbg_kat_source;
+
+static ATCA_STATUS atcac_drbg_kat_entropy(void* ctx, uint8_t* entropy, size_t entropy_size)
+{
+    atcac_drbg_kat_source* source = (atcac_drbg_kat_source*)ctx;
+
+    memcpy(entropy, &source->data[source->offset], entropy_size);
+    source->offset += entropy_size;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Instantiate and generate known answer test (SP 800-90A 11.3) using
+ *         the first HMAC_DRBG SHA-256 vector from the NIST CAVP set without
+ *         prediction resistance.
+ *
+ * \return ATCA_SUCCESS on success, ATCA_HEALTH_TEST_ERROR if the output does
+ *         not match, otherwise an error code.
+ */
+ATCA_STATUS atcac_drbg_health_test(void)
+{
+    // *INDENT-OFF*
+    static const uint8_t kat_seed[ATCAC_DRBG_SEED_SIZE + ATCAC_DRBG_NONCE_SIZE] = {
+        /* EntropyInput */
+        0xca, 0x85, 0x19, 0x11, 0x34, 0x93, 0x84, 0xbf, 0xfe, 0x89, 0xde, 0x1c, 0xbd, 0xc4, 0x6e, 0x68,
+        0x31, 0xe4, 0x4d, 0x34, 0xa4, 0xfb, 0x93, 0x5e, 0xe2, 0x85, 0xdd, 0x14, 0xb7, 0x1a, 0x74, 0x88,
+        /* Nonce */
+        0x65, 0x9b, 0xa9, 0x6c, 0x60, 0x1d, 0xc6, 0x9f, 0xc9, 0x02, 0x94, 0x08, 0x05, 0xec, 0x0c, 0xa8
+    };
+    static const uint8_t kat_returned_bits[128] = {
+        0xe5, 0x28, 0xe9, 0xab, 0xf2, 0xde, 0xce, 0x54, 0xd4, 0x7c, 0x7e, 0x75, 0xe5, 0xfe, 0x30, 0x21,
+        0x49, 0xf8, 0x17, 0xea, 0x9f, 0xb4, 0xbe, 0xe6, 0xf4, 0x19, 0x96, 0x97, 0xd0, 0x4d, 0x5b, 0x89,
+        0xd5, 0x4f, 0xbb, 0x97, 0x8a, 0x15, 0xb5, 0xc4, 0x43, 0xc9, 0xec, 0x21, 0x03, 0x6d, 0x24, 0x60,
+        0xb6, 0xf7, 0x3e, 0xba, 0xd0, 0xdc, 0x2a, 0xba, 0x6e, 0x62, 0x4a, 0xbf, 0x07, 0x74, 0x5b, 0xc1,
+        0x07, 0x69, 0x4b, 0xb7, 0x54, 0x7b, 0xb0, 0x99, 0x5f, 0x70, 0xde, 0x25, 0xd6, 0xb2, 0x9e, 0x2d,
+        0x30, 0x11, 0xbb, 0x19, 0xd2, 0x76, 0x76, 0xc0, 0x71, 0x62, 0xc8, 0xb5, 0xcc, 0xde, 0x06, 0x68,
+        0x96, 0x1d, 0xf8, 0x68, 0x03, 0x48, 0x2c, 0xb3, 0x7e, 0xd6, 0xd5, 0xc0, 0xbb, 0x8d, 0x50, 0xcf,
+        0x1f, 0x50, 0xd4, 0x76, 0xaa, 0x04, 0x58, 0xbd, 0xab, 0xa8, 0x06, 0xf4, 0x8b, 0xe9, 0xdc, 0xb8
+    };
+    // *INDENT-ON*
+    atcac_drbg_kat_source source = { kat_seed, 0 };
+    atcac_drbg_ctx ctx;
+    uint8_t returned_bits[sizeof(kat_returned_bits)];
+    ATCA_STATUS status;
+
+    if (ATCA_SUCCESS == (status = atcac_drbg_init(&ctx, atcac_drbg_kat_entropy, &source, NULL, 0)))
+    {
+        /* The vector discards the first generate call */
+        if (ATCA_SUCCESS == (status = atcac_drbg_generate(&ctx, returned_bits, sizeof(returned_bits))))
+        {
+            status = atcac_drbg_generate(&ctx, returned_bits, sizeof(returned_bits));
+        }
+    }
+
+    if (ATCA_SUCCESS == status && memcmp(returned_bits, kat_returned_bits, sizeof(kat_returned_bits)))
+    {
+        status = ATCA_HEALTH_TEST_ERROR;
+    }
+
+    (void)atcac_drbg_free(&ctx);
+    memset(returned_bits, 0, sizeof(returned_bits));
+    return status;
+}
+
+/** \brief Entropy source that draws from the device random number generator,
+ *         32 bytes per Random command.
+ *
+ * \param[in]  ctx           Device to use, or NULL for the default device
+ * \param[out] entropy       Entropy is returned here
+ * \param[in]  entropy_size  Number of bytes requested
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcac_drbg_device_entropy(void* ctx, uint8_t* entropy, size_t entropy_size)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCADevice device = ctx ? (ATCADevice)ctx : atcab_get_device();
+    uint8_t random_num[RANDOM_NUM_SIZE];
+
+    while (entropy_size && ATCA_SUCCESS == status)
+    {
+        size_t copy_size = (entropy_size > sizeof(random_num)) ? sizeof(random_num) : entropy_size;
+
+        if (ATCA_SUCCESS == (status = atcab_random_ext(device, random_num)))
+        {
+            memcpy(entropy, random_num, copy_size);
+            entropy += copy_size;
+            entropy_size -= copy_size;
+        }
+    }
+
+    memset(random_num, 0, sizeof(random_num));
+    return status;
+}
+
+/** \brief Instantiate the default DRBG on first use, after its known answer
+ *         test has passed.
+ */
+static ATCA_STATUS atcac_sw_random_start(void)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    if (!g_atcac_sw_drbg.instantiated)
+    {
+        if (ATCA_SUCCESS == (status = atcac_drbg_health_test()))
+        {
+            status = atcac_drbg_init(&g_atcac_sw_drbg, atcac_drbg_device_entropy, NULL, NULL, 0);
+        }
+    }
+    return status;
+}
+
+/** \brief return software generated random number from the default DRBG,
+ *         which is seeded and periodically reseeded from the device.
+ * \param[out] data       ptr to space to receive the random number
+ * \param[in]  data_size  size of data buffer
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+int atcac_sw_random(uint8_t* data, size_t data_size)
+{
+    ATCA_STATUS status = atcac_sw_random_start();
+
+    if (ATCA_SUCCESS == status)
+    {
+        status = atcac_drbg_random(&g_atcac_sw_drbg, data, data_size);
+    }
+    return status;
+}
+
+/** \brief Idle time maintenance of the default DRBG, see atcac_drbg_idle()
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atcac_sw_random_idle(void)
+{
+    ATCA_STATUS status = atcac_sw_random_start();
+
+    if (ATCA_SUCCESS == status)
+    {
+        status = atcac_drbg_idle(&g_atcac_sw_drbg);
+    }
+    return status;
+}
+
+/** \brief Access the default DRBG, e.g. to read its reseed counter and health
+ *         test failures or to change its reseed interval.
+ * \return Pointer to the default DRBG context
+ */
+atcac_drbg_ctx* atcac_sw_random_drbg(void)
+{
+    return &g_atcac_sw_drbg;
+}
+
+#else
 
 /** \brief return software generated random number and the function is currently not implemented
  * \param[out] data       ptr to space to receive the random number
@@ -36,4 +538,6 @@
 int atcac_sw_random(uint8_t* data, size_t data_size)
 {
     return ATCA_UNIMPLEMENTED;
-}
\ No newline at end of file
+}
+
+#endif
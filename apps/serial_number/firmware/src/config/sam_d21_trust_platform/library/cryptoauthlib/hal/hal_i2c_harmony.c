@@ -48,6 +48,195 @@
     the HAL layer will not compile because the START I2C drivers are a dependency *
  */
 
+/** \brief Number of I2C peripherals the HAL keeps state for. Transfers on
+ *         additional buses poll the plib busy flag and always reprogram the
+ *         baud rate for the wake pulse.
+ */
+#ifndef ATCA_HAL_I2C_MAX_BUSES
+#define ATCA_HAL_I2C_MAX_BUSES      2
+#endif
+
+/** \brief Time SDA is held low for an ATCA_WAKE_GPIO wake pulse (tWLO) */
+#ifndef ATCA_HAL_I2C_WAKE_LOW_USEC
+#define ATCA_HAL_I2C_WAKE_LOW_USEC  80
+#endif
+
+/** \brief Executed while waiting for the completion callback of a transfer,
+ *         between checks of the transfer timeout. Empty by default. Define it
+ *         as __asm__ volatile ("wfe") to sleep until the next event when a
+ *         periodic interrupt (e.g. SysTick) guarantees the timeout is still
+ *         checked, or to hook in other work.
+ */
+#ifndef ATCA_HAL_I2C_WAIT_HOOK
+#define ATCA_HAL_I2C_WAIT_HOOK()
+#endif
+
+/** \brief Time added to the duration of a transfer at the bus speed before it
+ *         is considered failed, covers interrupt latency and clock stretching.
+ */
+#ifndef ATCA_HAL_I2C_TIMEOUT_MARGIN_US
+#define ATCA_HAL_I2C_TIMEOUT_MARGIN_US  1000
+#endif
+
+/** \brief State of an I2C peripheral registered in hal_i2c_init */
+typedef struct
+{
+    atca_plib_i2c_api_t*    plib;
+    bool                    event;          // transfers complete through the plib callback
+    volatile bool           busy;           // transfer in progress, cleared by the callback
+    uint32_t                speed;          // current bus speed, 0 if unknown
+    PLIB_I2C_TRANSFER_SETUP wake_setup;     // precomputed setup for the wake pulse
+} hal_i2c_bus_t;
+
+static hal_i2c_bus_t hal_i2c_buses[ATCA_HAL_I2C_MAX_BUSES];
+
+/** \brief plib transfer completion callback, executed from the I2C interrupt
+ * \param[in] context  hal_i2c_bus_t of the peripheral
+ */
+static void hal_i2c_event_callback(uintptr_t context)
+{
+    ((hal_i2c_bus_t*)context)->busy = false;
+}
+
+/** \brief Find the state of a plib registered in hal_i2c_init
+ * \param[in] plib  plib api of the peripheral
+ * \return the bus state or NULL if the plib is not registered
+ */
+static hal_i2c_bus_t* hal_i2c_bus_get(atca_plib_i2c_api_t* plib)
+{
+    int i;
+
+    for (i = 0; i < ATCA_HAL_I2C_MAX_BUSES; i++)
+    {
+        if (hal_i2c_buses[i].plib == plib)
+        {
+            return &hal_i2c_buses[i];
+        }
+    }
+    return NULL;
+}
+
+/** \brief Time allowed for transferring a number of bytes, at the current
+ *         speed of the bus or at 100 kHz while that is unknown
+ * \param[in] bus     bus state or NULL
+ * \param[in] length  number of bytes of the transfer, without the address
+ * \return timeout in us
+ */
+static uint32_t hal_i2c_timeout_us(hal_i2c_bus_t* bus, size_t length)
+{
+    uint32_t rate = (bus && bus->speed) ? bus->speed / 1000 : 100;
+
+    if (0 == rate)
+    {
+        rate = 1;
+    }
+    /* 9 clocks per byte with the acknowledge, plus the address byte */
+    return ((uint32_t)(length + 1) * 9 * 1000) / rate + ATCA_HAL_I2C_TIMEOUT_MARGIN_US;
+}
+
+/** \brief Wait until the current transfer of the plib has completed. A
+ *         transfer that does not complete in time is abandoned, a late
+ *         callback only clears the busy flag again.
+ * \param[in] plib        plib api of the peripheral
+ * \param[in] bus         bus state or NULL to poll the plib
+ * \param[in] timeout_us  time allowed for the transfer
+ * \return ATCA_SUCCESS on success, ATCA_TIMEOUT on timeout.
+ */
+static ATCA_STATUS hal_i2c_wait(atca_plib_i2c_api_t* plib, hal_i2c_bus_t* bus, uint32_t timeout_us)
+{
+    uint32_t start_us = hal_timestamp_us();
+
+    if (bus && bus->event)
+    {
+        while (bus->busy)
+        {
+            if (hal_timestamp_us() - start_us > timeout_us)
+            {
+                bus->busy = false;
+                return ATCA_TIMEOUT;
+            }
+            ATCA_HAL_I2C_WAIT_HOOK();
+        }
+    }
+    else
+    {
+        while (plib->is_busy() == true)
+        {
+            if (hal_timestamp_us() - start_us > timeout_us)
+            {
+                return ATCA_TIMEOUT;
+            }
+        }
+    }
+    return ATCA_SUCCESS;
+}
+
+/** \brief Run a transfer and wait for it to complete. Writes, reads or, if both
+ *         lengths are given, writes and then reads with a repeated start.
+ * \param[in]  plib     plib api of the peripheral
+ * \param[in]  address  7 bit device address
+ * \param[in]  wdata    bytes to write
+ * \param[in]  wlength  number of bytes to write
+ * \param[out] rdata    receives the bytes read
+ * \param[in]  rlength  number of bytes to read
+ * \return ATCA_SUCCESS on success, ATCA_TIMEOUT when the bus or the
+ *         transfer did not complete in time, otherwise an error code.
+ */
+static ATCA_STATUS hal_i2c_transfer(atca_plib_i2c_api_t* plib, uint16_t address, uint8_t* wdata, uint32_t wlength,
+                                    uint8_t* rdata, uint32_t rlength)
+{
+    hal_i2c_bus_t* bus = hal_i2c_bus_get(plib);
+    ATCA_STATUS status;
+    bool started;
+
+    /* Wait for the I2C bus to be ready, another transfer may be up to the
+       largest command long */
+    if ((status = hal_i2c_wait(plib, bus, hal_i2c_timeout_us(bus, ATCA_CMD_SIZE_MAX))) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+
+    if (bus)
+    {
+        bus->busy = bus->event;
+    }
+
+    if (wlength && rlength)
+    {
+        started = plib->write_read(address, wdata, wlength, rdata, rlength);
+    }
+    else if (wlength)
+    {
+        started = plib->write(address, wdata, wlength);
+    }
+    else
+    {
+        started = plib->read(address, rdata, rlength);
+    }
+
+    if (started == true)
+    {
+        /* Wait for the I2C transfer to complete, a repeated start adds the
+           address byte again */
+        if ((status = hal_i2c_wait(plib, bus, hal_i2c_timeout_us(bus, wlength + rlength + 1))) != ATCA_SUCCESS)
+        {
+            return status;
+        }
+
+        /* Transfer complete. Check if the transfer was successful */
+        if (plib->error_get() == PLIB_I2C_ERROR_NONE)
+        {
+            return ATCA_SUCCESS;
+        }
+    }
+    else if (bus)
+    {
+        bus->busy = false;
+    }
+
+    return ATCA_COMM_FAIL;
+}
+
 /** \brief discover i2c buses available for this hardware
  * this maintains a list of logical to physical bus mappings freeing the application
  * of the a-prior knowledge
@@ -95,6 +284,41 @@ ATCA_STATUS hal_i2c_discover_devices(int bus_num, ATCAIfaceCfg cfg[], int *found
 
 ATCA_STATUS hal_i2c_init(void *hal, ATCAIfaceCfg *cfg)
 {
+    atca_plib_i2c_api_t * plib;
+    hal_i2c_bus_t* bus;
+
+    if (!cfg)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    plib = (atca_plib_i2c_api_t*)cfg->cfg_data;
+    if (!plib)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    /* Take a free slot for a new bus */
+    if (!hal_i2c_bus_get(plib) && NULL != (bus = hal_i2c_bus_get(NULL)))
+    {
+        if (hal_i2c_wait(plib, NULL, hal_i2c_timeout_us(NULL, ATCA_CMD_SIZE_MAX)) != ATCA_SUCCESS)
+        {
+            return ATCA_TIMEOUT;
+        }
+        bus->busy = false;
+        /* The plib keeps its generated rate until change_i2c_speed programs one */
+        bus->speed = 0;
+        bus->wake_setup.clkSpeed = 100000;
+        bus->plib = plib;
+
+        /* Complete transfers from the plib interrupt when the plib provides a callback */
+        if (plib->callback_register)
+        {
+            bus->event = true;
+            plib->callback_register(hal_i2c_event_callback, (uintptr_t)bus);
+        }
+    }
+
     return ATCA_SUCCESS;
 }
 
@@ -137,29 +361,17 @@ ATCA_STATUS hal_i2c_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata,
         txlength++;                 // account for word address value byte.
     }
 
-    /* Wait for the I2C bus to be ready */
-    while (plib->is_busy() == true);
-
-    if (plib->write(cfg->atcai2c.slave_address>>1, txdata, txlength) == true)
-    {
-        /* Wait for the I2C transfer to complete */
-        while (plib->is_busy() == true);
-
-        /* Transfer complete. Check if the transfer was successful */
-        if (plib->error_get() != PLIB_I2C_ERROR_NONE)
-        {
-            return ATCA_COMM_FAIL;
-        }
-    }
-    else
-    {
-        return ATCA_COMM_FAIL;
-    }
-
-    return ATCA_SUCCESS;
+    return hal_i2c_transfer(plib, cfg->atcai2c.slave_address>>1, txdata, txlength, NULL, 0);
 }
 
 /** \brief HAL implementation of I2C receive function for START I2C
+ *
+ * The word address is written and the length bytes read back in one
+ * transaction with a repeated start when the plib provides write_read. A
+ * response whose size is known to be the minimum of 4 bytes (rxlength of 4,
+ * e.g. a status only response) is fetched completely in that single
+ * transaction.
+ *
  * \param[in]    iface         Device to interact with.
  * \param[in]    word_address  device transaction type
  * \param[out]   rxdata        Data received will be returned here.
@@ -173,6 +385,7 @@ ATCA_STATUS hal_i2c_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxda
     ATCAIfaceCfg* cfg = atgetifacecfg(iface);
     uint16_t rxdata_max_size;
     uint16_t read_length = 2;
+    uint16_t first_length;
     uint8_t min_resp_size = 4;
     atca_plib_i2c_api_t * plib;
     int retries;
@@ -190,44 +403,40 @@ ATCA_STATUS hal_i2c_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxda
     rxdata_max_size = *rxlength;
     *rxlength = 0;
 
+#if ATCA_TA_SUPPORT
+    /*Set read length.. Check for register reads or 1 byte reads*/
+    if((word_address == ATCA_MAIN_PROCESSOR_RD_CSR) || (word_address == ATCA_FAST_CRYPTO_RD_FSR)
+        || (rxdata_max_size == 1))
+    {
+        read_length = 1;
+    }
+#endif
+
+    /* Fixed size response - read it at once */
+    if ((cfg->devtype != TA100) && (rxdata_max_size == min_resp_size))
+    {
+        read_length = min_resp_size;
+    }
+    first_length = read_length;
+
     do
     {
-        /*Send Word address to device...*/
+        /*Send Word address to device and read the length bytes...*/
         retries = cfg->rx_retries;
         while (retries-- > 0 && status != ATCA_SUCCESS)
         {
-            status = hal_i2c_send(iface, word_address, &word_address, 0);
-        }
-        if(ATCA_SUCCESS != status)
-        {
-            ATCA_TRACE(status, "hal_i2c_send - failed");
-            break;
-        }
-
-#if ATCA_TA_SUPPORT
-        /*Set read length.. Check for register reads or 1 byte reads*/
-        if((word_address == ATCA_MAIN_PROCESSOR_RD_CSR) || (word_address == ATCA_FAST_CRYPTO_RD_FSR)
-            || (rxdata_max_size == 1))
-        {
-            read_length = 1;
-        }
-#endif
-
-        /* Read length bytes to know number of bytes to read */
-        status = ATCA_COMM_FAIL;
-        if (plib->read(cfg->atcai2c.slave_address>>1, rxdata, read_length) == true)
-        {
-            /* Wait for the I2C transfer to complete */
-            while (plib->is_busy() == true);
-            /* Transfer complete. Check if the transfer was successful */
-            if (plib->error_get() == PLIB_I2C_ERROR_NONE)
+            if (plib->write_read)
             {
-                status = ATCA_SUCCESS;
+                status = hal_i2c_transfer(plib, cfg->atcai2c.slave_address>>1, &word_address, 1, rxdata, first_length);
+            }
+            else if (ATCA_SUCCESS == (status = hal_i2c_send(iface, word_address, &word_address, 0)))
+            {
+                status = hal_i2c_transfer(plib, cfg->atcai2c.slave_address>>1, NULL, 0, rxdata, first_length);
             }
         }
         if(ATCA_SUCCESS != status)
         {
-            ATCA_TRACE(status, "plib->read - failed");
+            ATCA_TRACE(status, "hal_i2c_receive - failed");
             break;
         }
 
@@ -259,24 +468,17 @@ ATCA_STATUS hal_i2c_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxda
             status = ATCA_TRACE(ATCA_RX_FAIL, "packet size is invalid");
             break;
         }
-        
-        /* Read given length bytes from device */
-        status = ATCA_COMM_FAIL;
-        if (plib->read(cfg->atcai2c.slave_address>>1, &rxdata[2], read_length - 2) == true)
+
+        if (read_length > first_length)
         {
-            /* Wait for the I2C transfer to complete */
-            while (plib->is_busy() == true);
-            /* Transfer complete. Check if the transfer was successful */
-            if (plib->error_get() == PLIB_I2C_ERROR_NONE)
+            /* Read the rest of the response from device */
+            status = hal_i2c_transfer(plib, cfg->atcai2c.slave_address>>1, NULL, 0, &rxdata[first_length], read_length - first_length);
+            if(ATCA_SUCCESS != status)
             {
-                status = ATCA_SUCCESS;
+                status = ATCA_TRACE(status, "plib->read - failed");
+                break;
             }
         }
-        if(ATCA_SUCCESS != status)
-        {
-            status = ATCA_TRACE(status, "plib->read - failed");
-            break;
-        }
     }
     while (0);
 
@@ -305,12 +507,36 @@ void change_i2c_speed(ATCAIface iface, uint32_t speed)
     }
 
     PLIB_I2C_TRANSFER_SETUP setup;
+    hal_i2c_bus_t* bus = hal_i2c_bus_get(plib);
+
+    /* Nothing to do if the bus already runs at that speed */
+    if (bus && bus->speed == speed)
+    {
+        return;
+    }
+
     setup.clkSpeed = speed;
 
-    /* Make sure I2C is not busy before changing the I2C clock speed */
-    while (plib->is_busy() == true);
+    /* Make sure I2C is not busy before changing the I2C clock speed, a bus
+       that stays busy keeps its speed */
+    if (hal_i2c_wait(plib, bus, hal_i2c_timeout_us(bus, ATCA_CMD_SIZE_MAX)) != ATCA_SUCCESS)
+    {
+        return;
+    }
 
-    (void)plib->transfer_setup(&setup, 0);
+    if (bus && speed == bus->wake_setup.clkSpeed)
+    {
+        (void)plib->transfer_setup(&bus->wake_setup, 0);
+    }
+    else
+    {
+        (void)plib->transfer_setup(&setup, 0);
+    }
+
+    if (bus)
+    {
+        bus->speed = speed;
+    }
 }
 
 /** \brief wake up CryptoAuth device using I2C bus
@@ -339,48 +565,51 @@ ATCA_STATUS hal_i2c_wake(ATCAIface iface)
     }
 
     retries = cfg->rx_retries;
-
     bdrt = cfg->atcai2c.baud;
-    if (bdrt != 100000)   // if not already at 100KHz, change it
+
+    if ((cfg->wake_mode & ATCA_WAKE_PULSE_MASK) == ATCA_WAKE_GPIO && plib->sda_drive)
     {
-        change_i2c_speed(iface, 100000);
-    }
+        // Hold SDA low for tWLO, the bus keeps its baud rate
+        hal_i2c_bus_t* bus = hal_i2c_bus_get(plib);
+        ATCA_STATUS status;
 
-    while (plib->is_busy() == true);
+        if ((status = hal_i2c_wait(plib, bus, hal_i2c_timeout_us(bus, ATCA_CMD_SIZE_MAX))) != ATCA_SUCCESS)
+        {
+            return status;
+        }
+        plib->sda_drive(true);
+        atca_delay_us(ATCA_HAL_I2C_WAKE_LOW_USEC);
+        plib->sda_drive(false);
+    }
+    else
+    {
+        if (bdrt != 100000)   // if not already at 100KHz, change it
+        {
+            change_i2c_speed(iface, 100000);
+        }
 
-    // Send the 00 address as the wake pulse; part will NACK, so don't check for status
-    (void)plib->write(0x00, (uint8_t*)&data[0], 1);
+        // Send the 00 address as the wake pulse; part will NACK, so don't check for status
+        (void)hal_i2c_transfer(plib, 0x00, (uint8_t*)&data[0], 1, NULL, 0);
 
-    /* Wait for the I2C transfer to complete */
-    while (plib->is_busy() == true);
+        // if necessary, revert baud rate to what came in.
+        if (bdrt != 100000)
+        {
+            change_i2c_speed(iface, bdrt);
+        }
+    }
 
     // wait tWHI + tWLO which is configured based on device type and configuration structure
     atca_delay_us(cfg->wake_delay);
 
     while (retries-- > 0 && isSuccess == false)
     {
-        if (plib->read(cfg->atcai2c.slave_address>>1, (uint8_t*)&data[0], 4) == true)
+        if (hal_i2c_transfer(plib, cfg->atcai2c.slave_address>>1, NULL, 0, (uint8_t*)&data[0], 4) == ATCA_SUCCESS)
         {
-            /* Wait for the I2C transfer to complete */
-            while (plib->is_busy() == true);
-
-            /* Transfer complete. Check if the transfer was successful */
-            if (plib->error_get() == PLIB_I2C_ERROR_NONE)
-            {
-                isSuccess = true;
-            }
+            isSuccess = true;
         }
     }
 
-    if (isSuccess == true)
-    {
-        // if necessary, revert baud rate to what came in.
-        if (bdrt != 100000)
-        {
-            change_i2c_speed(iface, bdrt);
-        }
-    }
-    else
+    if (isSuccess == false)
     {
         return ATCA_COMM_FAIL;
     }
@@ -412,26 +641,7 @@ ATCA_STATUS hal_i2c_idle(ATCAIface iface)
 
     data[0] = 0x02;  // idle word address value
 
-    /* Wait for the I2C bus to be ready */
-    while (plib->is_busy() == true);
-
-    if (plib->write(cfg->atcai2c.slave_address>>1, (uint8_t*)&data[0], 1) == true)
-    {
-        /* Wait for the I2C transfer to complete */
-        while (plib->is_busy() == true);
-
-        /* Transfer complete. Check if the transfer was successful */
-        if (plib->error_get() != PLIB_I2C_ERROR_NONE)
-        {
-            return ATCA_COMM_FAIL;
-        }
-    }
-    else
-    {
-        return ATCA_COMM_FAIL;
-    }
-
-    return ATCA_SUCCESS;
+    return hal_i2c_transfer(plib, cfg->atcai2c.slave_address>>1, (uint8_t*)&data[0], 1, NULL, 0);
 }
 
 /** \brief sleep CryptoAuth device using I2C bus
@@ -458,26 +668,7 @@ ATCA_STATUS hal_i2c_sleep(ATCAIface iface)
 
     data[0] = 0x01;  // sleep word address value
 
-    /* Wait for the I2C bus to be ready */
-    while (plib->is_busy() == true);
-
-    if (plib->write(cfg->atcai2c.slave_address>>1, (uint8_t*)&data[0], 1) == true)
-    {
-        /* Wait for the I2C transfer to complete */
-        while (plib->is_busy() == true);
-
-        /* Transfer complete. Check if the transfer was successful */
-        if (plib->error_get() != PLIB_I2C_ERROR_NONE)
-        {
-            return ATCA_COMM_FAIL;
-        }
-    }
-    else
-    {
-        return ATCA_COMM_FAIL;
-    }
-
-    return ATCA_SUCCESS;
+    return hal_i2c_transfer(plib, cfg->atcai2c.slave_address>>1, (uint8_t*)&data[0], 1, NULL, 0);
 }
 
 /** \brief manages reference count on given bus and releases resource if no more refences exist
@@ -0,0 +1,250 @@
+/**
+ * \file
+ * \brief Recorder of the transactions between the library and the HAL
+ *
+ * atca_iface.c hands every HAL call to hal_recorder_log() when the library is
+ * built with ATCA_HAL_RECORDER. The calls are kept in a ring buffer that can
+ * be read out as a trace, dumped over the console and fed to a replay HAL to
+ * reproduce the timing of a device offline.
+ *
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include <string.h>
+#include "hal_recorder.h"
+#include "atca_hal.h"
+
+/** \defgroup hal_ Hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ *
+   @{ */
+
+static uint16_t hal_rec_get16(const uint8_t* buf)
+{
+    return (uint16_t)(buf[0] | (buf[1] << 8));
+}
+
+static uint32_t hal_rec_get32(const uint8_t* buf)
+{
+    return hal_rec_get16(buf) | ((uint32_t)hal_rec_get16(&buf[2]) << 16);
+}
+
+#ifdef ATCA_HAL_RECORDER
+static void hal_rec_put16(uint8_t* buf, uint16_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+}
+
+static void hal_rec_put32(uint8_t* buf, uint32_t value)
+{
+    hal_rec_put16(buf, (uint16_t)value);
+    hal_rec_put16(&buf[2], (uint16_t)(value >> 16));
+}
+
+static uint8_t hal_rec_buf[ATCA_HAL_RECORDER_SIZE];
+static size_t hal_rec_head;     // offset of the oldest record
+static size_t hal_rec_used;     // bytes of hal_rec_buf holding records
+static uint8_t hal_rec_devtype = (uint8_t)ATCA_DEV_UNKNOWN;
+
+/** \brief Copy bytes into the ring at an offset from the oldest record */
+static void hal_rec_write(size_t offset, const uint8_t* data, size_t length)
+{
+    size_t pos = (hal_rec_head + offset) % ATCA_HAL_RECORDER_SIZE;
+    size_t chunk;
+
+    while (length)
+    {
+        chunk = ATCA_HAL_RECORDER_SIZE - pos;
+        chunk = (chunk < length) ? chunk : length;
+        memcpy(&hal_rec_buf[pos], data, chunk);
+        data += chunk;
+        length -= chunk;
+        pos = 0;
+    }
+}
+
+/** \brief Copy bytes out of the ring from an offset from the oldest record */
+static void hal_rec_copy(size_t offset, uint8_t* data, size_t length)
+{
+    size_t pos = (hal_rec_head + offset) % ATCA_HAL_RECORDER_SIZE;
+    size_t chunk;
+
+    while (length)
+    {
+        chunk = ATCA_HAL_RECORDER_SIZE - pos;
+        chunk = (chunk < length) ? chunk : length;
+        memcpy(data, &hal_rec_buf[pos], chunk);
+        data += chunk;
+        length -= chunk;
+        pos = 0;
+    }
+}
+
+/** \brief Drop the oldest record */
+static void hal_rec_drop(void)
+{
+    uint8_t header[HAL_REC_HEADER_SIZE];
+    size_t size;
+
+    hal_rec_copy(0, header, sizeof(header));
+    size = HAL_REC_HEADER_SIZE + hal_rec_get16(&header[2]);
+    hal_rec_head = (hal_rec_head + size) % ATCA_HAL_RECORDER_SIZE;
+    hal_rec_used -= size;
+}
+
+/** \brief Record a HAL call. Records that don't fit into the ring at all are
+ *         not kept.
+ * \param[in] iface         Interface the call was made on
+ * \param[in] type          HAL call
+ * \param[in] status        Status the HAL returned
+ * \param[in] start_us      hal_timestamp_us() before the call
+ * \param[in] word_address  Word address of a send or receive
+ * \param[in] data          Bytes sent or received, NULL for none
+ * \param[in] length        Number of bytes in data
+ */
+void hal_recorder_log(ATCAIface iface, hal_rec_type_t type, ATCA_STATUS status, uint32_t start_us,
+                      uint8_t word_address, const uint8_t* data, size_t length)
+{
+    uint8_t header[HAL_REC_HEADER_SIZE];
+    size_t payload = (type == HAL_REC_SEND || type == HAL_REC_RECEIVE) ? length + 1 : 0;
+    size_t size = HAL_REC_HEADER_SIZE + payload;
+
+    if (size > ATCA_HAL_RECORDER_SIZE || payload > UINT16_MAX)
+    {
+        return;
+    }
+    if (iface && iface->mIfaceCFG)
+    {
+        hal_rec_devtype = (uint8_t)iface->mIfaceCFG->devtype;
+    }
+
+    while (ATCA_HAL_RECORDER_SIZE - hal_rec_used < size)
+    {
+        hal_rec_drop();
+    }
+
+    header[0] = (uint8_t)type;
+    header[1] = (uint8_t)status;
+    hal_rec_put16(&header[2], (uint16_t)payload);
+    hal_rec_put32(&header[4], start_us);
+    hal_rec_put32(&header[8], hal_timestamp_us() - start_us);
+    hal_rec_write(hal_rec_used, header, sizeof(header));
+    if (payload)
+    {
+        hal_rec_write(hal_rec_used + HAL_REC_HEADER_SIZE, &word_address, 1);
+        if (length)
+        {
+            hal_rec_write(hal_rec_used + HAL_REC_HEADER_SIZE + 1, data, length);
+        }
+    }
+    hal_rec_used += size;
+}
+
+/** \brief Discard all recorded transactions */
+void hal_recorder_clear(void)
+{
+    hal_rec_head = 0;
+    hal_rec_used = 0;
+}
+
+/** \brief Size of the trace hal_recorder_read() returns
+ * \return Trace header plus recorded transactions in bytes
+ */
+size_t hal_recorder_size(void)
+{
+    return HAL_REC_TRACE_HEADER_SIZE + hal_rec_used;
+}
+
+/** \brief Read part of the trace of the recorded transactions, oldest first.
+ *         The trace can be read in pieces to dump it without a buffer for the
+ *         complete trace.
+ * \param[in]  offset  Offset into the trace
+ * \param[out] buf     Receives the trace bytes
+ * \param[in]  length  Size of buf
+ * \return Number of bytes copied into buf
+ */
+size_t hal_recorder_read(size_t offset, uint8_t* buf, size_t length)
+{
+    uint8_t header[HAL_REC_TRACE_HEADER_SIZE] = { 0 };
+    size_t total = hal_recorder_size();
+    size_t copied = 0;
+    size_t chunk;
+
+    if (buf == NULL || offset >= total)
+    {
+        return 0;
+    }
+    length = (length < total - offset) ? length : total - offset;
+
+    if (offset < HAL_REC_TRACE_HEADER_SIZE)
+    {
+        memcpy(header, HAL_REC_MAGIC, 4);
+        header[4] = HAL_REC_VERSION;
+        header[5] = hal_rec_devtype;
+        chunk = HAL_REC_TRACE_HEADER_SIZE - offset;
+        chunk = (chunk < length) ? chunk : length;
+        memcpy(buf, &header[offset], chunk);
+        copied = chunk;
+        offset += chunk;
+    }
+    if (copied < length)
+    {
+        hal_rec_copy(offset - HAL_REC_TRACE_HEADER_SIZE, &buf[copied], length - copied);
+    }
+    return length;
+}
+#endif
+
+/** \brief Decode the record at the start of a buffer of trace records
+ * \param[in]  trace   Records, following the trace header
+ * \param[in]  length  Bytes available in trace
+ * \param[out] rec     Decoded record, its payload points into trace
+ * \return Size of the record in bytes, 0 when trace doesn't hold a complete
+ *         record
+ */
+size_t hal_recorder_decode(const uint8_t* trace, size_t length, hal_rec_t* rec)
+{
+    if (trace == NULL || rec == NULL || length < HAL_REC_HEADER_SIZE)
+    {
+        return 0;
+    }
+
+    rec->type = trace[0];
+    rec->status = (ATCA_STATUS)trace[1];
+    rec->length = hal_rec_get16(&trace[2]);
+    rec->start_us = hal_rec_get32(&trace[4]);
+    rec->duration_us = hal_rec_get32(&trace[8]);
+    rec->payload = &trace[HAL_REC_HEADER_SIZE];
+
+    if (length < HAL_REC_HEADER_SIZE + (size_t)rec->length)
+    {
+        return 0;
+    }
+    return HAL_REC_HEADER_SIZE + rec->length;
+}
+
+/** @} */
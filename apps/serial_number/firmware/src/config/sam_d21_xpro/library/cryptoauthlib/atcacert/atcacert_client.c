@@ -30,10 +30,12 @@
 
 #include <stdlib.h>
 #include "atcacert_client.h"
+#include "atcacert_cache.h"
 #include "atcacert_der.h"
 #include "atcacert_pem.h"
 #include "cryptoauthlib.h"
 #include "calib/calib_basic.h"
+#include "crypto/atca_crypto_sw_sha2.h"
 
 // Perform floor integer division (-1 / 2 == -1) instead of truncate towards zero (-1 / 2 == 0)
 static int floor_div(int a, int b)
@@ -109,6 +111,49 @@ int atcacert_read_device_loc(const atcacert_device_loc_t* device_loc,
     return ATCACERT_E_SUCCESS;
 }
 
+// Identify a certificate by the device serial number, the certificate
+// definition and the CA public key. Only the serial number is read, the
+// device data the certificate is built from is read on a miss only. The
+// cache is cleared whenever a command changes that data, see
+// calib_cert_cache_update().
+static int atcacert_read_cache_key(const atcacert_def_t* cert_def,
+                                   const uint8_t         ca_public_key[64],
+                                   uint8_t               key[ATCACERT_CACHE_KEY_SIZE])
+{
+    int ret = 0;
+    atcac_sha2_256_ctx ctx;
+    uint8_t serial_num[ATCA_SERIAL_NUM_SIZE];
+    uint8_t def_id[6];
+
+    ret = atcab_read_serial_number(serial_num);
+    if (ret != ATCA_SUCCESS)
+    {
+        return ret;
+    }
+
+    def_id[0] = (uint8_t)cert_def->type;
+    def_id[1] = cert_def->template_id;
+    def_id[2] = cert_def->chain_id;
+    def_id[3] = (uint8_t)(cert_def->cert_template_size & 0xFF);
+    def_id[4] = (uint8_t)(cert_def->cert_template_size >> 8);
+    def_id[5] = (ca_public_key != NULL) ? 1 : 0;
+
+    atcac_sw_sha2_256_init(&ctx);
+    atcac_sw_sha2_256_update(&ctx, serial_num, sizeof(serial_num));
+    atcac_sw_sha2_256_update(&ctx, def_id, sizeof(def_id));
+    if (cert_def->cert_template != NULL)
+    {
+        atcac_sw_sha2_256_update(&ctx, cert_def->cert_template, cert_def->cert_template_size);
+    }
+    if (ca_public_key != NULL)
+    {
+        atcac_sw_sha2_256_update(&ctx, ca_public_key, 64);
+    }
+    atcac_sw_sha2_256_finish(&ctx, key);
+
+    return ATCACERT_E_SUCCESS;
+}
+
 int atcacert_read_cert(const atcacert_def_t* cert_def,
                        const uint8_t         ca_public_key[64],
                        uint8_t*              cert,
@@ -119,6 +164,8 @@ int atcacert_read_cert(const atcacert_def_t* cert_def,
     size_t device_locs_count = 0;
     size_t i = 0;
     atcacert_build_state_t build_state;
+    atcacert_cache_t* cache = atcacert_get_cache();
+    uint8_t cache_key[ATCACERT_CACHE_KEY_SIZE];
 
     if (cert_def == NULL || cert_size == NULL)
     {
@@ -141,6 +188,19 @@ int atcacert_read_cert(const atcacert_def_t* cert_def,
         return ret;
     }
 
+    if (cache != NULL)
+    {
+        ret = atcacert_read_cache_key(cert_def, ca_public_key, cache_key);
+        if (ret != ATCACERT_E_SUCCESS)
+        {
+            return ret;
+        }
+        if (atcacert_cache_lookup(cache, cache_key, cert, cert_size))
+        {
+            return ATCACERT_E_SUCCESS;
+        }
+    }
+
     ret = atcacert_cert_build_start(&build_state, cert_def, cert, cert_size, ca_public_key);
     if (ret != ATCACERT_E_SUCCESS)
     {
@@ -169,6 +229,12 @@ int atcacert_read_cert(const atcacert_def_t* cert_def,
         return ret;
     }
 
+    if (cache != NULL)
+    {
+        // A certificate that can't be cached is still returned
+        (void)atcacert_cache_store(cache, cache_key, cert, *cert_size);
+    }
+
     return ATCACERT_E_SUCCESS;
 }
 
@@ -346,3 +346,85 @@ ATCA_STATUS atca_jwt_verify(
 
     return status;
 }
+
+/**
+ * \brief Verifies the signatures of several jwts. The token digests are
+ *        computed together with the multi-buffer SHA256 and the signatures are
+ *        checked with a batch verify on the device.
+ */
+ATCA_STATUS atca_jwt_verify_batch(
+    size_t             count,       /**< [in] Number of tokens */
+    const char* const  bufs[],      /**< [in] Encoded jwts, each null terminated */
+    const uint8_t*     pubkeys,     /**< [in] Public key of each token (raw byte format), 64 bytes each */
+    bool*              is_verified  /**< [out] Verification result of each token, false for a token
+                                               that is not a well formed jwt */
+    )
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    const uint8_t* data[ATCA_JWT_BATCH_CHUNK];
+    size_t data_size[ATCA_JWT_BATCH_CHUNK];
+    size_t index[ATCA_JWT_BATCH_CHUNK];
+    uint8_t digests[ATCA_JWT_BATCH_CHUNK][ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signatures[ATCA_JWT_BATCH_CHUNK][ATCA_ECCP256_SIG_SIZE];
+    uint8_t keys[ATCA_JWT_BATCH_CHUNK][ATCA_ECCP256_PUBKEY_SIZE];
+    bool verified[ATCA_JWT_BATCH_CHUNK];
+    size_t chunk;
+    size_t valid;
+    size_t i;
+
+    if (count > 0 && (!bufs || !pubkeys || !is_verified))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    for (; count > 0 && ATCA_SUCCESS == status; count -= chunk, bufs += chunk,
+         pubkeys += chunk * ATCA_ECCP256_PUBKEY_SIZE, is_verified += chunk)
+    {
+        chunk = (count < ATCA_JWT_BATCH_CHUNK) ? count : ATCA_JWT_BATCH_CHUNK;
+
+        /* Split the tokens, malformed ones are rejected without going to the device */
+        for (i = 0, valid = 0; i < chunk; i++)
+        {
+            const char* payload = bufs[i] ? strchr(bufs[i], '.') : NULL;
+            const char* sig = payload ? strchr(payload + 1, '.') : NULL;
+            size_t sig_len = ATCA_ECCP256_SIG_SIZE;
+
+            is_verified[i] = false;
+            if (!sig || ATCA_SUCCESS != atcab_base64decode_(sig + 1, strlen(sig + 1), signatures[valid],
+                                                            &sig_len, atcab_b64rules_urlsafe)
+                || sig_len != ATCA_ECCP256_SIG_SIZE)
+            {
+                continue;
+            }
+            data[valid] = (const uint8_t*)bufs[i];
+            data_size[valid] = (size_t)(sig - bufs[i]);
+            memcpy(keys[valid], &pubkeys[i * ATCA_ECCP256_PUBKEY_SIZE], ATCA_ECCP256_PUBKEY_SIZE);
+            index[valid++] = i;
+        }
+
+        if (valid == 0)
+        {
+            continue;
+        }
+
+        /* Digest the tokens */
+        if (ATCA_SUCCESS != (status = atcac_sw_sha2_256_multi(valid, data, data_size, &digests[0][0])))
+        {
+            break;
+        }
+
+        /* Verify the signatures using the device */
+        if (ATCA_SUCCESS != (status = atcab_verify_extern_batch((uint16_t)valid, &digests[0][0], &signatures[0][0],
+                                                                &keys[0][0], verified)))
+        {
+            break;
+        }
+
+        for (i = 0; i < valid; i++)
+        {
+            is_verified[index[i]] = verified[i];
+        }
+    }
+
+    return status;
+}
@@ -38,6 +38,11 @@
 extern "C" {
 #endif
 
+/** \brief Tokens atca_jwt_verify_batch() digests and verifies together */
+#ifndef ATCA_JWT_BATCH_CHUNK
+#define ATCA_JWT_BATCH_CHUNK    (8)
+#endif
+
 /** \brief Structure to hold metadata information about the jwt being built */
 typedef struct
 {
@@ -52,6 +57,7 @@ ATCA_STATUS atca_jwt_add_claim_numeric(atca_jwt_t* jwt, const char* claim, int32
 ATCA_STATUS atca_jwt_finalize(atca_jwt_t* jwt, uint16_t key_id);
 void atca_jwt_check_payload_start(atca_jwt_t* jwt);
 ATCA_STATUS atca_jwt_verify(const char* buf, uint16_t buflen, const uint8_t* pubkey);
+ATCA_STATUS atca_jwt_verify_batch(size_t count, const char* const bufs[], const uint8_t* pubkeys, bool* is_verified);
 
 /** @} */
 #ifdef __cplusplus
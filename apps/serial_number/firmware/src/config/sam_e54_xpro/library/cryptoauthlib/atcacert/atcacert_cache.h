@@ -0,0 +1,159 @@
+/**
+ * \file
+ * \brief Cache of reconstructed certificates, so certificates that were built
+ *        from the device data before are returned without rebuilding them.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+
+#ifndef ATCACERT_CACHE_H
+#define ATCACERT_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "atcacert.h"
+
+// Inform function naming when compiling in C++
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \defgroup atcacert_ Certificate manipulation methods (atcacert_)
+ *
+   @{ */
+
+#define ATCACERT_CACHE_KEY_SIZE     (32)                                //!< Size of the key identifying a cached certificate
+#define ATCACERT_CACHE_HEADER_SIZE  (4 + ATCACERT_CACHE_KEY_SIZE + 2)   //!< Entry header: magic, key and certificate size
+
+/** \brief Writes to a persistent cache region. Called with the offset into
+ *         the region, it has to erase the underlying memory as needed.
+ *         Returns ATCACERT_E_SUCCESS on success, otherwise an error code. */
+typedef int (*atcacert_cache_write_cb)(void* ctx, size_t offset, const uint8_t* data, size_t data_size);
+
+/** \brief Certificate cache. Entries are stored in a caller supplied region,
+ *         either RAM or a memory mapped persistent region (e.g. flash) that
+ *         keeps the certificates over a reset. Each entry is keyed by a hash
+ *         over the certificate definition, the CA public key and the device
+ *         serial number, so a lookup only reads the serial number. */
+typedef struct atcacert_cache_s
+{
+    uint8_t*                region;         //!< Entry storage
+    size_t                  entry_size;     //!< Bytes per entry, the header plus the largest certificate
+    size_t                  entry_count;    //!< Number of entries in the region
+    size_t                  next;           //!< Entry replaced next when all are used
+    atcacert_cache_write_cb write;          //!< Writes to a persistent region, NULL when the region is written directly
+    void*                   write_ctx;      //!< Passed to write
+    uint32_t                hits;           //!< Certificates returned from the cache
+    uint32_t                misses;         //!< Certificates that had to be built
+} atcacert_cache_t;
+
+/**
+ * \brief Initialize a certificate cache over a region. Entries already in a
+ *        persistent region are kept, a RAM region has to be zeroed or cleared
+ *        with atcacert_cache_clear() first.
+ *
+ * \param[out] cache          Cache to initialize.
+ * \param[in]  region         Entry storage.
+ * \param[in]  region_size    Size of region in bytes.
+ * \param[in]  max_cert_size  Largest certificate to be cached in bytes.
+ * \param[in]  write          Writes to a persistent region. Set to NULL to
+ *                            write the region directly.
+ * \param[in]  write_ctx      Passed to write.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_cache_init(atcacert_cache_t*       cache,
+                        uint8_t*                region,
+                        size_t                  region_size,
+                        size_t                  max_cert_size,
+                        atcacert_cache_write_cb write,
+                        void*                   write_ctx);
+
+/**
+ * \brief Select the cache used by atcacert_read_cert().
+ *
+ * The cached certificates are dropped whenever this library sends a command
+ * that changes the data or OTP zone, e.g. a Write including those of
+ * atcacert_write_cert() or a GenKey creating a new private key. Changes made
+ * through another host or library instance need atcacert_cache_clear().
+ *
+ * \param[in] cache  Cache to use, NULL to always build certificates.
+ */
+void atcacert_set_cache(atcacert_cache_t* cache);
+
+/**
+ * \brief Get the cache used by atcacert_read_cert().
+ *
+ * \return Cache selected by atcacert_set_cache(), NULL when there is none.
+ */
+atcacert_cache_t* atcacert_get_cache(void);
+
+/**
+ * \brief Drop all entries of a cache.
+ *
+ * \param[in] cache  Cache to clear.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_cache_clear(atcacert_cache_t* cache);
+
+/**
+ * \brief Look up a certificate.
+ *
+ * \param[in]     cache      Cache to look in.
+ * \param[in]     key        Key the certificate was stored with.
+ * \param[out]    cert       Buffer to receive the certificate.
+ * \param[in,out] cert_size  As input, the size of the cert buffer in bytes.
+ *                           As output, the size of the certificate returned.
+ *
+ * \return true when the certificate was found and fits cert.
+ */
+bool atcacert_cache_lookup(atcacert_cache_t* cache,
+                           const uint8_t     key[ATCACERT_CACHE_KEY_SIZE],
+                           uint8_t*          cert,
+                           size_t*           cert_size);
+
+/**
+ * \brief Store a certificate, replacing an entry with the same key. When all
+ *        entries are used they are replaced in turn.
+ *
+ * \param[in] cache      Cache to store in.
+ * \param[in] key        Key identifying the certificate.
+ * \param[in] cert       Certificate.
+ * \param[in] cert_size  Size of the certificate in bytes.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code.
+ */
+int atcacert_cache_store(atcacert_cache_t* cache,
+                         const uint8_t     key[ATCACERT_CACHE_KEY_SIZE],
+                         const uint8_t*    cert,
+                         size_t            cert_size);
+
+/** @} */
+#ifdef __cplusplus
+}
+#endif
+
+#endif
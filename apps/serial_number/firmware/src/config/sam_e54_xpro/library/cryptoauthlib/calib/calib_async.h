@@ -0,0 +1,105 @@
+/**
+ * \file
+ * \brief Non-blocking command execution for CryptoAuth devices.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#ifndef CALIB_ASYNC_H_
+#define CALIB_ASYNC_H_
+
+/** \ingroup atcab_
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Completion callback of an asynchronous operation
+ *  \param[in] status  Result of the operation
+ *  \param[in] param   Parameter given when the operation was submitted
+ */
+typedef void (*atca_async_callback)(ATCA_STATUS status, void* param);
+
+struct calib_async_ctx;
+
+/** \brief Operation specific step. Called with the response status of the
+ *         previous command (ATCA_SUCCESS for the first step) and either builds
+ *         the next command in the context packet or sets done.
+ */
+typedef ATCA_STATUS (*calib_async_step)(struct calib_async_ctx* ctx, ATCA_STATUS rsp_status, bool* done);
+
+/** \brief States of the per device asynchronous execution state machine */
+typedef enum
+{
+    CALIB_ASYNC_STATE_IDLE,     //!< No operation in progress
+    CALIB_ASYNC_STATE_WAKE,     //!< Device has to be woken
+    CALIB_ASYNC_STATE_SEND,     //!< Next command is ready to be sent
+    CALIB_ASYNC_STATE_WAIT,     //!< Waiting for the command to execute
+    CALIB_ASYNC_STATE_RECEIVE,  //!< Polling for the response
+} calib_async_state_t;
+
+/** \brief Context of an asynchronous operation. Owned by the caller and must
+ *         stay valid, together with all buffers passed to the submit call,
+ *         until the completion callback has run.
+ */
+typedef struct calib_async_ctx
+{
+    struct calib_async_ctx* next;                //!< Next operation in progress
+    ATCADevice              device;              //!< Device executing the operation
+    calib_async_state_t     state;               //!< Current state
+    calib_async_step        fp_step;             //!< Operation specific step function
+    uint8_t                 step;                //!< Index of the current command within the operation
+    ATCA_STATUS             status;              //!< Result once the operation has completed
+    uint32_t                sent_us;             //!< Time the current command was sent
+    uint32_t                wait_us;             //!< Time after sent_us of the next poll
+    uint32_t                interval_us;         //!< Polling interval
+    uint16_t                key_id;              //!< Key used by the operation
+    const uint8_t*          message;             //!< 32 byte message digest
+    const uint8_t*          signature;           //!< Signature to verify
+    const uint8_t*          public_key;          //!< Public key to verify with or of the ECDH peer
+    uint8_t*                out;                 //!< Output buffer of the operation
+    bool*                   is_verified;         //!< Verification result
+    atca_async_callback     callback;            //!< Completion callback
+    void*                   param;               //!< Completion callback parameter
+    ATCAPacket              packet;              //!< Command/response buffer
+} calib_async_ctx_t;
+
+ATCA_STATUS calib_async_sign(ATCADevice device, calib_async_ctx_t* ctx, uint16_t key_id, const uint8_t* msg, uint8_t* signature,
+                             atca_async_callback callback, void* param);
+ATCA_STATUS calib_async_verify_extern(ATCADevice device, calib_async_ctx_t* ctx, const uint8_t* message, const uint8_t* signature,
+                                      const uint8_t* public_key, bool* is_verified, atca_async_callback callback, void* param);
+ATCA_STATUS calib_async_ecdh(ATCADevice device, calib_async_ctx_t* ctx, uint16_t key_id, const uint8_t* public_key, uint8_t* pms,
+                             atca_async_callback callback, void* param);
+ATCA_STATUS calib_async_random(ATCADevice device, calib_async_ctx_t* ctx, uint8_t* rand_out, atca_async_callback callback, void* param);
+bool calib_async_tasks(void);
+uint32_t calib_async_idle_us(void);
+bool calib_async_is_busy(ATCADevice device);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif
@@ -47,7 +47,6 @@ extern "C" {
 
 #define ATCA_UNSUPPORTED_CMD ((uint16_t)0xFFFF)
 
-#ifdef ATCA_NO_POLL
 /** \brief Structure to hold the device execution time and the opcode for the
  *         corresponding command
  */
@@ -58,9 +57,50 @@ typedef struct
 }device_execution_time_t;
 
 ATCA_STATUS calib_get_execution_time(uint8_t opcode, ATCACommand ca_cmd);
+
+/** \brief Time a wake session may keep the device awake before it is idled
+ *         and woken again. The device watchdog (tWATCHDOG) is 0.7s minimum. */
+#ifndef ATCA_WATCHDOG_BUDGET_MSEC
+#define ATCA_WATCHDOG_BUDGET_MSEC           (600)
+#endif
+
+/** \brief Wake session budget for an ATECC608A with ChipMode WDG_LONG set (7s minimum) */
+#ifndef ATCA_WATCHDOG_LONG_BUDGET_MSEC
+#define ATCA_WATCHDOG_LONG_BUDGET_MSEC      (6000)
+#endif
+
+#if !defined(ATCA_NO_POLL) && !defined(ATCA_NO_ADAPTIVE_POLL)
+/** \brief Polling interval once the expected completion time is reached */
+#ifndef ATCA_POLLING_FINE_TIME_USEC
+#define ATCA_POLLING_FINE_TIME_USEC         (500)
+#endif
+
+ATCA_STATUS calib_poll_export(ATCADevice device, calib_poll_entry_t* entries, size_t* count);
+ATCA_STATUS calib_poll_reset(ATCADevice device);
 #endif
 
+#ifndef ATCA_NO_POLL
+void calib_poll_timing(ATCADevice device, const ATCAPacket* packet, uint32_t* wait_us, uint32_t* interval_us);
+void calib_poll_learn(ATCADevice device, const ATCAPacket* packet, uint32_t complete_us);
+#endif
+
+/** \brief True while commands on the device share one wake, either through an
+ *         open wake session or the ATCA_WAKE_SESSION wake mode */
+#define calib_wake_shared(device)   ((device)->wake_depth || ((device)->mIface->mIfaceCFG->wake_mode & ATCA_WAKE_SESSION))
+
+ATCA_STATUS calib_wake_for_command(ATCADevice device, uint32_t expected_ms);
+uint16_t calib_get_response_size(const ATCAPacket* packet);
 ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device);
+void calib_cert_cache_update(const ATCAPacket* packet);
+
+#ifdef ATCA_CONFIG_CACHE
+void calib_config_cache_update(ATCADevice device, const ATCAPacket* packet);
+#endif
+#ifdef ATCA_DATA_CACHE
+ATCA_STATUS calib_data_cache_get_pubkey(ATCADevice device, uint16_t key_id, uint8_t* public_key);
+void calib_data_cache_put_pubkey(ATCADevice device, uint16_t key_id, const uint8_t* public_key);
+void calib_data_cache_update(ATCADevice device, const ATCAPacket* packet);
+#endif
 
 #ifdef __cplusplus
 }
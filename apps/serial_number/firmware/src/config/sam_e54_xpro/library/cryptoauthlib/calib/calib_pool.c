@@ -0,0 +1,519 @@
+/**
+ * \file
+ * \brief Pool of CryptoAuth devices that share work between them.
+ *
+ * Requests are queued on the pool and handed to the least busy device that
+ * holds the key, using the non-blocking execution of calib_async. With N
+ * devices up to N requests execute at the same time. A device that stops
+ * responding is taken out of the pool and its request moves to another
+ * device.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include "cryptoauthlib.h"
+#include "calib_pool.h"
+
+/** \brief Check whether a status means the device did not respond properly,
+ *         as opposed to the device rejecting the command
+ */
+static bool calib_pool_is_comm_error(ATCA_STATUS status)
+{
+    switch (status)
+    {
+    case ATCA_WAKE_FAILED:
+    case ATCA_STATUS_CRC:
+    case ATCA_STATUS_SELFTEST_ERROR:
+    case ATCA_RX_CRC_ERROR:
+    case ATCA_RX_FAIL:
+    case ATCA_RX_NO_RESPONSE:
+    case ATCA_TX_TIMEOUT:
+    case ATCA_RX_TIMEOUT:
+    case ATCA_TOO_MANY_COMM_RETRIES:
+    case ATCA_COMM_FAIL:
+    case ATCA_TIMEOUT:
+    case ATCA_TX_FAIL:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/** \brief Time a device has spent executing requests since the last stats
+ *         reset, including the request in progress
+ */
+static uint32_t calib_pool_busy_us(const calib_pool_member_t* member, uint32_t now)
+{
+    return member->busy_us + (member->request ? now - member->started_us : 0);
+}
+
+static void calib_pool_dispatch(calib_pool_t* pool);
+
+/** \brief Completion callback of the request in progress on a device
+ *  \param[in] status  Result of the operation
+ *  \param[in] param   Pool member that executed it
+ */
+static void calib_pool_complete(ATCA_STATUS status, void* param)
+{
+    calib_pool_member_t* member = (calib_pool_member_t*)param;
+    calib_pool_t* pool = member->pool;
+    calib_pool_request_t* req = member->request;
+    uint32_t now = hal_timestamp_us();
+
+    member->busy_us += now - member->started_us;
+    member->request = NULL;
+
+    if (calib_pool_is_comm_error(status))
+    {
+        member->errors++;
+        if (++member->failures >= ATCA_POOL_FAIL_LIMIT || !member->online)
+        {
+            member->online = false;
+            member->offline_us = now;
+        }
+
+        // Fail over: try the request again on another device
+        req->tried |= (uint32_t)1 << (member - pool->members);
+        req->last_status = status;
+        req->next = pool->queue;
+        pool->queue = req;
+        calib_pool_dispatch(pool);
+        return;
+    }
+
+    member->failures = 0;
+    member->online = true;
+    member->ops++;
+    if (status != ATCA_SUCCESS)
+    {
+        member->errors++;
+    }
+
+    if (req->callback)
+    {
+        req->callback(status, req->param);
+    }
+    calib_pool_dispatch(pool);
+}
+
+/** \brief Starts a request on a device
+ *  \return ATCA_SUCCESS when the request was started, otherwise an error code.
+ */
+static ATCA_STATUS calib_pool_start(calib_pool_member_t* member, calib_pool_request_t* req)
+{
+    ATCA_STATUS status = ATCA_BAD_PARAM;
+
+    member->request = req;
+    member->started_us = hal_timestamp_us();
+
+    switch (req->op)
+    {
+    case CALIB_POOL_OP_SIGN:
+        status = calib_async_sign(member->device, &member->async, req->key_id, req->message, req->out, calib_pool_complete, member);
+        break;
+    case CALIB_POOL_OP_VERIFY_EXTERN:
+        status = calib_async_verify_extern(member->device, &member->async, req->message, req->signature, req->public_key,
+                                           req->is_verified, calib_pool_complete, member);
+        break;
+    case CALIB_POOL_OP_ECDH:
+        status = calib_async_ecdh(member->device, &member->async, req->key_id, req->public_key, req->out, calib_pool_complete, member);
+        break;
+    case CALIB_POOL_OP_RANDOM:
+        status = calib_async_random(member->device, &member->async, req->out, calib_pool_complete, member);
+        break;
+    default:
+        break;
+    }
+
+    if (status != ATCA_SUCCESS)
+    {
+        member->request = NULL;
+    }
+    return status;
+}
+
+/** \brief Picks the device to run a request on: the least busy idle device
+ *         holding the key. Devices out of the pool are only picked once
+ *         their reprobe time has passed and no responding device is idle.
+ *  \param[in]  pool     Pool
+ *  \param[in]  req      Request to place
+ *  \param[out] waiting  Set when a suitable device exists but is busy
+ *  \return Pool member or NULL if no device can take the request now.
+ */
+static calib_pool_member_t* calib_pool_select(calib_pool_t* pool, const calib_pool_request_t* req, bool* waiting)
+{
+    calib_pool_member_t* best = NULL;
+    calib_pool_member_t* member;
+    uint32_t now = hal_timestamp_us();
+    uint32_t best_busy = 0;
+    uint32_t busy;
+    uint8_t i;
+
+    *waiting = false;
+    for (i = 0; i < pool->count; i++)
+    {
+        member = &pool->members[i];
+
+        if ((req->tried & ((uint32_t)1 << i)) ||
+            ((req->op == CALIB_POOL_OP_SIGN || req->op == CALIB_POOL_OP_ECDH) && !(member->key_mask & (1u << req->key_id))))
+        {
+            continue;
+        }
+
+        if (!member->online && (now - member->offline_us) < (ATCA_POOL_REPROBE_MSEC * 1000u))
+        {
+            continue;
+        }
+
+        if (member->request || calib_async_is_busy(member->device))
+        {
+            *waiting = true;
+            continue;
+        }
+
+        busy = calib_pool_busy_us(member, now);
+        if (best == NULL || (member->online && !best->online) || (member->online == best->online && busy < best_busy))
+        {
+            best = member;
+            best_busy = busy;
+        }
+    }
+
+    return best;
+}
+
+/** \brief Hands queued requests to idle devices. Requests no device can
+ *         take any more are completed with the error of the last device that
+ *         failed them, or ATCA_NO_DEVICES when no device could take them.
+ */
+static void calib_pool_dispatch(calib_pool_t* pool)
+{
+    calib_pool_request_t** link = &pool->queue;
+    calib_pool_request_t* req;
+    calib_pool_member_t* member;
+    ATCA_STATUS status;
+    bool waiting;
+
+    while ((req = *link) != NULL)
+    {
+        member = calib_pool_select(pool, req, &waiting);
+        if (member == NULL && waiting)
+        {
+            link = &req->next;
+            continue;
+        }
+
+        // The request leaves the queue
+        *link = req->next;
+        req->next = NULL;
+
+        if (member == NULL)
+        {
+            status = req->last_status;
+        }
+        else if ((status = calib_pool_start(member, req)) == ATCA_SUCCESS)
+        {
+            continue;
+        }
+
+        if (req->callback)
+        {
+            req->callback(status, req->param);
+        }
+        // The callback may have queued requests, start over
+        link = &pool->queue;
+    }
+}
+
+/** \brief Queues a request and starts it if a device is idle */
+static ATCA_STATUS calib_pool_submit(calib_pool_t* pool, calib_pool_request_t* req, atca_async_callback callback, void* param)
+{
+    calib_pool_request_t** link = &pool->queue;
+
+    req->next = NULL;
+    req->tried = 0;
+    req->last_status = ATCA_NO_DEVICES;
+    req->callback = callback;
+    req->param = param;
+
+    while (*link)
+    {
+        link = &(*link)->next;
+    }
+    *link = req;
+
+    calib_pool_dispatch(pool);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Initializes an empty pool
+ *  \param[in] pool  Pool to initialize
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_pool_init(calib_pool_t* pool)
+{
+    if (pool == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    memset(pool, 0, sizeof(*pool));
+    pool->stats_us = hal_timestamp_us();
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Adds an initialized device to a pool
+ *
+ *  \param[in] pool      Pool
+ *  \param[in] device    Device context, e.g. from atcab_init_ext()
+ *  \param[in] key_mask  Slots of the device that hold the pool keys, bit n
+ *                       for slot n. Sign and ECDH requests for a slot only go
+ *                       to devices that have its bit set.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_pool_add(calib_pool_t* pool, ATCADevice device, uint16_t key_mask)
+{
+    calib_pool_member_t* member;
+
+    if (pool == NULL || device == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (pool->count >= ATCA_POOL_MAX_DEVICES)
+    {
+        return ATCA_ALLOC_FAILURE;
+    }
+
+    member = &pool->members[pool->count++];
+    memset(member, 0, sizeof(*member));
+    member->pool = pool;
+    member->device = device;
+    member->key_mask = key_mask;
+    member->online = true;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Submits an ECDSA sign of a 32 byte message digest to the pool.
+ *
+ *  \param[in]  pool       Pool
+ *  \param[in]  req        Request, owned by the caller until the callback
+ *  \param[in]  key_id     Slot of the ECC private key used to sign
+ *  \param[in]  msg        32-byte message to be signed, has to stay valid
+ *                         until the callback
+ *  \param[out] signature  Receives the 64-byte signature (R and S)
+ *  \param[in]  callback   Completion callback, may be NULL
+ *  \param[in]  param      Parameter passed to the callback
+ *
+ *  \return ATCA_SUCCESS when the request was queued, otherwise an error code.
+ */
+ATCA_STATUS calib_pool_sign(calib_pool_t* pool, calib_pool_request_t* req, uint16_t key_id, const uint8_t* msg, uint8_t* signature,
+                            atca_async_callback callback, void* param)
+{
+    if (pool == NULL || req == NULL || key_id > 15 || msg == NULL || signature == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    req->op = CALIB_POOL_OP_SIGN;
+    req->key_id = key_id;
+    req->message = msg;
+    req->out = signature;
+
+    return calib_pool_submit(pool, req, callback, param);
+}
+
+/** \brief Submits the verification of a signature with an external public
+ *         key to the pool. Any device can take it.
+ *
+ *  \param[in]  pool         Pool
+ *  \param[in]  req          Request, owned by the caller until the callback
+ *  \param[in]  message      32 byte message, has to stay valid until the callback
+ *  \param[in]  signature    64 byte signature (R and S), has to stay valid
+ *                           until the callback
+ *  \param[in]  public_key   64 byte public key (X and Y), has to stay valid
+ *                           until the callback
+ *  \param[out] is_verified  Receives the verification result
+ *  \param[in]  callback     Completion callback, may be NULL
+ *  \param[in]  param        Parameter passed to the callback
+ *
+ *  \return ATCA_SUCCESS when the request was queued, otherwise an error code.
+ */
+ATCA_STATUS calib_pool_verify_extern(calib_pool_t* pool, calib_pool_request_t* req, const uint8_t* message, const uint8_t* signature,
+                                     const uint8_t* public_key, bool* is_verified, atca_async_callback callback, void* param)
+{
+    if (pool == NULL || req == NULL || message == NULL || signature == NULL || public_key == NULL || is_verified == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    req->op = CALIB_POOL_OP_VERIFY_EXTERN;
+    req->message = message;
+    req->signature = signature;
+    req->public_key = public_key;
+    req->is_verified = is_verified;
+
+    return calib_pool_submit(pool, req, callback, param);
+}
+
+/** \brief Submits an ECDH with the private key in a slot to the pool. The
+ *         premaster secret is returned in the clear.
+ *
+ *  \param[in]  pool        Pool
+ *  \param[in]  req         Request, owned by the caller until the callback
+ *  \param[in]  key_id      Slot of the ECC private key
+ *  \param[in]  public_key  64 byte public key (X and Y) of the other party,
+ *                          has to stay valid until the callback
+ *  \param[out] pms         Receives the 32 byte premaster secret
+ *  \param[in]  callback    Completion callback, may be NULL
+ *  \param[in]  param       Parameter passed to the callback
+ *
+ *  \return ATCA_SUCCESS when the request was queued, otherwise an error code.
+ */
+ATCA_STATUS calib_pool_ecdh(calib_pool_t* pool, calib_pool_request_t* req, uint16_t key_id, const uint8_t* public_key, uint8_t* pms,
+                            atca_async_callback callback, void* param)
+{
+    if (pool == NULL || req == NULL || key_id > 15 || public_key == NULL || pms == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    req->op = CALIB_POOL_OP_ECDH;
+    req->key_id = key_id;
+    req->public_key = public_key;
+    req->out = pms;
+
+    return calib_pool_submit(pool, req, callback, param);
+}
+
+/** \brief Submits the generation of a 32 byte random number to the pool. Any
+ *         device can take it.
+ *
+ *  \param[in]  pool      Pool
+ *  \param[in]  req       Request, owned by the caller until the callback
+ *  \param[out] rand_out  Receives the 32 bytes of random data
+ *  \param[in]  callback  Completion callback, may be NULL
+ *  \param[in]  param     Parameter passed to the callback
+ *
+ *  \return ATCA_SUCCESS when the request was queued, otherwise an error code.
+ */
+ATCA_STATUS calib_pool_random(calib_pool_t* pool, calib_pool_request_t* req, uint8_t* rand_out, atca_async_callback callback, void* param)
+{
+    if (pool == NULL || req == NULL || rand_out == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    req->op = CALIB_POOL_OP_RANDOM;
+    req->out = rand_out;
+
+    return calib_pool_submit(pool, req, callback, param);
+}
+
+/** \brief Advances the requests of a pool. Call it periodically from the
+ *         application main loop, e.g. from SYS_Tasks(). It also advances any
+ *         other asynchronous operation, see calib_async_tasks().
+ *  \param[in] pool  Pool
+ *  \return true while requests are queued or in progress
+ */
+bool calib_pool_tasks(calib_pool_t* pool)
+{
+    uint8_t i;
+
+    (void)calib_async_tasks();
+
+    // Picks up devices that are due to be probed again
+    calib_pool_dispatch(pool);
+
+    if (pool->queue)
+    {
+        return true;
+    }
+    for (i = 0; i < pool->count; i++)
+    {
+        if (pool->members[i].request)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/** \brief Gets the statistics of a device in the pool since the last
+ *         calib_pool_reset_stats().
+ *
+ *  \param[in]  pool   Pool
+ *  \param[in]  index  Index of the device, in the order it was added
+ *  \param[out] stats  Receives the statistics
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_pool_get_stats(calib_pool_t* pool, uint8_t index, calib_pool_stats_t* stats)
+{
+    calib_pool_member_t* member;
+    uint32_t now = hal_timestamp_us();
+    uint32_t elapsed_us;
+
+    if (pool == NULL || stats == NULL || index >= pool->count)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    elapsed_us = now - pool->stats_us;
+    member = &pool->members[index];
+    stats->device = member->device;
+    stats->online = member->online;
+    stats->busy = (member->request != NULL);
+    stats->ops = member->ops;
+    stats->errors = member->errors;
+    stats->busy_us = calib_pool_busy_us(member, now);
+    stats->utilization = (uint8_t)(elapsed_us ? ((uint64_t)stats->busy_us * 100u) / elapsed_us : 0);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Restarts the statistics of all devices in the pool. The busy time
+ *         is kept in microseconds, so reset at least every hour.
+ *  \param[in] pool  Pool
+ */
+void calib_pool_reset_stats(calib_pool_t* pool)
+{
+    uint32_t now = hal_timestamp_us();
+    uint8_t i;
+
+    for (i = 0; i < pool->count; i++)
+    {
+        pool->members[i].busy_us = 0;
+        pool->members[i].ops = 0;
+        pool->members[i].errors = 0;
+        if (pool->members[i].request)
+        {
+            pool->members[i].started_us = now;
+        }
+    }
+    pool->stats_us = now;
+}
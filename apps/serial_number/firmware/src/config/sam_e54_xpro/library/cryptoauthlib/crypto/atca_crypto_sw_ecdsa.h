@@ -30,6 +30,7 @@
 #define ATCA_CRYPTO_SW_ECDSA_H
 
 #include "atca_crypto_sw.h"
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -46,6 +47,26 @@
 #define ATCA_ECC_P256_PUBLIC_KEY_SIZE  (ATCA_ECC_P256_FIELD_SIZE * 2)
 #define ATCA_ECC_P256_SIGNATURE_SIZE   (ATCA_ECC_P256_FIELD_SIZE * 2)
 
+/** \brief Window width in bits used for the generator in
+ *         atcac_sw_ecdsa_verify_p256(). The precomputed generator table takes
+ *         (2^w - 1) * 64 bytes of flash, valid values are 1 to 6 */
+#ifndef ATCAC_ECC_P256_GEN_WINDOW
+#define ATCAC_ECC_P256_GEN_WINDOW      (4)
+#endif
+
+/** \brief Window width in bits used for the public key. Its table is built
+ *         on the stack per verify and takes (2^w - 1) * 96 bytes, valid values
+ *         are 1 to 5 */
+#ifndef ATCAC_ECC_P256_KEY_WINDOW
+#define ATCAC_ECC_P256_KEY_WINDOW      (4)
+#endif
+
+/** \brief Signatures that share one inversion in
+ *         atcac_sw_ecdsa_verify_p256_batch(), each takes 96 bytes of stack */
+#ifndef ATCAC_ECC_P256_BATCH_CHUNK
+#define ATCAC_ECC_P256_BATCH_CHUNK     (8)
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -53,6 +74,8 @@ extern "C" {
 int atcac_sw_ecdsa_verify_p256(const uint8_t msg[ATCA_ECC_P256_FIELD_SIZE],
                                const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
                                const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE]);
+int atcac_sw_ecdsa_verify_p256_batch(size_t count, const uint8_t* msgs, const uint8_t* signatures,
+                                     const uint8_t* public_keys, bool* is_verified);
 
 #ifdef __cplusplus
 }
@@ -47,6 +47,14 @@ extern "C" {
 
 ATCA_DLL ATCADevice _gDevice;
 
+/** \brief Number of device contexts atcab_init_ext() can hand out when the
+ *         library is built with ATCA_NO_HEAP. The global basic API context
+ *         (_gDevice) occupies one of them once atcab_init() is called.
+ */
+#ifndef ATCA_MAX_DEVICES
+#define ATCA_MAX_DEVICES                        (2)
+#endif
+
 // Basic global methods
 ATCA_STATUS atcab_version(char *ver_str);
 ATCA_STATUS atcab_init_ext(ATCADevice* device, ATCAIfaceCfg* cfg);
@@ -55,15 +63,43 @@ ATCA_STATUS atcab_init_device(ATCADevice ca_device);
 ATCA_STATUS atcab_release_ext(ATCADevice* device);
 ATCA_STATUS atcab_release(void);
 ATCADevice atcab_get_device(void);
+uint32_t atcab_get_device_generation(void);
 ATCADeviceType atcab_get_device_type_ext(ATCADevice device);
 ATCADeviceType atcab_get_device_type(void);
 
 bool atcab_is_ca_device(ATCADeviceType dev_type);
 bool atcab_is_ta_device(ATCADeviceType dev_type);
 
+#ifdef ATCA_STATS
+ATCA_STATUS atcab_get_stats_ext(ATCADevice device, atca_stats_t* stats);
+ATCA_STATUS atcab_get_stats(atca_stats_t* stats);
+ATCA_STATUS atcab_reset_stats_ext(ATCADevice device);
+ATCA_STATUS atcab_reset_stats(void);
+#endif
+
+#ifdef ATCA_CONFIG_CACHE
+ATCA_STATUS atcab_config_cache_enable_ext(ATCADevice device, bool enable);
+ATCA_STATUS atcab_config_cache_enable(bool enable);
+ATCA_STATUS atcab_config_cache_invalidate_ext(ATCADevice device);
+ATCA_STATUS atcab_config_cache_invalidate(void);
+ATCA_STATUS atcab_config_cache_stats_ext(ATCADevice device, uint32_t* hits, uint32_t* misses);
+ATCA_STATUS atcab_config_cache_stats(uint32_t* hits, uint32_t* misses);
+#endif
+
+#ifdef ATCA_DATA_CACHE
+ATCA_STATUS atcab_data_cache_policy_ext(ATCADevice device, uint16_t data_slots, uint16_t pubkey_slots);
+ATCA_STATUS atcab_data_cache_policy(uint16_t data_slots, uint16_t pubkey_slots);
+ATCA_STATUS atcab_data_cache_invalidate_ext(ATCADevice device);
+ATCA_STATUS atcab_data_cache_invalidate(void);
+ATCA_STATUS atcab_data_cache_stats_ext(ATCADevice device, uint32_t* hits, uint32_t* misses);
+ATCA_STATUS atcab_data_cache_stats(uint32_t* hits, uint32_t* misses);
+#endif
+
 #define atcab_cfg_discover(...)                 calib_cfg_discover(__VA_ARGS__)
 #define atcab_get_addr(...)                     calib_get_addr(__VA_ARGS__)
 #define atca_execute_command(...)               calib_execute_command(__VA_ARGS__)
+#define atcab_poll_export(...)                  calib_poll_export(_gDevice, __VA_ARGS__)
+#define atcab_poll_reset()                      calib_poll_reset(_gDevice)
 
 
 // AES Mode functions
@@ -90,318 +126,542 @@ ATCA_STATUS atcab_aes_ctr_increment(atca_aes_ctr_ctx_t* ctx);
 
 #if ATCA_CA_SUPPORT && !ATCA_TA_SUPPORT && !defined(ATCA_USE_ATCAB_FUNCTIONS)
 #define atcab_wakeup()                          calib_wakeup(_gDevice)
+#define atcab_wakeup_ext                        calib_wakeup
 #define atcab_idle()                            calib_idle(_gDevice)
+#define atcab_idle_ext                          calib_idle
 #define atcab_sleep()                           calib_sleep(_gDevice)
+#define atcab_sleep_ext                         calib_sleep
+#define atcab_session_begin()                   calib_session_begin(_gDevice)
+#define atcab_session_begin_ext                 calib_session_begin
+#define atcab_session_end()                     calib_session_end(_gDevice)
+#define atcab_session_end_ext                   calib_session_end
+#define atcab_async_sign(...)                   calib_async_sign(_gDevice, __VA_ARGS__)
+#define atcab_async_sign_ext                    calib_async_sign
+#define atcab_async_verify_extern(...)          calib_async_verify_extern(_gDevice, __VA_ARGS__)
+#define atcab_async_verify_extern_ext           calib_async_verify_extern
+#define atcab_async_tasks()                     calib_async_tasks()
+#define atcab_async_idle_us()                   calib_async_idle_us()
 #define _atcab_exit(...)                         _calib_exit(_gDevice, __VA_ARGS__)
 #define atcab_get_zone_size(...)                calib_get_zone_size(_gDevice, __VA_ARGS__)
+#define atcab_get_zone_size_ext                 calib_get_zone_size
 
 
 // AES command functions
 #define atcab_aes(...)                          calib_aes(_gDevice, __VA_ARGS__)
+#define atcab_aes_ext                           calib_aes
 #define atcab_aes_encrypt(...)                  calib_aes_encrypt(_gDevice, __VA_ARGS__)
 #define atcab_aes_encrypt_ext                   calib_aes_encrypt
 #define atcab_aes_decrypt(...)                  calib_aes_decrypt(_gDevice, __VA_ARGS__)
 #define atcab_aes_decrypt_ext                   calib_aes_decrypt
 #define atcab_aes_gfm(...)                      calib_aes_gfm(_gDevice, __VA_ARGS__)
+#define atcab_aes_gfm_ext                       calib_aes_gfm
 
 #define atcab_aes_gcm_init(...)                 calib_aes_gcm_init(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_init_ext                  calib_aes_gcm_init
 #define atcab_aes_gcm_init_rand(...)            calib_aes_gcm_init_rand(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_init_rand_ext             calib_aes_gcm_init_rand
 #define atcab_aes_gcm_aad_update(...)           calib_aes_gcm_aad_update(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_aad_update_ext            calib_aes_gcm_aad_update
 #define atcab_aes_gcm_encrypt_update(...)       calib_aes_gcm_encrypt_update(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_encrypt_update_ext        calib_aes_gcm_encrypt_update
 #define atcab_aes_gcm_encrypt_finish(...)       calib_aes_gcm_encrypt_finish(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_encrypt_finish_ext        calib_aes_gcm_encrypt_finish
 #define atcab_aes_gcm_decrypt_update(...)       calib_aes_gcm_decrypt_update(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_decrypt_update_ext        calib_aes_gcm_decrypt_update
 #define atcab_aes_gcm_decrypt_finish(...)       calib_aes_gcm_decrypt_finish(_gDevice, __VA_ARGS__)
+#define atcab_aes_gcm_decrypt_finish_ext        calib_aes_gcm_decrypt_finish
 
 // CheckMAC command functions
 #define atcab_checkmac(...)                     calib_checkmac(_gDevice, __VA_ARGS__)
+#define atcab_checkmac_ext                      calib_checkmac
 
 // Counter command functions
 #define atcab_counter(...)                      calib_counter(_gDevice, __VA_ARGS__)
+#define atcab_counter_ext                       calib_counter
 #define atcab_counter_increment(...)            calib_counter_increment(_gDevice, __VA_ARGS__)
+#define atcab_counter_increment_ext             calib_counter_increment
 #define atcab_counter_read(...)                 calib_counter_read(_gDevice, __VA_ARGS__)
+#define atcab_counter_read_ext                  calib_counter_read
 
 // DeriveKey command functions
 #define atcab_derivekey(...)                    calib_derivekey(_gDevice, __VA_ARGS__)
+#define atcab_derivekey_ext                     calib_derivekey
 
 // ECDH command functions
 #define atcab_ecdh_base(...)                    calib_ecdh_base(_gDevice, __VA_ARGS__)
+#define atcab_ecdh_base_ext                     calib_ecdh_base
 #define atcab_ecdh(...)                         calib_ecdh(_gDevice, __VA_ARGS__)
+#define atcab_ecdh_ext                          calib_ecdh
 #define atcab_ecdh_enc(...)                     calib_ecdh_enc(_gDevice, __VA_ARGS__)
+#define atcab_ecdh_enc_ext                      calib_ecdh_enc
 #define atcab_ecdh_ioenc(...)                   calib_ecdh_ioenc(_gDevice, __VA_ARGS__)
+#define atcab_ecdh_ioenc_ext                    calib_ecdh_ioenc
 #define atcab_ecdh_tempkey(...)                 calib_ecdh_tempkey(_gDevice, __VA_ARGS__)
+#define atcab_ecdh_tempkey_ext                  calib_ecdh_tempkey
 #define atcab_ecdh_tempkey_ioenc(...)           calib_ecdh_tempkey_ioenc(_gDevice, __VA_ARGS__)
+#define atcab_ecdh_tempkey_ioenc_ext            calib_ecdh_tempkey_ioenc
 
 // GenDig command functions
 #define atcab_gendig(...)                       calib_gendig(_gDevice, __VA_ARGS__)
+#define atcab_gendig_ext                        calib_gendig
 
 // GenKey command functions
 #define atcab_genkey_base(...)                  calib_genkey_base(_gDevice, __VA_ARGS__)
+#define atcab_genkey_base_ext                   calib_genkey_base
 #define atcab_genkey(...)                       calib_genkey(_gDevice, __VA_ARGS__)
+#define atcab_genkey_ext                        calib_genkey
 #define atcab_get_pubkey(...)                   calib_get_pubkey(_gDevice, __VA_ARGS__)
+#define atcab_get_pubkey_ext                    calib_get_pubkey
 
 // HMAC command functions
 #define atcab_hmac(...)                         calib_hmac(_gDevice, __VA_ARGS__)
+#define atcab_hmac_ext                          calib_hmac
 
 // Info command functions
 #define atcab_info_base(...)                    calib_info_base(_gDevice, __VA_ARGS__)
+#define atcab_info_base_ext                     calib_info_base
 #define atcab_info(...)                         calib_info(_gDevice, __VA_ARGS__)
+#define atcab_info_ext                          calib_info
 #define atcab_info_get_latch(...)               calib_info_get_latch(_gDevice, __VA_ARGS__)
+#define atcab_info_get_latch_ext                calib_info_get_latch
 #define atcab_info_set_latch(...)               calib_info_set_latch(_gDevice, __VA_ARGS__)
+#define atcab_info_set_latch_ext                calib_info_set_latch
 
 // KDF command functions
 #define atcab_kdf(...)                          calib_kdf(_gDevice, __VA_ARGS__)
+#define atcab_kdf_ext                           calib_kdf
 
 // Lock command functions
 #define atcab_lock(...)                          calib_lock(_gDevice, __VA_ARGS__)
+#define atcab_lock_ext                           calib_lock
 #define atcab_lock_config_zone()                 calib_lock_config_zone(_gDevice)
+#define atcab_lock_config_zone_ext               calib_lock_config_zone
 #define atcab_lock_config_zone_crc(...)          calib_lock_config_zone_crc(_gDevice, __VA_ARGS__)
+#define atcab_lock_config_zone_crc_ext           calib_lock_config_zone_crc
 #define atcab_lock_data_zone()                   calib_lock_data_zone(_gDevice)
+#define atcab_lock_data_zone_ext                 calib_lock_data_zone
 #define atcab_lock_data_zone_crc(...)            calib_lock_data_zone_crc(_gDevice, __VA_ARGS__)
+#define atcab_lock_data_zone_crc_ext             calib_lock_data_zone_crc
 #define atcab_lock_data_slot(...)                calib_lock_data_slot(_gDevice, __VA_ARGS__)
+#define atcab_lock_data_slot_ext                 calib_lock_data_slot
 
 // MAC command functions
 #define atcab_mac(...)                          calib_mac(_gDevice, __VA_ARGS__)
+#define atcab_mac_ext                           calib_mac
 
 // Nonce command functions
 #define atcab_nonce_base(...)                   calib_nonce_base(_gDevice, __VA_ARGS__)
+#define atcab_nonce_base_ext                    calib_nonce_base
 #define atcab_nonce(...)                        calib_nonce(_gDevice, __VA_ARGS__)
+#define atcab_nonce_ext                         calib_nonce
 #define atcab_nonce_load(...)                   calib_nonce_load(_gDevice, __VA_ARGS__)
+#define atcab_nonce_load_ext                    calib_nonce_load
 #define atcab_nonce_rand(...)                   calib_nonce_rand(_gDevice, __VA_ARGS__)
+#define atcab_nonce_rand_ext                    calib_nonce_rand
 #define atcab_challenge(...)                    calib_challenge(_gDevice, __VA_ARGS__)
+#define atcab_challenge_ext                     calib_challenge
 #define atcab_challenge_seed_update(...)        calib_challenge_seed_update(_gDevice, __VA_ARGS__)
+#define atcab_challenge_seed_update_ext         calib_challenge_seed_update
 
 // PrivWrite command functions
 #define atcab_priv_write(...)                   calib_priv_write(_gDevice, __VA_ARGS__)
+#define atcab_priv_write_ext                    calib_priv_write
 
 
 // Random command functions
+#ifdef ATCA_RANDOM_DRBG
+ATCA_STATUS atcab_random(uint8_t* rand_out);
+#else
 #define atcab_random(...)                       calib_random(_gDevice, __VA_ARGS__)
+#endif
 #define atcab_random_ext                        calib_random
 
 // Read command functions
 #define atcab_read_zone(...)                    calib_read_zone(_gDevice, __VA_ARGS__)
+#define atcab_read_zone_ext                     calib_read_zone
 #define atcab_is_locked(...)                    calib_is_locked(_gDevice, __VA_ARGS__)
+#define atcab_is_locked_ext                     calib_is_locked
 #define atcab_is_config_locked(...)             calib_is_locked(_gDevice, LOCK_ZONE_CONFIG, __VA_ARGS__)
+#define atcab_is_config_locked_ext(device, ...) calib_is_locked(device, LOCK_ZONE_CONFIG, __VA_ARGS__)
 #define atcab_is_data_locked(...)               calib_is_locked(_gDevice, LOCK_ZONE_DATA, __VA_ARGS__)
+#define atcab_is_data_locked_ext(device, ...)   calib_is_locked(device, LOCK_ZONE_DATA, __VA_ARGS__)
 #define atcab_is_slot_locked(...)               calib_is_slot_locked(_gDevice, __VA_ARGS__)
+#define atcab_is_slot_locked_ext                calib_is_slot_locked
 #define atcab_read_bytes_zone(...)              calib_read_bytes_zone(_gDevice, __VA_ARGS__)
+#define atcab_read_bytes_zone_ext               calib_read_bytes_zone
 #define atcab_read_serial_number(...)           calib_read_serial_number(_gDevice, __VA_ARGS__)
+#define atcab_read_serial_number_ext            calib_read_serial_number
 #define atcab_read_pubkey(...)                  calib_read_pubkey(_gDevice, __VA_ARGS__)
+#define atcab_read_pubkey_ext                   calib_read_pubkey
 #define atcab_read_sig(...)                     calib_read_sig(_gDevice, __VA_ARGS__)
+#define atcab_read_sig_ext                      calib_read_sig
 #define atcab_read_config_zone(...)             calib_read_config_zone(_gDevice, __VA_ARGS__)
+#define atcab_read_config_zone_ext              calib_read_config_zone
 #define atcab_cmp_config_zone(...)              calib_cmp_config_zone(_gDevice, __VA_ARGS__)
+#define atcab_cmp_config_zone_ext               calib_cmp_config_zone
 #define atcab_read_enc(...)                     calib_read_enc(_gDevice, __VA_ARGS__)
+#define atcab_read_enc_ext                      calib_read_enc
 
 
 // SecureBoot command functions
 #define atcab_secureboot(...)                   calib_secureboot(_gDevice, __VA_ARGS__)
+#define atcab_secureboot_ext                    calib_secureboot
 #define atcab_secureboot_mac(...)               calib_secureboot_mac(_gDevice, __VA_ARGS__)
+#define atcab_secureboot_mac_ext                calib_secureboot_mac
 
 // SelfTest command functions
 #define atcab_selftest(...)                     calib_selftest(_gDevice, __VA_ARGS__)
+#define atcab_selftest_ext                      calib_selftest
 
 // SHA command functions
 #define atcab_sha_base(...)                     calib_sha_base(_gDevice, __VA_ARGS__)
+#define atcab_sha_base_ext                      calib_sha_base
 #define atcab_sha_start()                       calib_sha_start(_gDevice)
+#define atcab_sha_start_ext                     calib_sha_start
 #define atcab_sha_update(...)                   calib_sha_update(_gDevice, __VA_ARGS__)
+#define atcab_sha_update_ext                    calib_sha_update
 #define atcab_sha_end(...)                      calib_sha_end(_gDevice, __VA_ARGS__)
+#define atcab_sha_end_ext                       calib_sha_end
 #define atcab_sha_read_context(...)             calib_sha_read_context(_gDevice, __VA_ARGS__)
+#define atcab_sha_read_context_ext              calib_sha_read_context
 #define atcab_sha_write_context(...)            calib_sha_write_context(_gDevice, __VA_ARGS__)
+#define atcab_sha_write_context_ext             calib_sha_write_context
 #define atcab_sha(...)                          calib_sha(_gDevice, __VA_ARGS__)
+#define atcab_sha_ext                           calib_sha
 #define atcab_hw_sha2_256(...)                  calib_hw_sha2_256(_gDevice, __VA_ARGS__)
+#define atcab_hw_sha2_256_ext                   calib_hw_sha2_256
 #define atcab_hw_sha2_256_init(...)             calib_hw_sha2_256_init(_gDevice, __VA_ARGS__)
+#define atcab_hw_sha2_256_init_ext              calib_hw_sha2_256_init
 #define atcab_hw_sha2_256_update(...)           calib_hw_sha2_256_update(_gDevice, __VA_ARGS__)
+#define atcab_hw_sha2_256_update_ext            calib_hw_sha2_256_update
 #define atcab_hw_sha2_256_finish(...)           calib_hw_sha2_256_finish(_gDevice, __VA_ARGS__)
+#define atcab_hw_sha2_256_finish_ext            calib_hw_sha2_256_finish
 #define atcab_sha_hmac_init(...)                calib_sha_hmac_init(_gDevice, __VA_ARGS__)
+#define atcab_sha_hmac_init_ext                 calib_sha_hmac_init
 #define atcab_sha_hmac_update(...)              calib_sha_hmac_update(_gDevice, __VA_ARGS__)
+#define atcab_sha_hmac_update_ext               calib_sha_hmac_update
 #define atcab_sha_hmac_finish(...)              calib_sha_hmac_finish(_gDevice, __VA_ARGS__)
+#define atcab_sha_hmac_finish_ext               calib_sha_hmac_finish
 #define atcab_sha_hmac(...)                     calib_sha_hmac(_gDevice, __VA_ARGS__)
+#define atcab_sha_hmac_ext                      calib_sha_hmac
 #define SHA_CONTEXT_MAX_SIZE                    (99)
 
 // Sign command functions
 #define atcab_sign_base(...)                    calib_sign_base(_gDevice, __VA_ARGS__)
+#define atcab_sign_base_ext                     calib_sign_base
 #define atcab_sign(...)                         calib_sign(_gDevice, __VA_ARGS__)
+#define atcab_sign_ext                          calib_sign
 #define atcab_sign_internal(...)                calib_sign_internal(_gDevice, __VA_ARGS__)
+#define atcab_sign_internal_ext                 calib_sign_internal
 
 // UpdateExtra command functions
 #define atcab_updateextra(...)                  calib_updateextra(_gDevice, __VA_ARGS__)
+#define atcab_updateextra_ext                   calib_updateextra
 
 // Verify command functions
 #define atcab_verify(...)                       calib_verify(_gDevice, __VA_ARGS__)
+#define atcab_verify_ext                        calib_verify
 #define atcab_verify_extern(...)                calib_verify_extern(_gDevice, __VA_ARGS__)
+#define atcab_verify_extern_ext                 calib_verify_extern
+#define atcab_verify_extern_batch(...)          calib_verify_extern_batch(_gDevice, __VA_ARGS__)
+#define atcab_verify_extern_batch_ext           calib_verify_extern_batch
 #define atcab_verify_extern_mac(...)            calib_verify_extern_mac(_gDevice, __VA_ARGS__)
+#define atcab_verify_extern_mac_ext             calib_verify_extern_mac
 #define atcab_verify_stored(...)                calib_verify_stored(_gDevice, __VA_ARGS__)
+#define atcab_verify_stored_ext                 calib_verify_stored
 #define atcab_verify_stored_mac(...)            calib_verify_stored_mac(_gDevice, __VA_ARGS__)
+#define atcab_verify_stored_mac_ext             calib_verify_stored_mac
 #define atcab_verify_validate(...)              calib_verify_validate(_gDevice, __VA_ARGS__)
+#define atcab_verify_validate_ext               calib_verify_validate
 #define atcab_verify_invalidate(...)            calib_verify_invalidate(_gDevice, __VA_ARGS__)
+#define atcab_verify_invalidate_ext             calib_verify_invalidate
 
 // Write command functions
 #define atcab_write(...)                        calib_write(_gDevice, __VA_ARGS__)
+#define atcab_write_ext                         calib_write
 #define atcab_write_zone(...)                   calib_write_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_zone_ext                    calib_write_zone
 #define atcab_write_bytes_zone(...)             calib_write_bytes_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_bytes_zone_ext              calib_write_bytes_zone
 #define atcab_write_pubkey(...)                 calib_write_pubkey(_gDevice, __VA_ARGS__)
+#define atcab_write_pubkey_ext                  calib_write_pubkey
 #define atcab_write_config_zone(...)            calib_write_config_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_config_zone_ext             calib_write_config_zone
 #define atcab_write_enc(...)                    calib_write_enc(_gDevice, __VA_ARGS__)
+#define atcab_write_enc_ext                     calib_write_enc
 #define atcab_write_config_counter(...)         calib_write_config_counter(_gDevice, __VA_ARGS__)
+#define atcab_write_config_counter_ext          calib_write_config_counter
 
 #elif ATCA_TA_SUPPORT && !ATCA_CA_SUPPORT && !defined(ATCA_USE_ATCAB_FUNCTIONS)
 
 #define atcab_wakeup(...)                       (0)
+#define atcab_wakeup_ext(...)                   (0)
 #define atcab_idle(...)                         (0)
+#define atcab_idle_ext(...)                     (0)
 #define atcab_sleep(...)                        (0)
+#define atcab_sleep_ext(...)                    (0)
+#define atcab_session_begin(...)                (0)
+#define atcab_session_begin_ext(...)            (0)
+#define atcab_session_end(...)                  (0)
+#define atcab_session_end_ext(...)              (0)
+#define atcab_async_sign(...)                   (0)
+#define atcab_async_sign_ext(...)               (0)
+#define atcab_async_verify_extern(...)          (0)
+#define atcab_async_verify_extern_ext(...)      (0)
+#define atcab_async_tasks(...)                  (0)
+#define atcab_async_idle_us(...)                (0)
 #define _atcab_exit(...)                        (1)
 #define atcab_get_zone_size(...)                talib_get_zone_size(_gDevice, __VA_ARGS__)
+#define atcab_get_zone_size_ext                 talib_get_zone_size
 //#define atcab_cfg_discover(...)                 (1)
 //#define atcab_get_addr(...)                     (1)
 
 // AES command functions
 #define atcab_aes(...)                          (1)
+#define atcab_aes_ext(...)                      (1)
 #define atcab_aes_encrypt(...)                  talib_aes_encrypt(_gDevice, __VA_ARGS__)
 #define atcab_aes_encrypt_ext                   talib_aes_encrypt
 #define atcab_aes_decrypt(...)                  talib_aes_decrypt(_gDevice, __VA_ARGS__)
 #define atcab_aes_decrypt_ext                   talib_aes_decrypt
 #define atcab_aes_gfm(...)                      (1)
+#define atcab_aes_gfm_ext(...)                  (1)
 
 #define atcab_aes_gcm_init(...)                 (1)
+#define atcab_aes_gcm_init_ext(...)             (1)
 #define atcab_aes_gcm_init_rand(...)            (1)
+#define atcab_aes_gcm_init_rand_ext(...)        (1)
 #define atcab_aes_gcm_aad_update(...)           (1)
+#define atcab_aes_gcm_aad_update_ext(...)       (1)
 #define atcab_aes_gcm_encrypt_update(...)       (1)
+#define atcab_aes_gcm_encrypt_update_ext(...)   (1)
 #define atcab_aes_gcm_encrypt_finish(...)       (1)
+#define atcab_aes_gcm_encrypt_finish_ext(...)   (1)
 #define atcab_aes_gcm_decrypt_update(...)       (1)
+#define atcab_aes_gcm_decrypt_update_ext(...)   (1)
 #define atcab_aes_gcm_decrypt_finish(...)       (1)
+#define atcab_aes_gcm_decrypt_finish_ext(...)   (1)
 
 // CheckMAC command functions
 #define atcab_checkmac(...)                     (1)
+#define atcab_checkmac_ext(...)                 (1)
 
 // Counter command functions
 #define atcab_counter(...)                      talib_counter(_gDevice, __VA_ARGS__)
+#define atcab_counter_ext                       talib_counter
 #define atcab_counter_increment(...)            talib_counter_increment(_gDevice, __VA_ARGS__)
+#define atcab_counter_increment_ext             talib_counter_increment
 #define atcab_counter_read(...)                 talib_counter_read(_gDevice, __VA_ARGS__)
+#define atcab_counter_read_ext                  talib_counter_read
 
 // DeriveKey command functions
 #define atcab_derivekey(...)                    (1)
+#define atcab_derivekey_ext(...)                (1)
 
 // ECDH command functions
 #define atcab_ecdh_base(...)                    (1)
+#define atcab_ecdh_base_ext(...)                (1)
 #define atcab_ecdh(...)                         talib_ecdh_compat(_gDevice, __VA_ARGS__)
+#define atcab_ecdh_ext                          talib_ecdh_compat
 #define atcab_ecdh_enc(...)                     (ATCA_UNIMPLEMENTED)
+#define atcab_ecdh_enc_ext(...)                 (ATCA_UNIMPLEMENTED)
 #define atcab_ecdh_ioenc(...)                   (ATCA_UNIMPLEMENTED)
+#define atcab_ecdh_ioenc_ext(...)               (ATCA_UNIMPLEMENTED)
 #define atcab_ecdh_tempkey(...)                 (1)
+#define atcab_ecdh_tempkey_ext(...)             (1)
 #define atcab_ecdh_tempkey_ioenc(...)           (ATCA_UNIMPLEMENTED)
+#define atcab_ecdh_tempkey_ioenc_ext(...)       (ATCA_UNIMPLEMENTED)
 
 // GenDig command functions
 #define atcab_gendig(...)                       (1)
+#define atcab_gendig_ext(...)                   (1)
 
 // GenKey command functions
 #define atcab_genkey_base(...)                  (ATCA_UNIMPLEMENTED)
+#define atcab_genkey_base_ext(...)              (ATCA_UNIMPLEMENTED)
 #define atcab_genkey(...)                       talib_genkey_compat(_gDevice, __VA_ARGS__)
+#define atcab_genkey_ext                        talib_genkey_compat
 #define atcab_get_pubkey(...)                   talib_get_pubkey_compat(_gDevice, __VA_ARGS__)
+#define atcab_get_pubkey_ext                    talib_get_pubkey_compat
 
 // HMAC command functions
 #define atcab_hmac(...)                         (ATCA_UNIMPLEMENTED)
+#define atcab_hmac_ext(...)                     (ATCA_UNIMPLEMENTED)
 
 // Info command functions
 #define atcab_info_base(...)                    talib_info_base(_gDevice, __VA_ARGS__)
+#define atcab_info_base_ext                     talib_info_base
 #define atcab_info(...)                         talib_info_compat(_gDevice, __VA_ARGS__)
+#define atcab_info_ext                          talib_info_compat
 #define atcab_info_get_latch(...)               (1)
+#define atcab_info_get_latch_ext(...)           (1)
 #define atcab_info_set_latch(...)               (1)
+#define atcab_info_set_latch_ext(...)           (1)
 //#define atcab_info_get_latch(...)               talib_info_get_latch(_gDevice, __VA_ARGS__)
 //#define atcab_info_set_latch(...)               talib_info_set_latch(_gDevice, __VA_ARGS__)
 
 // KDF command functions
 #define atcab_kdf(...)                          (1)
+#define atcab_kdf_ext(...)                      (1)
 
 // Lock command functions
 #define atcab_lock(...)                         (1)
+#define atcab_lock_ext(...)                     (1)
 #define atcab_lock_config_zone()                talib_lock_config(_gDevice)
+#define atcab_lock_config_zone_ext              talib_lock_config
 #define atcab_lock_config_zone_crc(...)         talib_lock_config_with_crc(_gDevice, __VA_ARGS__)
+#define atcab_lock_config_zone_crc_ext          talib_lock_config_with_crc
 #define atcab_lock_data_zone()                  talib_lock_setup(_gDevice)
+#define atcab_lock_data_zone_ext                talib_lock_setup
 #define atcab_lock_data_zone_crc(...)           (1)
+#define atcab_lock_data_zone_crc_ext(...)       (1)
 #define atcab_lock_data_slot(...)               talib_lock_handle(_gDevice, __VA_ARGS__)
+#define atcab_lock_data_slot_ext                talib_lock_handle
 
 // MAC command functions
 #define atcab_mac(...)                          (ATCA_UNIMPLEMENTED)
+#define atcab_mac_ext(...)                      (ATCA_UNIMPLEMENTED)
 
 // Nonce command functions
 #define atcab_nonce_base(...)                   (1)
+#define atcab_nonce_base_ext(...)               (1)
 #define atcab_nonce(...)                        (1)
+#define atcab_nonce_ext(...)                    (1)
 #define atcab_nonce_load(...)                   (1)
+#define atcab_nonce_load_ext(...)               (1)
 #define atcab_nonce_rand(...)                   (1)
+#define atcab_nonce_rand_ext(...)               (1)
 #define atcab_challenge(...)                    (1)
+#define atcab_challenge_ext(...)                (1)
 #define atcab_challenge_seed_update(...)        (1)
+#define atcab_challenge_seed_update_ext(...)    (1)
 
 // PrivWrite command functionsoc
 #define atcab_priv_write(...)                   (1)
+#define atcab_priv_write_ext(...)               (1)
 
 // Random command functions
+#ifdef ATCA_RANDOM_DRBG
+ATCA_STATUS atcab_random(uint8_t* rand_out);
+#else
 #define atcab_random(...)                       talib_random_compat(_gDevice, __VA_ARGS__)
+#endif
 #define atcab_random_ext                        talib_random_compat
 
 // Read command functions
 #define atcab_read_zone(...)                    (ATCA_UNIMPLEMENTED)
+#define atcab_read_zone_ext(...)                (ATCA_UNIMPLEMENTED)
 #define atcab_is_locked(...)                    talib_is_locked_compat(_gDevice, __VA_ARGS__)
+#define atcab_is_locked_ext                     talib_is_locked_compat
 #define atcab_is_config_locked(...)             talib_is_config_locked(_gDevice, __VA_ARGS__)
+#define atcab_is_config_locked_ext              talib_is_config_locked
 #define atcab_is_data_locked(...)               talib_is_setup_locked(_gDevice, __VA_ARGS__)
+#define atcab_is_data_locked_ext                talib_is_setup_locked
 #define atcab_is_slot_locked(...)               talib_is_handle_locked(_gDevice, __VA_ARGS__)
+#define atcab_is_slot_locked_ext                talib_is_handle_locked
 #define atcab_read_bytes_zone(...)              talib_read_bytes_zone(_gDevice, __VA_ARGS__)
+#define atcab_read_bytes_zone_ext               talib_read_bytes_zone
 #define atcab_read_serial_number(...)           talib_info_serial_number_compat(_gDevice, __VA_ARGS__)
+#define atcab_read_serial_number_ext            talib_info_serial_number_compat
 #define atcab_read_pubkey(...)                  talib_read_pubkey_compat(_gDevice, __VA_ARGS__)
+#define atcab_read_pubkey_ext                   talib_read_pubkey_compat
 #define atcab_read_sig(...)                     talib_read_sig_compat(_gDevice, __VA_ARGS__)
+#define atcab_read_sig_ext                      talib_read_sig_compat
 #define atcab_read_config_zone(...)             talib_read_config_zone(_gDevice, __VA_ARGS__)
+#define atcab_read_config_zone_ext              talib_read_config_zone
 #define atcab_cmp_config_zone(...)              talib_cmp_config_zone(_gDevice, __VA_ARGS__)
+#define atcab_cmp_config_zone_ext               talib_cmp_config_zone
 #define atcab_read_enc(...)                     (ATCA_UNIMPLEMENTED)
+#define atcab_read_enc_ext(...)                 (ATCA_UNIMPLEMENTED)
 
 
 // SecureBoot command functions
 #define atcab_secureboot(...)                   (ATCA_UNIMPLEMENTED)
+#define atcab_secureboot_ext(...)               (ATCA_UNIMPLEMENTED)
 #define atcab_secureboot_mac(...)               (ATCA_UNIMPLEMENTED)
+#define atcab_secureboot_mac_ext(...)           (ATCA_UNIMPLEMENTED)
 
 // SelfTest command functions
 #define atcab_selftest(...)                     (1)
+#define atcab_selftest_ext(...)                 (1)
 
 // SHA command functions
 #define atcab_sha_base(...)                     talib_sha_base_compat(_gDevice, __VA_ARGS__)
+#define atcab_sha_base_ext                      talib_sha_base_compat
 #define atcab_sha_start()                       talib_sha_start(_gDevice)
+#define atcab_sha_start_ext                     talib_sha_start
 #define atcab_sha_update(...)                   talib_sha_update_compat(_gDevice, __VA_ARGS__)
+#define atcab_sha_update_ext                    talib_sha_update_compat
 #define atcab_sha_end(...)                      talib_sha_end_compat(_gDevice, __VA_ARGS__)
+#define atcab_sha_end_ext                       talib_sha_end_compat
 #define atcab_sha_read_context(...)             talib_sha_read_context(_gDevice, __VA_ARGS__)
+#define atcab_sha_read_context_ext              talib_sha_read_context
 #define atcab_sha_write_context(...)            talib_sha_write_context(_gDevice, __VA_ARGS__)
+#define atcab_sha_write_context_ext             talib_sha_write_context
 #define atcab_sha(...)                          talib_sha(_gDevice, __VA_ARGS__)
+#define atcab_sha_ext                           talib_sha
 #define atcab_hw_sha2_256(...)                  (1)
+#define atcab_hw_sha2_256_ext(...)              (1)
 #define atcab_hw_sha2_256_init(...)             (1)
+#define atcab_hw_sha2_256_init_ext(...)         (1)
 #define atcab_hw_sha2_256_update(...)           (1)
+#define atcab_hw_sha2_256_update_ext(...)       (1)
 #define atcab_hw_sha2_256_finish(...)           (1)
+#define atcab_hw_sha2_256_finish_ext(...)       (1)
 #define atcab_sha_hmac_init(...)                (ATCA_UNIMPLEMENTED)
+#define atcab_sha_hmac_init_ext(...)            (ATCA_UNIMPLEMENTED)
 #define atcab_sha_hmac_update(...)              (ATCA_UNIMPLEMENTED)
+#define atcab_sha_hmac_update_ext(...)          (ATCA_UNIMPLEMENTED)
 #define atcab_sha_hmac_finish(...)              (ATCA_UNIMPLEMENTED)
+#define atcab_sha_hmac_finish_ext(...)          (ATCA_UNIMPLEMENTED)
 #define atcab_sha_hmac(...)                     talib_hmac_compat(_gDevice, __VA_ARGS__)
+#define atcab_sha_hmac_ext                      talib_hmac_compat
 #define SHA_CONTEXT_MAX_SIZE                    (109)
 
 // Sign command functions
 #define atcab_sign_base(...)                    (1)
+#define atcab_sign_base_ext(...)                (1)
 #define atcab_sign(...)                         talib_sign_compat(_gDevice, __VA_ARGS__)
+#define atcab_sign_ext                          talib_sign_compat
 #define atcab_sign_internal(...)                (1)
+#define atcab_sign_internal_ext(...)            (1)
 
 // UpdateExtra command functions
 #define atcab_updateextra(...)                  (1)
+#define atcab_updateextra_ext(...)              (1)
 
 // Verify command functions
 #define atcab_verify(...)                       (1)
+#define atcab_verify_ext(...)                   (1)
 #define atcab_verify_extern(...)                talib_verify_extern_compat(_gDevice, __VA_ARGS__)
+#define atcab_verify_extern_ext                 talib_verify_extern_compat
+#define atcab_verify_extern_batch(...)          (ATCA_UNIMPLEMENTED)
+#define atcab_verify_extern_batch_ext(...)      (ATCA_UNIMPLEMENTED)
 #define atcab_verify_extern_mac(...)            (ATCA_UNIMPLEMENTED)
+#define atcab_verify_extern_mac_ext(...)        (ATCA_UNIMPLEMENTED)
 #define atcab_verify_stored(...)                talib_verify_stored_compat(_gDevice, __VA_ARGS__)
+#define atcab_verify_stored_ext                 talib_verify_stored_compat
 #define atcab_verify_stored_mac(...)            (ATCA_UNIMPLEMENTED)
+#define atcab_verify_stored_mac_ext(...)        (ATCA_UNIMPLEMENTED)
 #define atcab_verify_validate(...)              (ATCA_UNIMPLEMENTED)
+#define atcab_verify_validate_ext(...)          (ATCA_UNIMPLEMENTED)
 #define atcab_verify_invalidate(...)            (ATCA_UNIMPLEMENTED)
+#define atcab_verify_invalidate_ext(...)        (ATCA_UNIMPLEMENTED)
 
 // Write command functions
 #define atcab_write(...)                        (ATCA_UNIMPLEMENTED)
+#define atcab_write_ext(...)                    (ATCA_UNIMPLEMENTED)
 #define atcab_write_zone(...)                   talib_write_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_zone_ext                    talib_write_zone
 #define atcab_write_bytes_zone(...)             talib_write_bytes_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_bytes_zone_ext              talib_write_bytes_zone
 #define atcab_write_pubkey(...)                 talib_write_pubkey_compat(_gDevice, __VA_ARGS__)
+#define atcab_write_pubkey_ext                  talib_write_pubkey_compat
 #define atcab_write_config_zone(...)            talib_write_config_zone(_gDevice, __VA_ARGS__)
+#define atcab_write_config_zone_ext             talib_write_config_zone
 #define atcab_write_enc(...)                    (ATCA_UNIMPLEMENTED)
+#define atcab_write_enc_ext(...)                (ATCA_UNIMPLEMENTED)
 #define atcab_write_config_counter(...)         (ATCA_UNIMPLEMENTED)
+#define atcab_write_config_counter_ext(...)     (ATCA_UNIMPLEMENTED)
 
 #endif
 
@@ -410,99 +670,163 @@ ATCA_STATUS atcab_aes_ctr_increment(atca_aes_ctr_ctx_t* ctx);
 /* Basic global methods */
 ATCA_STATUS _atcab_exit(void);
 ATCA_STATUS atcab_wakeup(void);
+ATCA_STATUS atcab_wakeup_ext(ATCADevice device);
 ATCA_STATUS atcab_idle(void);
+ATCA_STATUS atcab_idle_ext(ATCADevice device);
 ATCA_STATUS atcab_sleep(void);
+ATCA_STATUS atcab_sleep_ext(ATCADevice device);
+ATCA_STATUS atcab_session_begin_ext(ATCADevice device);
+ATCA_STATUS atcab_session_begin(void);
+ATCA_STATUS atcab_session_end_ext(ATCADevice device);
+ATCA_STATUS atcab_session_end(void);
+ATCA_STATUS atcab_async_sign_ext(ATCADevice device, calib_async_ctx_t* ctx, uint16_t key_id, const uint8_t* msg, uint8_t* signature,
+                                 atca_async_callback callback, void* param);
+ATCA_STATUS atcab_async_sign(calib_async_ctx_t* ctx, uint16_t key_id, const uint8_t* msg, uint8_t* signature, atca_async_callback callback, void* param);
+ATCA_STATUS atcab_async_verify_extern_ext(ATCADevice device, calib_async_ctx_t* ctx, const uint8_t* message, const uint8_t* signature,
+                                          const uint8_t* public_key, bool* is_verified, atca_async_callback callback, void* param);
+ATCA_STATUS atcab_async_verify_extern(calib_async_ctx_t* ctx, const uint8_t* message, const uint8_t* signature, const uint8_t* public_key,
+                                      bool* is_verified, atca_async_callback callback, void* param);
+bool atcab_async_tasks(void);
+uint32_t atcab_async_idle_us(void);
 //ATCA_STATUS atcab_cfg_discover(ATCAIfaceCfg cfg_array[], int max);
 //ATCA_STATUS atcab_get_addr(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint16_t* addr);
 ATCA_STATUS atcab_get_zone_size(uint8_t zone, uint16_t slot, size_t* size);
+ATCA_STATUS atcab_get_zone_size_ext(ATCADevice device, uint8_t zone, uint16_t slot, size_t* size);
 
 // AES command functions
 ATCA_STATUS atcab_aes(uint8_t mode, uint16_t key_id, const uint8_t* aes_in, uint8_t* aes_out);
+ATCA_STATUS atcab_aes_ext(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* aes_in, uint8_t* aes_out);
 ATCA_STATUS atcab_aes_encrypt(uint16_t key_id, uint8_t key_block, const uint8_t* plaintext, uint8_t* ciphertext);
 ATCA_STATUS atcab_aes_encrypt_ext(ATCADevice device, uint16_t key_id, uint8_t key_block, const uint8_t* plaintext, uint8_t* ciphertext);
 ATCA_STATUS atcab_aes_decrypt(uint16_t key_id, uint8_t key_block, const uint8_t* ciphertext, uint8_t* plaintext);
 ATCA_STATUS atcab_aes_decrypt_ext(ATCADevice device, uint16_t key_id, uint8_t key_block, const uint8_t* ciphertext, uint8_t* plaintext);
 ATCA_STATUS atcab_aes_gfm(const uint8_t* h, const uint8_t* input, uint8_t* output);
+ATCA_STATUS atcab_aes_gfm_ext(ATCADevice device, const uint8_t* h, const uint8_t* input, uint8_t* output);
 
 /* AES GCM */
 ATCA_STATUS atcab_aes_gcm_init(atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, const uint8_t* iv, size_t iv_size);
+ATCA_STATUS atcab_aes_gcm_init_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, const uint8_t* iv, size_t iv_size);
 ATCA_STATUS atcab_aes_gcm_init_rand(atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, size_t rand_size,
                                     const uint8_t* free_field, size_t free_field_size, uint8_t* iv);
+ATCA_STATUS atcab_aes_gcm_init_rand_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, uint16_t key_id, uint8_t key_block, size_t rand_size,
+                                        const uint8_t* free_field, size_t free_field_size, uint8_t* iv);
 ATCA_STATUS atcab_aes_gcm_aad_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* aad, uint32_t aad_size);
+ATCA_STATUS atcab_aes_gcm_aad_update_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* aad, uint32_t aad_size);
 ATCA_STATUS atcab_aes_gcm_encrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* plaintext, uint32_t plaintext_size, uint8_t* ciphertext);
+ATCA_STATUS atcab_aes_gcm_encrypt_update_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* plaintext, uint32_t plaintext_size, uint8_t* ciphertext);
 ATCA_STATUS atcab_aes_gcm_encrypt_finish(atca_aes_gcm_ctx_t* ctx, uint8_t* tag, size_t tag_size);
+ATCA_STATUS atcab_aes_gcm_encrypt_finish_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, uint8_t* tag, size_t tag_size);
 ATCA_STATUS atcab_aes_gcm_decrypt_update(atca_aes_gcm_ctx_t* ctx, const uint8_t* ciphertext, uint32_t ciphertext_size, uint8_t* plaintext);
+ATCA_STATUS atcab_aes_gcm_decrypt_update_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* ciphertext, uint32_t ciphertext_size, uint8_t* plaintext);
 ATCA_STATUS atcab_aes_gcm_decrypt_finish(atca_aes_gcm_ctx_t* ctx, const uint8_t* tag, size_t tag_size, bool* is_verified);
+ATCA_STATUS atcab_aes_gcm_decrypt_finish_ext(ATCADevice device, atca_aes_gcm_ctx_t* ctx, const uint8_t* tag, size_t tag_size, bool* is_verified);
 
 /* CheckMAC command */
 ATCA_STATUS atcab_checkmac(uint8_t mode, uint16_t key_id, const uint8_t* challenge, const uint8_t* response, const uint8_t* other_data);
+ATCA_STATUS atcab_checkmac_ext(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* challenge, const uint8_t* response, const uint8_t* other_data);
 
 /* Counter command */
 ATCA_STATUS atcab_counter(uint8_t mode, uint16_t counter_id, uint32_t* counter_value);
+ATCA_STATUS atcab_counter_ext(ATCADevice device, uint8_t mode, uint16_t counter_id, uint32_t* counter_value);
 ATCA_STATUS atcab_counter_increment(uint16_t counter_id, uint32_t* counter_value);
+ATCA_STATUS atcab_counter_increment_ext(ATCADevice device, uint16_t counter_id, uint32_t* counter_value);
 ATCA_STATUS atcab_counter_read(uint16_t counter_id, uint32_t* counter_value);
+ATCA_STATUS atcab_counter_read_ext(ATCADevice device, uint16_t counter_id, uint32_t* counter_value);
 
 /* DeriveKey command */
 ATCA_STATUS atcab_derivekey(uint8_t mode, uint16_t key_id, const uint8_t* mac);
+ATCA_STATUS atcab_derivekey_ext(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* mac);
 
 /* ECDH command */
 ATCA_STATUS atcab_ecdh_base(uint8_t mode, uint16_t key_id, const uint8_t* public_key, uint8_t* pms, uint8_t* out_nonce);
+ATCA_STATUS atcab_ecdh_base_ext(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* public_key, uint8_t* pms, uint8_t* out_nonce);
 ATCA_STATUS atcab_ecdh(uint16_t key_id, const uint8_t* public_key, uint8_t* pms);
+ATCA_STATUS atcab_ecdh_ext(ATCADevice device, uint16_t key_id, const uint8_t* public_key, uint8_t* pms);
 
 #if defined(ATCA_USE_CONSTANT_HOST_NONCE)
 ATCA_STATUS atcab_ecdh_enc(uint16_t key_id, const uint8_t* public_key, uint8_t* pms, const uint8_t* read_key, uint16_t read_key_id);
+ATCA_STATUS atcab_ecdh_enc_ext(ATCADevice device, uint16_t key_id, const uint8_t* public_key, uint8_t* pms, const uint8_t* read_key, uint16_t read_key_id);
 #else
 ATCA_STATUS atcab_ecdh_enc(uint16_t key_id, const uint8_t* public_key, uint8_t* pms, const uint8_t* read_key, uint16_t read_key_id, const uint8_t num_in[NONCE_NUMIN_SIZE]);
+ATCA_STATUS atcab_ecdh_enc_ext(ATCADevice device, uint16_t key_id, const uint8_t* public_key, uint8_t* pms, const uint8_t* read_key, uint16_t read_key_id, const uint8_t num_in[NONCE_NUMIN_SIZE]);
 #endif
 
 ATCA_STATUS atcab_ecdh_ioenc(uint16_t key_id, const uint8_t* public_key, uint8_t* pms, const uint8_t* io_key);
+ATCA_STATUS atcab_ecdh_ioenc_ext(ATCADevice device, uint16_t key_id, const uint8_t* public_key, uint8_t* pms, const uint8_t* io_key);
 ATCA_STATUS atcab_ecdh_tempkey(const uint8_t* public_key, uint8_t* pms);
+ATCA_STATUS atcab_ecdh_tempkey_ext(ATCADevice device, const uint8_t* public_key, uint8_t* pms);
 ATCA_STATUS atcab_ecdh_tempkey_ioenc(const uint8_t* public_key, uint8_t* pms, const uint8_t* io_key);
+ATCA_STATUS atcab_ecdh_tempkey_ioenc_ext(ATCADevice device, const uint8_t* public_key, uint8_t* pms, const uint8_t* io_key);
 
 // GenDig command functions
 ATCA_STATUS atcab_gendig(uint8_t zone, uint16_t key_id, const uint8_t* other_data, uint8_t other_data_size);
+ATCA_STATUS atcab_gendig_ext(ATCADevice device, uint8_t zone, uint16_t key_id, const uint8_t* other_data, uint8_t other_data_size);
 
 // GenKey command functions
 ATCA_STATUS atcab_genkey_base(uint8_t mode, uint16_t key_id, const uint8_t* other_data, uint8_t* public_key);
+ATCA_STATUS atcab_genkey_base_ext(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* other_data, uint8_t* public_key);
 ATCA_STATUS atcab_genkey(uint16_t key_id, uint8_t* public_key);
+ATCA_STATUS atcab_genkey_ext(ATCADevice device, uint16_t key_id, uint8_t* public_key);
 ATCA_STATUS atcab_get_pubkey(uint16_t key_id, uint8_t* public_key);
+ATCA_STATUS atcab_get_pubkey_ext(ATCADevice device, uint16_t key_id, uint8_t* public_key);
 
 // HMAC command functions
 ATCA_STATUS atcab_hmac(uint8_t mode, uint16_t key_id, uint8_t* digest);
+ATCA_STATUS atcab_hmac_ext(ATCADevice device, uint8_t mode, uint16_t key_id, uint8_t* digest);
 
 // Info command functions
 ATCA_STATUS atcab_info_base(uint8_t mode, uint16_t param2, uint8_t* out_data);
+ATCA_STATUS atcab_info_base_ext(ATCADevice device, uint8_t mode, uint16_t param2, uint8_t* out_data);
 ATCA_STATUS atcab_info(uint8_t* revision);
+ATCA_STATUS atcab_info_ext(ATCADevice device, uint8_t* revision);
 ATCA_STATUS atcab_info_set_latch(bool state);
+ATCA_STATUS atcab_info_set_latch_ext(ATCADevice device, bool state);
 ATCA_STATUS atcab_info_get_latch(bool* state);
+ATCA_STATUS atcab_info_get_latch_ext(ATCADevice device, bool* state);
 
 // KDF command functions
 ATCA_STATUS atcab_kdf(uint8_t mode, uint16_t key_id, const uint32_t details, const uint8_t* message, uint8_t* out_data, uint8_t* out_nonce);
+ATCA_STATUS atcab_kdf_ext(ATCADevice device, uint8_t mode, uint16_t key_id, const uint32_t details, const uint8_t* message, uint8_t* out_data, uint8_t* out_nonce);
 
 // Lock command functions
 ATCA_STATUS atcab_lock(uint8_t mode, uint16_t summary_crc);
+ATCA_STATUS atcab_lock_ext(ATCADevice device, uint8_t mode, uint16_t summary_crc);
 ATCA_STATUS atcab_lock_config_zone(void);
+ATCA_STATUS atcab_lock_config_zone_ext(ATCADevice device);
 ATCA_STATUS atcab_lock_config_zone_crc(uint16_t summary_crc);
+ATCA_STATUS atcab_lock_config_zone_crc_ext(ATCADevice device, uint16_t summary_crc);
 ATCA_STATUS atcab_lock_data_zone(void);
+ATCA_STATUS atcab_lock_data_zone_ext(ATCADevice device);
 ATCA_STATUS atcab_lock_data_zone_crc(uint16_t summary_crc);
+ATCA_STATUS atcab_lock_data_zone_crc_ext(ATCADevice device, uint16_t summary_crc);
 ATCA_STATUS atcab_lock_data_slot(uint16_t slot);
+ATCA_STATUS atcab_lock_data_slot_ext(ATCADevice device, uint16_t slot);
 
 // MAC command functions
 ATCA_STATUS atcab_mac(uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest);
+ATCA_STATUS atcab_mac_ext(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* challenge, uint8_t* digest);
 
 // Nonce command functions
 ATCA_STATUS atcab_nonce_base(uint8_t mode, uint16_t zero, const uint8_t* num_in, uint8_t* rand_out);
+ATCA_STATUS atcab_nonce_base_ext(ATCADevice device, uint8_t mode, uint16_t zero, const uint8_t* num_in, uint8_t* rand_out);
 ATCA_STATUS atcab_nonce(const uint8_t* num_in);
+ATCA_STATUS atcab_nonce_ext(ATCADevice device, const uint8_t* num_in);
 ATCA_STATUS atcab_nonce_load(uint8_t target, const uint8_t* num_in, uint16_t num_in_size);
+ATCA_STATUS atcab_nonce_load_ext(ATCADevice device, uint8_t target, const uint8_t* num_in, uint16_t num_in_size);
 ATCA_STATUS atcab_nonce_rand(const uint8_t* num_in, uint8_t* rand_out);
+ATCA_STATUS atcab_nonce_rand_ext(ATCADevice device, const uint8_t* num_in, uint8_t* rand_out);
 ATCA_STATUS atcab_challenge(const uint8_t* num_in);
+ATCA_STATUS atcab_challenge_ext(ATCADevice device, const uint8_t* num_in);
 ATCA_STATUS atcab_challenge_seed_update(const uint8_t* num_in, uint8_t* rand_out);
+ATCA_STATUS atcab_challenge_seed_update_ext(ATCADevice device, const uint8_t* num_in, uint8_t* rand_out);
 
 // PrivWrite command functions
 #if defined(ATCA_USE_CONSTANT_HOST_NONCE)
 ATCA_STATUS atcab_priv_write(uint16_t key_id, const uint8_t priv_key[36], uint16_t write_key_id, const uint8_t write_key[32]);
+ATCA_STATUS atcab_priv_write_ext(ATCADevice device, uint16_t key_id, const uint8_t priv_key[36], uint16_t write_key_id, const uint8_t write_key[32]);
 #else
 ATCA_STATUS atcab_priv_write(uint16_t key_id, const uint8_t priv_key[36], uint16_t write_key_id, const uint8_t write_key[32], const uint8_t num_in[NONCE_NUMIN_SIZE]);
+ATCA_STATUS atcab_priv_write_ext(ATCADevice device, uint16_t key_id, const uint8_t priv_key[36], uint16_t write_key_id, const uint8_t write_key[32], const uint8_t num_in[NONCE_NUMIN_SIZE]);
 #endif
 
 // Random command functions
@@ -511,82 +835,134 @@ ATCA_STATUS atcab_random_ext(ATCADevice device, uint8_t* rand_out);
 
 // Read command functions
 ATCA_STATUS atcab_read_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t* data, uint8_t len);
+ATCA_STATUS atcab_read_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t* data, uint8_t len);
 ATCA_STATUS atcab_is_locked(uint8_t zone, bool* is_locked);
+ATCA_STATUS atcab_is_locked_ext(ATCADevice device, uint8_t zone, bool* is_locked);
 ATCA_STATUS atcab_is_config_locked(bool* is_locked);
+ATCA_STATUS atcab_is_config_locked_ext(ATCADevice device, bool* is_locked);
 ATCA_STATUS atcab_is_data_locked(bool* is_locked);
+ATCA_STATUS atcab_is_data_locked_ext(ATCADevice device, bool* is_locked);
 ATCA_STATUS atcab_is_slot_locked(uint16_t slot, bool* is_locked);
+ATCA_STATUS atcab_is_slot_locked_ext(ATCADevice device, uint16_t slot, bool* is_locked);
 ATCA_STATUS atcab_read_bytes_zone(uint8_t zone, uint16_t slot, size_t offset, uint8_t* data, size_t length);
+ATCA_STATUS atcab_read_bytes_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset, uint8_t* data, size_t length);
 ATCA_STATUS atcab_read_serial_number(uint8_t* serial_number);
+ATCA_STATUS atcab_read_serial_number_ext(ATCADevice device, uint8_t* serial_number);
 ATCA_STATUS atcab_read_pubkey(uint16_t slot, uint8_t* public_key);
+ATCA_STATUS atcab_read_pubkey_ext(ATCADevice device, uint16_t slot, uint8_t* public_key);
 ATCA_STATUS atcab_read_sig(uint16_t slot, uint8_t* sig);
+ATCA_STATUS atcab_read_sig_ext(ATCADevice device, uint16_t slot, uint8_t* sig);
 ATCA_STATUS atcab_read_config_zone(uint8_t* config_data);
+ATCA_STATUS atcab_read_config_zone_ext(ATCADevice device, uint8_t* config_data);
 ATCA_STATUS atcab_cmp_config_zone(uint8_t* config_data, bool* same_config);
+ATCA_STATUS atcab_cmp_config_zone_ext(ATCADevice device, uint8_t* config_data, bool* same_config);
 
 #if defined(ATCA_USE_CONSTANT_HOST_NONCE)
 ATCA_STATUS atcab_read_enc(uint16_t key_id, uint8_t block, uint8_t* data, const uint8_t* enc_key, const uint16_t enc_key_id);
+ATCA_STATUS atcab_read_enc_ext(ATCADevice device, uint16_t key_id, uint8_t block, uint8_t* data, const uint8_t* enc_key, const uint16_t enc_key_id);
 #else
 ATCA_STATUS atcab_read_enc(uint16_t key_id, uint8_t block, uint8_t* data, const uint8_t* enc_key, const uint16_t enc_key_id, const uint8_t num_in[NONCE_NUMIN_SIZE]);
+ATCA_STATUS atcab_read_enc_ext(ATCADevice device, uint16_t key_id, uint8_t block, uint8_t* data, const uint8_t* enc_key, const uint16_t enc_key_id, const uint8_t num_in[NONCE_NUMIN_SIZE]);
 #endif
 
 // SecureBoot command functions
 ATCA_STATUS atcab_secureboot(uint8_t mode, uint16_t param2, const uint8_t* digest, const uint8_t* signature, uint8_t* mac);
+ATCA_STATUS atcab_secureboot_ext(ATCADevice device, uint8_t mode, uint16_t param2, const uint8_t* digest, const uint8_t* signature, uint8_t* mac);
 ATCA_STATUS atcab_secureboot_mac(uint8_t mode, const uint8_t* digest, const uint8_t* signature, const uint8_t* num_in, const uint8_t* io_key, bool* is_verified);
+ATCA_STATUS atcab_secureboot_mac_ext(ATCADevice device, uint8_t mode, const uint8_t* digest, const uint8_t* signature, const uint8_t* num_in, const uint8_t* io_key, bool* is_verified);
 
 /* SelfTest Command */
 ATCA_STATUS atcab_selftest(uint8_t mode, uint16_t param2, uint8_t* result);
+ATCA_STATUS atcab_selftest_ext(ATCADevice device, uint8_t mode, uint16_t param2, uint8_t* result);
 
 /* SHA Command  */
 #define SHA_CONTEXT_MAX_SIZE                    (109)
 ATCA_STATUS atcab_sha_base(uint8_t mode, uint16_t length, const uint8_t* data_in, uint8_t* data_out, uint16_t* data_out_size);
+ATCA_STATUS atcab_sha_base_ext(ATCADevice device, uint8_t mode, uint16_t length, const uint8_t* data_in, uint8_t* data_out, uint16_t* data_out_size);
 ATCA_STATUS atcab_sha_start(void);
+ATCA_STATUS atcab_sha_start_ext(ATCADevice device);
 ATCA_STATUS atcab_sha_update(const uint8_t* message);
+ATCA_STATUS atcab_sha_update_ext(ATCADevice device, const uint8_t* message);
 ATCA_STATUS atcab_sha_end(uint8_t* digest, uint16_t length, const uint8_t* message);
+ATCA_STATUS atcab_sha_end_ext(ATCADevice device, uint8_t* digest, uint16_t length, const uint8_t* message);
 ATCA_STATUS atcab_sha_read_context(uint8_t* context, uint16_t* context_size);
+ATCA_STATUS atcab_sha_read_context_ext(ATCADevice device, uint8_t* context, uint16_t* context_size);
 ATCA_STATUS atcab_sha_write_context(const uint8_t* context, uint16_t context_size);
+ATCA_STATUS atcab_sha_write_context_ext(ATCADevice device, const uint8_t* context, uint16_t context_size);
 ATCA_STATUS atcab_sha(uint16_t length, const uint8_t* message, uint8_t* digest);
+ATCA_STATUS atcab_sha_ext(ATCADevice device, uint16_t length, const uint8_t* message, uint8_t* digest);
 ATCA_STATUS atcab_hw_sha2_256(const uint8_t* data, size_t data_size, uint8_t* digest);
+ATCA_STATUS atcab_hw_sha2_256_ext(ATCADevice device, const uint8_t* data, size_t data_size, uint8_t* digest);
 
 ATCA_STATUS atcab_hw_sha2_256_init(atca_sha256_ctx_t* ctx);
+ATCA_STATUS atcab_hw_sha2_256_init_ext(ATCADevice device, atca_sha256_ctx_t* ctx);
 ATCA_STATUS atcab_hw_sha2_256_update(atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
+ATCA_STATUS atcab_hw_sha2_256_update_ext(ATCADevice device, atca_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
 ATCA_STATUS atcab_hw_sha2_256_finish(atca_sha256_ctx_t* ctx, uint8_t* digest);
+ATCA_STATUS atcab_hw_sha2_256_finish_ext(ATCADevice device, atca_sha256_ctx_t* ctx, uint8_t* digest);
 ATCA_STATUS atcab_sha_hmac_init(atca_hmac_sha256_ctx_t* ctx, uint16_t key_slot);
+ATCA_STATUS atcab_sha_hmac_init_ext(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, uint16_t key_slot);
 ATCA_STATUS atcab_sha_hmac_update(atca_hmac_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
+ATCA_STATUS atcab_sha_hmac_update_ext(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, const uint8_t* data, size_t data_size);
 ATCA_STATUS atcab_sha_hmac_finish(atca_hmac_sha256_ctx_t* ctx, uint8_t* digest, uint8_t target);
+ATCA_STATUS atcab_sha_hmac_finish_ext(ATCADevice device, atca_hmac_sha256_ctx_t* ctx, uint8_t* digest, uint8_t target);
 
 ATCA_STATUS atcab_sha_hmac(const uint8_t* data, size_t data_size, uint16_t key_slot, uint8_t* digest, uint8_t target);
+ATCA_STATUS atcab_sha_hmac_ext(ATCADevice device, const uint8_t* data, size_t data_size, uint16_t key_slot, uint8_t* digest, uint8_t target);
 
 /* Sign command */
 ATCA_STATUS atcab_sign_base(uint8_t mode, uint16_t key_id, uint8_t* signature);
+ATCA_STATUS atcab_sign_base_ext(ATCADevice device, uint8_t mode, uint16_t key_id, uint8_t* signature);
 ATCA_STATUS atcab_sign(uint16_t key_id, const uint8_t* msg, uint8_t* signature);
+ATCA_STATUS atcab_sign_ext(ATCADevice device, uint16_t key_id, const uint8_t* msg, uint8_t* signature);
 ATCA_STATUS atcab_sign_internal(uint16_t key_id, bool is_invalidate, bool is_full_sn, uint8_t* signature);
+ATCA_STATUS atcab_sign_internal_ext(ATCADevice device, uint16_t key_id, bool is_invalidate, bool is_full_sn, uint8_t* signature);
 
 /* UpdateExtra command */
 ATCA_STATUS atcab_updateextra(uint8_t mode, uint16_t new_value);
+ATCA_STATUS atcab_updateextra_ext(ATCADevice device, uint8_t mode, uint16_t new_value);
 
 /* Verify command */
 ATCA_STATUS atcab_verify(uint8_t mode, uint16_t key_id, const uint8_t* signature, const uint8_t* public_key, const uint8_t* other_data, uint8_t* mac);
+ATCA_STATUS atcab_verify_ext(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* signature, const uint8_t* public_key, const uint8_t* other_data, uint8_t* mac);
 ATCA_STATUS atcab_verify_extern(const uint8_t* message, const uint8_t* signature, const uint8_t* public_key, bool* is_verified);
+ATCA_STATUS atcab_verify_extern_ext(ATCADevice device, const uint8_t* message, const uint8_t* signature, const uint8_t* public_key, bool* is_verified);
+ATCA_STATUS atcab_verify_extern_batch(uint16_t count, const uint8_t* messages, const uint8_t* signatures, const uint8_t* public_keys, bool* is_verified);
+ATCA_STATUS atcab_verify_extern_batch_ext(ATCADevice device, uint16_t count, const uint8_t* messages, const uint8_t* signatures, const uint8_t* public_keys, bool* is_verified);
 ATCA_STATUS atcab_verify_extern_mac(const uint8_t* message, const uint8_t* signature, const uint8_t* public_key, const uint8_t* num_in, const uint8_t* io_key, bool* is_verified);
+ATCA_STATUS atcab_verify_extern_mac_ext(ATCADevice device, const uint8_t* message, const uint8_t* signature, const uint8_t* public_key, const uint8_t* num_in, const uint8_t* io_key, bool* is_verified);
 ATCA_STATUS atcab_verify_stored(const uint8_t* message, const uint8_t* signature, uint16_t key_id, bool* is_verified);
+ATCA_STATUS atcab_verify_stored_ext(ATCADevice device, const uint8_t* message, const uint8_t* signature, uint16_t key_id, bool* is_verified);
 ATCA_STATUS atcab_verify_stored_mac(const uint8_t* message, const uint8_t* signature, uint16_t key_id, const uint8_t* num_in, const uint8_t* io_key, bool* is_verified);
+ATCA_STATUS atcab_verify_stored_mac_ext(ATCADevice device, const uint8_t* message, const uint8_t* signature, uint16_t key_id, const uint8_t* num_in, const uint8_t* io_key, bool* is_verified);
 
 ATCA_STATUS atcab_verify_validate(uint16_t key_id, const uint8_t* signature, const uint8_t* other_data, bool* is_verified);
+ATCA_STATUS atcab_verify_validate_ext(ATCADevice device, uint16_t key_id, const uint8_t* signature, const uint8_t* other_data, bool* is_verified);
 ATCA_STATUS atcab_verify_invalidate(uint16_t key_id, const uint8_t* signature, const uint8_t* other_data, bool* is_verified);
+ATCA_STATUS atcab_verify_invalidate_ext(ATCADevice device, uint16_t key_id, const uint8_t* signature, const uint8_t* other_data, bool* is_verified);
 
 /* Write command functions */
 ATCA_STATUS atcab_write(uint8_t zone, uint16_t address, const uint8_t* value, const uint8_t* mac);
+ATCA_STATUS atcab_write_ext(ATCADevice device, uint8_t zone, uint16_t address, const uint8_t* value, const uint8_t* mac);
 ATCA_STATUS atcab_write_zone(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t* data, uint8_t len);
+ATCA_STATUS atcab_write_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, const uint8_t* data, uint8_t len);
 ATCA_STATUS atcab_write_bytes_zone(uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t* data, size_t length);
+ATCA_STATUS atcab_write_bytes_zone_ext(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset_bytes, const uint8_t* data, size_t length);
 ATCA_STATUS atcab_write_pubkey(uint16_t slot, const uint8_t* public_key);
+ATCA_STATUS atcab_write_pubkey_ext(ATCADevice device, uint16_t slot, const uint8_t* public_key);
 ATCA_STATUS atcab_write_config_zone(const uint8_t* config_data);
+ATCA_STATUS atcab_write_config_zone_ext(ATCADevice device, const uint8_t* config_data);
 
 #if defined(ATCA_USE_CONSTANT_HOST_NONCE)
 ATCA_STATUS atcab_write_enc(uint16_t key_id, uint8_t block, const uint8_t* data, const uint8_t* enc_key, const uint16_t enc_key_id);
+ATCA_STATUS atcab_write_enc_ext(ATCADevice device, uint16_t key_id, uint8_t block, const uint8_t* data, const uint8_t* enc_key, const uint16_t enc_key_id);
 #else
 ATCA_STATUS atcab_write_enc(uint16_t key_id, uint8_t block, const uint8_t* data, const uint8_t* enc_key, const uint16_t enc_key_id, const uint8_t num_in[NONCE_NUMIN_SIZE]);
+ATCA_STATUS atcab_write_enc_ext(ATCADevice device, uint16_t key_id, uint8_t block, const uint8_t* data, const uint8_t* enc_key, const uint16_t enc_key_id, const uint8_t num_in[NONCE_NUMIN_SIZE]);
 #endif
 
 ATCA_STATUS atcab_write_config_counter(uint16_t counter_id, uint32_t counter_value);
+ATCA_STATUS atcab_write_config_counter_ext(ATCADevice device, uint16_t counter_id, uint32_t counter_value);
 
 
 #endif /* ATCA_TA_SUPPORT && ATCA_CA_SUPPORT */
@@ -40,6 +40,7 @@
 extern "C" {
 #endif
 
+#include "atca_config.h"
 #include "atca_devtypes.h"
 #include <stdint.h>
 #include "atca_status.h"
@@ -57,6 +58,13 @@ typedef enum
 } ATCAIfaceType;
 
 
+/* Wake strategies selected by ATCAIfaceCfg.wake_mode */
+#define ATCA_WAKE_BAUD          ((uint8_t)0x00)  // Wake pulse by addressing 0x00 at 100 kHz, the bus baud is restored afterwards
+#define ATCA_WAKE_GPIO          ((uint8_t)0x01)  // Wake pulse by holding SDA low through the plib sda_drive hook, no baud change
+#define ATCA_WAKE_PULSE_MASK    ((uint8_t)0x0F)  // Bits selecting how the wake pulse is generated
+#define ATCA_WAKE_SESSION       ((uint8_t)0x10)  // Keep the device awake between commands as if a wake session was always open,
+                                                 // it is only woken again when the watchdog is about to expire
+
 /*The types are used within the kit protocol to identify the correct interface*/
 typedef enum
 {   ATCA_KIT_AUTO_IFACE,        //Selects the first device if the Kit interface is not defined
@@ -140,11 +148,50 @@ typedef struct
     };
 
     uint16_t wake_delay;    // microseconds of tWHI + tWLO which varies based on chip type
+    uint8_t  wake_mode;     // ATCA_WAKE_* strategy used to wake the device
     int      rx_retries;    // the number of retries to attempt for receiving bytes
     void *   cfg_data;      // opaque data used by HAL in device discovery
 } ATCAIfaceCfg;
 typedef struct atca_iface * ATCAIface;
 
+#ifdef ATCA_STATS
+/** \brief Number of distinct opcodes execution statistics are kept for */
+#ifndef ATCA_STATS_OPCODES
+#define ATCA_STATS_OPCODES      (16)
+#endif
+
+/** \brief Execution statistics of a single command opcode */
+typedef struct
+{
+    uint8_t  opcode;        //!< Command opcode
+    uint32_t count;         //!< Number of times the command was executed
+    uint32_t errors;        //!< Executions that did not return ATCA_SUCCESS
+    uint64_t total_us;      //!< Time from the start of the command until its response was checked
+} atca_opcode_stats_t;
+
+/** \brief Counters of the traffic on an interface, kept when ATCA_STATS
+ *         is defined. Times are in us as measured by hal_timestamp_us(). */
+typedef struct
+{
+    uint32_t            wakes;          //!< Calls to atwake()
+    uint32_t            wake_failures;  //!< Calls to atwake() that failed, also after the retry following the POST delay
+    uint32_t            crc_errors;     //!< Responses with a bad CRC
+    uint32_t            rx_no_response; //!< Receives without a response, i.e. the device was still busy
+    uint32_t            polls;          //!< Receive retries while waiting for a command to complete
+    uint32_t            tx_bytes;       //!< Bytes sent
+    uint32_t            rx_bytes;       //!< Bytes received
+    uint64_t            wake_us;        //!< Time spent waking the device
+    uint64_t            transfer_us;    //!< Time spent in the HAL send and receive
+    uint64_t            wait_us;        //!< Time spent delaying for command completion
+    uint8_t             opcode_count;   //!< Number of valid entries in opcodes
+    atca_opcode_stats_t opcodes[ATCA_STATS_OPCODES];
+} atca_stats_t;
+
+/** \brief Add to an interface counter */
+#define ATCA_STATS_ADD(iface, field, value)     ((iface)->stats.field += (value))
+#else
+#define ATCA_STATS_ADD(iface, field, value)     ((void)0)
+#endif
 
 /** \brief atca_iface is the C object backing ATCAIface.  See the atca_iface.h file for
  * details on the ATCAIface methods
@@ -166,6 +213,9 @@ struct atca_iface
     // treat as private
     void *hal_data;     // generic pointer used by HAL to point to architecture specific structure
                         // no ATCA object should touch this except HAL, HAL manages this pointer and memory it points to
+#ifdef ATCA_STATS
+    atca_stats_t stats; // traffic counters, see atgetstats()
+#endif
 };
 
 ATCA_STATUS initATCAIface(ATCAIfaceCfg *cfg, ATCAIface ca_iface);
@@ -186,6 +236,12 @@ ATCA_STATUS atsleep(ATCAIface ca_iface);
 ATCAIfaceCfg * atgetifacecfg(ATCAIface ca_iface);
 void* atgetifacehaldat(ATCAIface ca_iface);
 
+#ifdef ATCA_STATS
+ATCA_STATUS atgetstats(ATCAIface ca_iface, atca_stats_t *stats);
+void atresetstats(ATCAIface ca_iface);
+void atrecordcommand(ATCAIface ca_iface, uint8_t opcode, ATCA_STATUS status, uint32_t elapsed_us);
+#endif
+
 
 #ifdef __cplusplus
 }
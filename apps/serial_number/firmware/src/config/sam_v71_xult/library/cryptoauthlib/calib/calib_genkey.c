@@ -57,6 +57,14 @@ ATCA_STATUS calib_genkey_base(ATCADevice device, uint8_t mode, uint16_t key_id,
     ATCACommand ca_cmd = device->mCommands;
     ATCA_STATUS status = ATCA_GEN_FAIL;
 
+#ifdef ATCA_DATA_CACHE
+    // Computing a public key doesn't change the device, a cached one will do
+    if (mode == GENKEY_MODE_PUBLIC && public_key != NULL && calib_data_cache_get_pubkey(device, key_id, public_key) == ATCA_SUCCESS)
+    {
+        return ATCA_SUCCESS;
+    }
+#endif
+
     do
     {
         // Build GenKey command
@@ -82,6 +90,12 @@ ATCA_STATUS calib_genkey_base(ATCADevice device, uint8_t mode, uint16_t key_id,
             if (packet.data[ATCA_COUNT_IDX] == (ATCA_PUB_KEY_SIZE + ATCA_PACKET_OVERHEAD))
             {
                 memcpy(public_key, &packet.data[ATCA_RSP_DATA_IDX], ATCA_PUB_KEY_SIZE);
+#ifdef ATCA_DATA_CACHE
+                if (!(mode & GENKEY_MODE_PUBKEY_DIGEST))
+                {
+                    calib_data_cache_put_pubkey(device, key_id, public_key);
+                }
+#endif
             }
             else
             {
@@ -35,9 +35,11 @@
 atca_plib_i2c_api_t twihs0_plib_i2c_api = {
     .read = TWIHS0_Read,
     .write = TWIHS0_Write,
+    .write_read = TWIHS0_WriteRead,
     .is_busy = TWIHS0_IsBusy,
     .error_get = TWIHS0_ErrorGet,
-    .transfer_setup = TWIHS0_TransferSetup
+    .transfer_setup = TWIHS0_TransferSetup,
+    .callback_register = TWIHS0_CallbackRegister
 };
 
 
@@ -42,26 +42,41 @@
 #define ATCA_POST_DELAY_MSEC 25
 #endif
 
+/** Keep traffic and per opcode execution statistics of the interfaces, see atcab_get_stats() */
+#ifndef ATCA_STATS
+#define ATCA_STATS
+#endif
+
 
 /* Define generic interfaces to the processor libraries */
 
 #define PLIB_I2C_ERROR          SERCOM_I2C_ERROR
 #define PLIB_I2C_ERROR_NONE     SERCOM_I2C_ERROR_NONE
 #define PLIB_I2C_TRANSFER_SETUP SERCOM_I2C_TRANSFER_SETUP
+#define PLIB_I2C_CALLBACK       SERCOM_I2C_CALLBACK
 
 typedef bool (* atca_i2c_plib_read)( uint16_t, uint8_t *, uint32_t );
 typedef bool (* atca_i2c_plib_write)( uint16_t, uint8_t *, uint32_t );
+typedef bool (* atca_i2c_plib_write_read)( uint16_t, uint8_t *, uint32_t, uint8_t *, uint32_t );
 typedef bool (* atca_i2c_plib_is_busy)( void );
 typedef PLIB_I2C_ERROR (* atca_i2c_error_get)( void );
 typedef bool (* atca_i2c_plib_transfer_setup)(PLIB_I2C_TRANSFER_SETUP* setup, uint32_t srcClkFreq);
+typedef void (* atca_i2c_plib_callback_register)(PLIB_I2C_CALLBACK callback, uintptr_t context);
+/* Optional, used by ATCA_WAKE_GPIO: drive SDA low as a GPIO (true) or hand it back to the I2C peripheral (false).
+   hal_harmony_init.c provides it for the SERCOM I2C plibs. Other plibs have to supply their own, without it
+   ATCA_WAKE_GPIO falls back to the baud rate wake */
+typedef void (* atca_i2c_plib_sda_drive)(bool low);
 
 typedef struct atca_plib_api
 {
     atca_i2c_plib_read              read;
     atca_i2c_plib_write             write;
+    atca_i2c_plib_write_read        write_read;
     atca_i2c_plib_is_busy           is_busy;
     atca_i2c_error_get              error_get;
     atca_i2c_plib_transfer_setup    transfer_setup;
+    atca_i2c_plib_callback_register callback_register;
+    atca_i2c_plib_sda_drive         sda_drive;
 } atca_plib_i2c_api_t;
 
 extern atca_plib_i2c_api_t sercom2_plib_i2c_api;
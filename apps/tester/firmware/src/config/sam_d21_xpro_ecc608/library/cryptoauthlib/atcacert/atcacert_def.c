@@ -1569,6 +1569,49 @@ int atcacert_get_tbs_digest(const atcacert_def_t* cert_def,
     return ret;
 }
 
+int atcacert_get_tbs_digest_batch(const atcacert_def_t* cert_def,
+                                  size_t                count,
+                                  const uint8_t* const  certs[],
+                                  const size_t          cert_sizes[],
+                                  uint8_t*              tbs_digests)
+{
+    int ret = ATCACERT_E_SUCCESS;
+    const uint8_t* tbs[ATCACERT_TBS_DIGEST_CHUNK];
+    size_t tbs_sizes[ATCACERT_TBS_DIGEST_CHUNK];
+    size_t chunk;
+    size_t i;
+
+    if (cert_def == NULL || (count > 0 && (certs == NULL || cert_sizes == NULL || tbs_digests == NULL)))
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    for (; count > 0; count -= chunk, certs += chunk, cert_sizes += chunk, tbs_digests += chunk * 32)
+    {
+        chunk = (count < ATCACERT_TBS_DIGEST_CHUNK) ? count : ATCACERT_TBS_DIGEST_CHUNK;
+        for (i = 0; i < chunk; i++)
+        {
+            if (certs[i] == NULL)
+            {
+                return ATCACERT_E_BAD_PARAMS;
+            }
+            ret = atcacert_get_tbs(cert_def, certs[i], cert_sizes[i], &tbs[i], &tbs_sizes[i]);
+            if (ret != ATCACERT_E_SUCCESS)
+            {
+                return ret;
+            }
+        }
+
+        ret = atcac_sw_sha2_256_multi(chunk, tbs, tbs_sizes, tbs_digests);
+        if (ret != ATCACERT_E_SUCCESS)
+        {
+            return ret;
+        }
+    }
+
+    return ret;
+}
+
 int atcacert_set_cert_element(const atcacert_def_t*      cert_def,
                               const atcacert_cert_loc_t* cert_loc,
                               uint8_t*                   cert,
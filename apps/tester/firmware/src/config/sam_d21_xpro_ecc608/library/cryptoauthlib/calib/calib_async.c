@@ -0,0 +1,653 @@
+/**
+ * \file
+ * \brief Non-blocking command execution for CryptoAuth devices.
+ *
+ * Operations are submitted with one of the calib_async_* calls and then
+ * advanced by calib_async_tasks(), which is meant to be called from the
+ * application main loop (SYS_Tasks() in MPLAB Harmony). Each device runs a
+ * state machine of wake, send, wait, receive (response size, CRC and status
+ * check) and idle. While the device executes a command calib_async_tasks()
+ * returns right away so the rest of the system keeps running. All commands
+ * of an operation share one wake, so TempKey and the message digest buffer
+ * are preserved between them.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include "cryptoauthlib.h"
+#include "calib_async.h"
+
+/** \brief Operations in progress */
+static calib_async_ctx_t* calib_async_list;
+
+/** \brief Completes an operation: idles the device unless a wake session
+ *         keeps it awake, removes the operation and runs its callback.
+ *  \param[in] ctx     Operation to complete
+ *  \param[in] status  Result of the operation
+ */
+static void calib_async_complete(calib_async_ctx_t* ctx, ATCA_STATUS status)
+{
+    calib_async_ctx_t** link;
+    ATCADevice device = ctx->device;
+
+    if (!calib_wake_shared(device) || status != ATCA_SUCCESS)
+    {
+        device->wake_active = 0;
+        (void)atidle(device->mIface);
+    }
+
+    for (link = &calib_async_list; *link; link = &(*link)->next)
+    {
+        if (*link == ctx)
+        {
+            *link = ctx->next;
+            break;
+        }
+    }
+
+    ctx->next = NULL;
+    ctx->state = CALIB_ASYNC_STATE_IDLE;
+    ctx->status = status;
+    device->async_ctx = NULL;
+
+    if (ctx->callback)
+    {
+        ctx->callback(status, ctx->param);
+    }
+}
+
+/** \brief Sets up the polling of the command that was just sent */
+static void calib_async_sent(calib_async_ctx_t* ctx)
+{
+    ctx->sent_us = hal_timestamp_us();
+#ifdef ATCA_NO_POLL
+    if (calib_get_execution_time(ctx->packet.opcode, ctx->device->mCommands) == ATCA_SUCCESS)
+    {
+        ctx->wait_us = ctx->device->mCommands->execution_time_msec * 1000;
+    }
+    else
+    {
+        ctx->wait_us = ATCA_POLLING_MAX_TIME_MSEC * 1000;
+    }
+    ctx->interval_us = ATCA_POLLING_FREQUENCY_TIME_MSEC * 1000;
+#else
+    calib_poll_timing(ctx->device, &ctx->packet, &ctx->wait_us, &ctx->interval_us);
+#endif
+}
+
+/** \brief Advances one operation as far as it can go without waiting
+ *  \param[in] ctx  Operation to advance
+ */
+static void calib_async_run(calib_async_ctx_t* ctx)
+{
+    ATCADevice device = ctx->device;
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint8_t word_address = 0xFF;
+    uint32_t elapsed_us;
+    uint16_t rxsize;
+    bool done = false;
+
+    if (ATCA_I2C_IFACE == device->mIface->mIfaceCFG->iface_type)
+    {
+        word_address = 0x03; // insert the Word Address Value, Command token
+    }
+
+    switch (ctx->state)
+    {
+    case CALIB_ASYNC_STATE_WAKE:
+        if (calib_get_execution_time(ctx->packet.opcode, device->mCommands) != ATCA_SUCCESS)
+        {
+            // Unknown duration - force a fresh watchdog period
+            device->mCommands->execution_time_msec = ATCA_WATCHDOG_LONG_BUDGET_MSEC;
+        }
+        if ((status = calib_wake_for_command(device, device->mCommands->execution_time_msec)) != ATCA_SUCCESS)
+        {
+            break;
+        }
+        if (!device->wake_active)
+        {
+            // The commands of one operation share a wake even outside of a
+            // wake session, track it so each of them gets the budget check
+            device->wake_active = 1;
+            device->wake_timestamp_us = hal_timestamp_us();
+        }
+    /* fall through */
+
+    case CALIB_ASYNC_STATE_SEND:
+        if ((status = atsend(device->mIface, word_address, (uint8_t*)&ctx->packet, ctx->packet.txsize)) != ATCA_SUCCESS)
+        {
+            break;
+        }
+        calib_async_sent(ctx);
+        ctx->state = CALIB_ASYNC_STATE_WAIT;
+    /* fall through */
+
+    case CALIB_ASYNC_STATE_WAIT:
+        elapsed_us = hal_timestamp_us() - ctx->sent_us;
+        if (elapsed_us < ctx->wait_us)
+        {
+            // Still executing - let the rest of the system run
+            return;
+        }
+        ctx->state = CALIB_ASYNC_STATE_RECEIVE;
+    /* fall through */
+
+    case CALIB_ASYNC_STATE_RECEIVE:
+        rxsize = calib_get_response_size(&ctx->packet);
+        if (atreceive(device->mIface, 0, ctx->packet.data, &rxsize) != ATCA_SUCCESS)
+        {
+            elapsed_us = hal_timestamp_us() - ctx->sent_us;
+            if (elapsed_us >= ATCA_POLLING_MAX_TIME_MSEC * 1000)
+            {
+                status = ATCA_RX_NO_RESPONSE;
+                break;
+            }
+            ATCA_STATS_ADD(device->mIface, polls, 1);
+            ctx->wait_us = elapsed_us + ctx->interval_us;
+            ctx->state = CALIB_ASYNC_STATE_WAIT;
+            return;
+        }
+
+        if (rxsize < 4)
+        {
+            status = (rxsize > 0) ? ATCA_RX_FAIL : ATCA_RX_NO_RESPONSE;
+            break;
+        }
+
+        if ((status = atCheckCrc(ctx->packet.data)) != ATCA_SUCCESS)
+        {
+            ATCA_STATS_ADD(device->mIface, crc_errors, 1);
+            break;
+        }
+
+        status = isATCAError(ctx->packet.data);
+#ifdef ATCA_STATS
+        atrecordcommand(device->mIface, ctx->packet.opcode, status, hal_timestamp_us() - ctx->sent_us);
+#endif
+#ifdef ATCA_DATA_CACHE
+        calib_data_cache_update(device, &ctx->packet);
+#endif
+        calib_cert_cache_update(&ctx->packet);
+#ifndef ATCA_NO_POLL
+        if (status == ATCA_SUCCESS)
+        {
+            calib_poll_learn(device, &ctx->packet, hal_timestamp_us() - ctx->sent_us);
+        }
+#endif
+
+        ctx->step++;
+        if ((status = ctx->fp_step(ctx, status, &done)) == ATCA_SUCCESS && !done)
+        {
+            // The main loop may run for a while before the next command is
+            // sent, check the watchdog budget again before sending it
+            ctx->state = CALIB_ASYNC_STATE_WAKE;
+            return;
+        }
+        break;
+
+    default:
+        return;
+    }
+
+    calib_async_complete(ctx, status);
+}
+
+/** \brief Starts an operation on a device
+ *  \param[in] device  Device to run the operation on
+ *  \param[in] ctx     Operation context with the operation fields filled in
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS calib_async_submit(ATCADevice device, calib_async_ctx_t* ctx)
+{
+    calib_async_ctx_t** link;
+    ATCA_STATUS status;
+    bool done = false;
+
+    if (device->async_ctx)
+    {
+        return ATCA_FUNC_FAIL;
+    }
+
+    ctx->device = device;
+    ctx->step = 0;
+    ctx->status = ATCA_SUCCESS;
+
+    // Build the first command
+    if ((status = ctx->fp_step(ctx, ATCA_SUCCESS, &done)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+
+    // Append, operations are started in the order they were submitted
+    ctx->state = CALIB_ASYNC_STATE_WAKE;
+    ctx->next = NULL;
+    for (link = &calib_async_list; *link; link = &(*link)->next)
+    {
+        ;
+    }
+    *link = ctx;
+    device->async_ctx = ctx;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Steps of an asynchronous sign: update the RNG seed, load the
+ *         message and sign it
+ */
+static ATCA_STATUS calib_async_sign_step(calib_async_ctx_t* ctx, ATCA_STATUS rsp_status, bool* done)
+{
+    ATCACommand ca_cmd = ctx->device->mCommands;
+    ATCAPacket* packet = &ctx->packet;
+    bool use_msgdigbuf = (ca_cmd->dt == ATECC608A);
+
+    if (rsp_status != ATCA_SUCCESS)
+    {
+        return rsp_status;
+    }
+
+    switch (ctx->step)
+    {
+    case 0:
+        // Make sure RNG has updated its seed
+        packet->param1 = RANDOM_SEED_UPDATE;
+        packet->param2 = 0x0000;
+        return atRandom(ca_cmd, packet);
+
+    case 1:
+        // Load message into device, the ATECC608A uses the Message Digest Buffer
+        packet->param1 = NONCE_MODE_PASSTHROUGH | NONCE_MODE_INPUT_LEN_32;
+        packet->param1 |= use_msgdigbuf ? NONCE_MODE_TARGET_MSGDIGBUF : NONCE_MODE_TARGET_TEMPKEY;
+        packet->param2 = 0x0000;
+        memcpy(packet->data, ctx->message, 32);
+        return atNonce(ca_cmd, packet);
+
+    case 2:
+        packet->param1 = SIGN_MODE_EXTERNAL | (use_msgdigbuf ? SIGN_MODE_SOURCE_MSGDIGBUF : SIGN_MODE_SOURCE_TEMPKEY);
+        packet->param2 = ctx->key_id;
+        return atSign(ca_cmd, packet);
+
+    default:
+        if (packet->data[ATCA_COUNT_IDX] != (ATCA_SIG_SIZE + ATCA_PACKET_OVERHEAD))
+        {
+            return ATCA_RX_FAIL;
+        }
+        memcpy(ctx->out, &packet->data[ATCA_RSP_DATA_IDX], ATCA_SIG_SIZE);
+        *done = true;
+        return ATCA_SUCCESS;
+    }
+}
+
+/** \brief Steps of an asynchronous external verify: load the message and
+ *         verify the signature against the public key
+ */
+static ATCA_STATUS calib_async_verify_extern_step(calib_async_ctx_t* ctx, ATCA_STATUS rsp_status, bool* done)
+{
+    ATCACommand ca_cmd = ctx->device->mCommands;
+    ATCAPacket* packet = &ctx->packet;
+    bool use_msgdigbuf = (ca_cmd->dt == ATECC608A);
+
+    switch (ctx->step)
+    {
+    case 0:
+        packet->param1 = NONCE_MODE_PASSTHROUGH | NONCE_MODE_INPUT_LEN_32;
+        packet->param1 |= use_msgdigbuf ? NONCE_MODE_TARGET_MSGDIGBUF : NONCE_MODE_TARGET_TEMPKEY;
+        packet->param2 = 0x0000;
+        memcpy(packet->data, ctx->message, 32);
+        return atNonce(ca_cmd, packet);
+
+    case 1:
+        if (rsp_status != ATCA_SUCCESS)
+        {
+            return rsp_status;
+        }
+        packet->param1 = VERIFY_MODE_EXTERNAL | (use_msgdigbuf ? VERIFY_MODE_SOURCE_MSGDIGBUF : VERIFY_MODE_SOURCE_TEMPKEY);
+        packet->param2 = VERIFY_KEY_P256;
+        memcpy(&packet->data[0], ctx->signature, ATCA_SIG_SIZE);
+        memcpy(&packet->data[ATCA_SIG_SIZE], ctx->public_key, ATCA_PUB_KEY_SIZE);
+        return atVerify(ca_cmd, packet);
+
+    default:
+        *done = true;
+        *ctx->is_verified = (rsp_status == ATCA_SUCCESS);
+        if (rsp_status == ATCA_CHECKMAC_VERIFY_FAILED)
+        {
+            return ATCA_SUCCESS;  // Verify failed, but command succeeded
+        }
+        return rsp_status;
+    }
+}
+
+/** \brief Steps of an asynchronous ECDH with the private key in a slot and
+ *         the premaster secret returned in the clear
+ */
+static ATCA_STATUS calib_async_ecdh_step(calib_async_ctx_t* ctx, ATCA_STATUS rsp_status, bool* done)
+{
+    ATCAPacket* packet = &ctx->packet;
+
+    if (rsp_status != ATCA_SUCCESS)
+    {
+        return rsp_status;
+    }
+
+    switch (ctx->step)
+    {
+    case 0:
+        packet->param1 = ECDH_PREFIX_MODE;
+        packet->param2 = ctx->key_id;
+        memcpy(packet->data, ctx->public_key, ATCA_PUB_KEY_SIZE);
+        return atECDH(ctx->device->mCommands, packet);
+
+    default:
+        if (packet->data[ATCA_COUNT_IDX] < (ATCA_KEY_SIZE + ATCA_PACKET_OVERHEAD))
+        {
+            return ATCA_RX_FAIL;
+        }
+        memcpy(ctx->out, &packet->data[ATCA_RSP_DATA_IDX], ATCA_KEY_SIZE);
+        *done = true;
+        return ATCA_SUCCESS;
+    }
+}
+
+/** \brief Steps of an asynchronous random number generation */
+static ATCA_STATUS calib_async_random_step(calib_async_ctx_t* ctx, ATCA_STATUS rsp_status, bool* done)
+{
+    ATCAPacket* packet = &ctx->packet;
+
+    if (rsp_status != ATCA_SUCCESS)
+    {
+        return rsp_status;
+    }
+
+    switch (ctx->step)
+    {
+    case 0:
+        packet->param1 = RANDOM_SEED_UPDATE;
+        packet->param2 = 0x0000;
+        return atRandom(ctx->device->mCommands, packet);
+
+    default:
+        if (packet->data[ATCA_COUNT_IDX] != RANDOM_RSP_SIZE)
+        {
+            return ATCA_RX_FAIL;
+        }
+        memcpy(ctx->out, &packet->data[ATCA_RSP_DATA_IDX], RANDOM_NUM_SIZE);
+        *done = true;
+        return ATCA_SUCCESS;
+    }
+}
+
+/** \brief Submits an ECDSA sign of an external 32 byte message digest. The
+ *         call returns once the operation has been queued, progress is made
+ *         by calib_async_tasks().
+ *
+ *  \param[in]  device     Device context pointer
+ *  \param[in]  ctx        Operation context, owned by the caller until the callback
+ *  \param[in]  key_id     Slot of the ECC private key used to sign
+ *  \param[in]  msg        32-byte message to be signed, has to stay valid
+ *                         until the callback
+ *  \param[out] signature  Receives the 64-byte signature (R and S)
+ *  \param[in]  callback   Completion callback, may be NULL
+ *  \param[in]  param      Parameter passed to the callback
+ *
+ *  \return ATCA_SUCCESS when the operation was queued, otherwise an error code.
+ */
+ATCA_STATUS calib_async_sign(ATCADevice device, calib_async_ctx_t* ctx, uint16_t key_id, const uint8_t* msg, uint8_t* signature,
+                             atca_async_callback callback, void* param)
+{
+    if (device == NULL || ctx == NULL || msg == NULL || signature == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    if (device->async_ctx)
+    {
+        // Busy, the context of the running operation must not be touched
+        return ATCA_FUNC_FAIL;
+    }
+
+    ctx->fp_step = calib_async_sign_step;
+    ctx->key_id = key_id;
+    ctx->message = msg;
+    ctx->out = signature;
+    ctx->callback = callback;
+    ctx->param = param;
+
+    return calib_async_submit(device, ctx);
+}
+
+/** \brief Submits the verification of a signature over an external 32 byte
+ *         message digest with an external public key. The call returns once
+ *         the operation has been queued, progress is made by
+ *         calib_async_tasks().
+ *
+ *  \param[in]  device       Device context pointer
+ *  \param[in]  ctx          Operation context, owned by the caller until the callback
+ *  \param[in]  message      32 byte message, has to stay valid until the callback
+ *  \param[in]  signature    64 byte signature (R and S), has to stay valid
+ *                           until the callback
+ *  \param[in]  public_key   64 byte public key (X and Y), has to stay valid
+ *                           until the callback
+ *  \param[out] is_verified  Receives the verification result
+ *  \param[in]  callback     Completion callback, may be NULL
+ *  \param[in]  param        Parameter passed to the callback
+ *
+ *  \return ATCA_SUCCESS when the operation was queued, otherwise an error code.
+ */
+ATCA_STATUS calib_async_verify_extern(ATCADevice device, calib_async_ctx_t* ctx, const uint8_t* message, const uint8_t* signature,
+                                      const uint8_t* public_key, bool* is_verified, atca_async_callback callback, void* param)
+{
+    if (device == NULL || ctx == NULL || message == NULL || signature == NULL || public_key == NULL || is_verified == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    if (device->async_ctx)
+    {
+        // Busy, the context of the running operation must not be touched
+        return ATCA_FUNC_FAIL;
+    }
+
+    *is_verified = false;
+    ctx->fp_step = calib_async_verify_extern_step;
+    ctx->message = message;
+    ctx->signature = signature;
+    ctx->public_key = public_key;
+    ctx->is_verified = is_verified;
+    ctx->callback = callback;
+    ctx->param = param;
+
+    return calib_async_submit(device, ctx);
+}
+
+/** \brief Submits an ECDH with the private key in a slot. The premaster
+ *         secret is returned in the clear. The call returns once the
+ *         operation has been queued, progress is made by calib_async_tasks().
+ *
+ *  \param[in]  device      Device context pointer
+ *  \param[in]  ctx         Operation context, owned by the caller until the callback
+ *  \param[in]  key_id      Slot of the ECC private key
+ *  \param[in]  public_key  64 byte public key (X and Y) of the other party,
+ *                          has to stay valid until the callback
+ *  \param[out] pms         Receives the 32 byte premaster secret
+ *  \param[in]  callback    Completion callback, may be NULL
+ *  \param[in]  param       Parameter passed to the callback
+ *
+ *  \return ATCA_SUCCESS when the operation was queued, otherwise an error code.
+ */
+ATCA_STATUS calib_async_ecdh(ATCADevice device, calib_async_ctx_t* ctx, uint16_t key_id, const uint8_t* public_key, uint8_t* pms,
+                             atca_async_callback callback, void* param)
+{
+    if (device == NULL || ctx == NULL || public_key == NULL || pms == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    if (device->async_ctx)
+    {
+        // Busy, the context of the running operation must not be touched
+        return ATCA_FUNC_FAIL;
+    }
+
+    ctx->fp_step = calib_async_ecdh_step;
+    ctx->key_id = key_id;
+    ctx->public_key = public_key;
+    ctx->out = pms;
+    ctx->callback = callback;
+    ctx->param = param;
+
+    return calib_async_submit(device, ctx);
+}
+
+/** \brief Submits the generation of a 32 byte random number. The call
+ *         returns once the operation has been queued, progress is made by
+ *         calib_async_tasks().
+ *
+ *  \param[in]  device    Device context pointer
+ *  \param[in]  ctx       Operation context, owned by the caller until the callback
+ *  \param[out] rand_out  Receives the 32 bytes of random data
+ *  \param[in]  callback  Completion callback, may be NULL
+ *  \param[in]  param     Parameter passed to the callback
+ *
+ *  \return ATCA_SUCCESS when the operation was queued, otherwise an error code.
+ */
+ATCA_STATUS calib_async_random(ATCADevice device, calib_async_ctx_t* ctx, uint8_t* rand_out, atca_async_callback callback, void* param)
+{
+    if (device == NULL || ctx == NULL || rand_out == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    if (device->async_ctx)
+    {
+        // Busy, the context of the running operation must not be touched
+        return ATCA_FUNC_FAIL;
+    }
+
+    ctx->fp_step = calib_async_random_step;
+    ctx->out = rand_out;
+    ctx->callback = callback;
+    ctx->param = param;
+
+    return calib_async_submit(device, ctx);
+}
+
+/** \brief Finds the operation whose response is most overdue
+ *  \param[in] now  Current timestamp
+ *  \return Operation to poll next or NULL if no response is due yet.
+ */
+static calib_async_ctx_t* calib_async_next_due(uint32_t now)
+{
+    calib_async_ctx_t* ctx;
+    calib_async_ctx_t* due = NULL;
+    uint32_t overdue = 0;
+    uint32_t elapsed_us;
+
+    for (ctx = calib_async_list; ctx; ctx = ctx->next)
+    {
+        if (ctx->state != CALIB_ASYNC_STATE_WAIT)
+        {
+            continue;
+        }
+        elapsed_us = now - ctx->sent_us;
+        if (elapsed_us >= ctx->wait_us && (due == NULL || elapsed_us - ctx->wait_us > overdue))
+        {
+            due = ctx;
+            overdue = elapsed_us - ctx->wait_us;
+        }
+    }
+    return due;
+}
+
+/** \brief Advances all asynchronous operations. Call it periodically from the
+ *         application main loop, e.g. from SYS_Tasks().
+ *
+ *  Commands waiting to be sent go out first so every device is executing
+ *  while the others are polled. Responses are then collected, the most
+ *  overdue first. With several devices on one bus the execution time of one
+ *  device is used for the transfers of the others.
+ *
+ *  \return true while operations are in progress
+ */
+bool calib_async_tasks(void)
+{
+    calib_async_ctx_t* ctx = calib_async_list;
+    calib_async_ctx_t* next;
+
+    while (ctx)
+    {
+        // The context may be unlinked by its completion
+        next = ctx->next;
+        if (ctx->state == CALIB_ASYNC_STATE_WAKE || ctx->state == CALIB_ASYNC_STATE_SEND)
+        {
+            calib_async_run(ctx);
+        }
+        ctx = next;
+    }
+
+    // A polled context completes, moves on to its next command or is
+    // rescheduled for a later poll
+    while ((ctx = calib_async_next_due(hal_timestamp_us())) != NULL)
+    {
+        calib_async_run(ctx);
+    }
+
+    return calib_async_list != NULL;
+}
+
+/** \brief Time until calib_async_tasks() has work to do again. The main loop
+ *         can spend it on other tasks or in a low power wait.
+ *  \return Microseconds until the next response is due, 0 if there is work
+ *          to do now or no operation is in progress
+ */
+uint32_t calib_async_idle_us(void)
+{
+    calib_async_ctx_t* ctx;
+    uint32_t now = hal_timestamp_us();
+    uint32_t idle_us = 0;
+    uint32_t elapsed_us;
+    bool first = true;
+
+    for (ctx = calib_async_list; ctx; ctx = ctx->next)
+    {
+        if (ctx->state != CALIB_ASYNC_STATE_WAIT)
+        {
+            return 0;
+        }
+        elapsed_us = now - ctx->sent_us;
+        if (elapsed_us >= ctx->wait_us)
+        {
+            return 0;
+        }
+        if (first || ctx->wait_us - elapsed_us < idle_us)
+        {
+            idle_us = ctx->wait_us - elapsed_us;
+            first = false;
+        }
+    }
+    return idle_us;
+}
+
+/** \brief Check whether an asynchronous operation is in progress on a device
+ *  \param[in] device  Device context pointer
+ *  \return true if an operation is in progress
+ */
+bool calib_async_is_busy(ATCADevice device)
+{
+    return (device != NULL) && (device->async_ctx != NULL);
+}
@@ -14,6 +14,8 @@
 ATCA_STATUS calib_wakeup(ATCADevice device);
 ATCA_STATUS calib_idle(ATCADevice device);
 ATCA_STATUS calib_sleep(ATCADevice device);
+ATCA_STATUS calib_session_begin(ATCADevice device);
+ATCA_STATUS calib_session_end(ATCADevice device);
 ATCA_STATUS _calib_exit(ATCADevice device);
 ATCA_STATUS calib_cfg_discover(ATCAIfaceCfg cfg_array[], int max);
 ATCA_STATUS calib_get_addr(uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint16_t* addr);
@@ -110,6 +112,16 @@ ATCA_STATUS calib_read_pubkey(ATCADevice device, uint16_t slot, uint8_t *public_
 ATCA_STATUS calib_read_sig(ATCADevice device, uint16_t slot, uint8_t *sig);
 ATCA_STATUS calib_read_config_zone(ATCADevice device, uint8_t* config_data);
 ATCA_STATUS calib_cmp_config_zone(ATCADevice device, uint8_t* config_data, bool* same_config);
+#ifdef ATCA_CONFIG_CACHE
+ATCA_STATUS calib_config_cache_enable(ATCADevice device, bool enable);
+ATCA_STATUS calib_config_cache_invalidate(ATCADevice device);
+ATCA_STATUS calib_config_cache_stats(ATCADevice device, uint32_t* hits, uint32_t* misses);
+#endif
+#ifdef ATCA_DATA_CACHE
+ATCA_STATUS calib_data_cache_policy(ATCADevice device, uint16_t data_slots, uint16_t pubkey_slots);
+ATCA_STATUS calib_data_cache_invalidate(ATCADevice device);
+ATCA_STATUS calib_data_cache_stats(ATCADevice device, uint32_t* hits, uint32_t* misses);
+#endif
 
 
 #if defined(ATCA_USE_CONSTANT_HOST_NONCE)
@@ -162,6 +174,7 @@ ATCA_STATUS calib_updateextra(ATCADevice device, uint8_t mode, uint16_t new_valu
 // Verify command functions
 ATCA_STATUS calib_verify(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* signature, const uint8_t* public_key, const uint8_t* other_data, uint8_t* mac);
 ATCA_STATUS calib_verify_extern(ATCADevice device, const uint8_t *message, const uint8_t *signature, const uint8_t *public_key, bool *is_verified);
+ATCA_STATUS calib_verify_extern_batch(ATCADevice device, uint16_t count, const uint8_t* messages, const uint8_t* signatures, const uint8_t* public_keys, bool* is_verified);
 ATCA_STATUS calib_verify_extern_mac(ATCADevice device, const uint8_t *message, const uint8_t* signature, const uint8_t* public_key, const uint8_t* num_in, const uint8_t* io_key, bool* is_verified);
 ATCA_STATUS calib_verify_stored(ATCADevice device, const uint8_t *message, const uint8_t *signature, uint16_t key_id, bool *is_verified);
 ATCA_STATUS calib_verify_stored_mac(ATCADevice device, const uint8_t *message, const uint8_t *signature, uint16_t key_id, const uint8_t* num_in, const uint8_t* io_key, bool* is_verified);
@@ -35,26 +35,10 @@
 
 #include "cryptoauthlib.h"
 #include "host/atca_host.h"
+#include "atcacert/atcacert_cache.h"
 
-/** \brief Executes Read command, which reads either 4 or 32 bytes of data from
- *          a given slot, configuration zone, or the OTP zone.
- *
- *   When reading a slot or OTP, data zone must be locked and the slot
- *   configuration must not be secret for a slot to be successfully read.
- *
- *  \param[in]  device   Device context pointer
- *  \param[in]  zone     Zone to be read from device. Options are
- *                       ATCA_ZONE_CONFIG, ATCA_ZONE_OTP, or ATCA_ZONE_DATA.
- *  \param[in]  slot     Slot number for data zone and ignored for other zones.
- *  \param[in]  block    32 byte block index within the zone.
- *  \param[in]  offset   4 byte work index within the block. Ignored for 32 byte
- *                       reads.
- *  \param[out] data     Read data is returned here.
- *  \param[in]  len      Length of the data to be read. Must be either 4 or 32.
- *
- *  returns ATCA_SUCCESS on success, otherwise an error code.
- */
-ATCA_STATUS calib_read_zone(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+/** \brief Issues a Read command to the device, see calib_read_zone() */
+static ATCA_STATUS calib_read_zone_device(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
 {
     ATCAPacket packet;
     ATCACommand ca_cmd = device->mCommands;
@@ -106,6 +90,576 @@ ATCA_STATUS calib_read_zone(ATCADevice device, uint8_t zone, uint16_t slot, uint
 
     return status;
 }
+
+#ifdef ATCA_CONFIG_CACHE
+/* Config zone bytes that change without a command the cache sees, reads
+ * touching them bypass the cache. Bytes 52-67 are Counter[0]/Counter[1] on the
+ * ECC devices, which limited use keys advance, and are excluded on every part.
+ * Up to byte 84 follow the UseFlag/UpdateCount and LastKeyUse bytes of the
+ * ATSHA204A and LastKeyUse of the ATECC108A/508A. */
+#define CALIB_CONFIG_VOLATILE_START     (52)
+#define CALIB_CONFIG_COUNTER_END        (68)
+#define CALIB_CONFIG_VOLATILE_END       (84)
+
+/** \brief Read the whole config zone into the cache within one wake */
+static ATCA_STATUS calib_config_cache_fill(ATCADevice device)
+{
+    atca_config_cache_t* cache = &device->config_cache;
+    ATCA_STATUS status;
+    ATCA_STATUS end_status;
+    size_t config_size = 0;
+    size_t offset;
+    uint8_t len = ATCA_BLOCK_SIZE;
+
+    if ((status = calib_get_zone_size(device, ATCA_ZONE_CONFIG, 0, &config_size)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+    if (config_size > sizeof(cache->data))
+    {
+        return ATCA_INVALID_SIZE;
+    }
+
+    if ((status = calib_session_begin(device)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+    for (offset = 0; offset < config_size; offset += len)
+    {
+        len = (config_size - offset >= ATCA_BLOCK_SIZE) ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE;
+        status = calib_read_zone_device(device, ATCA_ZONE_CONFIG, 0, (uint8_t)(offset / ATCA_BLOCK_SIZE),
+                                        (uint8_t)((offset % ATCA_BLOCK_SIZE) / ATCA_WORD_SIZE), &cache->data[offset], len);
+        if (status != ATCA_SUCCESS)
+        {
+            break;
+        }
+    }
+    end_status = calib_session_end(device);
+
+    if (status == ATCA_SUCCESS && end_status == ATCA_SUCCESS)
+    {
+        cache->valid = 1;
+    }
+    return (status != ATCA_SUCCESS) ? status : end_status;
+}
+
+/** \brief Serve a config zone read from the cache, filling it first when it
+ *         doesn't hold the config zone yet
+ * \return ATCA_SUCCESS when the read was served, ATCA_UNIMPLEMENTED when it has
+ *         to go to the device, otherwise an error code.
+ */
+static ATCA_STATUS calib_config_cache_read(ATCADevice device, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+{
+    atca_config_cache_t* cache = &device->config_cache;
+    ATCADeviceType devtype = device->mIface->mIfaceCFG->devtype;
+    size_t start = (size_t)block * ATCA_BLOCK_SIZE + ((len == ATCA_WORD_SIZE) ? (size_t)offset * ATCA_WORD_SIZE : 0);
+    size_t config_size = 0;
+    size_t volatile_end = (devtype == ATECC608A) ? CALIB_CONFIG_COUNTER_END : CALIB_CONFIG_VOLATILE_END;
+    ATCA_STATUS status;
+
+    if (calib_get_zone_size(device, ATCA_ZONE_CONFIG, 0, &config_size) != ATCA_SUCCESS || start + len > config_size)
+    {
+        // Let the device report the bad address
+        return ATCA_UNIMPLEMENTED;
+    }
+    if (start < volatile_end && start + len > CALIB_CONFIG_VOLATILE_START)
+    {
+        cache->misses++;
+        return ATCA_UNIMPLEMENTED;
+    }
+
+    if (!cache->valid)
+    {
+        cache->misses++;
+        if ((status = calib_config_cache_fill(device)) != ATCA_SUCCESS)
+        {
+            return status;
+        }
+    }
+    else
+    {
+        cache->hits++;
+    }
+    memcpy(data, &cache->data[start], len);
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Enable or disable serving config zone reads of a device from a host
+ *         copy of its config zone. The copy is read on the first config zone
+ *         read after the cache is enabled and dropped whenever a command
+ *         that changes the config zone is executed (Write to the config zone,
+ *         Lock, UpdateExtra and Counter increments).
+ *  \param[in] device  Device context pointer
+ *  \param[in] enable  true to serve config zone reads from the cache
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_config_cache_enable(ATCADevice device, bool enable)
+{
+    if (device == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    device->config_cache.enabled = enable ? 1 : 0;
+    device->config_cache.valid = 0;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Drop the host copy of the config zone, the next config zone read
+ *         reads it from the device again. Needed after the config zone was
+ *         changed through another device context.
+ *  \param[in] device  Device context pointer
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_config_cache_invalidate(ATCADevice device)
+{
+    if (device == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    device->config_cache.valid = 0;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Get the number of config zone reads served from the cache and of
+ *         those that went to the device since the device was initialized.
+ *  \param[in]  device  Device context pointer
+ *  \param[out] hits    Reads served from the cache
+ *  \param[out] misses  Reads that went to the device
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_config_cache_stats(ATCADevice device, uint32_t* hits, uint32_t* misses)
+{
+    if (device == NULL || hits == NULL || misses == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    *hits = device->config_cache.hits;
+    *misses = device->config_cache.misses;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Drop the cached config zone when a command that changes it is sent
+ *  \param[in] device  Device the command was sent to
+ *  \param[in] packet  Command packet
+ */
+void calib_config_cache_update(ATCADevice device, const ATCAPacket* packet)
+{
+    switch (packet->opcode)
+    {
+    case ATCA_WRITE:
+        if ((packet->param1 & ATCA_ZONE_MASK) == ATCA_ZONE_CONFIG)
+        {
+            device->config_cache.valid = 0;
+        }
+        break;
+    case ATCA_COUNTER:
+        if ((packet->param1 & COUNTER_MODE_MASK) == COUNTER_MODE_INCREMENT)
+        {
+            device->config_cache.valid = 0;
+        }
+        break;
+    case ATCA_LOCK:
+    case ATCA_UPDATE_EXTRA:
+        device->config_cache.valid = 0;
+        break;
+    default:
+        break;
+    }
+}
+#endif
+
+#ifdef ATCA_DATA_CACHE
+#define CALIB_DATA_CACHE_FREE       (0)
+#define CALIB_DATA_CACHE_BLOCK      (1)
+#define CALIB_DATA_CACHE_WORD       (2)
+#define CALIB_DATA_CACHE_PUBKEY     (3)
+
+#define CALIB_DATA_CACHE_SLOTS      (16)    // Slots of the data zone
+#define CALIB_SLOT_CONFIG_OFFSET    (20)    // Config zone offset of SlotConfig[0]
+#define CALIB_SLOT_CONFIG_SECRET    (0x80)  // IsSecret bit in the first byte of a SlotConfig
+
+/** \brief Find the entry holding the given data, NULL when there is none */
+static atca_data_cache_entry_t* calib_data_cache_find(atca_data_cache_t* cache, uint8_t kind, uint8_t slot, uint8_t block, uint8_t offset)
+{
+    size_t i;
+
+    for (i = 0; i < ATCA_DATA_CACHE_ENTRIES; i++)
+    {
+        atca_data_cache_entry_t* entry = &cache->entries[i];
+        if (entry->kind == kind && entry->slot == slot && entry->block == block && entry->offset == offset)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+/** \brief Store data in the entry already holding it, a free entry or the
+ *         least recently used entry */
+static void calib_data_cache_store(atca_data_cache_t* cache, uint8_t kind, uint8_t slot, uint8_t block, uint8_t offset,
+                                   const uint8_t* data, uint8_t len)
+{
+    atca_data_cache_entry_t* entry = calib_data_cache_find(cache, kind, slot, block, offset);
+    size_t i;
+
+    if (entry == NULL)
+    {
+        entry = &cache->entries[0];
+        for (i = 1; i < ATCA_DATA_CACHE_ENTRIES && entry->kind != CALIB_DATA_CACHE_FREE; i++)
+        {
+            if (cache->entries[i].kind == CALIB_DATA_CACHE_FREE || cache->entries[i].used < entry->used)
+            {
+                entry = &cache->entries[i];
+            }
+        }
+    }
+
+    entry->kind = kind;
+    entry->slot = slot;
+    entry->block = block;
+    entry->offset = offset;
+    entry->used = ++cache->clock;
+    memcpy(entry->data, data, len);
+}
+
+/** \brief Drop all entries of a slot */
+static void calib_data_cache_drop(atca_data_cache_t* cache, uint16_t slot)
+{
+    size_t i;
+
+    for (i = 0; i < ATCA_DATA_CACHE_ENTRIES; i++)
+    {
+        if (cache->entries[i].slot == slot)
+        {
+            cache->entries[i].kind = CALIB_DATA_CACHE_FREE;
+        }
+    }
+}
+
+/** \brief Serve a data zone read from the cache, reading it from the device
+ *         and keeping it when it isn't cached yet
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS calib_data_cache_read(ATCADevice device, uint8_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+{
+    atca_data_cache_t* cache = &device->data_cache;
+    atca_data_cache_entry_t* entry;
+    ATCA_STATUS status;
+
+    // A cached block also serves reads of its words
+    if ((entry = calib_data_cache_find(cache, CALIB_DATA_CACHE_BLOCK, slot, block, 0)) != NULL)
+    {
+        memcpy(data, &entry->data[(len == ATCA_WORD_SIZE) ? offset * ATCA_WORD_SIZE : 0], len);
+    }
+    else if (len == ATCA_WORD_SIZE && (entry = calib_data_cache_find(cache, CALIB_DATA_CACHE_WORD, slot, block, offset)) != NULL)
+    {
+        memcpy(data, entry->data, len);
+    }
+
+    if (entry != NULL)
+    {
+        entry->used = ++cache->clock;
+        cache->hits++;
+        return ATCA_SUCCESS;
+    }
+
+    cache->misses++;
+    if ((status = calib_read_zone_device(device, ATCA_ZONE_DATA, slot, block, offset, data, len)) == ATCA_SUCCESS)
+    {
+        if (len == ATCA_BLOCK_SIZE)
+        {
+            calib_data_cache_store(cache, CALIB_DATA_CACHE_BLOCK, slot, block, 0, data, len);
+        }
+        else
+        {
+            calib_data_cache_store(cache, CALIB_DATA_CACHE_WORD, slot, block, offset, data, len);
+        }
+    }
+    return status;
+}
+
+/** \brief Select the slots whose data zone reads and GenKey public keys are
+ *         kept on the host. Data zone reads of a slot are served from the
+ *         cache once read and public keys computed by GenKey are kept per
+ *         slot, so repeated reads of certificates and public keys don't go
+ *         to the device again. Entries of a slot are dropped whenever a
+ *         command that changes the slot is executed (Write, PrivWrite,
+ *         GenKey creating a private key, DeriveKey, KDF and ECDH writing to
+ *         the slot, Verify validating or invalidating it).
+ *
+ *  Secret slots are refused for data_slots, their reads either fail or are
+ *  encrypted with a different key every time. The policy is cleared when the
+ *  config zone is written as the slot configuration it was checked against
+ *  may change.
+ *
+ *  \param[in] device        Device context pointer
+ *  \param[in] data_slots    Bit mask of the slots whose data zone reads are
+ *                           cached, 0 disables caching of reads
+ *  \param[in] pubkey_slots  Bit mask of the slots whose public keys computed
+ *                           by GenKey are cached, 0 disables caching of public
+ *                           keys
+ *  \return ATCA_SUCCESS on success, ATCA_BAD_PARAM when data_slots contains a
+ *          secret slot, otherwise an error code.
+ */
+ATCA_STATUS calib_data_cache_policy(ATCADevice device, uint16_t data_slots, uint16_t pubkey_slots)
+{
+    ATCA_STATUS status;
+    uint8_t slot_config[CALIB_DATA_CACHE_SLOTS * 2];
+    uint8_t slot;
+
+    if (device == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (data_slots != 0)
+    {
+        if ((status = calib_read_bytes_zone(device, ATCA_ZONE_CONFIG, 0, CALIB_SLOT_CONFIG_OFFSET, slot_config, sizeof(slot_config))) != ATCA_SUCCESS)
+        {
+            return status;
+        }
+        for (slot = 0; slot < CALIB_DATA_CACHE_SLOTS; slot++)
+        {
+            if ((data_slots & (1u << slot)) && (slot_config[slot * 2] & CALIB_SLOT_CONFIG_SECRET))
+            {
+                return ATCA_BAD_PARAM;
+            }
+        }
+    }
+
+    memset(device->data_cache.entries, 0, sizeof(device->data_cache.entries));
+    device->data_cache.data_slots = data_slots;
+    device->data_cache.pubkey_slots = pubkey_slots;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Drop all cached data zone reads and public keys, needed after the
+ *         data zone was changed through another device context.
+ *  \param[in] device  Device context pointer
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_data_cache_invalidate(ATCADevice device)
+{
+    if (device == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    memset(device->data_cache.entries, 0, sizeof(device->data_cache.entries));
+    return ATCA_SUCCESS;
+}
+
+/** \brief Get the number of cacheable data zone reads and public key
+ *         computations served from the cache and of those that went to the
+ *         device since the device was initialized.
+ *  \param[in]  device  Device context pointer
+ *  \param[out] hits    Requests served from the cache
+ *  \param[out] misses  Requests that went to the device
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_data_cache_stats(ATCADevice device, uint32_t* hits, uint32_t* misses)
+{
+    if (device == NULL || hits == NULL || misses == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    *hits = device->data_cache.hits;
+    *misses = device->data_cache.misses;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Look up the public key of a slot computed by an earlier GenKey
+ *  \param[in]  device      Device context pointer
+ *  \param[in]  key_id      Slot of the private key
+ *  \param[out] public_key  64 byte public key is returned here
+ *  \return ATCA_SUCCESS when the public key was cached, otherwise
+ *          ATCA_UNIMPLEMENTED and the public key has to be computed.
+ */
+ATCA_STATUS calib_data_cache_get_pubkey(ATCADevice device, uint16_t key_id, uint8_t* public_key)
+{
+    atca_data_cache_t* cache = &device->data_cache;
+    atca_data_cache_entry_t* entry;
+
+    if (key_id >= CALIB_DATA_CACHE_SLOTS || !(cache->pubkey_slots & (1u << key_id)))
+    {
+        return ATCA_UNIMPLEMENTED;
+    }
+    if ((entry = calib_data_cache_find(cache, CALIB_DATA_CACHE_PUBKEY, (uint8_t)key_id, 0, 0)) == NULL)
+    {
+        cache->misses++;
+        return ATCA_UNIMPLEMENTED;
+    }
+
+    entry->used = ++cache->clock;
+    cache->hits++;
+    memcpy(public_key, entry->data, ATCA_PUB_KEY_SIZE);
+    return ATCA_SUCCESS;
+}
+
+/** \brief Keep the public key of a slot returned by GenKey
+ *  \param[in] device      Device context pointer
+ *  \param[in] key_id      Slot of the private key
+ *  \param[in] public_key  64 byte public key
+ */
+void calib_data_cache_put_pubkey(ATCADevice device, uint16_t key_id, const uint8_t* public_key)
+{
+    atca_data_cache_t* cache = &device->data_cache;
+
+    if (key_id < CALIB_DATA_CACHE_SLOTS && (cache->pubkey_slots & (1u << key_id)))
+    {
+        calib_data_cache_store(cache, CALIB_DATA_CACHE_PUBKEY, (uint8_t)key_id, 0, 0, public_key, ATCA_PUB_KEY_SIZE);
+    }
+}
+
+/** \brief Drop the cached data of the slots a command changes
+ *  \param[in] device  Device the command was sent to
+ *  \param[in] packet  Command packet
+ */
+void calib_data_cache_update(ATCADevice device, const ATCAPacket* packet)
+{
+    atca_data_cache_t* cache = &device->data_cache;
+
+    switch (packet->opcode)
+    {
+    case ATCA_WRITE:
+        if ((packet->param1 & ATCA_ZONE_MASK) == ATCA_ZONE_DATA)
+        {
+            calib_data_cache_drop(cache, (packet->param2 >> 3) & 0x0F);
+        }
+        else if ((packet->param1 & ATCA_ZONE_MASK) == ATCA_ZONE_CONFIG)
+        {
+            memset(cache->entries, 0, sizeof(cache->entries));
+            cache->data_slots = 0;
+        }
+        break;
+    case ATCA_GENKEY:
+        if (packet->param1 & GENKEY_MODE_PRIVATE)
+        {
+            calib_data_cache_drop(cache, packet->param2);
+        }
+        break;
+    case ATCA_PRIVWRITE:
+    case ATCA_DERIVE_KEY:
+        calib_data_cache_drop(cache, packet->param2);
+        break;
+    case ATCA_VERIFY:
+        if ((packet->param1 & VERIFY_MODE_MASK) == VERIFY_MODE_VALIDATE || (packet->param1 & VERIFY_MODE_MASK) == VERIFY_MODE_INVALIDATE)
+        {
+            calib_data_cache_drop(cache, packet->param2);
+        }
+        break;
+    case ATCA_KDF:
+        if ((packet->param1 & KDF_MODE_TARGET_MASK) == KDF_MODE_TARGET_SLOT)
+        {
+            calib_data_cache_drop(cache, packet->param2 >> 8);
+        }
+        break;
+    case ATCA_ECDH:
+        if ((packet->param1 & ECDH_MODE_COPY_MASK) == ECDH_MODE_COPY_COMPATIBLE || (packet->param1 & ECDH_MODE_COPY_MASK) == ECDH_MODE_COPY_EEPROM_SLOT)
+        {
+            calib_data_cache_drop(cache, packet->param2 | 0x0001);
+        }
+        break;
+    case ATCA_LOCK:
+        memset(cache->entries, 0, sizeof(cache->entries));
+        break;
+    default:
+        break;
+    }
+}
+#endif
+
+/** \brief Drop the certificates atcacert_read_cert() cached when a command
+ *         changes the data zone or OTP zone they are built from. The cache
+ *         doesn't know which slots a certificate came from, so every such
+ *         command clears it. Clearing an empty cache costs nothing.
+ *  \param[in] packet  Command packet
+ */
+void calib_cert_cache_update(const ATCAPacket* packet)
+{
+    atcacert_cache_t* cache = atcacert_get_cache();
+    bool changed;
+
+    if (cache == NULL)
+    {
+        return;
+    }
+
+    switch (packet->opcode)
+    {
+    case ATCA_WRITE:
+        changed = (packet->param1 & ATCA_ZONE_MASK) != ATCA_ZONE_CONFIG;
+        break;
+    case ATCA_GENKEY:
+        changed = (packet->param1 & GENKEY_MODE_PRIVATE) ? true : false;
+        break;
+    case ATCA_PRIVWRITE:
+    case ATCA_DERIVE_KEY:
+        changed = true;
+        break;
+    case ATCA_VERIFY:
+        changed = (packet->param1 & VERIFY_MODE_MASK) == VERIFY_MODE_VALIDATE || (packet->param1 & VERIFY_MODE_MASK) == VERIFY_MODE_INVALIDATE;
+        break;
+    case ATCA_KDF:
+        changed = (packet->param1 & KDF_MODE_TARGET_MASK) == KDF_MODE_TARGET_SLOT;
+        break;
+    case ATCA_ECDH:
+        changed = (packet->param1 & ECDH_MODE_COPY_MASK) == ECDH_MODE_COPY_COMPATIBLE || (packet->param1 & ECDH_MODE_COPY_MASK) == ECDH_MODE_COPY_EEPROM_SLOT;
+        break;
+    default:
+        changed = false;
+        break;
+    }
+
+    if (changed)
+    {
+        // The command already ran, a region that can't be erased is left to
+        // the next atcacert_cache_clear() of the application
+        (void)atcacert_cache_clear(cache);
+    }
+}
+
+/** \brief Executes Read command, which reads either 4 or 32 bytes of data from
+ *          a given slot, configuration zone, or the OTP zone.
+ *
+ *   When reading a slot or OTP, data zone must be locked and the slot
+ *   configuration must not be secret for a slot to be successfully read.
+ *
+ *  \param[in]  device   Device context pointer
+ *  \param[in]  zone     Zone to be read from device. Options are
+ *                       ATCA_ZONE_CONFIG, ATCA_ZONE_OTP, or ATCA_ZONE_DATA.
+ *  \param[in]  slot     Slot number for data zone and ignored for other zones.
+ *  \param[in]  block    32 byte block index within the zone.
+ *  \param[in]  offset   4 byte work index within the block. Ignored for 32 byte
+ *                       reads.
+ *  \param[out] data     Read data is returned here.
+ *  \param[in]  len      Length of the data to be read. Must be either 4 or 32.
+ *
+ *  returns ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_read_zone(ATCADevice device, uint8_t zone, uint16_t slot, uint8_t block, uint8_t offset, uint8_t *data, uint8_t len)
+{
+#ifdef ATCA_CONFIG_CACHE
+    ATCA_STATUS status;
+
+    if (zone == ATCA_ZONE_CONFIG && device != NULL && device->config_cache.enabled && data != NULL &&
+        (len == ATCA_WORD_SIZE || len == ATCA_BLOCK_SIZE))
+    {
+        if ((status = calib_config_cache_read(device, block, offset, data, len)) != ATCA_UNIMPLEMENTED)
+        {
+            return status;
+        }
+    }
+#endif
+#ifdef ATCA_DATA_CACHE
+    if (zone == ATCA_ZONE_DATA && device != NULL && slot < CALIB_DATA_CACHE_SLOTS && (device->data_cache.data_slots & (1u << slot)) &&
+        data != NULL && (len == ATCA_BLOCK_SIZE || (len == ATCA_WORD_SIZE && offset < ATCA_BLOCK_SIZE / ATCA_WORD_SIZE)))
+    {
+        return calib_data_cache_read(device, (uint8_t)slot, block, offset, data, len);
+    }
+#endif
+    return calib_read_zone_device(device, zone, slot, block, offset, data, len);
+}
 /** \brief Executes Read command, which reads the 9 byte serial number of the
  *          device from the config zone.
  *
@@ -361,7 +915,7 @@ ATCA_STATUS calib_read_config_zone(ATCADevice device, uint8_t* config_data)
             break;
         }
 
-        if ((_gDevice->mIface->mIfaceCFG->devtype == ATSHA204A) || (_gDevice->mIface->mIfaceCFG->devtype == ATSHA206A))
+        if ((device->mIface->mIfaceCFG->devtype == ATSHA204A) || (device->mIface->mIfaceCFG->devtype == ATSHA206A))
         {
             status = calib_read_bytes_zone(device, ATCA_ZONE_CONFIG, 0, 0x00, config_data, ATCA_SHA_CONFIG_SIZE);
         }
@@ -432,7 +986,7 @@ ATCA_STATUS calib_cmp_config_zone(ATCADevice device, uint8_t* config_data, bool*
             break;
         }
 
-        if (_gDevice->mIface->mIfaceCFG->devtype == ATECC608A)
+        if (device->mIface->mIfaceCFG->devtype == ATECC608A)
         {
             /* Skip Counter[0], Counter[1], which can change during operation */
 
@@ -606,8 +1160,11 @@ ATCA_STATUS calib_read_pubkey(ATCADevice device, uint16_t slot, uint8_t *public_
 /** \brief Used to read an arbitrary number of bytes from any zone configured
  *          for clear reads.
  *
- * This function will issue the Read command as many times as is required to
- * read the requested data.
+ * The range is covered with 32 byte block reads and only falls back to 4 byte
+ * word reads for the part of a zone that doesn't fill a whole block. All reads
+ * are issued inside one wake session, so the device is woken once for the
+ * whole range. Blocks and words that lie completely within the requested
+ * range are read straight into the data buffer.
  *
  *  \param[in]  device  Device context pointer
  *  \param[in]  zone    Zone to read data from. Option are ATCA_ZONE_CONFIG(0),
@@ -623,15 +1180,14 @@ ATCA_STATUS calib_read_pubkey(ATCADevice device, uint16_t slot, uint8_t *public_
 ATCA_STATUS calib_read_bytes_zone(ATCADevice device, uint8_t zone, uint16_t slot, size_t offset, uint8_t *data, size_t length)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
+    ATCA_STATUS end_status;
     size_t zone_size = 0;
-    uint8_t read_buf[32];
-    size_t data_idx = 0;
-    size_t cur_block = 0;
-    size_t cur_offset = 0;
-    uint8_t read_size = ATCA_BLOCK_SIZE;
-    size_t read_buf_idx = 0;
-    size_t copy_length = 0;
-    size_t read_offset = 0;
+    uint8_t read_buf[ATCA_BLOCK_SIZE];
+    size_t read_offset;
+    size_t end_offset;
+    uint8_t read_size;
+    size_t copy_start;
+    size_t copy_end;
 
     if (zone != ATCA_ZONE_CONFIG && zone != ATCA_ZONE_OTP && zone != ATCA_ZONE_DATA)
     {
@@ -650,72 +1206,66 @@ ATCA_STATUS calib_read_bytes_zone(ATCADevice device, uint8_t zone, uint16_t slot
         return ATCA_BAD_PARAM;
     }
 
-    do
+    if (ATCA_SUCCESS != (status = calib_get_zone_size(device, zone, slot, &zone_size)))
     {
-        if(ATCA_SUCCESS != (status = calib_get_zone_size(device, zone, slot, &zone_size)))
+        return status;
+    }
+    if (offset + length > zone_size)
+    {
+        return ATCA_BAD_PARAM; // Can't read past the end of a zone
+    }
+    end_offset = offset + length;
+
+    // Start at the block holding the offset, or at its word when that block
+    // runs past the end of the zone
+    read_offset = offset - (offset % ATCA_BLOCK_SIZE);
+    if (read_offset + ATCA_BLOCK_SIZE > zone_size)
+    {
+        read_offset = offset - (offset % ATCA_WORD_SIZE);
+    }
+
+    if (ATCA_SUCCESS != (status = calib_session_begin(device)))
+    {
+        return status;
+    }
+
+    while (read_offset < end_offset)
+    {
+        if ((read_offset % ATCA_BLOCK_SIZE) == 0 && read_offset + ATCA_BLOCK_SIZE <= zone_size)
         {
-            break;
+            read_size = ATCA_BLOCK_SIZE;
         }
-        if (offset + length > zone_size)
+        else
         {
-            return ATCA_BAD_PARAM; // Can't read past the end of a zone
-
+            // Less than a block left in the zone, can't read past its end
+            read_size = ATCA_WORD_SIZE;
         }
-        cur_block = offset / ATCA_BLOCK_SIZE;
 
-        while (data_idx < length)
+        if (read_offset >= offset && read_offset + read_size <= end_offset)
         {
-            if (read_size == ATCA_BLOCK_SIZE && zone_size - cur_block * ATCA_BLOCK_SIZE < ATCA_BLOCK_SIZE)
-            {
-                // We have less than a block to read and can't read past the end of the zone, switch to word reads
-                read_size = ATCA_WORD_SIZE;
-                cur_offset = ((data_idx + offset) / ATCA_WORD_SIZE) % (ATCA_BLOCK_SIZE / ATCA_WORD_SIZE);
-            }
-
-            // Read next chunk of data
-            if(ATCA_SUCCESS != (status = calib_read_zone(device, zone, slot, (uint8_t)cur_block, (uint8_t)cur_offset, read_buf, read_size)))
-            {
-                break;
-            }
-
-            // Calculate where in the read buffer we need data from
-            read_offset = cur_block * ATCA_BLOCK_SIZE + cur_offset * ATCA_WORD_SIZE;
-            if (read_offset < offset)
-            {
-                read_buf_idx = offset - read_offset;  // Read data starts before the requested chunk
-            }
-            else
-            {
-                read_buf_idx = 0;                     // Read data is within the requested chunk
-
-            }
-            // Calculate how much data from the read buffer we want to copy
-            if (length - data_idx < read_size - read_buf_idx)
-            {
-                copy_length = length - data_idx;
-            }
-            else
-            {
-                copy_length = read_size - read_buf_idx;
-            }
-
-            memcpy(&data[data_idx], &read_buf[read_buf_idx], copy_length);
-            data_idx += copy_length;
-            if (read_size == ATCA_BLOCK_SIZE)
-            {
-                cur_block += 1;
-            }
-            else
+            status = calib_read_zone(device, zone, slot, (uint8_t)(read_offset / ATCA_BLOCK_SIZE),
+                                     (uint8_t)((read_offset % ATCA_BLOCK_SIZE) / ATCA_WORD_SIZE), &data[read_offset - offset], read_size);
+        }
+        else
+        {
+            // Only part of the read falls within the requested range
+            status = calib_read_zone(device, zone, slot, (uint8_t)(read_offset / ATCA_BLOCK_SIZE),
+                                     (uint8_t)((read_offset % ATCA_BLOCK_SIZE) / ATCA_WORD_SIZE), read_buf, read_size);
+            if (status == ATCA_SUCCESS)
             {
-                cur_offset += 1;
+                copy_start = (read_offset < offset) ? offset : read_offset;
+                copy_end = (read_offset + read_size > end_offset) ? end_offset : read_offset + read_size;
+                memcpy(&data[copy_start - offset], &read_buf[copy_start - read_offset], copy_end - copy_start);
             }
         }
         if (status != ATCA_SUCCESS)
         {
             break;
         }
+        read_offset += read_size;
     }
-    while (false);
 
-    return status;
+    end_status = calib_session_end(device);
+
+    return (status != ATCA_SUCCESS) ? status : end_status;
 }
@@ -61,10 +61,45 @@ TEST(atca_cmd_unit_test, crcerror)
     TEST_ASSERT_EQUAL_INT8_MESSAGE(0xff, packet.data[1], "Failed bad CRC test");
 }
 
+TEST(atca_cmd_unit_test, crc_incremental)
+{
+    // Info command in revision mode: count, opcode, param1, param2 and CRC
+    const uint8_t info_cmd[] = { 0x07, 0x30, 0x00, 0x00, 0x00, 0x03, 0x5D };
+    uint8_t data[64];
+    uint8_t crc[ATCA_CRC_SIZE];
+    uint8_t crc_split[ATCA_CRC_SIZE];
+    uint16_t running;
+    size_t i;
+
+    atCRC(sizeof(info_cmd) - ATCA_CRC_SIZE, info_cmd, crc);
+    TEST_ASSERT_EQUAL_MEMORY(&info_cmd[sizeof(info_cmd) - ATCA_CRC_SIZE], crc, ATCA_CRC_SIZE);
+
+    for (i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(i * 37 + 11);
+    }
+    atCRC(sizeof(data), data, crc);
+
+    // Bytes folded in as they arrive give the same CRC as the whole buffer
+    running = ATCA_CRC_INIT;
+    for (i = 0; i < sizeof(data); i++)
+    {
+        running = atCrcUpdate(running, 1, &data[i]);
+    }
+    atCrcFinal(running, crc_split);
+    TEST_ASSERT_EQUAL_MEMORY(crc, crc_split, ATCA_CRC_SIZE);
+
+    running = atCrcUpdate(ATCA_CRC_INIT, 5, data);
+    running = atCrcUpdate(running, sizeof(data) - 5, &data[5]);
+    atCrcFinal(running, crc_split);
+    TEST_ASSERT_EQUAL_MEMORY(crc, crc_split, ATCA_CRC_SIZE);
+}
+
 
 t_test_case_info calib_packet_info[] =
 {
     { REGISTER_TEST_CASE(atca_cmd_unit_test, crcerror), DEVICE_MASK(ATSHA204A) | DEVICE_MASK(ATECC108A) | DEVICE_MASK(ATECC508A) | DEVICE_MASK(ATECC608A) },
+    { REGISTER_TEST_CASE(atca_cmd_unit_test, crc_incremental), DEVICE_MASK(ATSHA204A) | DEVICE_MASK(ATECC108A) | DEVICE_MASK(ATECC508A) | DEVICE_MASK(ATECC608A) },
     /* Array Termination element*/
     { (fp_test_case)NULL,                    (uint8_t)0 },
 };
@@ -309,6 +309,38 @@ TEST(atca_jwt_crypto, verify_invalid)
                                                                    atca_jwt_test_vector_pubkey));
 }
 
+TEST(atca_jwt_crypto, verify_batch)
+{
+    char bufs[3][512];
+    const char* tokens[4] = { bufs[0], bufs[1], bufs[2], "not.a-token" };
+    uint8_t pubkeys[4][ATCA_ECCP256_PUBKEY_SIZE];
+    bool is_verified[4] = { false, true, false, true };
+    int i;
+
+    snprintf(bufs[0], sizeof(bufs[0]), "%s%s%s",
+             atca_jwt_test_vector_header,
+             atca_jwt_test_vector_payload,
+             atca_jwt_test_vector_sig);
+    snprintf(bufs[1], sizeof(bufs[1]), "%s%s%s",
+             atca_jwt_test_vector_header,
+             atca_jwt_test_vector_payload,
+             atca_jwt_test_vector_invalid_sig);
+    memcpy(bufs[2], bufs[0], sizeof(bufs[2]));
+
+    for (i = 0; i < 4; i++)
+    {
+        memcpy(pubkeys[i], atca_jwt_test_vector_pubkey, ATCA_ECCP256_PUBKEY_SIZE);
+    }
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atca_jwt_verify_batch(4, tokens, &pubkeys[0][0], is_verified));
+    TEST_ASSERT_TRUE(is_verified[0]);
+    TEST_ASSERT_FALSE(is_verified[1]);
+    TEST_ASSERT_TRUE(is_verified[2]);
+    TEST_ASSERT_FALSE(is_verified[3]);
+
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atca_jwt_verify_batch(4, NULL, &pubkeys[0][0], is_verified));
+}
+
 TEST(atca_jwt_crypto, finalize)
 {
     atca_jwt_t jwt;
@@ -364,6 +396,7 @@ t_test_case_info jwt_unit_test_info[] =
 
     { REGISTER_TEST_CASE(atca_jwt_crypto, verify),                                    ATCA_JWT_TEST_DEVICES},
     { REGISTER_TEST_CASE(atca_jwt_crypto, verify_invalid),                            ATCA_JWT_TEST_DEVICES},
+    { REGISTER_TEST_CASE(atca_jwt_crypto, verify_batch),                              ATCA_JWT_TEST_DEVICES},
     { REGISTER_TEST_CASE(atca_jwt_crypto, finalize),                                  ATCA_JWT_TEST_DEVICES},
 
     { (fp_test_case)NULL,                 (uint8_t)0 },                               /* Array Termination element*/
@@ -0,0 +1,227 @@
+/**
+ * \file
+ * \brief Cache of reconstructed certificates, so certificates that were built
+ *        from the device data before are returned without rebuilding them.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+
+#include <string.h>
+#include "atcacert_cache.h"
+
+// Marks an entry holding a certificate
+static const uint8_t g_cache_magic[4] = { 'A', 'C', 'R', 'T' };
+
+static atcacert_cache_t* g_cache = NULL;
+
+static uint8_t* cache_entry(atcacert_cache_t* cache, size_t index)
+{
+    return &cache->region[index * cache->entry_size];
+}
+
+static int cache_write(atcacert_cache_t* cache, size_t offset, const uint8_t* data, size_t data_size)
+{
+    if (cache->write != NULL)
+    {
+        return cache->write(cache->write_ctx, offset, data, data_size);
+    }
+    memcpy(&cache->region[offset], data, data_size);
+    return ATCACERT_E_SUCCESS;
+}
+
+static bool cache_entry_is_used(atcacert_cache_t* cache, size_t index)
+{
+    return memcmp(cache_entry(cache, index), g_cache_magic, sizeof(g_cache_magic)) == 0;
+}
+
+static size_t cache_entry_cert_size(atcacert_cache_t* cache, size_t index)
+{
+    const uint8_t* entry = cache_entry(cache, index);
+
+    return (size_t)entry[ATCACERT_CACHE_HEADER_SIZE - 2] | ((size_t)entry[ATCACERT_CACHE_HEADER_SIZE - 1] << 8);
+}
+
+static bool cache_find(atcacert_cache_t* cache, const uint8_t key[ATCACERT_CACHE_KEY_SIZE], size_t* index)
+{
+    size_t i;
+
+    for (i = 0; i < cache->entry_count; i++)
+    {
+        if (cache_entry_is_used(cache, i) && memcmp(&cache_entry(cache, i)[sizeof(g_cache_magic)], key, ATCACERT_CACHE_KEY_SIZE) == 0)
+        {
+            *index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+int atcacert_cache_init(atcacert_cache_t*       cache,
+                        uint8_t*                region,
+                        size_t                  region_size,
+                        size_t                  max_cert_size,
+                        atcacert_cache_write_cb write,
+                        void*                   write_ctx)
+{
+    if (cache == NULL || region == NULL || max_cert_size == 0 || max_cert_size > 0xFFFF)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+    if (region_size < ATCACERT_CACHE_HEADER_SIZE + max_cert_size)
+    {
+        return ATCACERT_E_BUFFER_TOO_SMALL;
+    }
+
+    memset(cache, 0, sizeof(*cache));
+    cache->region = region;
+    cache->entry_size = ATCACERT_CACHE_HEADER_SIZE + max_cert_size;
+    cache->entry_count = region_size / cache->entry_size;
+    cache->write = write;
+    cache->write_ctx = write_ctx;
+
+    return ATCACERT_E_SUCCESS;
+}
+
+void atcacert_set_cache(atcacert_cache_t* cache)
+{
+    g_cache = cache;
+}
+
+atcacert_cache_t* atcacert_get_cache(void)
+{
+    return g_cache;
+}
+
+int atcacert_cache_clear(atcacert_cache_t* cache)
+{
+    static const uint8_t unused[sizeof(g_cache_magic)] = { 0 };
+    int ret;
+    size_t i;
+
+    if (cache == NULL)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+
+    for (i = 0; i < cache->entry_count; i++)
+    {
+        if (cache_entry_is_used(cache, i))
+        {
+            ret = cache_write(cache, i * cache->entry_size, unused, sizeof(unused));
+            if (ret != ATCACERT_E_SUCCESS)
+            {
+                return ret;
+            }
+        }
+    }
+    cache->next = 0;
+
+    return ATCACERT_E_SUCCESS;
+}
+
+bool atcacert_cache_lookup(atcacert_cache_t* cache,
+                           const uint8_t     key[ATCACERT_CACHE_KEY_SIZE],
+                           uint8_t*          cert,
+                           size_t*           cert_size)
+{
+    size_t index;
+    size_t size;
+
+    if (cache == NULL || key == NULL || cert == NULL || cert_size == NULL)
+    {
+        return false;
+    }
+
+    if (!cache_find(cache, key, &index))
+    {
+        cache->misses++;
+        return false;
+    }
+
+    size = cache_entry_cert_size(cache, index);
+    if (size > cache->entry_size - ATCACERT_CACHE_HEADER_SIZE || size > *cert_size)
+    {
+        // Let the certificate build report the small buffer
+        cache->misses++;
+        return false;
+    }
+
+    memcpy(cert, &cache_entry(cache, index)[ATCACERT_CACHE_HEADER_SIZE], size);
+    *cert_size = size;
+    cache->hits++;
+
+    return true;
+}
+
+int atcacert_cache_store(atcacert_cache_t* cache,
+                         const uint8_t     key[ATCACERT_CACHE_KEY_SIZE],
+                         const uint8_t*    cert,
+                         size_t            cert_size)
+{
+    uint8_t header[ATCACERT_CACHE_HEADER_SIZE];
+    size_t index;
+    size_t offset;
+    int ret;
+
+    if (cache == NULL || key == NULL || cert == NULL)
+    {
+        return ATCACERT_E_BAD_PARAMS;
+    }
+    if (cert_size > cache->entry_size - ATCACERT_CACHE_HEADER_SIZE)
+    {
+        return ATCACERT_E_BUFFER_TOO_SMALL;
+    }
+
+    if (!cache_find(cache, key, &index))
+    {
+        for (index = 0; index < cache->entry_count && cache_entry_is_used(cache, index); index++)
+        {
+            ;
+        }
+        if (index == cache->entry_count)
+        {
+            index = cache->next;
+            cache->next = (cache->next + 1) % cache->entry_count;
+        }
+    }
+    offset = index * cache->entry_size;
+
+    // The certificate is written before the header marking the entry as used
+    memset(header, 0, sizeof(g_cache_magic));
+    if ((ret = cache_write(cache, offset, header, sizeof(g_cache_magic))) != ATCACERT_E_SUCCESS)
+    {
+        return ret;
+    }
+    if ((ret = cache_write(cache, offset + ATCACERT_CACHE_HEADER_SIZE, cert, cert_size)) != ATCACERT_E_SUCCESS)
+    {
+        return ret;
+    }
+
+    memcpy(&header[0], g_cache_magic, sizeof(g_cache_magic));
+    memcpy(&header[sizeof(g_cache_magic)], key, ATCACERT_CACHE_KEY_SIZE);
+    header[ATCACERT_CACHE_HEADER_SIZE - 2] = (uint8_t)(cert_size & 0xFF);
+    header[ATCACERT_CACHE_HEADER_SIZE - 1] = (uint8_t)(cert_size >> 8);
+
+    return cache_write(cache, offset, header, sizeof(header));
+}
@@ -48,6 +48,12 @@
 
 #define ATCA_MAX_TRANSFORMS 2
 
+/** \brief Certificates atcacert_get_tbs_digest_batch() hashes per call to the
+ *         multi-buffer SHA256 */
+#ifndef ATCACERT_TBS_DIGEST_CHUNK
+#define ATCACERT_TBS_DIGEST_CHUNK   (32)
+#endif
+
 
 /** \defgroup atcacert_ Certificate manipulation methods (atcacert_)
  *
@@ -666,6 +672,25 @@ int atcacert_get_tbs_digest(const atcacert_def_t * cert_def,
                             size_t                 cert_size,
                             uint8_t                tbs_digest[32]);
 
+/**
+ * \brief Get the SHA256 digests of the TBS data of several certificates built
+ *        from the same certificate definition, hashing them together.
+ *
+ * \param[in]  cert_def     Certificate definition for the certificates.
+ * \param[in]  count        Number of certificates.
+ * \param[in]  certs        Certificates to get the TBS digests for.
+ * \param[in]  cert_sizes   Size of each certificate in bytes.
+ * \param[out] tbs_digests  TBS data digests will be returned here. 32 bytes per certificate.
+ *
+ * \return ATCACERT_E_SUCCESS on success, otherwise an error code from the first certificate
+ *         that failed.
+ */
+int atcacert_get_tbs_digest_batch(const atcacert_def_t * cert_def,
+                                  size_t                 count,
+                                  const uint8_t * const  certs[],
+                                  const size_t           cert_sizes[],
+                                  uint8_t *              tbs_digests);
+
 /**
  * \brief Sets an element in a certificate. The data_size must match the size in cert_loc.
  *
@@ -49,12 +49,11 @@
 ATCA_STATUS calib_aes(ATCADevice device, uint8_t mode, uint16_t key_id, const uint8_t* aes_in, uint8_t* aes_out)
 {
     ATCAPacket packet;
-    ATCACommand ca_cmd = _gDevice->mCommands;
     ATCA_STATUS status = ATCA_GEN_FAIL;
 
     do
     {
-        if (aes_in == NULL)
+        if ((device == NULL) || (aes_in == NULL))
         {
             status = ATCA_BAD_PARAM;
             break;
@@ -72,7 +71,7 @@ ATCA_STATUS calib_aes(ATCADevice device, uint8_t mode, uint16_t key_id, const ui
             memcpy(packet.data, aes_in, AES_DATA_SIZE);
         }
 
-        if ((status = atAES(ca_cmd, &packet)) != ATCA_SUCCESS)
+        if ((status = atAES(device->mCommands, &packet)) != ATCA_SUCCESS)
         {
             break;
         }
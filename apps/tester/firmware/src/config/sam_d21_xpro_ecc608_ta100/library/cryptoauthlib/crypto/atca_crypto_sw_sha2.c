@@ -201,3 +201,38 @@ int atcac_sw_sha2_256(const uint8_t* data, size_t data_size, uint8_t digest[ATCA
 
     return ATCA_SUCCESS;
 }
+
+/** \brief Computes the SHA256 digests of independent messages together. The
+ *         software implementation hashes several messages in lockstep on
+ *         hosts with SIMD support.
+ * \param[in]  count      number of messages
+ * \param[in]  data       messages to hash
+ * \param[in]  data_size  size of each message, in bytes
+ * \param[out] digests    receives count digests, ATCA_SHA2_256_DIGEST_SIZE bytes each
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+
+int atcac_sw_sha2_256_multi(size_t count, const uint8_t* const data[], const size_t data_size[], uint8_t* digests)
+{
+    if (count > 0 && (!data || !data_size || !digests))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+#if ATCA_ENABLE_SHA256_IMPL
+    sw_sha256_multi(count, data, data_size, digests);
+
+    return ATCA_SUCCESS;
+#else
+    {
+        int ret = ATCA_SUCCESS;
+        size_t i;
+
+        for (i = 0; i < count && ret == ATCA_SUCCESS; i++)
+        {
+            ret = atcac_sw_sha2_256(data[i], data_size[i], &digests[i * ATCA_SHA2_256_DIGEST_SIZE]);
+        }
+        return ret;
+    }
+#endif
+}
@@ -40,16 +40,38 @@ static void sercom0_select_pin(uint32_t pin, bool value)
 atca_plib_spi_api_t sercom0_plib_spi_api = {
     .read = SERCOM0_SPI_Read,
     .write = SERCOM0_SPI_Write,
+    .write_read = SERCOM0_SPI_WriteRead,
     .is_busy = SERCOM0_SPI_IsBusy,
-    .select = &sercom0_select_pin
+    .select = &sercom0_select_pin,
+    .callback_register = SERCOM0_SPI_CallbackRegister
 };
 
+/* Drive SDA (SERCOM2 PAD0) low as a GPIO for the ATCA_WAKE_GPIO wake pulse,
+   or hand it back to the SERCOM */
+static void sercom2_sda_drive(bool low)
+{
+    if (low)
+    {
+        PORT_PinClear(PORT_PIN_PA08);
+        PORT_PinOutputEnable(PORT_PIN_PA08);
+        PORT_REGS->GROUP[PORT_PIN_PA08 >> 5].PORT_PINCFG[PORT_PIN_PA08 & 0x1F] &= (uint8_t)~PORT_PINCFG_PMUXEN_Msk;
+    }
+    else
+    {
+        PORT_REGS->GROUP[PORT_PIN_PA08 >> 5].PORT_PINCFG[PORT_PIN_PA08 & 0x1F] |= (uint8_t)PORT_PINCFG_PMUXEN_Msk;
+        PORT_PinInputEnable(PORT_PIN_PA08);
+    }
+}
+
 atca_plib_i2c_api_t sercom2_plib_i2c_api = {
     .read = SERCOM2_I2C_Read,
     .write = SERCOM2_I2C_Write,
+    .write_read = SERCOM2_I2C_WriteRead,
     .is_busy = SERCOM2_I2C_IsBusy,
     .error_get = SERCOM2_I2C_ErrorGet,
-    .transfer_setup = SERCOM2_I2C_TransferSetup
+    .transfer_setup = SERCOM2_I2C_TransferSetup,
+    .callback_register = SERCOM2_I2C_CallbackRegister,
+    .sda_drive = sercom2_sda_drive
 };
 
 
@@ -32,7 +32,7 @@ TEST(atca_cmd_basic_test, challenge)
     ATCA_STATUS status = ATCA_GEN_FAIL;
     uint8_t random_number[32];
 
-    status = atcab_random(random_number);
+    status = atcab_random_ext(_gDevice, random_number);
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
 
     status = atcab_nonce(random_number);
@@ -698,6 +698,101 @@ TEST(atca_cmd_unit_test, random)
     atca_delay_ms(1);
 }
 
+#if !defined(ATCA_NO_POLL) && !defined(ATCA_NO_ADAPTIVE_POLL)
+TEST(atca_cmd_unit_test, poll_learning)
+{
+    ATCA_STATUS status;
+    ATCAPacket packet;
+    ATCACommand ca_cmd = _gDevice->mCommands;
+    calib_poll_entry_t entries[ATCA_POLLING_ADAPT_ENTRIES];
+    size_t count = ATCA_POLLING_ADAPT_ENTRIES;
+    int i;
+
+    status = calib_poll_reset(_gDevice);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // The first random is polled at the default rate, the rest use the learned time
+    for (i = 0; i < 3; i++)
+    {
+        packet.param1 = RANDOM_SEED_UPDATE;
+        packet.param2 = 0x0000;
+        status = atRandom(ca_cmd, &packet);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        status = atca_execute_command(&packet, _gDevice);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    }
+
+    status = calib_poll_export(_gDevice, entries, &count);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, count);
+    TEST_ASSERT_EQUAL(ATCA_RANDOM, entries[0].opcode);
+    TEST_ASSERT_EQUAL(RANDOM_SEED_UPDATE, entries[0].mode);
+    TEST_ASSERT_EQUAL(3, entries[0].samples);
+    TEST_ASSERT(entries[0].avg_us > 0);
+    TEST_ASSERT(entries[0].avg_us < ATCA_POLLING_MAX_TIME_MSEC * 1000);
+}
+
+TEST(atca_cmd_unit_test, poll_table)
+{
+    ATCA_STATUS status;
+    ATCAPacket packet;
+    struct atca_device other;
+    calib_poll_entry_t entries[ATCA_POLLING_ADAPT_ENTRIES];
+    size_t count = ATCA_POLLING_ADAPT_ENTRIES;
+    uint32_t wait_us;
+    uint32_t interval_us;
+    uint8_t i;
+
+    status = calib_poll_reset(_gDevice);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Looking up a command that hasn't completed yet doesn't create an entry
+    memset(&packet, 0, sizeof(packet));
+    packet.opcode = ATCA_INFO;
+    calib_poll_timing(_gDevice, &packet, &wait_us, &interval_us);
+    TEST_ASSERT_EQUAL(ATCA_POLLING_INIT_TIME_MSEC * 1000, wait_us);
+    status = calib_poll_export(_gDevice, entries, &count);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(0, count);
+
+    // Fill the table, then use the first entry again
+    for (i = 0; i < ATCA_POLLING_ADAPT_ENTRIES; i++)
+    {
+        packet.param1 = i;
+        calib_poll_learn(_gDevice, &packet, 1000);
+    }
+    packet.param1 = 0;
+    calib_poll_timing(_gDevice, &packet, &wait_us, &interval_us);
+    TEST_ASSERT_EQUAL(ATCA_POLLING_FINE_TIME_USEC, interval_us);
+
+    // A new command replaces the least recently used entry, mode 1
+    packet.param1 = ATCA_POLLING_ADAPT_ENTRIES;
+    calib_poll_learn(_gDevice, &packet, 1000);
+    count = ATCA_POLLING_ADAPT_ENTRIES;
+    status = calib_poll_export(_gDevice, entries, &count);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(ATCA_POLLING_ADAPT_ENTRIES, count);
+    TEST_ASSERT_EQUAL(0, entries[0].mode);
+    TEST_ASSERT_EQUAL(ATCA_POLLING_ADAPT_ENTRIES, entries[1].mode);
+
+    // Every device learns into its own table
+    memset(&other, 0, sizeof(other));
+    other.mCommands = _gDevice->mCommands;
+    other.mIface = _gDevice->mIface;
+    packet.param1 = 1;
+    calib_poll_learn(&other, &packet, 1000);
+    count = ATCA_POLLING_ADAPT_ENTRIES;
+    status = calib_poll_export(&other, entries, &count);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, count);
+    calib_poll_timing(_gDevice, &packet, &wait_us, &interval_us);
+    TEST_ASSERT_EQUAL(ATCA_POLLING_INIT_TIME_MSEC * 1000, wait_us);
+
+    status = calib_poll_reset(_gDevice);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+}
+#endif
+
 TEST(atca_cmd_unit_test, read)
 {
     ATCA_STATUS status;
@@ -715,6 +810,36 @@ TEST(atca_cmd_unit_test, read)
     TEST_ASSERT_EQUAL(0x07, packet.data[ATCA_COUNT_IDX]);
 }
 
+TEST(atca_cmd_unit_test, response_size)
+{
+    ATCA_STATUS status;
+    ATCAPacket packet;
+    ATCACommand ca_cmd = _gDevice->mCommands;
+
+    // Status only response is received as a fixed size response
+    packet.param1 = NONCE_MODE_PASSTHROUGH;
+    packet.param2 = 0x0000;
+    memset(packet.data, 0x55, 32);
+
+    status = atNonce(ca_cmd, &packet);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(ATCA_RSP_SIZE_MIN, calib_get_response_size(&packet));
+    status = atca_execute_command(&packet, _gDevice);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(ATCA_RSP_SIZE_MIN, packet.data[ATCA_COUNT_IDX]);
+
+    // Variable size response still reads the length first
+    packet.param1 = RANDOM_SEED_UPDATE;
+    packet.param2 = 0x0000;
+
+    status = atRandom(ca_cmd, &packet);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(sizeof(packet.data), calib_get_response_size(&packet));
+    status = atca_execute_command(&packet, _gDevice);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(RANDOM_RSP_SIZE, packet.data[ATCA_COUNT_IDX]);
+}
+
 #ifdef ATCA_ATECC608A_SUPPORT
 extern const uint8_t sboot_dummy_image[];
 
@@ -1138,7 +1263,12 @@ t_test_case_info calib_commands_info[] =
     { REGISTER_TEST_CASE(atca_cmd_unit_test, pause),        DEVICE_MASK(ATSHA204A) | DEVICE_MASK(ATECC108A) | DEVICE_MASK(ATECC508A)                          },
     { REGISTER_TEST_CASE(atca_cmd_unit_test, privwrite),                             DEVICE_MASK(ATECC108A) | DEVICE_MASK(ATECC508A) | DEVICE_MASK(ATECC608A) },
     { REGISTER_TEST_CASE(atca_cmd_unit_test, random),       DEVICE_MASK(ATSHA204A) | DEVICE_MASK(ATECC108A) | DEVICE_MASK(ATECC508A) | DEVICE_MASK(ATECC608A) },
+#if !defined(ATCA_NO_POLL) && !defined(ATCA_NO_ADAPTIVE_POLL)
+    { REGISTER_TEST_CASE(atca_cmd_unit_test, poll_learning), DEVICE_MASK(ATSHA204A) | DEVICE_MASK(ATECC108A) | DEVICE_MASK(ATECC508A) | DEVICE_MASK(ATECC608A) },
+    { REGISTER_TEST_CASE(atca_cmd_unit_test, poll_table), DEVICE_MASK(ATSHA204A) | DEVICE_MASK(ATECC108A) | DEVICE_MASK(ATECC508A) | DEVICE_MASK(ATECC608A) },
+#endif
     { REGISTER_TEST_CASE(atca_cmd_unit_test, read),         DEVICE_MASK(ATSHA204A) | DEVICE_MASK(ATECC108A) | DEVICE_MASK(ATECC508A) | DEVICE_MASK(ATECC608A) },
+    { REGISTER_TEST_CASE(atca_cmd_unit_test, response_size), DEVICE_MASK(ATSHA204A) | DEVICE_MASK(ATECC108A) | DEVICE_MASK(ATECC508A) | DEVICE_MASK(ATECC608A) },
 #ifdef ATCA_ATECC608A_SUPPORT
     { REGISTER_TEST_CASE(atca_cmd_unit_test, sboot),                                                                                   DEVICE_MASK(ATECC608A) },
     { REGISTER_TEST_CASE(atca_cmd_unit_test, selftest),                                                                                DEVICE_MASK(ATECC608A) },
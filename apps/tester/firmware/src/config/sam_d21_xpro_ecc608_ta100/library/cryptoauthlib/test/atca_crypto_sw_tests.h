@@ -44,10 +44,17 @@ void test_atcac_sw_sha2_256_nist3(void);
 void test_atcac_sw_sha2_256_nist_short(void);
 void test_atcac_sw_sha2_256_nist_long(void);
 void test_atcac_sw_sha2_256_nist_monte(void);
+void test_atcac_sw_sha2_256_multi(void);
 
 void test_atcac_aes128_gcm(void);
 void test_atcac_aes128_cmac(void);
 void test_atcac_sha256_hmac(void);
 void test_atcac_sha256_hmac_nist(void);
 
+void test_atcac_drbg_health_test(void);
+void test_atcac_drbg_reseed(void);
+
+void test_atcac_sw_ecdsa_verify_p256(void);
+void test_atcac_sw_ecdsa_verify_p256_batch(void);
+
 #endif
\ No newline at end of file
@@ -29,6 +29,9 @@
 #include "atca_test.h"
 #include "cmd-processor.h"
 #include "atca_crypto_sw_tests.h"
+#ifdef ATCA_HAL_RECORDER
+#include "hal/hal_recorder.h"
+#endif
 
 #ifndef ATCA_SERIAL_NUM_SIZE
 #define ATCA_SERIAL_NUM_SIZE        (9)
@@ -239,6 +242,58 @@ int discover(int argc, char* argv[])
 }
 #endif
 
+#if ATCA_CA_SUPPORT && !defined(ATCA_NO_POLL) && !defined(ATCA_NO_ADAPTIVE_POLL)
+int poll_table(int argc, char* argv[])
+{
+    calib_poll_entry_t entries[ATCA_POLLING_ADAPT_ENTRIES];
+    size_t count = ATCA_POLLING_ADAPT_ENTRIES;
+    size_t i;
+    ATCA_STATUS status;
+
+    status = atcab_poll_export(entries, &count);
+    if (status == ATCA_SUCCESS)
+    {
+        for (i = 0; i < count; i++)
+        {
+            printf("{\"dt\": %u, \"clock_divider\": %u, \"opcode\": \"0x%02X\", \"mode\": \"0x%02X\", \"samples\": %u, \"avg_us\": %lu, \"dev_us\": %lu}\r\n",
+                   entries[i].dt, entries[i].clock_divider, entries[i].opcode, entries[i].mode, entries[i].samples,
+                   (unsigned long)entries[i].avg_us, (unsigned long)entries[i].dev_us);
+        }
+    }
+    return status;
+}
+#endif
+
+#ifdef ATCA_HAL_RECORDER
+int dump_recorder(int argc, char* argv[])
+{
+    uint8_t trace[32];
+    char displaystr[sizeof(trace) * 2 + 1];
+    size_t offset = 0;
+    size_t length;
+    size_t i;
+
+    if (argc > 1 && !strcmp(argv[1], "clear"))
+    {
+        hal_recorder_clear();
+        return ATCA_SUCCESS;
+    }
+
+    printf("-----BEGIN ATCA TRACE-----\r\n");
+    while ((length = hal_recorder_read(offset, trace, sizeof(trace))) > 0)
+    {
+        for (i = 0; i < length; i++)
+        {
+            sprintf(&displaystr[i * 2], "%02X", trace[i]);
+        }
+        printf("%s\r\n", displaystr);
+        offset += length;
+    }
+    printf("-----END ATCA TRACE-----\r\n");
+    return ATCA_SUCCESS;
+}
+#endif
+
 int info(int argc, char* argv[])
 {
     ATCA_STATUS status;
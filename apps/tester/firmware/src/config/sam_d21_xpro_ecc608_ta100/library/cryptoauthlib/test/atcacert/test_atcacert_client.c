@@ -28,6 +28,7 @@
 #ifndef DO_NOT_TEST_CERT
 
 #include "atcacert/atcacert_client.h"
+#include "atcacert/atcacert_cache.h"
 #include "atcacert/atcacert_pem.h"
 #include "third_party/unity/unity.h"
 #include "third_party/unity/unity_fixture.h"
@@ -430,6 +431,124 @@ TEST(atcacert_client, atcacert_read_cert_bad_params)
     TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
 }
 
+static uint8_t g_cert_cache_region[2 * (ATCACERT_CACHE_HEADER_SIZE + 512)];
+static size_t g_cert_cache_writes;
+
+// Stands in for a flash driver writing to a persistent region
+static int cert_cache_write(void* ctx, size_t offset, const uint8_t* data, size_t data_size)
+{
+    memcpy(&((uint8_t*)ctx)[offset], data, data_size);
+    g_cert_cache_writes++;
+    return ATCACERT_E_SUCCESS;
+}
+
+TEST(atcacert_client, atcacert_read_cert_cache)
+{
+    int ret = 0;
+    uint8_t cert[512];
+    size_t cert_size = sizeof(cert);
+    uint8_t comp_cert[72];
+    uint8_t changed[sizeof(comp_cert)];
+    atcacert_cache_t cache;
+    const atcacert_device_loc_t* comp_cert_loc = &g_test_cert_def_0_device.comp_cert_dev_loc;
+    uint16_t genkey_slot = 0;
+
+    memset(g_cert_cache_region, 0, sizeof(g_cert_cache_region));
+    g_cert_cache_writes = 0;
+    ret = atcacert_cache_init(&cache, g_cert_cache_region, sizeof(g_cert_cache_region), 512, cert_cache_write, g_cert_cache_region);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL(2, cache.entry_count);
+    atcacert_set_cache(&cache);
+
+    // Built once, then returned from the cache
+    ret = atcacert_read_cert(&g_test_cert_def_0_device, g_signer_public_key, cert, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL(g_device_cert_ref_size, cert_size);
+    TEST_ASSERT_EQUAL_MEMORY(g_device_cert_ref, cert, cert_size);
+    TEST_ASSERT_NOT_EQUAL(0, g_cert_cache_writes);
+
+    memset(cert, 0, sizeof(cert));
+    cert_size = sizeof(cert);
+#ifdef ATCA_STATS
+    ret = atcab_reset_stats();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+#endif
+    ret = atcacert_read_cert(&g_test_cert_def_0_device, g_signer_public_key, cert, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL(g_device_cert_ref_size, cert_size);
+    TEST_ASSERT_EQUAL_MEMORY(g_device_cert_ref, cert, cert_size);
+    TEST_ASSERT_EQUAL(1, cache.misses);
+    TEST_ASSERT_EQUAL(1, cache.hits);
+#ifdef ATCA_STATS
+    {
+        // A hit reads no more than the serial number
+        atca_stats_t stats;
+        ret = atcab_get_stats(&stats);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+        TEST_ASSERT(stats.opcode_count <= 1);
+        TEST_ASSERT(stats.opcode_count == 0 || (stats.opcodes[0].opcode == ATCA_READ && stats.opcodes[0].count <= 1));
+    }
+#endif
+
+    // A different CA key builds a different certificate
+    cert_size = sizeof(cert);
+    ret = atcacert_read_cert(&g_test_cert_def_0_device, NULL, cert, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL(2, cache.misses);
+
+    // Changing the compressed certificate in the slot directly drops the
+    // cached certificates
+    ret = atcab_read_bytes_zone(comp_cert_loc->zone, comp_cert_loc->slot, comp_cert_loc->offset, comp_cert, sizeof(comp_cert));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+    memcpy(changed, comp_cert, sizeof(changed));
+    changed[40] ^= 0x01;
+    ret = atcab_write_bytes_zone(comp_cert_loc->zone, comp_cert_loc->slot, comp_cert_loc->offset, changed, sizeof(changed));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+
+    cert_size = sizeof(cert);
+    ret = atcacert_read_cert(&g_test_cert_def_0_device, g_signer_public_key, cert, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL(3, cache.misses);
+    TEST_ASSERT(cert_size != g_device_cert_ref_size || memcmp(g_device_cert_ref, cert, cert_size) != 0);
+
+    ret = atcab_write_bytes_zone(comp_cert_loc->zone, comp_cert_loc->slot, comp_cert_loc->offset, comp_cert, sizeof(comp_cert));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+
+    // Writing a certificate drops the cached ones
+    ret = atcacert_write_cert(&g_test_cert_def_0_device, g_device_cert_ref, g_device_cert_ref_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    cert_size = sizeof(cert);
+    ret = atcacert_read_cert(&g_test_cert_def_0_device, g_signer_public_key, cert, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY(g_device_cert_ref, cert, cert_size);
+    TEST_ASSERT_EQUAL(4, cache.misses);
+    TEST_ASSERT_EQUAL(1, cache.hits);
+
+    // The region keeps the entries over a new init, as after a reset
+    ret = atcacert_cache_init(&cache, g_cert_cache_region, sizeof(g_cert_cache_region), 512, cert_cache_write, g_cert_cache_region);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    cert_size = sizeof(cert);
+    ret = atcacert_read_cert(&g_test_cert_def_0_device, g_signer_public_key, cert, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY(g_device_cert_ref, cert, cert_size);
+    TEST_ASSERT_EQUAL(1, cache.hits);
+
+    // So does a new private key, here in a slot the certificate doesn't use
+    ret = atca_test_config_get_id(TEST_TYPE_ECC_GENKEY, &genkey_slot);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+    TEST_ASSERT_NOT_EQUAL(g_test_cert_def_0_device.private_key_slot, genkey_slot);
+    ret = atcab_genkey(genkey_slot, NULL);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+    cert_size = sizeof(cert);
+    ret = atcacert_read_cert(&g_test_cert_def_0_device, g_signer_public_key, cert, &cert_size);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY(g_device_cert_ref, cert, cert_size);
+    TEST_ASSERT_EQUAL(1, cache.hits);
+    TEST_ASSERT_EQUAL(1, cache.misses);
+
+    atcacert_set_cache(NULL);
+}
+
 TEST(atcacert_client, atcacert_get_response)
 {
     int ret = 0;
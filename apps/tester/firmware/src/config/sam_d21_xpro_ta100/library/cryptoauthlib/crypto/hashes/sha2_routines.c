@@ -28,113 +28,259 @@
 #include <string.h>
 #include "sha2_routines.h"
 #include "atca_compiler.h"
-#define rotate_right(value, places) ((value >> places) | (value << (32 - places)))
+
+#if SHA256_SHANI
+#include <immintrin.h>
+#include <cpuid.h>
+#elif SHA256_ARMV8_CE
+#include <arm_neon.h>
+#endif
+
+#define rotate_right(value, places) (((value) >> (places)) | ((value) << (32 - (places))))
+
+#define SHA256_CH(x, y, z)      ((z) ^ ((x) & ((y) ^ (z))))
+#define SHA256_MAJ(x, y, z)     (((x) & (y)) | ((z) & ((x) | (y))))
+#define SHA256_SIGMA0(x)        (rotate_right(x, 2) ^ rotate_right(x, 13) ^ rotate_right(x, 22))
+#define SHA256_SIGMA1(x)        (rotate_right(x, 6) ^ rotate_right(x, 11) ^ rotate_right(x, 25))
+#define SHA256_GAMMA0(x)        (rotate_right(x, 7) ^ rotate_right(x, 18) ^ ((x) >> 3))
+#define SHA256_GAMMA1(x)        (rotate_right(x, 17) ^ rotate_right(x, 19) ^ ((x) >> 10))
+
+/* Message schedule word i (16..63) computed in place in the 16 word window */
+#define SHA256_SCHEDULE(w, i)   ((w)[(i) & 15] += SHA256_GAMMA1((w)[((i) - 2) & 15]) + (w)[((i) - 7) & 15] + SHA256_GAMMA0((w)[((i) - 15) & 15]))
+
+/* One round without rotating the working variables, callers rename them instead. t1 is
+   declared by the caller so the same rounds serve the scalar and the multi-buffer code */
+#define SHA256_ROUND(a, b, c, d, e, f, g, h, i, wi)                                             \
+    do {                                                                                        \
+        t1 = (h) + SHA256_SIGMA1(e) + SHA256_CH(e, f, g) + sha256_k[i] + (wi);                  \
+        (d) += t1;                                                                              \
+        (h) = t1 + SHA256_SIGMA0(a) + SHA256_MAJ(a, b, c);                                      \
+    } while (0)
+
+#define SHA256_ROUNDS_8(w, i, wfn)                                                              \
+    do {                                                                                        \
+        SHA256_ROUND(a, b, c, d, e, f, g, h, (i) + 0, wfn(w, (i) + 0));                         \
+        SHA256_ROUND(h, a, b, c, d, e, f, g, (i) + 1, wfn(w, (i) + 1));                         \
+        SHA256_ROUND(g, h, a, b, c, d, e, f, (i) + 2, wfn(w, (i) + 2));                         \
+        SHA256_ROUND(f, g, h, a, b, c, d, e, (i) + 3, wfn(w, (i) + 3));                         \
+        SHA256_ROUND(e, f, g, h, a, b, c, d, (i) + 4, wfn(w, (i) + 4));                         \
+        SHA256_ROUND(d, e, f, g, h, a, b, c, (i) + 5, wfn(w, (i) + 5));                         \
+        SHA256_ROUND(c, d, e, f, g, h, a, b, (i) + 6, wfn(w, (i) + 6));                         \
+        SHA256_ROUND(b, c, d, e, f, g, h, a, (i) + 7, wfn(w, (i) + 7));                         \
+    } while (0)
+
+#define SHA256_LOADED(w, i)     ((w)[i])
+
+// *INDENT-OFF*
+static const uint32_t sha256_k[] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t sha256_hash_init[] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+// *INDENT-ON*
 
 /**
- * \brief Processes whole blocks (64 bytes) of data.
+ * \brief Processes whole blocks (64 bytes) of data with the portable
+ *        implementation.
  *
- * \param[in] ctx          SHA256 hash context
- * \param[in] blocks       Raw blocks to be processed
- * \param[in] block_count  Number of 64-byte blocks to process
+ * Each block is copied into a 16 word window so the words are read with
+ * aligned loads whatever the alignment of the caller's data. The rest of
+ * the message schedule is computed in that window as the rounds need it and
+ * the rounds are unrolled eight at a time so the working variables never
+ * move between registers.
+ *
+ * \param[in,out] hash         Hash state
+ * \param[in]     blocks       Raw blocks to be processed
+ * \param[in]     block_count  Number of 64-byte blocks to process
  */
-static void sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_t block_count)
+static void sw_sha256_process_generic(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
 {
-    int i = 0;
-    uint32_t block = 0;
+    uint32_t w[16];
+    uint32_t a, b, c, d, e, f, g, h, t1;
+    int i;
 
-    union
+    for (; block_count > 0; block_count--, blocks += SHA256_BLOCK_SIZE)
     {
-        uint32_t w_word[SHA256_BLOCK_SIZE];
-        uint8_t  w_byte[SHA256_BLOCK_SIZE * sizeof(uint32_t)];
-    } w_union;
-
-    static const uint32_t k[] = {
-        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
-        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
-        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
-        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
-        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
-        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
-        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
-        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
-    };
-
-    // Loop through all the blocks to process
-    for (block = 0; block < block_count; block++)
-    {
-        uint32_t w_index;
-        uint32_t word_value;
-        uint32_t s0, s1;
-        uint32_t t1, t2;
-        uint32_t maj, ch;
-        uint32_t rotate_register[8];
-        const uint8_t* cur_msg_block = &blocks[block * SHA256_BLOCK_SIZE];
-
-        // Swap word bytes
-        for (i = 0; i < SHA256_BLOCK_SIZE; i += 4)
+        memcpy(w, blocks, sizeof(w));
+        for (i = 0; i < 16; i++)
         {
-            w_union.w_byte[i + 3] = cur_msg_block[i + 0];
-            w_union.w_byte[i + 2] = cur_msg_block[i + 1];
-            w_union.w_byte[i + 1] = cur_msg_block[i + 2];
-            w_union.w_byte[i + 0] = cur_msg_block[i + 3];
-            w_union.w_word[i / 4] = ATCA_UINT32_HOST_TO_LE(w_union.w_word[i / 4]);
+            w[i] = ATCA_UINT32_BE_TO_HOST(w[i]);
         }
 
+        a = hash[0];
+        b = hash[1];
+        c = hash[2];
+        d = hash[3];
+        e = hash[4];
+        f = hash[5];
+        g = hash[6];
+        h = hash[7];
+
+        SHA256_ROUNDS_8(w, 0, SHA256_LOADED);
+        SHA256_ROUNDS_8(w, 8, SHA256_LOADED);
+        for (i = 16; i < 64; i += 8)
+        {
+            SHA256_ROUNDS_8(w, i, SHA256_SCHEDULE);
+        }
 
-        w_index = 16;
-        while (w_index < SHA256_BLOCK_SIZE)
+        hash[0] += a;
+        hash[1] += b;
+        hash[2] += c;
+        hash[3] += d;
+        hash[4] += e;
+        hash[5] += f;
+        hash[6] += g;
+        hash[7] += h;
+    }
+}
+
+#if SHA256_SHANI
+/** \brief Checks once whether the CPU supports the SHA extensions and the
+ *         SSSE3/SSE4.1 instructions used around them */
+static int sw_sha256_has_shani(void)
+{
+    static int has_shani = -1;
+    unsigned int eax, ebx, ecx, edx;
+
+    if (has_shani < 0)
+    {
+        has_shani = 0;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 9)) && (ecx & (1u << 19)))
         {
-            // right rotate for 32-bit variable in C: (value >> places) | (value << 32 - places)
-            word_value = w_union.w_word[w_index - 15];
-            s0 = rotate_right(word_value, 7) ^ rotate_right(word_value, 18) ^ (word_value >> 3);
+            if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1u << 29)))
+            {
+                has_shani = 1;
+            }
+        }
+    }
+    return has_shani;
+}
+
+/** \brief Processes whole blocks with the x86 SHA extensions */
+__attribute__((target("sha,sse4.1")))
+static void sw_sha256_process_shani(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
+{
+    const __m128i shuf_mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i state0, state1, abef_save, cdgh_save;
+    __m128i msg[4], tmp;
+    int i;
 
-            word_value = w_union.w_word[w_index - 2];
-            s1 = rotate_right(word_value, 17) ^ rotate_right(word_value, 19) ^ (word_value >> 10);
+    /* The instructions work on ABEF and CDGH halves of the state */
+    tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&hash[0]), 0xB1);
+    state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&hash[4]), 0x1B);
+    state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
 
-            w_union.w_word[w_index] = w_union.w_word[w_index - 16] + s0 + w_union.w_word[w_index - 7] + s1;
+    for (; block_count > 0; block_count--, blocks += SHA256_BLOCK_SIZE)
+    {
+        abef_save = state0;
+        cdgh_save = state1;
 
-            w_index++;
+        for (i = 0; i < 4; i++)
+        {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)&blocks[i * 16]), shuf_mask);
         }
 
-        // Initialize hash value for this chunk.
-        for (i = 0; i < 8; i++)
+        for (i = 0; i < 16; i++)
         {
-            rotate_register[i] = ctx->hash[i];
+            tmp = _mm_add_epi32(msg[i & 3], _mm_loadu_si128((const __m128i*)&sha256_k[i * 4]));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, tmp);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(tmp, 0x0E));
+
+            if (i < 12)
+            {
+                /* Words 4 groups ahead replace the group just consumed */
+                tmp = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                tmp = _mm_add_epi32(tmp, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                msg[i & 3] = _mm_sha256msg2_epu32(tmp, msg[(i + 3) & 3]);
+            }
         }
 
-        // hash calculation loop
-        for (i = 0; i < SHA256_BLOCK_SIZE; i++)
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    _mm_storeu_si128((__m128i*)&hash[0], _mm_blend_epi16(tmp, state1, 0xF0));
+    _mm_storeu_si128((__m128i*)&hash[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+#endif
+
+#if SHA256_ARMV8_CE
+/** \brief Processes whole blocks with the ARMv8 cryptography extension */
+static void sw_sha256_process_armv8(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
+{
+    uint32x4_t state0, state1, abcd_save, efgh_save;
+    uint32x4_t msg[4], tmp0, tmp1;
+    int i;
+
+    state0 = vld1q_u32(&hash[0]);
+    state1 = vld1q_u32(&hash[4]);
+
+    for (; block_count > 0; block_count--, blocks += SHA256_BLOCK_SIZE)
+    {
+        abcd_save = state0;
+        efgh_save = state1;
+
+        for (i = 0; i < 4; i++)
         {
-            s0 = rotate_right(rotate_register[0], 2)
-                 ^ rotate_right(rotate_register[0], 13)
-                 ^ rotate_right(rotate_register[0], 22);
-            maj = (rotate_register[0] & rotate_register[1])
-                  ^ (rotate_register[0] & rotate_register[2])
-                  ^ (rotate_register[1] & rotate_register[2]);
-            t2 = s0 + maj;
-            s1 = rotate_right(rotate_register[4], 6)
-                 ^ rotate_right(rotate_register[4], 11)
-                 ^ rotate_right(rotate_register[4], 25);
-            ch = (rotate_register[4] & rotate_register[5])
-                 ^ (~rotate_register[4] & rotate_register[6]);
-            t1 = rotate_register[7] + s1 + ch + k[i] + w_union.w_word[i];
-
-            rotate_register[7] = rotate_register[6];
-            rotate_register[6] = rotate_register[5];
-            rotate_register[5] = rotate_register[4];
-            rotate_register[4] = rotate_register[3] + t1;
-            rotate_register[3] = rotate_register[2];
-            rotate_register[2] = rotate_register[1];
-            rotate_register[1] = rotate_register[0];
-            rotate_register[0] = t1 + t2;
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(&blocks[i * 16])));
         }
 
-        // Add the hash of this block to current result.
-        for (i = 0; i < 8; i++)
+        for (i = 0; i < 16; i++)
         {
-            ctx->hash[i] += rotate_register[i];
+            tmp0 = vaddq_u32(msg[i & 3], vld1q_u32(&sha256_k[i * 4]));
+            tmp1 = state0;
+            state0 = vsha256hq_u32(state0, state1, tmp0);
+            state1 = vsha256h2q_u32(state1, tmp1, tmp0);
+
+            if (i < 12)
+            {
+                msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]),
+                                             msg[(i + 2) & 3], msg[(i + 3) & 3]);
+            }
         }
+
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
     }
+
+    vst1q_u32(&hash[0], state0);
+    vst1q_u32(&hash[4], state1);
+}
+#endif
+
+/**
+ * \brief Processes whole blocks (64 bytes) of data.
+ *
+ * \param[in,out] hash         Hash state
+ * \param[in]     blocks       Raw blocks to be processed
+ * \param[in]     block_count  Number of 64-byte blocks to process
+ */
+static void sw_sha256_process(uint32_t hash[8], const uint8_t* blocks, uint32_t block_count)
+{
+#if SHA256_SHANI
+    if (sw_sha256_has_shani())
+    {
+        sw_sha256_process_shani(hash, blocks, block_count);
+        return;
+    }
+#elif SHA256_ARMV8_CE
+    sw_sha256_process_armv8(hash, blocks, block_count);
+    return;
+#endif
+    sw_sha256_process_generic(hash, blocks, block_count);
 }
 
 /**
@@ -145,17 +291,8 @@ static void sw_sha256_process(sw_sha256_ctx* ctx, const uint8_t* blocks, uint32_
 
 void sw_sha256_init(sw_sha256_ctx* ctx)
 {
-    static const uint32_t hash_init[] = {
-        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
-        0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
-    };
-    int i;
-
     memset(ctx, 0, sizeof(*ctx));
-    for (i = 0; i < 8; i++)
-    {
-        ctx->hash[i] = hash_init[i];
-    }
+    memcpy(ctx->hash, sha256_hash_init, sizeof(ctx->hash));
 }
 
 /**
@@ -172,6 +309,13 @@ void sw_sha256_update(sw_sha256_ctx* ctx, const uint8_t* msg, uint32_t msg_size)
     uint32_t rem_size = SHA256_BLOCK_SIZE - ctx->block_size;
     uint32_t copy_size = msg_size > rem_size ? rem_size : msg_size;
 
+    // Count the message up front, carrying into the upper word of the size
+    ctx->total_msg_size += msg_size;
+    if (ctx->total_msg_size < msg_size)
+    {
+        ctx->total_msg_size_hi++;
+    }
+
     // Copy data into current block
     memcpy(&ctx->block[ctx->block_size], msg, copy_size);
 
@@ -183,15 +327,14 @@ void sw_sha256_update(sw_sha256_ctx* ctx, const uint8_t* msg, uint32_t msg_size)
     }
 
     // Process the current block
-    sw_sha256_process(ctx, ctx->block, 1);
+    sw_sha256_process(ctx->hash, ctx->block, 1);
 
     // Process any additional blocks
     msg_size -= copy_size; // Adjust to the remaining message bytes
     block_count = msg_size / SHA256_BLOCK_SIZE;
-    sw_sha256_process(ctx, &msg[copy_size], block_count);
+    sw_sha256_process(ctx->hash, &msg[copy_size], block_count);
 
     // Save any remaining data
-    ctx->total_msg_size += (block_count + 1) * SHA256_BLOCK_SIZE;
     ctx->block_size = msg_size % SHA256_BLOCK_SIZE;
     memcpy(ctx->block, &msg[copy_size + block_count * SHA256_BLOCK_SIZE], ctx->block_size);
 }
@@ -204,12 +347,13 @@ void sw_sha256_update(sw_sha256_ctx* ctx, const uint8_t* msg, uint32_t msg_size)
 void sw_sha256_final(sw_sha256_ctx* ctx, uint8_t digest[SHA256_DIGEST_SIZE])
 {
     int i, j;
+    uint32_t msg_size_bits_hi;
     uint32_t msg_size_bits;
     uint32_t pad_zero_count;
 
-    // Calculate the total message size in bits
-    ctx->total_msg_size += ctx->block_size;
-    msg_size_bits = ctx->total_msg_size * 8;
+    // Calculate the total message size in bits as a 64 bit value
+    msg_size_bits_hi = (ctx->total_msg_size_hi << 3) | (ctx->total_msg_size >> 29);
+    msg_size_bits = ctx->total_msg_size << 3;
 
     // Calculate the number of padding zero bytes required between the 1 bit byte and the 64 bit message size in bits.
     pad_zero_count = (SHA256_BLOCK_SIZE - ((ctx->block_size + 9) % SHA256_BLOCK_SIZE)) % SHA256_BLOCK_SIZE;
@@ -217,18 +361,21 @@ void sw_sha256_final(sw_sha256_ctx* ctx, uint8_t digest[SHA256_DIGEST_SIZE])
     // Append a single 1 bit
     ctx->block[ctx->block_size++] = 0x80;
 
-    // Add padding zeros plus upper 4 bytes of total msg size in bits (only supporting 32bit message bit counts)
-    memset(&ctx->block[ctx->block_size], 0, pad_zero_count + 4);
-    ctx->block_size += pad_zero_count + 4;
+    // Add padding zeros
+    memset(&ctx->block[ctx->block_size], 0, pad_zero_count);
+    ctx->block_size += pad_zero_count;
 
-    // Add the total message size in bits to the end of the current block. Technically this is
-    // supposed to be 8 bytes. This shortcut will reduce the max message size to 536,870,911 bytes.
+    // Add the total message size in bits to the end of the current block, MSB first
+    ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits_hi >> 24);
+    ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits_hi >> 16);
+    ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits_hi >> 8);
+    ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits_hi >> 0);
     ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits >> 24);
     ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits >> 16);
     ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits >> 8);
     ctx->block[ctx->block_size++] = (uint8_t)(msg_size_bits >> 0);
 
-    sw_sha256_process(ctx, ctx->block, ctx->block_size / SHA256_BLOCK_SIZE);
+    sw_sha256_process(ctx->hash, ctx->block, ctx->block_size / SHA256_BLOCK_SIZE);
 
     // All blocks have been processed.
     // Concatenate the hashes to produce digest, MSB of every hash first.
@@ -254,4 +401,355 @@ void sw_sha256(const uint8_t* message, unsigned int len, uint8_t digest[SHA256_D
     sw_sha256_init(&ctx);
     sw_sha256_update(&ctx, message, len);
     sw_sha256_final(&ctx, digest);
-}
\ No newline at end of file
+}
+
+/** \brief Writes the big endian digest of a hash state */
+static void sw_sha256_digest(const uint32_t hash[8], uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        digest[i * 4 + 0] = (uint8_t)(hash[i] >> 24);
+        digest[i * 4 + 1] = (uint8_t)(hash[i] >> 16);
+        digest[i * 4 + 2] = (uint8_t)(hash[i] >> 8);
+        digest[i * 4 + 3] = (uint8_t)(hash[i] >> 0);
+    }
+}
+
+/**
+ * \brief Builds the padded final block(s) of a message.
+ *
+ * \param[out] tail      Receives the padded blocks, 2 blocks in size
+ * \param[in]  rem       Message bytes after the last full block
+ * \param[in]  rem_size  Number of bytes in rem, less than one block
+ * \param[in]  msg_size  Total message size in bytes
+ *
+ * \return Number of padded blocks, 1 or 2
+ */
+static uint32_t sw_sha256_pad(uint8_t tail[SHA256_BLOCK_SIZE * 2], const uint8_t* rem, size_t rem_size, uint64_t msg_size)
+{
+    uint32_t tail_size = (rem_size + 9 > SHA256_BLOCK_SIZE) ? SHA256_BLOCK_SIZE * 2 : SHA256_BLOCK_SIZE;
+    uint64_t msg_size_bits = msg_size << 3;
+    int i;
+
+    memcpy(tail, rem, rem_size);
+    tail[rem_size] = 0x80;
+    memset(&tail[rem_size + 1], 0, tail_size - rem_size - 1);
+    for (i = 0; i < 8; i++)
+    {
+        tail[tail_size - 1 - i] = (uint8_t)(msg_size_bits >> (8 * i));
+    }
+
+    return tail_size / SHA256_BLOCK_SIZE;
+}
+
+/** \brief Hashes one message of any size with the single buffer code */
+static void sw_sha256_single(const uint8_t* msg, size_t msg_size, uint8_t digest[SHA256_DIGEST_SIZE])
+{
+    uint32_t hash[8];
+    uint8_t tail[SHA256_BLOCK_SIZE * 2];
+    size_t block_count = msg_size / SHA256_BLOCK_SIZE;
+    size_t chunk;
+
+    memcpy(hash, sha256_hash_init, sizeof(hash));
+    for (; block_count > 0; block_count -= chunk, msg += chunk * SHA256_BLOCK_SIZE)
+    {
+        chunk = block_count > 0x1000000 ? 0x1000000 : block_count;
+        sw_sha256_process(hash, msg, (uint32_t)chunk);
+    }
+    sw_sha256_process(hash, tail, sw_sha256_pad(tail, msg, msg_size % SHA256_BLOCK_SIZE, msg_size));
+    sw_sha256_digest(hash, digest);
+}
+
+#if SHA256_MB_SIMD
+
+/* Hash states of the lanes, word i of every lane stored together */
+typedef uint32_t sw_sha256_mb_state[8][SHA256_MB_MAX_LANES];
+
+typedef void (*sw_sha256_mb_fn)(sw_sha256_mb_state state, const uint8_t* const blocks[SHA256_MB_MAX_LANES]);
+
+/**
+ * Defines a kernel that compresses one block of each lane. The rounds are the
+ * scalar ones applied to GCC vector types, one message per vector element,
+ * so the compiler emits SSE2, AVX2, AVX-512 or NEON instructions for them.
+ */
+#define SHA256_MB_KERNEL(attr, name, vec_t, lanes)                                              \
+    attr static void name(sw_sha256_mb_state state, const uint8_t* const blocks[SHA256_MB_MAX_LANES]) \
+    {                                                                                           \
+        vec_t w[16];                                                                            \
+        vec_t a, b, c, d, e, f, g, h, t1;                                                       \
+        uint32_t word;                                                                          \
+        int i, lane;                                                                            \
+                                                                                                \
+        for (i = 0; i < 16; i++)                                                                \
+        {                                                                                       \
+            for (lane = 0; lane < (lanes); lane++)                                              \
+            {                                                                                   \
+                memcpy(&word, &blocks[lane][i * 4], sizeof(word));                              \
+                w[i][lane] = ATCA_UINT32_BE_TO_HOST(word);                                      \
+            }                                                                                   \
+        }                                                                                       \
+        memcpy(&a, state[0], sizeof(a));                                                        \
+        memcpy(&b, state[1], sizeof(b));                                                        \
+        memcpy(&c, state[2], sizeof(c));                                                        \
+        memcpy(&d, state[3], sizeof(d));                                                        \
+        memcpy(&e, state[4], sizeof(e));                                                        \
+        memcpy(&f, state[5], sizeof(f));                                                        \
+        memcpy(&g, state[6], sizeof(g));                                                        \
+        memcpy(&h, state[7], sizeof(h));                                                        \
+        SHA256_ROUNDS_8(w, 0, SHA256_LOADED);                                                   \
+        SHA256_ROUNDS_8(w, 8, SHA256_LOADED);                                                   \
+        for (i = 16; i < 64; i += 8)                                                            \
+        {                                                                                       \
+            SHA256_ROUNDS_8(w, i, SHA256_SCHEDULE);                                             \
+        }                                                                                       \
+        SHA256_MB_ADD(state[0], a, vec_t);                                                      \
+        SHA256_MB_ADD(state[1], b, vec_t);                                                      \
+        SHA256_MB_ADD(state[2], c, vec_t);                                                      \
+        SHA256_MB_ADD(state[3], d, vec_t);                                                      \
+        SHA256_MB_ADD(state[4], e, vec_t);                                                      \
+        SHA256_MB_ADD(state[5], f, vec_t);                                                      \
+        SHA256_MB_ADD(state[6], g, vec_t);                                                      \
+        SHA256_MB_ADD(state[7], h, vec_t);                                                      \
+    }
+
+#define SHA256_MB_ADD(row, v, vec_t)                                                            \
+    do {                                                                                        \
+        vec_t sum;                                                                              \
+        memcpy(&sum, row, sizeof(sum));                                                         \
+        sum += (v);                                                                             \
+        memcpy(row, &sum, sizeof(sum));                                                         \
+    } while (0)
+
+typedef uint32_t sw_sha256_v4 __attribute__((vector_size(16)));
+SHA256_MB_KERNEL(, sw_sha256_mb_x4, sw_sha256_v4, 4)
+
+#if defined(__x86_64__) || defined(__i386__)
+typedef uint32_t sw_sha256_v8 __attribute__((vector_size(32)));
+typedef uint32_t sw_sha256_v16 __attribute__((vector_size(64)));
+SHA256_MB_KERNEL(__attribute__((target("avx2"))), sw_sha256_mb_x8, sw_sha256_v8, 8)
+SHA256_MB_KERNEL(__attribute__((target("avx512f"))), sw_sha256_mb_x16, sw_sha256_v16, 16)
+#endif
+
+/** \brief Picks the widest kernel the CPU runs */
+static uint32_t sw_sha256_mb_select(sw_sha256_mb_fn* kernel)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        *kernel = sw_sha256_mb_x16;
+        return 16;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        *kernel = sw_sha256_mb_x8;
+        return 8;
+    }
+#endif
+    *kernel = sw_sha256_mb_x4;
+    return 4;
+}
+
+/** \brief Next block a lane feeds to the kernel */
+typedef struct
+{
+    const uint8_t* data;                            //!< Next full block of the message
+    size_t         full_blocks;                     //!< Full message blocks left
+    uint32_t       tail_blocks;                     //!< Padded blocks left after them
+    uint8_t        tail[SHA256_BLOCK_SIZE * 2];     //!< Padded final block(s)
+    size_t         job;                             //!< Index of the message in the lane
+} sw_sha256_mb_lane;
+
+/** \brief Starts a message in a lane */
+static void sw_sha256_mb_start(sw_sha256_mb_state state, sw_sha256_mb_lane* lanes, uint32_t lane,
+                               size_t job, const uint8_t* msg, size_t msg_size)
+{
+    sw_sha256_mb_lane* l = &lanes[lane];
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        state[i][lane] = sha256_hash_init[i];
+    }
+    l->data = msg;
+    l->full_blocks = msg_size / SHA256_BLOCK_SIZE;
+    l->tail_blocks = sw_sha256_pad(l->tail, &msg[msg_size - msg_size % SHA256_BLOCK_SIZE],
+                                   msg_size % SHA256_BLOCK_SIZE, msg_size);
+    l->job = job;
+}
+#endif
+
+/**
+ * \brief Number of messages sw_sha256_multi() hashes in lockstep on this
+ *        CPU, 1 when it hashes them one at a time.
+ */
+uint32_t sw_sha256_multi_lanes(void)
+{
+#if SHA256_MB_SIMD
+    sw_sha256_mb_fn kernel;
+
+    return sw_sha256_mb_select(&kernel);
+#else
+    return 1;
+#endif
+}
+
+/**
+ * \brief Hashes independent messages together.
+ *
+ * Each SIMD lane carries one message, the kernel compresses one block of
+ * every lane per call and a lane that finishes its message is refilled with
+ * the next one, so messages of different sizes keep the lanes busy. Without
+ * SIMD support the messages are hashed one after the other.
+ *
+ * \param[in]  count      Number of messages
+ * \param[in]  msgs       Messages to hash
+ * \param[in]  msg_sizes  Size of each message in bytes
+ * \param[out] digests    Receives count digests of SHA256_DIGEST_SIZE bytes
+ */
+void sw_sha256_multi(size_t count, const uint8_t* const msgs[], const size_t msg_sizes[], uint8_t* digests)
+{
+#if SHA256_MB_SIMD
+    sw_sha256_mb_fn kernel;
+    sw_sha256_mb_lane lanes[SHA256_MB_MAX_LANES];
+    sw_sha256_mb_state state;
+    const uint8_t* blocks[SHA256_MB_MAX_LANES];
+    uint32_t lane_count = sw_sha256_mb_select(&kernel);
+    uint32_t active = 0;
+    uint32_t lane;
+    uint32_t i;
+    size_t next = 0;
+
+#if SHA256_SHANI
+    // The SHA extensions hash one message at a time faster than 4 or 8 lanes
+    // do, only the 16 AVX-512 lanes are ahead of them
+    if (lane_count < 16 && sw_sha256_has_shani())
+    {
+        lane_count = 1;
+    }
+#endif
+
+    if (lane_count < 2 || count < 2)
+    {
+        for (next = 0; next < count; next++)
+        {
+            sw_sha256_single(msgs[next], msg_sizes[next], &digests[next * SHA256_DIGEST_SIZE]);
+        }
+        return;
+    }
+
+    for (lane = 0; lane < lane_count && next < count; lane++, next++)
+    {
+        sw_sha256_mb_start(state, lanes, lane, next, msgs[next], msg_sizes[next]);
+        active++;
+    }
+    // Lanes without a message hash a copy of the first lane's block
+    for (; lane < lane_count; lane++)
+    {
+        lanes[lane].full_blocks = 0;
+        lanes[lane].tail_blocks = 0;
+    }
+
+    while (active > 1 || next < count)
+    {
+        for (lane = 0; lane < lane_count; lane++)
+        {
+            sw_sha256_mb_lane* l = &lanes[lane];
+
+            if (l->full_blocks > 0)
+            {
+                blocks[lane] = l->data;
+            }
+            else if (l->tail_blocks > 0)
+            {
+                blocks[lane] = l->tail;
+            }
+            else
+            {
+                blocks[lane] = NULL;
+            }
+        }
+        for (lane = 0; lane < lane_count; lane++)
+        {
+            if (blocks[lane] == NULL)
+            {
+                blocks[lane] = blocks[0] ? blocks[0] : lanes[0].tail;
+            }
+        }
+
+        kernel(state, blocks);
+
+        for (lane = 0; lane < lane_count; lane++)
+        {
+            sw_sha256_mb_lane* l = &lanes[lane];
+            uint32_t hash[8];
+
+            if (l->full_blocks > 0)
+            {
+                l->full_blocks--;
+                l->data += SHA256_BLOCK_SIZE;
+                continue;
+            }
+            if (l->tail_blocks == 0)
+            {
+                continue;
+            }
+            if (--l->tail_blocks > 0)
+            {
+                memmove(l->tail, &l->tail[SHA256_BLOCK_SIZE], SHA256_BLOCK_SIZE);
+                continue;
+            }
+
+            // Lane finished its message
+            for (i = 0; i < 8; i++)
+            {
+                hash[i] = state[i][lane];
+            }
+            sw_sha256_digest(hash, &digests[l->job * SHA256_DIGEST_SIZE]);
+            if (next < count)
+            {
+                sw_sha256_mb_start(state, lanes, lane, next, msgs[next], msg_sizes[next]);
+                next++;
+            }
+            else
+            {
+                active--;
+            }
+        }
+    }
+
+    // The last message finishes faster on its own
+    for (lane = 0; lane < lane_count && active > 0; lane++)
+    {
+        sw_sha256_mb_lane* l = &lanes[lane];
+        uint32_t hash[8];
+
+        if (l->full_blocks > 0 || l->tail_blocks > 0)
+        {
+            for (i = 0; i < 8; i++)
+            {
+                hash[i] = state[i][lane];
+            }
+            while (l->full_blocks > 0)
+            {
+                uint32_t chunk = l->full_blocks > 0x1000000 ? 0x1000000 : (uint32_t)l->full_blocks;
+                sw_sha256_process(hash, l->data, chunk);
+                l->data += (size_t)chunk * SHA256_BLOCK_SIZE;
+                l->full_blocks -= chunk;
+            }
+            sw_sha256_process(hash, l->tail, l->tail_blocks);
+            sw_sha256_digest(hash, &digests[l->job * SHA256_DIGEST_SIZE]);
+            active--;
+        }
+    }
+#else
+    size_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        sw_sha256_single(msgs[i], msg_sizes[i], &digests[i * SHA256_DIGEST_SIZE]);
+    }
+#endif
+}
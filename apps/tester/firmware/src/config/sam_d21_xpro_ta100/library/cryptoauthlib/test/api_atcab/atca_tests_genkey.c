@@ -75,11 +75,63 @@ TEST(atca_cmd_basic_test, get_pubkey)
     TEST_ASSERT_NOT_EQUAL(0, memcmp(public_key, frag, 4));
 }
 
+#if defined(ATCA_DATA_CACHE) && ATCA_CA_SUPPORT
+TEST(atca_cmd_basic_test, get_pubkey_cache)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint8_t public_key[ATCA_PUB_KEY_SIZE];
+    uint8_t cached_key[ATCA_PUB_KEY_SIZE];
+    uint32_t hits, misses;
+    uint32_t start_hits, start_misses;
+    uint16_t private_key_id;
+
+    test_assert_config_is_locked();
+
+    status = atca_test_config_get_id(TEST_TYPE_ECC_GENKEY, &private_key_id);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_data_cache_policy(0, (uint16_t)(1u << private_key_id));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_data_cache_stats(&start_hits, &start_misses);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Computed once, then served from the cache
+    status = atcab_get_pubkey(private_key_id, public_key);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_get_pubkey(private_key_id, cached_key);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(public_key, cached_key, sizeof(public_key));
+
+    status = atcab_data_cache_stats(&hits, &misses);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(start_misses + 1, misses);
+    TEST_ASSERT_EQUAL(start_hits + 1, hits);
+
+    // A new private key replaces the cached public key
+    status = atcab_genkey(private_key_id, public_key);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_get_pubkey(private_key_id, cached_key);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(public_key, cached_key, sizeof(public_key));
+
+    status = atcab_data_cache_policy(0, 0);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Computed by the device again, it must match the cached one
+    status = atcab_get_pubkey(private_key_id, cached_key);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(public_key, cached_key, sizeof(public_key));
+}
+#endif
+
 // *INDENT-OFF* - Preserve formatting
 t_test_case_info genkey_basic_test_info[] =
 {
     { REGISTER_TEST_CASE(atca_cmd_basic_test, genkey),     DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
     { REGISTER_TEST_CASE(atca_cmd_basic_test, get_pubkey), DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
+#if defined(ATCA_DATA_CACHE) && ATCA_CA_SUPPORT
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, get_pubkey_cache), DEVICE_MASK_ECC },
+#endif
     { (fp_test_case)NULL,                     (uint8_t)0 },/* Array Termination element*/
 };
 // *INDENT-ON*
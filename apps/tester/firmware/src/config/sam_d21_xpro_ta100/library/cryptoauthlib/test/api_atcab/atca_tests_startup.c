@@ -70,6 +70,7 @@ TEST(atca_cmd_basic_test, init)
 TEST(atca_cmd_basic_test, doubleinit)
 {
     uint8_t rev[4];
+    uint32_t generation;
     ATCA_STATUS status = ATCA_GEN_FAIL;
 
     TEST_ASSERT_NOT_EQUAL(NULL, _gDevice);
@@ -79,22 +80,62 @@ TEST(atca_cmd_basic_test, doubleinit)
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
 
     // a double init should be benign
+    generation = atcab_get_device_generation();
     status = atcab_init(gCfg);
 
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
     TEST_ASSERT_NOT_EQUAL(NULL, _gDevice);
 
+    // but tells per device caches that the context was set up again
+    TEST_ASSERT_NOT_EQUAL(generation, atcab_get_device_generation());
+
     // Make sure communication still works
     status = atcab_info(rev);
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
 }
 
+TEST(atca_cmd_basic_test, multi_init)
+{
+    ATCADevice device = NULL;
+    uint8_t rev[4];
+    uint8_t sn_global[ATCA_SERIAL_NUM_SIZE];
+    uint8_t sn_ext[ATCA_SERIAL_NUM_SIZE];
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+
+    TEST_ASSERT_NOT_EQUAL(NULL, _gDevice);
+
+    // A second context on the same interface runs alongside the global one
+    status = atcab_init_ext(&device, gCfg);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_NOT_EQUAL(NULL, device);
+    TEST_ASSERT_NOT_EQUAL(_gDevice, device);
+
+    status = atcab_info_ext(device, rev);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_read_serial_number_ext(device, sn_ext);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_read_serial_number(sn_global);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(sn_global, sn_ext, sizeof(sn_ext));
+
+    status = atcab_release_ext(&device);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(NULL, device);
+
+    // Releasing the second context leaves the global one intact
+    status = atcab_info(rev);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+}
+
 // *INDENT-OFF* - Preserve formatting
 t_test_case_info startup_basic_test_info[] =
 {
     { REGISTER_TEST_CASE(atca_cmd_basic_test, version),    DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
     { REGISTER_TEST_CASE(atca_cmd_basic_test, init),       DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
     { REGISTER_TEST_CASE(atca_cmd_basic_test, doubleinit), DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, multi_init), DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
     { (fp_test_case)NULL,                     (uint8_t)0 },/* Array Termination element*/
 };
 
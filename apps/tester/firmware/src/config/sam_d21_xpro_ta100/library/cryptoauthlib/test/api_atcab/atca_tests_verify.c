@@ -26,6 +26,7 @@
  */
 #include <stdlib.h>
 #include "atca_test.h"
+#include "crypto/atca_crypto_sw_ecdsa.h"
 
 TEST(atca_cmd_basic_test, verify_extern)
 {
@@ -61,6 +62,83 @@ TEST(atca_cmd_basic_test, verify_extern)
     TEST_ASSERT(!is_verified);
 }
 
+TEST(atca_cmd_basic_test, verify_extern_sw)
+{
+    ATCA_STATUS status;
+    uint8_t message[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signature[ATCA_ECCP256_SIG_SIZE];
+    uint8_t pubkey[ATCA_ECCP256_PUBKEY_SIZE];
+    uint16_t private_key_id;
+
+    test_assert_data_is_locked();
+
+    status = atca_test_config_get_id(TEST_TYPE_ECC_SIGN, &private_key_id);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_get_pubkey(private_key_id, pubkey);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_random(message);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_sign(private_key_id, message, signature);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Signature made by the device verifies in software
+    status = atcac_sw_ecdsa_verify_p256(message, signature, pubkey);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Verify with bad message, should fail
+    message[0]++;
+    status = atcac_sw_ecdsa_verify_p256(message, signature, pubkey);
+    TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, status);
+}
+
+TEST(atca_cmd_basic_test, verify_extern_batch)
+{
+    ATCA_STATUS status;
+    uint8_t messages[4][ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signatures[4][ATCA_ECCP256_SIG_SIZE];
+    uint8_t pubkeys[4][ATCA_ECCP256_PUBKEY_SIZE];
+    bool is_verified[4];
+    bool is_verified_sw[4];
+    uint16_t private_key_id;
+    int i;
+
+    test_assert_data_is_locked();
+
+    status = atca_test_config_get_id(TEST_TYPE_ECC_SIGN, &private_key_id);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    for (i = 0; i < 4; i++)
+    {
+        status = atcab_get_pubkey(private_key_id, pubkeys[i]);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+        status = atcab_random(messages[i]);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+        status = atcab_sign(private_key_id, messages[i], signatures[i]);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    }
+
+    // Second and last message don't match their signatures
+    messages[1][0]++;
+    messages[3][31]++;
+
+    status = atcab_verify_extern_batch(4, &messages[0][0], &signatures[0][0], &pubkeys[0][0], is_verified);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcac_sw_ecdsa_verify_p256_batch(4, &messages[0][0], &signatures[0][0], &pubkeys[0][0], is_verified_sw);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    for (i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_EQUAL((i & 1) == 0, is_verified[i]);
+        TEST_ASSERT_EQUAL(is_verified[i], is_verified_sw[i]);
+    }
+}
+
 #ifdef ATCA_ATECC608A_SUPPORT
 TEST(atca_cmd_basic_test, verify_extern_mac)
 {
@@ -496,6 +574,8 @@ TEST(atca_cmd_basic_test, verify_invalidate)
 t_test_case_info verify_basic_test_info[] =
 {
     { REGISTER_TEST_CASE(atca_cmd_basic_test, verify_extern),     DEVICE_MASK_ECC        | DEVICE_MASK(TA100)     },
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, verify_extern_sw),  DEVICE_MASK_ECC        | DEVICE_MASK(TA100)     },
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, verify_extern_batch), DEVICE_MASK_ECC      | DEVICE_MASK(TA100)     },
 #ifdef ATCA_ATECC608A_SUPPORT
     { REGISTER_TEST_CASE(atca_cmd_basic_test, verify_extern_mac), DEVICE_MASK(ATECC608A)                          },
 #endif
@@ -104,6 +104,7 @@ extern t_test_case_info kdf_basic_test_info[];
 extern t_test_case_info selftest_basic_test_info[];
 extern t_test_case_info gendig_basic_test_info[];
 extern t_test_case_info random_basic_test_info[];
+extern t_test_case_info session_basic_test_info[];
 extern t_test_case_info nonce_basic_test_info[];
 extern t_test_case_info pause_basic_test_info[];
 extern t_test_case_info updateextra_basic_test_info[];
@@ -206,6 +207,9 @@ int lock_data(int argc, char* argv[]);
 int info(int argc, char* argv[]);
 int read_sernum(int argc, char* argv[]);
 int discover(int argc, char* argv[]);
+int run_benchmarks(int argc, char* argv[]);
+int poll_table(int argc, char* argv[]);
+int dump_recorder(int argc, char* argv[]);
 
 int run_basic_tests(int argc, char* argv[]);
 int run_unit_tests(int argc, char* argv[]);
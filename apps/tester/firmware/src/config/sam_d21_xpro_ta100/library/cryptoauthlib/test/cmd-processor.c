@@ -87,6 +87,13 @@ static t_menu_info mas_menu_info[] =
     { "rand",     "Generate Some Random Numbers",                   do_randoms                           },
     { "readcfg",  "Read the Config Zone",                           (fp_menu_handler)read_config         },
     { "lockstat", "Zone Lock Status",                               lock_status                          },
+    { "bench",    "Run Benchmarks: bench [opts] [case|all] [iter]",  run_benchmarks                       },
+#if ATCA_CA_SUPPORT && !defined(ATCA_NO_POLL) && !defined(ATCA_NO_ADAPTIVE_POLL)
+    { "polltab",  "Print Learned Command Execution Times",          poll_table                           },
+#endif
+#ifdef ATCA_HAL_RECORDER
+    { "recdump",  "Dump Recorded HAL Trace: recdump [clear]",       dump_recorder                        },
+#endif
 #ifdef ATCA_TEST_LOCK_ENABLE
     { "lockcfg",  "Lock the Config Zone",                           (fp_menu_handler)lock_config         },
     { "lockdata", "Lock Data and OTP Zones",                        (fp_menu_handler)lock_data           },
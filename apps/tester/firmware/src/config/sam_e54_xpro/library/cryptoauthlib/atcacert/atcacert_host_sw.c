@@ -62,6 +62,10 @@ int atcacert_verify_cert_sw(const atcacert_def_t* cert_def,
     }
 
     ret = atcac_sw_ecdsa_verify_p256(tbs_digest, signature, ca_public_key);
+    if (ret == ATCA_CHECKMAC_VERIFY_FAILED)
+    {
+        return ATCACERT_E_VERIFY_FAILED;
+    }
     if (ret != ATCACERT_E_SUCCESS)
     {
         return ret;
@@ -88,10 +92,18 @@ int atcacert_verify_response_sw(const uint8_t device_public_key[64],
                                 const uint8_t challenge[32],
                                 const uint8_t response[64])
 {
+    int ret;
+
     if (device_public_key == NULL || challenge == NULL || response == NULL)
     {
         return ATCACERT_E_BAD_PARAMS;
     }
 
-    return atcac_sw_ecdsa_verify_p256(challenge, response, device_public_key);
+    ret = atcac_sw_ecdsa_verify_p256(challenge, response, device_public_key);
+    if (ret == ATCA_CHECKMAC_VERIFY_FAILED)
+    {
+        return ATCACERT_E_VERIFY_FAILED;
+    }
+
+    return ret;
 }
\ No newline at end of file
@@ -40,12 +40,20 @@
  */
 ATCA_STATUS calib_wakeup(ATCADevice device)
 {
+    ATCA_STATUS status;
+
     if (device == NULL)
     {
         return ATCA_GEN_FAIL;
     }
 
-    return atwake(device->mIface);
+    if ((status = atwake(device->mIface)) == ATCA_SUCCESS && calib_wake_shared(device))
+    {
+        device->wake_active = 1;
+        device->wake_timestamp_us = hal_timestamp_us();
+    }
+
+    return status;
 }
 
 /** \brief idle the CryptoAuth device
@@ -59,6 +67,7 @@ ATCA_STATUS calib_idle(ATCADevice device)
         return ATCA_GEN_FAIL;
     }
 
+    device->wake_active = 0;
     return atidle(device->mIface);
 }
 
@@ -73,9 +82,68 @@ ATCA_STATUS calib_sleep(ATCADevice device)
         return ATCA_GEN_FAIL;
     }
 
+    device->wake_active = 0;
     return atsleep(device->mIface);
 }
 
+/** \brief Begin a wake session. While at least one session is open commands
+ *         share a single wake instead of waking and idling the device around
+ *         every command, which also preserves TempKey between them. The
+ *         device is woken by the first command and idled again by
+ *         calib_session_end() or when the watchdog budget is about to run
+ *         out. Sessions may be nested.
+ *  \param[in] device     Device context pointer
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_session_begin(ATCADevice device)
+{
+    if (device == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (device->wake_depth == UINT8_MAX)
+    {
+        return ATCA_INVALID_SIZE;
+    }
+
+    if (!calib_wake_shared(device))
+    {
+        device->wake_active = 0;
+    }
+    device->wake_depth++;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief End a wake session started by calib_session_begin(). Closing the
+ *         outermost session idles the device.
+ *  \param[in] device     Device context pointer
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_session_end(ATCADevice device)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+
+    if (device == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (device->wake_depth == 0)
+    {
+        return ATCA_FUNC_FAIL;
+    }
+
+    if (--device->wake_depth == 0 && device->wake_active && !calib_wake_shared(device))
+    {
+        device->wake_active = 0;
+        status = atidle(device->mIface);
+    }
+
+    return status;
+}
+
 /** \brief auto discovery of crypto auth devices
  *
  * Calls interface discovery functions and fills in cfg_array up to the maximum
@@ -254,7 +322,7 @@ ATCA_STATUS calib_get_zone_size(ATCADevice device, uint8_t zone, uint16_t slot,
         default: status = ATCA_BAD_PARAM; break;
         }
     }
-    else if (_gDevice->mIface->mIfaceCFG->devtype == ATSHA206A)
+    else if (device->mIface->mIfaceCFG->devtype == ATSHA206A)
     {
         switch (zone)
         {
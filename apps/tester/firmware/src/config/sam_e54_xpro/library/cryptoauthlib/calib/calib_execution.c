@@ -8,6 +8,17 @@
  * however, by defining the ATCA_NO_POLL symbol the code will instead wait an
  * estimated max execution time before requesting the result.
  *
+ * When polling, the completion time of every command is learned per device,
+ * clock divider, opcode and mode. Once a command has been seen the
+ * initial wait is set to just below its expected completion time and polling
+ * continues at ATCA_POLLING_FINE_TIME_USEC intervals, which cuts both the
+ * oversleep and the number of polls. Define ATCA_NO_ADAPTIVE_POLL to use the
+ * fixed polling intervals only.
+ *
+ * Every command is normally framed by a wake and an idle. While a wake session
+ * is open (calib_session_begin) the device is kept awake between commands and
+ * is only idled when the session ends or the watchdog budget runs out.
+ *
  * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
  *
  * \page License
@@ -41,7 +52,6 @@
 #include "atca_devtypes.h"
 #include "hal/atca_hal.h"
 
-#ifdef ATCA_NO_POLL
 // *INDENT-OFF* - Preserve time formatting from the code formatter
 /*Execution times for ATSHA204A supported commands...*/
 static const device_execution_time_t device_execution_time_204[] = {
@@ -195,9 +205,7 @@ static const device_execution_time_t device_execution_time_608_m2[] = {
     { ATCA_WRITE,        45}
 };
 // *INDENT-ON*
-#endif
 
-#ifdef ATCA_NO_POLL
 /** \brief return the typical execution time for the given command
  *  \param[in] opcode  Opcode value of the command
  *  \param[in] ca_cmd  Command object for which the execution times are associated
@@ -275,8 +283,314 @@ ATCA_STATUS calib_get_execution_time(uint8_t opcode, ATCACommand ca_cmd)
 
     return status;
 }
+
+#if !defined(ATCA_NO_POLL) && !defined(ATCA_NO_ADAPTIVE_POLL)
+/** \brief Find the learned execution time entry of a command in the table of
+ *         the device and mark it as used.
+ *  \param[in] device  Device the command runs on
+ *  \param[in] packet  Command packet
+ *  \return Entry for the command or NULL when the command hasn't been learned
+ */
+static calib_poll_entry_t* calib_poll_find(ATCADevice device, const ATCAPacket* packet)
+{
+    atca_poll_table_t* table = &device->poll_table;
+    ATCACommand ca_cmd = device->mCommands;
+    calib_poll_entry_t* entry;
+    uint8_t i;
+
+    for (i = 0; i < table->count; i++)
+    {
+        entry = &table->entries[i];
+        if (entry->opcode == packet->opcode && entry->mode == packet->param1
+            && entry->dt == (uint8_t)ca_cmd->dt && entry->clock_divider == ca_cmd->clock_divider)
+        {
+            entry->used = ++table->clock;
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/** \brief Create the learned execution time entry of a command. Once the
+ *         table is full the least recently used entry is reused.
+ *  \param[in] device  Device the command runs on
+ *  \param[in] packet  Command packet
+ *  \return New, empty entry for the command
+ */
+static calib_poll_entry_t* calib_poll_insert(ATCADevice device, const ATCAPacket* packet)
+{
+    atca_poll_table_t* table = &device->poll_table;
+    ATCACommand ca_cmd = device->mCommands;
+    calib_poll_entry_t* entry;
+    uint8_t i;
+
+    if (table->count < ATCA_POLLING_ADAPT_ENTRIES)
+    {
+        entry = &table->entries[table->count++];
+    }
+    else
+    {
+        entry = &table->entries[0];
+        for (i = 1; i < ATCA_POLLING_ADAPT_ENTRIES; i++)
+        {
+            if ((int32_t)(table->entries[i].used - entry->used) < 0)
+            {
+                entry = &table->entries[i];
+            }
+        }
+    }
+
+    entry->dt = (uint8_t)ca_cmd->dt;
+    entry->clock_divider = ca_cmd->clock_divider;
+    entry->opcode = packet->opcode;
+    entry->mode = packet->param1;
+    entry->samples = 0;
+    entry->used = ++table->clock;
+    entry->avg_us = 0;
+    entry->dev_us = 0;
+
+    return entry;
+}
+
+/** \brief Add an observed completion time to a learned entry. The average
+ *         and deviation are exponentially weighted (1/8 and 1/4).
+ *  \param[in] entry        Entry to update
+ *  \param[in] complete_us  Time from the end of the send until the response
+ *                          was received
+ */
+static void calib_poll_update(calib_poll_entry_t* entry, uint32_t complete_us)
+{
+    uint32_t diff;
+
+    if (entry->samples == 0)
+    {
+        entry->avg_us = complete_us;
+        entry->dev_us = complete_us / 8;
+    }
+    else
+    {
+        diff = (complete_us > entry->avg_us) ? (complete_us - entry->avg_us) : (entry->avg_us - complete_us);
+        entry->avg_us = entry->avg_us - (entry->avg_us / 8) + (complete_us / 8);
+        entry->dev_us = entry->dev_us - (entry->dev_us / 4) + (diff / 4);
+    }
+
+    if (entry->samples < UINT16_MAX)
+    {
+        entry->samples++;
+    }
+}
+
+/** \brief Time to wait after sending a command before the first poll: the
+ *         learned average less twice the deviation, but at least half of it
+ *  \param[in] entry  Learned entry of the command
+ *  \return Initial wait in us
+ */
+static uint32_t calib_poll_initial_wait(const calib_poll_entry_t* entry)
+{
+    uint32_t margin = 2 * entry->dev_us;
+
+    if (margin > entry->avg_us / 2)
+    {
+        margin = entry->avg_us / 2;
+    }
+    return entry->avg_us - margin;
+}
+
+/** \brief Copy the learned execution time table of a device out for
+ *         inspection.
+ *  \param[in]    device   Device whose table is copied
+ *  \param[out]   entries  Buffer receiving the entries
+ *  \param[in,out] count    As input the number of entries the buffer holds.
+ *                          As output the number of entries copied.
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_poll_export(ATCADevice device, calib_poll_entry_t* entries, size_t* count)
+{
+    size_t n;
+
+    if (device == NULL || entries == NULL || count == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    n = (*count < device->poll_table.count) ? *count : device->poll_table.count;
+    memcpy(entries, device->poll_table.entries, n * sizeof(calib_poll_entry_t));
+    *count = n;
+
+    return ATCA_SUCCESS;
+}
+
+/** \brief Forget all learned execution times of a device
+ *  \param[in] device  Device whose table is cleared
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_poll_reset(ATCADevice device)
+{
+    if (device == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    memset(&device->poll_table, 0, sizeof(device->poll_table));
+
+    return ATCA_SUCCESS;
+}
 #endif
 
+#ifndef ATCA_NO_POLL
+/** \brief Get the wait before the first poll and the polling interval for a
+ *         command. Commands with a learned execution time are polled finely
+ *         from just before their expected completion, all others use the
+ *         ATCA_POLLING_INIT_TIME_MSEC and ATCA_POLLING_FREQUENCY_TIME_MSEC
+ *         defaults.
+ *  \param[in]  device       Device the command runs on
+ *  \param[in]  packet       Command packet
+ *  \param[out] wait_us      Wait before the first poll in us
+ *  \param[out] interval_us  Polling interval in us
+ */
+void calib_poll_timing(ATCADevice device, const ATCAPacket* packet, uint32_t* wait_us, uint32_t* interval_us)
+{
+#ifndef ATCA_NO_ADAPTIVE_POLL
+    calib_poll_entry_t* entry = calib_poll_find(device, packet);
+
+    if (entry)
+    {
+        *wait_us = calib_poll_initial_wait(entry);
+        if (*wait_us > ATCA_POLLING_MAX_TIME_MSEC * 1000)
+        {
+            *wait_us = ATCA_POLLING_MAX_TIME_MSEC * 1000;
+        }
+        *interval_us = ATCA_POLLING_FINE_TIME_USEC;
+        return;
+    }
+#else
+    (void)device;
+    (void)packet;
+#endif
+    *wait_us = ATCA_POLLING_INIT_TIME_MSEC * 1000;
+    *interval_us = ATCA_POLLING_FREQUENCY_TIME_MSEC * 1000;
+}
+
+/** \brief Record the observed completion time of a successfully executed
+ *         command for the adaptive polling scheduler.
+ *  \param[in] device       Device the command runs on
+ *  \param[in] packet       Command packet
+ *  \param[in] complete_us  Time from the end of the send until the response
+ *                          was received
+ */
+void calib_poll_learn(ATCADevice device, const ATCAPacket* packet, uint32_t complete_us)
+{
+#ifndef ATCA_NO_ADAPTIVE_POLL
+    calib_poll_entry_t* entry = calib_poll_find(device, packet);
+
+    if (entry == NULL)
+    {
+        entry = calib_poll_insert(device, packet);
+    }
+    calib_poll_update(entry, complete_us);
+#else
+    (void)device;
+    (void)packet;
+    (void)complete_us;
+#endif
+}
+#endif
+
+/** \brief Delay for a time given in us. Whole milliseconds are handed to
+ *         atca_delay_ms() so long waits don't overflow the us delay. The
+ *         delay is counted as wait time of the interface.
+ */
+static void calib_delay_us(ATCAIface iface, uint32_t delay_us)
+{
+    ATCA_STATS_ADD(iface, wait_us, delay_us);
+
+    if (delay_us >= 1000)
+    {
+        atca_delay_ms(delay_us / 1000);
+    }
+    if (delay_us % 1000)
+    {
+        atca_delay_us(delay_us % 1000);
+    }
+}
+
+/** \brief Wakes the device ahead of a command. Inside a wake session, or
+ *         between the commands of an asynchronous operation, the wake is
+ *         skipped while the device is already awake and the command is
+ *         expected to complete within the watchdog budget. Otherwise the
+ *         device is idled first, which restarts the watchdog on the next wake
+ *         while preserving TempKey.
+ *
+ * \param[in] device       Device to wake
+ * \param[in] expected_ms  Expected execution time of the next command
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS calib_wake_for_command(ATCADevice device, uint32_t expected_ms)
+{
+    ATCA_STATUS status;
+    uint32_t budget_ms = device->wake_budget_msec ? device->wake_budget_msec : ATCA_WATCHDOG_BUDGET_MSEC;
+    uint32_t elapsed_ms;
+
+    if (device->wake_active)
+    {
+        elapsed_ms = (hal_timestamp_us() - device->wake_timestamp_us) / 1000;
+        if (elapsed_ms + expected_ms < budget_ms)
+        {
+            return ATCA_SUCCESS;
+        }
+        // Watchdog deadline is near
+        device->wake_active = 0;
+        (void)atidle(device->mIface);
+    }
+
+    if ((status = atwake(device->mIface)) == ATCA_SUCCESS && calib_wake_shared(device))
+    {
+        device->wake_active = 1;
+        device->wake_timestamp_us = hal_timestamp_us();
+    }
+
+    return status;
+}
+
+/** \brief Size of the buffer to receive the response of a command into.
+ *         Commands that only return a status are received as a fixed size
+ *         response, which the HAL can read in a single transaction.
+ * \param[in] packet  Command packet that was sent
+ * \return number of bytes to request from atreceive()
+ */
+uint16_t calib_get_response_size(const ATCAPacket* packet)
+{
+    switch (packet->opcode)
+    {
+    case ATCA_CHECKMAC:
+    case ATCA_DERIVE_KEY:
+    case ATCA_GENDIG:
+    case ATCA_LOCK:
+    case ATCA_PAUSE:
+    case ATCA_PRIVWRITE:
+    case ATCA_UPDATE_EXTRA:
+    case ATCA_WRITE:
+        return ATCA_RSP_SIZE_MIN;
+    case ATCA_NONCE:
+        if ((packet->param1 & NONCE_MODE_MASK) == NONCE_MODE_PASSTHROUGH)
+        {
+            return ATCA_RSP_SIZE_MIN;
+        }
+        break;
+    case ATCA_VERIFY:
+        if (!(packet->param1 & VERIFY_MODE_MAC_FLAG))
+        {
+            return ATCA_RSP_SIZE_MIN;
+        }
+        break;
+    default:
+        break;
+    }
+    return sizeof(packet->data);
+}
+
 /** \brief Wakes up device, sends the packet, waits for command completion,
  *         receives response, and puts the device into the idle state.
  *
@@ -294,6 +608,19 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
     uint32_t max_delay_count;
     uint16_t rxsize;
     uint8_t word_address = 0xFF;
+#ifndef ATCA_NO_POLL
+    uint32_t poll_interval_us;
+    uint32_t sent_us = 0;
+#endif
+#ifdef ATCA_STATS
+    uint32_t start_us = hal_timestamp_us();
+#endif
+
+    if (device->async_ctx)
+    {
+        // An asynchronous operation owns the device
+        return ATCA_FUNC_FAIL;
+    }
 
     do
     {
@@ -302,14 +629,19 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
         {
             return status;
         }
-        execution_or_wait_time = device->mCommands->execution_time_msec;
+        execution_or_wait_time = device->mCommands->execution_time_msec * 1000;
         max_delay_count = 0;
 #else
-        execution_or_wait_time = ATCA_POLLING_INIT_TIME_MSEC;
-        max_delay_count = ATCA_POLLING_MAX_TIME_MSEC / ATCA_POLLING_FREQUENCY_TIME_MSEC;
+        if (calib_wake_shared(device) && calib_get_execution_time(packet->opcode, device->mCommands) != ATCA_SUCCESS)
+        {
+            // Unknown duration - force a fresh watchdog period
+            device->mCommands->execution_time_msec = ATCA_WATCHDOG_LONG_BUDGET_MSEC;
+        }
+        calib_poll_timing(device, packet, &execution_or_wait_time, &poll_interval_us);
+        max_delay_count = (ATCA_POLLING_MAX_TIME_MSEC * 1000 - execution_or_wait_time) / poll_interval_us;
 #endif
 
-        if ((status = atwake(device->mIface)) != ATCA_SUCCESS)
+        if ((status = calib_wake_for_command(device, calib_wake_shared(device) ? device->mCommands->execution_time_msec : 0)) != ATCA_SUCCESS)
         {
             break;
         }
@@ -324,15 +656,18 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
         {
             break;
         }
+#ifndef ATCA_NO_POLL
+        sent_us = hal_timestamp_us();
+#endif
 
         // Delay for execution time or initial wait before polling
-        atca_delay_ms(execution_or_wait_time);
+        calib_delay_us(device->mIface, execution_or_wait_time);
 
         do
         {
             memset(packet->data, 0, sizeof(packet->data));
             // receive the response
-            rxsize = sizeof(packet->data);
+            rxsize = calib_get_response_size(packet);
             if ((status = atreceive(device->mIface, 0, packet->data, &rxsize)) == ATCA_SUCCESS)
             {
                 break;
@@ -340,7 +675,8 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
 
 #ifndef ATCA_NO_POLL
             // delay for polling frequency time
-            atca_delay_ms(ATCA_POLLING_FREQUENCY_TIME_MSEC);
+            ATCA_STATS_ADD(device->mIface, polls, 1);
+            calib_delay_us(device->mIface, poll_interval_us);
 #endif
         }
         while (max_delay_count-- > 0);
@@ -365,6 +701,7 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
 
         if ((status = atCheckCrc(packet->data)) != ATCA_SUCCESS)
         {
+            ATCA_STATS_ADD(device->mIface, crc_errors, 1);
             break;
         }
 
@@ -372,9 +709,30 @@ ATCA_STATUS calib_execute_command(ATCAPacket* packet, ATCADevice device)
         {
             break;
         }
+#ifndef ATCA_NO_POLL
+        // Only successful executions are representative of the command time
+        calib_poll_learn(device, packet, hal_timestamp_us() - sent_us);
+#endif
     }
     while (0);
 
-    atidle(device->mIface);
+#ifdef ATCA_CONFIG_CACHE
+    calib_config_cache_update(device, packet);
+#endif
+#ifdef ATCA_DATA_CACHE
+    calib_data_cache_update(device, packet);
+#endif
+    calib_cert_cache_update(packet);
+
+    // Inside a wake session the device stays awake unless the command failed.
+    // A signature that doesn't verify is a normal outcome, not a failure.
+    if (!calib_wake_shared(device) || (status != ATCA_SUCCESS && status != ATCA_CHECKMAC_VERIFY_FAILED))
+    {
+        device->wake_active = 0;
+        atidle(device->mIface);
+    }
+#ifdef ATCA_STATS
+    atrecordcommand(device->mIface, packet->opcode, status, hal_timestamp_us() - start_us);
+#endif
     return status;
 }
\ No newline at end of file
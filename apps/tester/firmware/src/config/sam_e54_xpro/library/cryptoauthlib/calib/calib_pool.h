@@ -0,0 +1,146 @@
+/**
+ * \file
+ * \brief Pool of CryptoAuth devices that share work between them.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#ifndef CALIB_POOL_H_
+#define CALIB_POOL_H_
+
+/** \ingroup atcab_
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Maximum number of devices in a pool */
+#ifndef ATCA_POOL_MAX_DEVICES
+#define ATCA_POOL_MAX_DEVICES       (4)
+#endif
+#if ATCA_POOL_MAX_DEVICES > 32
+#error "ATCA_POOL_MAX_DEVICES is limited to 32"
+#endif
+
+/** \brief Consecutive communication failures after which a device is taken
+ *         out of the pool */
+#ifndef ATCA_POOL_FAIL_LIMIT
+#define ATCA_POOL_FAIL_LIMIT        (3)
+#endif
+
+/** \brief Time after which a device that was taken out of the pool is given
+ *         another request to find out whether it responds again */
+#ifndef ATCA_POOL_REPROBE_MSEC
+#define ATCA_POOL_REPROBE_MSEC      (5000)
+#endif
+
+/** \brief Operations a pool can dispatch */
+typedef enum
+{
+    CALIB_POOL_OP_SIGN,             //!< calib_async_sign
+    CALIB_POOL_OP_VERIFY_EXTERN,    //!< calib_async_verify_extern
+    CALIB_POOL_OP_ECDH,             //!< calib_async_ecdh
+    CALIB_POOL_OP_RANDOM,           //!< calib_async_random
+} calib_pool_op_t;
+
+/** \brief Request submitted to a pool. Owned by the caller and must stay
+ *         valid, together with all buffers passed to the submit call, until
+ *         the completion callback has run.
+ */
+typedef struct calib_pool_request
+{
+    struct calib_pool_request* next;        //!< Next queued request
+    calib_pool_op_t            op;          //!< Operation
+    uint16_t                   key_id;      //!< Key slot, for sign and ECDH
+    const uint8_t*             message;     //!< 32 byte message digest
+    const uint8_t*             signature;   //!< Signature to verify
+    const uint8_t*             public_key;  //!< Public key to verify with or of the ECDH peer
+    uint8_t*                   out;         //!< Output buffer of the operation
+    bool*                      is_verified; //!< Verification result
+    uint32_t                   tried;       //!< Devices that failed to respond to this request, bit n for device n
+    ATCA_STATUS                last_status; //!< Error of the last device that failed to respond, ATCA_NO_DEVICES if none did
+    atca_async_callback        callback;    //!< Completion callback
+    void*                      param;       //!< Completion callback parameter
+} calib_pool_request_t;
+
+struct calib_pool;
+
+/** \brief Device within a pool */
+typedef struct
+{
+    struct calib_pool*    pool;         //!< Pool the device belongs to
+    ATCADevice            device;       //!< Device context
+    uint16_t              key_mask;     //!< Slots holding the pool keys, bit n for slot n
+    bool                  online;       //!< Device is responding
+    uint8_t               failures;     //!< Consecutive communication failures
+    uint32_t              offline_us;   //!< Time the device was taken out of the pool
+    uint32_t              started_us;   //!< Time the current request was started
+    uint32_t              busy_us;      //!< Time spent executing requests since the last stats reset
+    uint32_t              ops;          //!< Requests completed since the last stats reset
+    uint32_t              errors;       //!< Requests failed since the last stats reset
+    calib_pool_request_t* request;      //!< Request in progress
+    calib_async_ctx_t     async;        //!< Operation context of the request in progress
+} calib_pool_member_t;
+
+/** \brief Pool of devices holding equivalent keys */
+typedef struct calib_pool
+{
+    calib_pool_member_t   members[ATCA_POOL_MAX_DEVICES];   //!< Devices in the pool
+    uint8_t               count;                            //!< Number of devices in the pool
+    calib_pool_request_t* queue;                            //!< Requests waiting for a device
+    uint32_t              stats_us;                         //!< Time of the last stats reset
+} calib_pool_t;
+
+/** \brief Per device statistics of a pool */
+typedef struct
+{
+    ATCADevice device;          //!< Device context
+    bool       online;          //!< Device is responding
+    bool       busy;            //!< A request is in progress on the device
+    uint32_t   ops;             //!< Requests completed
+    uint32_t   errors;          //!< Requests failed
+    uint32_t   busy_us;         //!< Time spent executing requests
+    uint8_t    utilization;     //!< Percentage of time spent executing requests
+} calib_pool_stats_t;
+
+ATCA_STATUS calib_pool_init(calib_pool_t* pool);
+ATCA_STATUS calib_pool_add(calib_pool_t* pool, ATCADevice device, uint16_t key_mask);
+ATCA_STATUS calib_pool_sign(calib_pool_t* pool, calib_pool_request_t* req, uint16_t key_id, const uint8_t* msg, uint8_t* signature,
+                            atca_async_callback callback, void* param);
+ATCA_STATUS calib_pool_verify_extern(calib_pool_t* pool, calib_pool_request_t* req, const uint8_t* message, const uint8_t* signature,
+                                     const uint8_t* public_key, bool* is_verified, atca_async_callback callback, void* param);
+ATCA_STATUS calib_pool_ecdh(calib_pool_t* pool, calib_pool_request_t* req, uint16_t key_id, const uint8_t* public_key, uint8_t* pms,
+                            atca_async_callback callback, void* param);
+ATCA_STATUS calib_pool_random(calib_pool_t* pool, calib_pool_request_t* req, uint8_t* rand_out, atca_async_callback callback, void* param);
+bool calib_pool_tasks(calib_pool_t* pool);
+ATCA_STATUS calib_pool_get_stats(calib_pool_t* pool, uint8_t index, calib_pool_stats_t* stats);
+void calib_pool_reset_stats(calib_pool_t* pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif
@@ -0,0 +1,104 @@
+/**
+ * \file
+ * \brief Recorder of the transactions between the library and the HAL
+ *
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#ifndef HAL_RECORDER_H_
+#define HAL_RECORDER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atca_config.h"
+#include "atca_status.h"
+#include "atca_iface.h"
+
+/** \defgroup hal_ Hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ *
+   @{ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** \brief Size of the ring buffer holding the recorded transactions. When it
+ *         is full the oldest transactions are dropped. */
+#ifndef ATCA_HAL_RECORDER_SIZE
+#define ATCA_HAL_RECORDER_SIZE      (4096)
+#endif
+
+/* Exported trace: an 8 byte header followed by the records, oldest first.
+ * Header: 'A' 'T' 'R' 'C', version, device type, 2 bytes reserved.
+ * Record: type, status (ATCA_STATUS), payload length (2 bytes), start time
+ * (4 bytes, hal_timestamp_us()), duration in us (4 bytes), payload. Multi
+ * byte fields are little endian. The payload of a send or receive is the word
+ * address followed by the bytes on the wire, a failed receive has no data. */
+#define HAL_REC_MAGIC               "ATRC"
+#define HAL_REC_VERSION             ((uint8_t)1)
+#define HAL_REC_TRACE_HEADER_SIZE   (8)
+#define HAL_REC_HEADER_SIZE         (12)
+
+/** \brief HAL call a record was made for */
+typedef enum
+{
+    HAL_REC_WAKE = 1,
+    HAL_REC_IDLE,
+    HAL_REC_SLEEP,
+    HAL_REC_SEND,
+    HAL_REC_RECEIVE
+} hal_rec_type_t;
+
+/** \brief Decoded record */
+typedef struct
+{
+    uint8_t        type;        //!< hal_rec_type_t
+    ATCA_STATUS    status;      //!< Status the HAL returned
+    uint32_t       start_us;    //!< hal_timestamp_us() when the call was made
+    uint32_t       duration_us; //!< Time the call took
+    uint16_t       length;      //!< Payload length
+    const uint8_t* payload;     //!< Word address and data, points into the trace
+} hal_rec_t;
+
+#ifdef ATCA_HAL_RECORDER
+void hal_recorder_log(ATCAIface iface, hal_rec_type_t type, ATCA_STATUS status, uint32_t start_us,
+                      uint8_t word_address, const uint8_t* data, size_t length);
+void hal_recorder_clear(void);
+size_t hal_recorder_size(void);
+size_t hal_recorder_read(size_t offset, uint8_t* buf, size_t length);
+#endif
+
+size_t hal_recorder_decode(const uint8_t* trace, size_t length, hal_rec_t* rec);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* HAL_RECORDER_H_ */
@@ -36,11 +36,67 @@ TEST(atca_cmd_basic_test, info)
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
 }
 
+#if ATCA_CA_SUPPORT && defined(ATCA_STATS)
+static ATCA_STATUS test_wake_fail(ATCAIface iface)
+{
+    (void)iface;
+    return ATCA_WAKE_FAILED;
+}
+
+TEST(atca_cmd_basic_test, info_stats)
+{
+    ATCA_STATUS status;
+    atca_stats_t stats;
+    uint8_t revision[4];
+    ATCAIface iface = atGetIFace(atcab_get_device());
+    ATCA_STATUS (*hal_wake)(ATCAIface) = iface->atwake;
+
+    status = atcab_reset_stats();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_get_stats(&stats);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    TEST_ASSERT_EQUAL(1, stats.opcode_count);
+    TEST_ASSERT_EQUAL(ATCA_INFO, stats.opcodes[0].opcode);
+    TEST_ASSERT_EQUAL(2, stats.opcodes[0].count);
+    TEST_ASSERT_EQUAL(0, stats.opcodes[0].errors);
+    TEST_ASSERT_EQUAL(2 * INFO_COUNT, stats.tx_bytes);
+    TEST_ASSERT_EQUAL(2 * INFO_RSP_SIZE, stats.rx_bytes);
+    TEST_ASSERT(stats.wakes >= 1);
+    TEST_ASSERT_EQUAL(0, stats.crc_errors);
+
+    status = atcab_reset_stats();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_get_stats(&stats);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(0, stats.opcode_count);
+    TEST_ASSERT_EQUAL(0, stats.tx_bytes);
+
+    // A wake that still fails after the POST retry counts as one failure
+    iface->atwake = test_wake_fail;
+    status = atwake(iface);
+    iface->atwake = hal_wake;
+    TEST_ASSERT_EQUAL(ATCA_WAKE_FAILED, status);
+    status = atcab_get_stats(&stats);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, stats.wakes);
+    TEST_ASSERT_EQUAL(1, stats.wake_failures);
+}
+#endif
 
 // *INDENT-OFF* - Preserve formatting
 t_test_case_info info_basic_test_info[] =
 {
     { REGISTER_TEST_CASE(atca_cmd_basic_test, info), DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC                      },
+#if ATCA_CA_SUPPORT && defined(ATCA_STATS)
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, info_stats), DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC                },
+#endif
     { (fp_test_case)NULL,                     (uint8_t)0 },/* Array Termination element*/
 };
 // *INDENT-ON*
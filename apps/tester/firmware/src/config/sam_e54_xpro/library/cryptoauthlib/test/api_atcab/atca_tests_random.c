@@ -26,20 +26,72 @@
  */
 #include <stdlib.h>
 #include "atca_test.h"
+#ifdef ATCA_RANDOM_DRBG
+#include "crypto/atca_crypto_sw_rand.h"
+#endif
 
 TEST(atca_cmd_basic_test, random)
 {
     ATCA_STATUS status = ATCA_GEN_FAIL;
     uint8_t randomnum[32];
 
+#ifdef ATCA_RANDOM_DRBG
+    // The DRBG is not seeded from the fixed pattern of an unlocked device
+    unit_test_assert_config_is_locked();
+#endif
+
+    status = atcab_random(randomnum);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+}
+
+#ifdef ATCA_RANDOM_DRBG
+TEST(atca_cmd_basic_test, random_drbg)
+{
+    ATCA_STATUS status = ATCA_GEN_FAIL;
+    uint8_t randomnum[32];
+    uint8_t randomnum2[32];
+    atca_stats_t stats;
+    uint32_t random_cmds = 0;
+    uint32_t reseeds;
+    size_t i;
+
+    unit_test_assert_config_is_locked();
+
+    // The first call instantiates the DRBG from the device
     status = atcab_random(randomnum);
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_reset_stats();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    reseeds = atcac_sw_random_drbg()->reseeds;
+
+    status = atcab_random(randomnum);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_random(randomnum2);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_NOT_EQUAL(0, memcmp(randomnum, randomnum2, sizeof(randomnum)));
+
+    // Only a due reseed sends a Random command
+    status = atcab_get_stats(&stats);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    for (i = 0; i < stats.opcode_count; i++)
+    {
+        if (ATCA_RANDOM == stats.opcodes[i].opcode)
+        {
+            random_cmds = stats.opcodes[i].count;
+        }
+    }
+    TEST_ASSERT_EQUAL(atcac_sw_random_drbg()->reseeds - reseeds, random_cmds);
 }
+#endif
 
 // *INDENT-OFF* - Preserve formatting
 t_test_case_info random_basic_test_info[] =
 {
     { REGISTER_TEST_CASE(atca_cmd_basic_test, random), DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
+#ifdef ATCA_RANDOM_DRBG
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, random_drbg), DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
+#endif
     { (fp_test_case)NULL,                     (uint8_t)0 },/* Array Termination element*/
 };
 // *INDENT-ON*
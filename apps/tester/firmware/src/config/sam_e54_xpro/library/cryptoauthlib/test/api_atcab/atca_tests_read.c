@@ -154,6 +154,201 @@ TEST(atca_cmd_basic_test, read_data_zone)
     TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
 }
 
+#if ATCA_CA_SUPPORT
+TEST(atca_cmd_basic_test, read_bytes_zone_ranges)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint8_t config_data[ATCA_ECC_CONFIG_SIZE];
+    uint8_t read_data[ATCA_ECC_CONFIG_SIZE];
+    size_t config_size = 0;
+    size_t i;
+    // offset, length pairs that start and end inside blocks and words
+    const size_t ranges[][2] = { { 0, 1 }, { 3, 10 }, { 30, 5 }, { 31, 66 }, { 60, 28 }, { 85, 3 } };
+
+#ifdef ATCA_STATS
+    atca_stats_t stats;
+#endif
+
+#ifdef ATCA_CONFIG_CACHE
+    // Read through to the device
+    status = atcab_config_cache_enable(false);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+#endif
+
+    status = atcab_get_zone_size(ATCA_ZONE_CONFIG, 0, &config_size);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Reference copy read a block or word at a time
+    for (i = 0; i < config_size; i += (config_size - i >= ATCA_BLOCK_SIZE) ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE)
+    {
+        status = atcab_read_zone(ATCA_ZONE_CONFIG, 0, (uint8_t)(i / ATCA_BLOCK_SIZE), (uint8_t)((i % ATCA_BLOCK_SIZE) / ATCA_WORD_SIZE),
+                                 &config_data[i], (config_size - i >= ATCA_BLOCK_SIZE) ? ATCA_BLOCK_SIZE : ATCA_WORD_SIZE);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    }
+
+    for (i = 0; i < sizeof(ranges) / sizeof(ranges[0]); i++)
+    {
+        memset(read_data, 0x77, sizeof(read_data));
+        status = atcab_read_bytes_zone(ATCA_ZONE_CONFIG, 0, ranges[i][0], read_data, ranges[i][1]);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        TEST_ASSERT_EQUAL_MEMORY(&config_data[ranges[i][0]], read_data, ranges[i][1]);
+    }
+
+#ifdef ATCA_STATS
+    // The whole zone takes one read per block and per word of the partial
+    // block at its end, sharing a single wake
+    status = atcab_reset_stats();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_read_bytes_zone(ATCA_ZONE_CONFIG, 0, 0, read_data, config_size);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(config_data, read_data, config_size);
+
+    status = atcab_get_stats(&stats);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, stats.opcode_count);
+    TEST_ASSERT_EQUAL(ATCA_READ, stats.opcodes[0].opcode);
+    TEST_ASSERT_EQUAL(config_size / ATCA_BLOCK_SIZE + (config_size % ATCA_BLOCK_SIZE) / ATCA_WORD_SIZE, stats.opcodes[0].count);
+    TEST_ASSERT(stats.wakes <= 1);
+#endif
+
+#ifdef ATCA_CONFIG_CACHE
+    status = atcab_config_cache_enable(true);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+#endif
+}
+#endif
+
+#if ATCA_CA_SUPPORT && defined(ATCA_CONFIG_CACHE)
+TEST(atca_cmd_basic_test, read_config_cache)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint8_t config_data[ATCA_ECC_CONFIG_SIZE];
+    uint8_t serial_number[ATCA_SERIAL_NUM_SIZE];
+    uint32_t hits, misses;
+    uint32_t start_hits, start_misses;
+    uint32_t counter_value;
+    bool is_locked;
+
+    test_assert_config_is_locked();
+
+    status = atcab_config_cache_invalidate();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_config_cache_stats(&start_hits, &start_misses);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // The first read fills the cache, the others are served from it
+    status = atcab_read_serial_number(serial_number);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_is_locked(LOCK_ZONE_CONFIG, &is_locked);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT(is_locked);
+    status = atcab_is_slot_locked(0, &is_locked);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_read_bytes_zone(ATCA_ZONE_CONFIG, 0, 0, config_data, 16);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(&serial_number[0], &config_data[0], 4);
+    TEST_ASSERT_EQUAL_MEMORY(&serial_number[4], &config_data[8], 5);
+
+    status = atcab_config_cache_stats(&hits, &misses);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(start_misses + 1, misses);
+    TEST_ASSERT_EQUAL(start_hits + 3, hits);
+
+    // Incrementing a counter changes the config zone, the next read goes
+    // to the device again
+    status = atcab_counter_increment(1, &counter_value);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_read_serial_number(serial_number);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_read_serial_number(serial_number);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_config_cache_stats(&hits, &misses);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(start_misses + 2, misses);
+    TEST_ASSERT_EQUAL(start_hits + 4, hits);
+
+    // The counters advance through limited use keys without a command the
+    // cache sees, reads of them always go to the device
+    status = atcab_read_bytes_zone(ATCA_ZONE_CONFIG, 0, 60, config_data, ATCA_WORD_SIZE);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_read_bytes_zone(ATCA_ZONE_CONFIG, 0, 60, config_data, ATCA_WORD_SIZE);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_config_cache_stats(&hits, &misses);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(start_misses + 4, misses);
+    TEST_ASSERT_EQUAL(start_hits + 4, hits);
+}
+#endif
+
+#if ATCA_CA_SUPPORT && defined(ATCA_DATA_CACHE)
+TEST(atca_cmd_basic_test, read_data_cache)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint8_t write_data[ATCA_BLOCK_SIZE];
+    uint8_t read_data[ATCA_BLOCK_SIZE];
+    uint8_t word[ATCA_WORD_SIZE];
+    uint32_t hits, misses;
+    uint32_t start_hits, start_misses;
+    uint16_t slot;
+    uint16_t private_key_id;
+
+    test_assert_data_is_locked();
+
+    status = atca_test_config_get_id(TEST_TYPE_DATA, &slot);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atca_test_config_get_id(TEST_TYPE_ECC_SIGN, &private_key_id);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Secret slots are never cached
+    status = atcab_data_cache_policy((uint16_t)(1u << private_key_id), 0);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, status);
+
+    status = atcab_data_cache_policy((uint16_t)(1u << slot), 0);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_data_cache_stats(&start_hits, &start_misses);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_random(write_data);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_write_zone(ATCA_ZONE_DATA, slot, 0, 0, write_data, sizeof(write_data));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // The first read goes to the device, the block then serves its words too
+    status = atcab_read_zone(ATCA_ZONE_DATA, slot, 0, 0, read_data, sizeof(read_data));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(write_data, read_data, sizeof(read_data));
+    status = atcab_read_zone(ATCA_ZONE_DATA, slot, 0, 0, read_data, sizeof(read_data));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(write_data, read_data, sizeof(read_data));
+    status = atcab_read_zone(ATCA_ZONE_DATA, slot, 0, 3, word, sizeof(word));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(&write_data[12], word, sizeof(word));
+
+    status = atcab_data_cache_stats(&hits, &misses);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(start_misses + 1, misses);
+    TEST_ASSERT_EQUAL(start_hits + 2, hits);
+
+    // Writing the slot drops its cached blocks
+    write_data[0] ^= 0xFF;
+    status = atcab_write_zone(ATCA_ZONE_DATA, slot, 0, 0, write_data, ATCA_WORD_SIZE);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_read_zone(ATCA_ZONE_DATA, slot, 0, 0, read_data, sizeof(read_data));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL_MEMORY(write_data, read_data, sizeof(read_data));
+
+    status = atcab_data_cache_stats(&hits, &misses);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(start_misses + 2, misses);
+    TEST_ASSERT_EQUAL(start_hits + 2, hits);
+
+    status = atcab_data_cache_policy(0, 0);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+}
+#endif
+
 // *INDENT-OFF* - Preserve formatting
 t_test_case_info read_basic_test_info[] =
 {
@@ -165,6 +360,15 @@ t_test_case_info read_basic_test_info[] =
     { REGISTER_TEST_CASE(atca_cmd_basic_test, read_otp_zone),    DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC },
 #endif
     { REGISTER_TEST_CASE(atca_cmd_basic_test, read_data_zone),   DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
+#if ATCA_CA_SUPPORT
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, read_bytes_zone_ranges), DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC },
+#endif
+#if ATCA_CA_SUPPORT && defined(ATCA_CONFIG_CACHE)
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, read_config_cache), DEVICE_MASK_ECC },
+#endif
+#if ATCA_CA_SUPPORT && defined(ATCA_DATA_CACHE)
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, read_data_cache),   DEVICE_MASK_ECC },
+#endif
     { (fp_test_case)NULL,                     (uint8_t)0 },      /* Array Termination element*/
 };
 // *INDENT-ON*
@@ -131,6 +131,7 @@ t_test_case_info* basic_tests[] =
     selftest_basic_test_info,
     gendig_basic_test_info,
     random_basic_test_info,
+    session_basic_test_info,
     nonce_basic_test_info,
     updateextra_basic_test_info,
     counter_basic_test_info,
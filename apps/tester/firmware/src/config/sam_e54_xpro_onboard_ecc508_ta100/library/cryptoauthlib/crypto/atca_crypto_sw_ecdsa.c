@@ -1,7 +1,8 @@
 /**
  * \file
- * \brief API wrapper for software ECDSA verify.  Currently unimplemented but could be
- *        implemented via a 3rd party library such as MicroECC.
+ * \brief Software ECDSA P-256 verify using Solinas reduction for the field,
+ *        Jacobian coordinates and interleaved fixed window (Shamir) scalar
+ *        multiplication with a precomputed generator table.
  *
  * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
  *
@@ -27,18 +28,979 @@
  */
 
 
+#include "cryptoauthlib.h"
 #include "atca_crypto_sw_ecdsa.h"
 
-/** \brief return software generated ECDSA verification result and the function is currently not implemented
- * \param[in] msg         ptr to message or challenge
- * \param[in] signature   ptr to the signature to verify
- * \param[in] public_key  ptr to public key of device which signed the challenge
- * return ATCA_UNIMPLEMENTED , as the function is currently not implemented
+#if ATCAC_ECC_P256_GEN_WINDOW < 1 || ATCAC_ECC_P256_GEN_WINDOW > 6
+#error "ATCAC_ECC_P256_GEN_WINDOW must be between 1 and 6"
+#endif
+
+#if ATCAC_ECC_P256_KEY_WINDOW < 1 || ATCAC_ECC_P256_KEY_WINDOW > 5
+#error "ATCAC_ECC_P256_KEY_WINDOW must be between 1 and 5"
+#endif
+
+/* Field elements and scalars are 8 little endian 32 bit limbs. The field and
+ * scalar arithmetic below is branch free and doesn't index memory by value;
+ * the scalar walk and the special cases of point addition only branch on the
+ * public inputs of a verify. */
+#define P256_LIMBS      (8)
+
+typedef struct
+{
+    uint32_t x[P256_LIMBS];
+    uint32_t y[P256_LIMBS];
+} p256_affine;
+
+typedef struct
+{
+    uint32_t x[P256_LIMBS];
+    uint32_t y[P256_LIMBS];
+    uint32_t z[P256_LIMBS];     //!< Zero for the point at infinity
+} p256_jacobian;
+
+// *INDENT-OFF*
+static const uint32_t p256_p[P256_LIMBS] = {
+    0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xFFFFFFFF
+};
+
+static const uint32_t p256_b[P256_LIMBS] = {
+    0x27D2604B, 0x3BCE3C3E, 0xCC53B0F6, 0x651D06B0, 0x769886BC, 0xB3EBBD55, 0xAA3A93E7, 0x5AC635D8
+};
+
+static const uint32_t p256_n[P256_LIMBS] = {
+    0xFC632551, 0xF3B9CAC2, 0xA7179E84, 0xBCE6FAAD, 0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF
+};
+
+/* -n^-1 mod 2^32, R^2 mod n and R mod n for Montgomery arithmetic mod n, R = 2^256 */
+#define P256_N0_INV     (0xEE00BC4F)
+
+static const uint32_t p256_n_r2[P256_LIMBS] = {
+    0xBE79EEA2, 0x83244C95, 0x49BD6FA6, 0x4699799C, 0x2B6BEC59, 0x2845B239, 0xF3D95620, 0x66E12D94
+};
+
+static const uint32_t p256_n_r[P256_LIMBS] = {
+    0x039CDAAF, 0x0C46353D, 0x58E8617B, 0x43190552, 0x00000000, 0x00000000, 0xFFFFFFFF, 0x00000000
+};
+
+/* i * G for i = 1 .. 2^ATCAC_ECC_P256_GEN_WINDOW - 1 */
+static const p256_affine p256_gen_table[(1 << ATCAC_ECC_P256_GEN_WINDOW) - 1] = {
+    { { 0xD898C296, 0xF4A13945, 0x2DEB33A0, 0x77037D81, 0x63A440F2, 0xF8BCE6E5, 0xE12C4247, 0x6B17D1F2 },
+      { 0x37BF51F5, 0xCBB64068, 0x6B315ECE, 0x2BCE3357, 0x7C0F9E16, 0x8EE7EB4A, 0xFE1A7F9B, 0x4FE342E2 } },
+#if ATCAC_ECC_P256_GEN_WINDOW >= 2
+    { { 0x47669978, 0xA60B48FC, 0x77F21B35, 0xC08969E2, 0x04B51AC3, 0x8A523803, 0x8D034F7E, 0x7CF27B18 },
+      { 0x227873D1, 0x9E04B79D, 0x3CE98229, 0xBA7DADE6, 0x9F7430DB, 0x293D9AC6, 0xDB8ED040, 0x07775510 } },
+    { { 0xC6E7FD6C, 0xFB41661B, 0xEFADA985, 0xE6C6B721, 0x1D4BF165, 0xC8F7EF95, 0xA6330A44, 0x5ECBE4D1 },
+      { 0xA27D5032, 0x9A79B127, 0x384FB83D, 0xD82AB036, 0x1A64A2EC, 0x374B06CE, 0x4998FF7E, 0x8734640C } },
+#endif
+#if ATCAC_ECC_P256_GEN_WINDOW >= 3
+    { { 0x6B030852, 0x50930244, 0x785596EF, 0x031FE2DB, 0x9EE62BD0, 0xA02DDE65, 0x32D08FBB, 0xE2534A35 },
+      { 0x184ED8C6, 0x5C42C23F, 0xF30EE005, 0x4EFC96C3, 0xDA862D76, 0x19DFEE5F, 0x4C633CC7, 0xE0F1575A } },
+    { { 0xC3D033ED, 0x21554A0D, 0x1F5BE524, 0xEF8C82FD, 0x08668FDF, 0xD784C856, 0x515140D2, 0x51590B7A },
+      { 0xFDA16DA4, 0xD1D0BB44, 0xD4D80888, 0x0D012F00, 0xBF8A7926, 0x8AE1BF36, 0x904A727D, 0xE0C17DA8 } },
+    { { 0x3C2291A9, 0xC6B0AAE9, 0xEBB215B4, 0x024C740D, 0xB897DDE3, 0x92D3242C, 0x76A4602C, 0xB01A172A },
+      { 0x8FC77FE2, 0xFD7C4853, 0x1C7E16BD, 0x1C00F770, 0xFBA70379, 0x6FEC0E2D, 0x3237DAD5, 0xE85C1074 } },
+    { { 0x3187B2A3, 0x30062870, 0xA80FEF5B, 0x7EF9F8B8, 0x7C01FB60, 0x25BB3066, 0xA0BF7B46, 0x8E533B6F },
+      { 0xC1F400B4, 0xC55E1A86, 0xCB041B21, 0x53C73633, 0xA6F59000, 0x6D069F83, 0xE0331836, 0x73EB1DBD } },
+#endif
+#if ATCAC_ECC_P256_GEN_WINDOW >= 4
+    { { 0xDB6FB393, 0xB4DD9DC1, 0x0FCE97DB, 0xC1D23898, 0x3AB54CAD, 0x4042742D, 0xBEE9B053, 0x62D9779D },
+      { 0x0F09957E, 0xDA540A6A, 0xBBE76A78, 0xA2ED51F6, 0x1167CEE0, 0x4FF15D77, 0x91E9D824, 0xAD5ACCBD } },
+    { { 0x90949EE0, 0xD79E8A4B, 0x2C6DF8B3, 0x9E0ACB8C, 0x1D71F872, 0x878938D5, 0xFEDF0B71, 0xEA68D7B6 },
+      { 0x4DD048FA, 0xE85A224A, 0xA4DE823F, 0x4D714FEA, 0x4A8EA0C8, 0x87014A96, 0x72C9FCE7, 0x2A2744C9 } },
+    { { 0x04C5723F, 0x4C360694, 0x1C48306E, 0x45CA6C47, 0xEA223FB5, 0x591214D1, 0x2A3A993E, 0xCEF66D6B },
+      { 0x44AF0773, 0xCA34BBAA, 0xFE751EEE, 0x590DED29, 0x9D3B4C10, 0x6E123CDD, 0x29AAAE90, 0x878662A2 } },
+    { { 0x74BC21D1, 0x433391D3, 0x255048BF, 0x16742ED0, 0xB0C21CDA, 0x0638379D, 0x883B4C59, 0x3ED113B7 },
+      { 0xE82A3740, 0xE2F8EEFC, 0x5E9889DA, 0x090D04DA, 0xA4F4C68A, 0x24C843AF, 0xCCC4C8A2, 0x9099209A } },
+    { { 0x8624E3C4, 0xD500C5EE, 0xB2F82C99, 0x79983028, 0x20E5D551, 0x46265373, 0xA817D95E, 0x741DD5BD },
+      { 0xCD4481D3, 0x1995FF22, 0x35BA5CA7, 0x8EEB912C, 0x4887B154, 0x56738355, 0x9C385FDC, 0x0770B46A } },
+    { { 0x46072C01, 0x98E15D9D, 0x65EAD58A, 0x792E284B, 0xD85EE2FC, 0x61805DF2, 0xE0AC495A, 0x177C837A },
+      { 0xEFC7BFD8, 0x9C43BBE2, 0xA1FB4DF3, 0x26EE14C3, 0xB40F4E72, 0xA24091AD, 0x4EBEA558, 0x63BB58CD } },
+    { { 0x24D2920B, 0x57092773, 0x7A069C5E, 0xF126ACBE, 0x4336DF3C, 0x7A76647F, 0x1C3862B9, 0x54E77A00 },
+      { 0x60D0B375, 0x1BA7C82F, 0x73509008, 0x7171EA77, 0x05A2E7C3, 0x42121F8C, 0x29F43175, 0xF599F1BB } },
+    { { 0xE59B9D5F, 0x63668C63, 0xDE3A0EF1, 0xAE03AF92, 0x99888265, 0xADFB3789, 0x971ABAE7, 0xF0454DC6 },
+      { 0x0D034F36, 0x47E59CDE, 0x75B5FA3F, 0x2A3B21CE, 0x1F9643E6, 0x4E6594E5, 0x592E2D1F, 0xB5B93EE3 } },
+#endif
+#if ATCAC_ECC_P256_GEN_WINDOW >= 5
+    { { 0xE1277C6E, 0xA5EB4787, 0xFF6CA038, 0xCD28392E, 0x9836315F, 0x8B821C62, 0x8A6B4185, 0x76A94D13 },
+      { 0x4B8C5110, 0x0E9DDD72, 0x0FC78BAA, 0x8599A004, 0xE11E8720, 0x6CB0A1B5, 0x341F260E, 0xA985FE61 } },
+    { { 0x4738A73E, 0xBA1ABCE3, 0xF0D64AF8, 0x5FA68678, 0x6F75301A, 0x9C0984B6, 0xC0F1CC3A, 0x47776904 },
+      { 0x71F1FCDC, 0x32F787FF, 0x28D5733F, 0x81B28044, 0x77648E83, 0x62318565, 0xB5B95728, 0xAA005EE6 } },
+    { { 0xBD781FDA, 0xD936266D, 0x9EA55C63, 0x37BB4C6F, 0xD1C7C874, 0xDEFC9378, 0x5780F470, 0x1057E0AB },
+      { 0x3C6A45A2, 0x8D83B339, 0x5EF4F1F7, 0xDCC11B5C, 0xD96EE5A7, 0x9FA9B7DF, 0x15CBE5DC, 0xF6F1645A } },
+    { { 0xAB03ED83, 0xC1FC7B74, 0x57884895, 0x782C4522, 0x7108C507, 0xCE39B7C1, 0x102C0C25, 0xCB6D2861 },
+      { 0x2BCECDAA, 0xE3915075, 0x30FA3E03, 0xA496716E, 0x0D6D6CE4, 0x5C35E710, 0x24D9EF51, 0x58D7614B } },
+    { { 0x6B28DA9A, 0xA234DC4C, 0x50465A94, 0x56E6B192, 0xD03CC56D, 0x9BCD6A0A, 0x78395BAB, 0x83A01A93 },
+      { 0x86F640B8, 0xF8240AAA, 0x6923F54F, 0x9F2202BB, 0xD612B75C, 0xAE6A5EB9, 0xE2F73234, 0x76E49B6D } },
+    { { 0x67399E83, 0xFD76364E, 0xF42B1523, 0x3A582139, 0xB473BCA5, 0x2E4AC86E, 0x86637C7B, 0x3250FCF6 },
+      { 0x71D48C09, 0x15DE24A0, 0x3B566A82, 0x897CD3C3, 0x1D7EB88C, 0x97B3090D, 0x667D3593, 0x42E7C342 } },
+    { { 0x50D67AFB, 0x36F5C4E9, 0x8E1DEF8E, 0x63EC9047, 0xA6D44E07, 0xFCC7A186, 0x50D48F99, 0xC0DD241A },
+      { 0xD8CAEC6C, 0x0CBCD16B, 0xE03EA2D6, 0xDA78E57C, 0xEAC062D8, 0x41A7CDC6, 0xA96548B8, 0x8286732E } },
+    { { 0x45CA7896, 0x672E5730, 0xDF64A4FE, 0x3C0BC0A5, 0xD4583FA6, 0xD28A3E39, 0x9C2640D7, 0x0E91C723 },
+      { 0x3140AD55, 0x13804654, 0x75E7A5AE, 0x7E688335, 0xB8E0BD6D, 0x1A22733B, 0x550DBA22, 0x5DF65C3B } },
+    { { 0x8C2AA4CB, 0x76E27D7D, 0x23AB1037, 0x9B2F3947, 0xAF585ABA, 0xB652B8B0, 0xEC62AD7E, 0xDB474918 },
+      { 0x94A7AB55, 0x21DB656C, 0x830A37D2, 0x8A249C47, 0x7B06D52B, 0x43979460, 0xBB743F28, 0x85811D39 } },
+    { { 0xF200D687, 0x84A4DC45, 0xB76F1B24, 0x41652FC5, 0x8C07FA84, 0x85F4F52D, 0x4B0C0BB6, 0x3A67E255 },
+      { 0x02F79324, 0xA9ED16B3, 0x35A7618A, 0x8C188AF7, 0x163AFB0D, 0x26DAF267, 0x2F1FCF43, 0x27D0F187 } },
+    { { 0x57658331, 0x74170018, 0xE1A2EEE6, 0xDFFD3D78, 0x0AE68AA5, 0xD1F3958B, 0x2185A599, 0xF5757C01 },
+      { 0x7268DEC4, 0xFF533DFE, 0x08DF840B, 0x0A6E5E51, 0xD2A08FD5, 0x4B1238D1, 0x2C7675B2, 0x393A6ED0 } },
+    { { 0x3B0883D1, 0xF2E20117, 0x683E54AB, 0x576355BD, 0x4611F378, 0xDEBA2FAC, 0x19D80D51, 0x184FFA58 },
+      { 0x60906E6F, 0x20D242C2, 0x63F04916, 0x45BDECCC, 0x26CB9995, 0xA4C6D908, 0x6688F359, 0xC0A66E27 } },
+    { { 0xC4300E4E, 0x39246F69, 0xFA621293, 0x36CBDCF7, 0xE7ACFC4D, 0x6C5F05FA, 0x5B4FD158, 0x38D86FA5 },
+      { 0xFF69E47B, 0x9F930DC0, 0x91D89BB7, 0xF8B9FCBB, 0x09E7022E, 0x7FF6A689, 0x4ABD0F27, 0x3F93B85A } },
+    { { 0x1C784DEF, 0xDEDD693D, 0x88B58A41, 0xFD8CD1C6, 0x90853B8C, 0xA7C36DA0, 0xFA195B07, 0xD6D33ADE },
+      { 0x93D1BCA6, 0x550C1245, 0x4B95EDED, 0x09A166AB, 0x558A5DCB, 0x3F78245F, 0xEE195D7E, 0x84AABA16 } },
+    { { 0xAD0838A3, 0x319869A8, 0x0DA08936, 0x6192A67D, 0xD0310C1C, 0x5F5A1904, 0x1AEA236A, 0x409F8DA2 },
+      { 0x2A1E8F5A, 0xE163D2C7, 0x162A6793, 0x3E99A0EC, 0xD3BD40F7, 0x0E26E72B, 0xCF008E57, 0x70DCF7B1 } },
+    { { 0xA1B45B8B, 0x3E3F9AA0, 0x52A95B3E, 0xFAC9DB7D, 0xA7AE9AA0, 0xA85DA026, 0x2DC7E05D, 0x301D9E50 },
+      { 0xA17EE267, 0xD58DB6AE, 0x6887CA61, 0x298D9AE4, 0x6B017D72, 0xE0D23C02, 0xB3061223, 0x6551B6F6 } },
+#endif
+#if ATCAC_ECC_P256_GEN_WINDOW >= 6
+    { { 0x2A7ED0E1, 0xD1475BD5, 0xB68371D9, 0xAA557FD5, 0x8EA5BEEF, 0x6C45074E, 0x90A242CA, 0x2377C7D6 },
+      { 0xDDB8D2B2, 0xE7C067B1, 0xECF46716, 0x6658A6CD, 0xBF901B7E, 0x3F8D90E9, 0x8413A439, 0x47A13FB9 } },
+    { { 0xCB2CD793, 0x65C100F3, 0x3AA872FD, 0xA03B0A53, 0x89D9D34E, 0xFA9AA25B, 0xFCD81356, 0x9807D699 },
+      { 0x79634AF4, 0x2F6BF924, 0x6C587853, 0xFFE630B9, 0x1D091B2F, 0x86A01A4D, 0xCAB11BF2, 0xC2A59CDC } },
+    { { 0x6820999E, 0xFB7FDBE1, 0xB7F8BE6C, 0x19CF2D31, 0xCE971339, 0x8D1A092F, 0x717DEF11, 0x2F9E6EBF },
+      { 0x06BE0B2F, 0x756B8803, 0x0AEDEA0D, 0x1682D295, 0xD0F524F6, 0xE3CB1A14, 0x532F8821, 0x7AEEAAD8 } },
+    { { 0x33BB291A, 0xA12D3890, 0x92AF9700, 0x94E8E1FE, 0x326C48CA, 0x8FFA3AD7, 0x9ED27D16, 0xD58D4A58 },
+      { 0xF586B9D5, 0xA5B0C9C6, 0x3B034979, 0x67271C16, 0x2DC7FEF6, 0x76EA9263, 0x02726B85, 0xD45514D1 } },
+    { { 0xABB598EF, 0x7D2A45B9, 0x9664DC22, 0x84E94CBF, 0xD5E965A3, 0x14281D73, 0x11C3731D, 0xDA5BD2D1 },
+      { 0x2044AE5F, 0x92333C24, 0x17B426A4, 0xBB159258, 0x075DF922, 0x2246527B, 0x38F06C54, 0x6166FC19 } },
+    { { 0x502B3348, 0x73A92894, 0x246BFD44, 0xE0D21379, 0x11A826AA, 0xD6B09786, 0x6DDB817D, 0x419A6A64 },
+      { 0xB09214B2, 0xDB1D6C81, 0xF3DEE1E2, 0x13C6D072, 0x954C2FD5, 0x545C9FB1, 0x1102F584, 0x332544CF } },
+    { { 0x576D8C46, 0x81155D60, 0xB4D38F8D, 0x76788153, 0x90596111, 0xB317D7B2, 0xD1356EA1, 0x971581BD },
+      { 0x2BCEC592, 0x80C784E3, 0x183F3253, 0xAAE84346, 0x8654186A, 0x9DD52F1E, 0xDF0D59C1, 0x870CE8AF } },
+    { { 0xFB2776C4, 0xA0C199DD, 0xD2D138D4, 0x547B942D, 0xA179046E, 0x42014976, 0xC3996D4D, 0x22A682F7 },
+      { 0xCBAA285D, 0x5347F649, 0x0265B068, 0x979DCC31, 0x5A54356C, 0xB918C983, 0x102223EE, 0x4F4606B0 } },
+    { { 0x1AAC91E6, 0xAA74B4DA, 0xAE412C0F, 0x57B44D35, 0x4D0EE0C4, 0xBD5B1858, 0xAAD46131, 0xBEA01E7D },
+      { 0x31D51D1C, 0x34C7FF64, 0x296DDCD9, 0x10FB9F1A, 0x816BDAF6, 0xD882DED2, 0x094DAC05, 0x21EDD4E6 } },
+    { { 0x995D2FA2, 0x3A7DE694, 0xD4175A59, 0x6067C5C3, 0xE6CFE8AA, 0x1CF258D2, 0x40DEE065, 0x67A6BEC2 },
+      { 0x441FEED5, 0x49C24CE1, 0x209ACA6C, 0x1542C7EE, 0x464D4499, 0x6C249B49, 0x22D13158, 0xDE692B70 } },
+    { { 0x8BA7F50C, 0xA8365415, 0x87027F3F, 0xDEADEB98, 0x877BB174, 0x7061A0E7, 0x70275E2C, 0x6780C5FC },
+      { 0x4A001266, 0x5C512F9E, 0x0C6A9CA5, 0x61A942F9, 0x1C7BD6D6, 0x81F730AC, 0xBC35D20E, 0x3CBA8C34 } },
+    { { 0x9B82D28D, 0x7544DC12, 0xD009B30F, 0x8F4BC4C6, 0x1D8F4B49, 0xD0423086, 0x6F1FF104, 0x986AE250 },
+      { 0x1BB07E97, 0x25110C44, 0x9C189F25, 0xD86FC628, 0x7D3C7B61, 0xE328A4D9, 0xA6460E0A, 0x003CCCC0 } },
+    { { 0xAC8D4F9B, 0x652D0380, 0xF47AAB0E, 0x170BFF9A, 0x13B498C2, 0x04211F78, 0x0D7E11CB, 0x4756686A },
+      { 0x82F785D0, 0x0E824A98, 0x384890B4, 0x65755AA6, 0x3474C4EB, 0x2FFC258F, 0x54863A6F, 0xCE334FDB } },
+    { { 0xFAE0BA03, 0x79C78080, 0xDD29D6D9, 0x0F5F609E, 0xDFF0672E, 0x3ECD0F5D, 0x70BDE99B, 0xA891D066 },
+      { 0x166934AE, 0xEFC3EDC8, 0xFEB0F2CC, 0x1C6B38F0, 0x033C1CE7, 0x419A88C4, 0x2CBFA1C1, 0xB596CD92 } },
+    { { 0xEB5925F8, 0x12B46293, 0x7C4D3B06, 0x174E94F8, 0x5B5EB6A5, 0x42CAAA1A, 0xFEA701FC, 0xB1BB852C },
+      { 0x8BDE3CB0, 0x783EA1F9, 0x09EF174F, 0x2075978E, 0x6FD1E6CD, 0x46047D20, 0x6C7874CB, 0x1D337DC6 } },
+    { { 0x7B1C0D7C, 0x51D68922, 0x3E19066D, 0xDD5B3158, 0x83071BBC, 0x595361EA, 0x48958708, 0x42C315CC },
+      { 0xB2F9B1B9, 0xD6C4A72B, 0xEB87F164, 0x74F1A1E1, 0xBB7A7990, 0x2914D1DF, 0x571B9585, 0x649A61CE } },
+    { { 0x9E4536CA, 0xABFB9DC6, 0x0A201A61, 0x1C2E9296, 0xE070CDA1, 0x8CCE745B, 0x492539EC, 0x9482FB0E },
+      { 0xF58CC1C8, 0x1FAD863B, 0x5707BFBB, 0xF63D5E29, 0xA7534E63, 0x1A5D638C, 0x45F157F9, 0x351D9CA7 } },
+    { { 0xA5674455, 0x7D228CE6, 0x758FD4FD, 0x28FB7EA9, 0x866E6C05, 0xBB22B146, 0x98068875, 0xF785B0E0 },
+      { 0x10D62408, 0xE7BC490C, 0x5F3AA60A, 0x4B04B6FD, 0x0D9F5B41, 0xE15C767F, 0x6080DA6E, 0x73FDB0BF } },
+    { { 0x4D9EDBA2, 0x508C58A2, 0xC3241EBB, 0x0C108A6A, 0x482A5DE0, 0x57A98127, 0xA9BAB3BA, 0xBA6821CB },
+      { 0x6784E120, 0x8F218B03, 0x2D77EB4F, 0xE70A8529, 0x8CBD21E7, 0x87375EC7, 0x60C4AF3B, 0x8841C5DE } },
+    { { 0x018E22B1, 0x044360F0, 0xE81008FF, 0x95F7EB56, 0x3C1D68BC, 0xAADEE686, 0x4D9DE43E, 0x672C4A51 },
+      { 0x91F37104, 0x99353991, 0x9704D941, 0x13624658, 0xACE203F7, 0x611DE5A4, 0x96A25BFE, 0x548C7E91 } },
+    { { 0x4B978B18, 0x2E1D72D0, 0x04492E3D, 0x03EB2D0A, 0xB2E54C18, 0x537105D2, 0xEC2F25EF, 0x194E35C4 },
+      { 0x03CF4764, 0xC049FE24, 0xE83D569B, 0x68EA7D11, 0x83C4294C, 0xBDB78F16, 0xC14EA798, 0xAF42679A } },
+    { { 0x7449D036, 0xF126EC9F, 0x8DE9B983, 0x982B1CA7, 0x54B88039, 0x5A478022, 0xC9D95245, 0x6F01BD49 },
+      { 0x989E17DB, 0x360233DD, 0xC3749B08, 0xA78551BF, 0x608776CE, 0x11A0F21A, 0xF1D5DEAB, 0x1562080F } },
+    { { 0xC3A3DC7D, 0x4AA8B7D7, 0x2CDC59FA, 0xF4B7DBE0, 0xAE03FCC8, 0x87C40153, 0x31B9EB05, 0x6FC0CD21 },
+      { 0x31FDE2A4, 0x7B065B17, 0x350BAE85, 0xAC630A8E, 0xF3764561, 0xC0E9D83B, 0x646B0513, 0xD4B77618 } },
+    { { 0xDF6E60A0, 0xDEC1DFF7, 0x62C1EADA, 0xC2A595B7, 0xFE7FEA2C, 0x7571A109, 0xA068C926, 0x079DBA7B },
+      { 0xB4824DEA, 0xFB0DA5AE, 0x5751A397, 0x83EB2DF3, 0x2A9588AB, 0x1D223F9D, 0x43D4D181, 0xDC1E19B7 } },
+    { { 0x83FB632E, 0x60A7520A, 0x6F67DC0D, 0x95646349, 0xD0D5A0EB, 0x42E8B595, 0xBCF2815A, 0x6F9A14FB },
+      { 0xF24ECF29, 0x92D75DA2, 0xDD394A5B, 0x9D87F2B8, 0xC776C9DB, 0x854C2DE4, 0x7B404F2A, 0xC8429EB8 } },
+    { { 0xD0F56077, 0x8ABD97B1, 0x2D6C6BD8, 0x289D406E, 0xEA907F86, 0x126D45A8, 0xBB4D2865, 0xC116E30E },
+      { 0xA410C206, 0x313FD7FD, 0x9E59C8C5, 0x7D5BD5E8, 0xB13B8765, 0xB8B16D9B, 0xC35B30C2, 0xE9478823 } },
+    { { 0x54419B1D, 0x9E2481F2, 0xFFDC599E, 0x8B0B3C9A, 0x04D6DF1F, 0x58912ACD, 0x6208539A, 0xEC247D21 },
+      { 0x3AC41FDE, 0x2B910626, 0xDA31F598, 0xFC715E31, 0x7595A5DD, 0x46E93B66, 0x4B253475, 0xCA31CA40 } },
+    { { 0x0FAA4B45, 0xA2B6EA0E, 0x9E8DC8EC, 0xE5094111, 0xFCA9BDF7, 0x765B2784, 0xFE0C6437, 0x665F1A6F },
+      { 0x2B7F4CCF, 0x6E25A660, 0x81E215BC, 0x7DEDE5BF, 0xF7EAC37F, 0x6E8CCA29, 0x9FFD18C2, 0x490E2CA4 } },
+    { { 0x96EF4963, 0x879BB82D, 0x6918D320, 0x22455914, 0xCAC1D0B8, 0x7E53B9EF, 0xC5A5AFBA, 0x05DAE8C2 },
+      { 0x51D34324, 0x56902360, 0xD1D3BF62, 0xF299E802, 0xD70304CE, 0xE2F782D0, 0x03C08119, 0xBB07A44D } },
+    { { 0x0D32AF0E, 0x5939AC38, 0x8B724FD5, 0x3E7910A0, 0x8D990001, 0x2D3A6B3D, 0xEDD3DA9A, 0x059CCB19 },
+      { 0x97FE91D1, 0x928E1E3C, 0x3956CECD, 0x1621F7A3, 0x9345638E, 0xDA65281B, 0xCAD49159, 0xBB6AD7EC } },
+    { { 0xAE8CCE2B, 0x9F88FF57, 0x39C67F26, 0x0F8216B2, 0x9829ECD8, 0xC4B1AC99, 0x4021EDCE, 0x571C05C8 },
+      { 0x84AB8115, 0xAC0128C2, 0xA6BB2DDB, 0xFFCC0CF8, 0x305F499A, 0x2DFB3D9F, 0x17533219, 0xF9325AFC } },
+    { { 0x5D8BDAC1, 0x32A29082, 0x01A7CD38, 0xDF53C8AF, 0x8ACC7D8F, 0x2A1F28A0, 0x5BF5DC80, 0x6A9501D8 },
+      { 0x5F1EF1A3, 0x30AFF53D, 0x697A6F35, 0xF8461B5C, 0x4A3C56A3, 0x81C6C6E4, 0x93473743, 0xCA640AD1 } },
+#endif
+};
+// *INDENT-ON*
+
+/** \brief r = a + b, returns the carry out */
+static uint32_t p256_bn_add(uint32_t r[P256_LIMBS], const uint32_t a[P256_LIMBS], const uint32_t b[P256_LIMBS])
+{
+    uint64_t c = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        c += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    return (uint32_t)c;
+}
+
+/** \brief r = a - b, returns the borrow out */
+static uint32_t p256_bn_sub(uint32_t r[P256_LIMBS], const uint32_t a[P256_LIMBS], const uint32_t b[P256_LIMBS])
+{
+    int64_t c = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        c += (int64_t)a[i] - b[i];
+        r[i] = (uint32_t)c;
+        c >>= 32;
+    }
+    return (uint32_t)(c & 1);
+}
+
+/** \brief r = mask ? a : b, mask must be all ones or zero */
+static void p256_bn_select(uint32_t r[P256_LIMBS], const uint32_t a[P256_LIMBS], const uint32_t b[P256_LIMBS], uint32_t mask)
+{
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        r[i] = (a[i] & mask) | (b[i] & ~mask);
+    }
+}
+
+static uint32_t p256_bn_is_zero(const uint32_t a[P256_LIMBS])
+{
+    uint32_t acc = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        acc |= a[i];
+    }
+    return (uint32_t)(((uint64_t)acc - 1) >> 63);
+}
+
+static uint32_t p256_bn_equal(const uint32_t a[P256_LIMBS], const uint32_t b[P256_LIMBS])
+{
+    uint32_t acc = 0;
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        acc |= a[i] ^ b[i];
+    }
+    return (uint32_t)(((uint64_t)acc - 1) >> 63);
+}
+
+/** \brief Loads a 32 byte big endian number */
+static void p256_bn_from_bytes(uint32_t r[P256_LIMBS], const uint8_t* bytes)
+{
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        const uint8_t* word = &bytes[(P256_LIMBS - 1 - i) * 4];
+        r[i] = ((uint32_t)word[0] << 24) | ((uint32_t)word[1] << 16) | ((uint32_t)word[2] << 8) | word[3];
+    }
+}
+
+/** \brief Returns the width bits of k starting at bit, bits past the top are zero */
+static uint32_t p256_bn_bits(const uint32_t k[P256_LIMBS], int bit, int width)
+{
+    int limb = bit >> 5;
+    int shift = bit & 31;
+    uint32_t bits = k[limb] >> shift;
+
+    if (shift + width > 32 && limb + 1 < P256_LIMBS)
+    {
+        bits |= k[limb + 1] << (32 - shift);
+    }
+    return bits & ((1u << width) - 1);
+}
+
+/** \brief r = a + b mod p */
+static void p256_fe_add(uint32_t r[P256_LIMBS], const uint32_t a[P256_LIMBS], const uint32_t b[P256_LIMBS])
+{
+    uint32_t t[P256_LIMBS];
+    uint32_t carry = p256_bn_add(r, a, b);
+    uint32_t borrow = p256_bn_sub(t, r, p256_p);
+
+    p256_bn_select(r, t, r, 0u - (carry | (borrow ^ 1)));
+}
+
+/** \brief r = a - b mod p */
+static void p256_fe_sub(uint32_t r[P256_LIMBS], const uint32_t a[P256_LIMBS], const uint32_t b[P256_LIMBS])
+{
+    uint32_t t[P256_LIMBS];
+    uint32_t mask = 0u - p256_bn_sub(r, a, b);
+    int i;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        t[i] = p256_p[i] & mask;
+    }
+    (void)p256_bn_add(r, r, t);
+}
+
+/** \brief Reduces a 512 bit product mod p with the NIST (Solinas) fast
+ *         reduction, FIPS 186-4 D.2.3 */
+static void p256_fe_reduce(uint32_t r[P256_LIMBS], const uint32_t c[2 * P256_LIMBS])
+{
+    int64_t acc[P256_LIMBS];
+    int64_t carry;
+    uint32_t t[P256_LIMBS];
+    int round;
+    int i;
+
+    /* s1 + 2 s2 + 2 s3 + s4 + s5 - s6 - s7 - s8 - s9, one limb at a time */
+    acc[0] = (int64_t)c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+    acc[1] = (int64_t)c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+    acc[2] = (int64_t)c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+    acc[3] = (int64_t)c[3] + 2 * ((int64_t)c[11] + c[12]) + c[13] - c[15] - c[8] - c[9];
+    acc[4] = (int64_t)c[4] + 2 * ((int64_t)c[12] + c[13]) + c[14] - c[9] - c[10];
+    acc[5] = (int64_t)c[5] + 2 * ((int64_t)c[13] + c[14]) + c[15] - c[10] - c[11];
+    acc[6] = (int64_t)c[6] + 3 * (int64_t)c[14] + 2 * (int64_t)c[15] + c[13] - c[8] - c[9];
+    acc[7] = (int64_t)c[7] + 3 * (int64_t)c[15] + c[8] - c[10] - c[11] - c[12] - c[13];
+
+    /* Normalize the limbs and fold the carry out of bit 256 back in using
+     * 2^256 = 2^224 - 2^192 - 2^96 + 1 (mod p). Two folds bring the value
+     * into [0, 2^256), the third pass only normalizes. */
+    for (round = 0; round < 3; round++)
+    {
+        carry = 0;
+        for (i = 0; i < P256_LIMBS; i++)
+        {
+            carry += acc[i];
+            acc[i] = carry & 0xFFFFFFFF;
+            carry >>= 32;
+        }
+        acc[0] += carry;
+        acc[3] -= carry;
+        acc[6] -= carry;
+        acc[7] += carry;
+    }
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        r[i] = (uint32_t)acc[i];
+    }
+
+    /* The result is below 2^256 < 2p */
+    p256_bn_select(r, t, r, 0u - (p256_bn_sub(t, r, p256_p) ^ 1));
+}
+
+/** \brief r = a * b mod p */
+static void p256_fe_mul(uint32_t r[P256_LIMBS], const uint32_t a[P256_LIMBS], const uint32_t b[P256_LIMBS])
+{
+    uint32_t t[2 * P256_LIMBS];
+    uint64_t c;
+    int i;
+    int j;
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        t[i] = 0;
+    }
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        c = 0;
+        for (j = 0; j < P256_LIMBS; j++)
+        {
+            c += (uint64_t)a[i] * b[j] + t[i + j];
+            t[i + j] = (uint32_t)c;
+            c >>= 32;
+        }
+        t[i + P256_LIMBS] = (uint32_t)c;
+    }
+
+    p256_fe_reduce(r, t);
+}
+
+/** \brief r = a^2 mod p, computes the cross products once */
+static void p256_fe_sqr(uint32_t r[P256_LIMBS], const uint32_t a[P256_LIMBS])
+{
+    uint32_t t[2 * P256_LIMBS];
+    uint64_t c;
+    uint64_t sq;
+    int i;
+    int j;
+
+    for (i = 0; i < 2 * P256_LIMBS; i++)
+    {
+        t[i] = 0;
+    }
+
+    for (i = 0; i < P256_LIMBS - 1; i++)
+    {
+        c = 0;
+        for (j = i + 1; j < P256_LIMBS; j++)
+        {
+            c += (uint64_t)a[i] * a[j] + t[i + j];
+            t[i + j] = (uint32_t)c;
+            c >>= 32;
+        }
+        t[i + P256_LIMBS] = (uint32_t)c;
+    }
+
+    for (i = 2 * P256_LIMBS - 1; i > 0; i--)
+    {
+        t[i] = (t[i] << 1) | (t[i - 1] >> 31);
+    }
+    t[0] <<= 1;
+
+    c = 0;
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        sq = (uint64_t)a[i] * a[i];
+        c += (uint64_t)t[2 * i] + (uint32_t)sq;
+        t[2 * i] = (uint32_t)c;
+        c >>= 32;
+        c += (uint64_t)t[2 * i + 1] + (sq >> 32);
+        t[2 * i + 1] = (uint32_t)c;
+        c >>= 32;
+    }
+
+    p256_fe_reduce(r, t);
+}
+
+/** \brief Montgomery multiplication mod n, r = a * b / 2^256 mod n */
+static void p256_sc_mont_mul(uint32_t r[P256_LIMBS], const uint32_t a[P256_LIMBS], const uint32_t b[P256_LIMBS])
+{
+    uint32_t t[P256_LIMBS + 2];
+    uint32_t s[P256_LIMBS];
+    uint32_t m;
+    uint64_t c;
+    int i;
+    int j;
+
+    for (i = 0; i < P256_LIMBS + 2; i++)
+    {
+        t[i] = 0;
+    }
+
+    for (i = 0; i < P256_LIMBS; i++)
+    {
+        c = 0;
+        for (j = 0; j < P256_LIMBS; j++)
+        {
+            c += (uint64_t)a[j] * b[i] + t[j];
+            t[j] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[P256_LIMBS];
+        t[P256_LIMBS] = (uint32_t)c;
+        t[P256_LIMBS + 1] = (uint32_t)(c >> 32);
+
+        m = t[0] * P256_N0_INV;
+        c = ((uint64_t)m * p256_n[0] + t[0]) >> 32;
+        for (j = 1; j < P256_LIMBS; j++)
+        {
+            c += (uint64_t)m * p256_n[j] + t[j];
+            t[j - 1] = (uint32_t)c;
+            c >>= 32;
+        }
+        c += t[P256_LIMBS];
+        t[P256_LIMBS - 1] = (uint32_t)c;
+        t[P256_LIMBS] = t[P256_LIMBS + 1] + (uint32_t)(c >> 32);
+    }
+
+    /* t < 2n, subtract n once if needed */
+    m = p256_bn_sub(s, t, p256_n);
+    p256_bn_select(r, t, s, 0u - (m & (t[P256_LIMBS] ^ 1)));
+}
+
+/** \brief r = a^-1 mod n in the Montgomery domain using a^(n-2) */
+static void p256_sc_mont_inv(uint32_t r[P256_LIMBS], const uint32_t a[P256_LIMBS])
+{
+    uint32_t e[P256_LIMBS];
+    uint32_t x[P256_LIMBS];
+    int bit;
+
+    /* The low limb of n is well above 2, so n - 2 doesn't borrow */
+    memcpy(e, p256_n, sizeof(e));
+    e[0] -= 2;
+
+    memcpy(x, p256_n_r, sizeof(x));
+    for (bit = 255; bit >= 0; bit--)
+    {
+        p256_sc_mont_mul(x, x, x);
+        if ((e[bit >> 5] >> (bit & 31)) & 1)
+        {
+            p256_sc_mont_mul(x, x, a);
+        }
+    }
+    memcpy(r, x, sizeof(x));
+}
+
+static const uint32_t p256_one[P256_LIMBS] = { 1, 0, 0, 0, 0, 0, 0, 0 };
+
+/** \brief Checks that the affine point is on the curve, y^2 = x^3 - 3x + b */
+static bool p256_point_is_valid(const p256_affine* a)
+{
+    uint32_t lhs[P256_LIMBS];
+    uint32_t rhs[P256_LIMBS];
+    uint32_t in_range;
+
+    in_range = p256_bn_sub(lhs, a->x, p256_p) & p256_bn_sub(rhs, a->y, p256_p);
+
+    p256_fe_sqr(lhs, a->y);
+    p256_fe_sqr(rhs, a->x);
+    p256_fe_mul(rhs, rhs, a->x);
+    p256_fe_sub(rhs, rhs, a->x);
+    p256_fe_sub(rhs, rhs, a->x);
+    p256_fe_sub(rhs, rhs, a->x);
+    p256_fe_add(rhs, rhs, p256_b);
+
+    return (in_range & p256_bn_equal(lhs, rhs)) != 0;
+}
+
+/** \brief r = 2a with the a = -3 doubling formulas (dbl-2001-b), r may alias a */
+static void p256_point_double(p256_jacobian* r, const p256_jacobian* a)
+{
+    uint32_t delta[P256_LIMBS];
+    uint32_t gamma[P256_LIMBS];
+    uint32_t beta[P256_LIMBS];
+    uint32_t alpha[P256_LIMBS];
+    uint32_t t[P256_LIMBS];
+
+    p256_fe_sqr(delta, a->z);
+    p256_fe_sqr(gamma, a->y);
+    p256_fe_mul(beta, a->x, gamma);
+
+    /* alpha = 3 (x - delta) (x + delta) */
+    p256_fe_sub(t, a->x, delta);
+    p256_fe_add(alpha, a->x, delta);
+    p256_fe_mul(alpha, alpha, t);
+    p256_fe_add(t, alpha, alpha);
+    p256_fe_add(alpha, alpha, t);
+
+    /* z3 = (y + z)^2 - gamma - delta */
+    p256_fe_add(t, a->y, a->z);
+    p256_fe_sqr(t, t);
+    p256_fe_sub(t, t, gamma);
+    p256_fe_sub(r->z, t, delta);
+
+    /* x3 = alpha^2 - 8 beta */
+    p256_fe_add(beta, beta, beta);
+    p256_fe_add(beta, beta, beta);
+    p256_fe_sqr(t, alpha);
+    p256_fe_sub(t, t, beta);
+    p256_fe_sub(r->x, t, beta);
+
+    /* y3 = alpha (4 beta - x3) - 8 gamma^2 */
+    p256_fe_sub(t, beta, r->x);
+    p256_fe_mul(t, alpha, t);
+    p256_fe_sqr(gamma, gamma);
+    p256_fe_add(gamma, gamma, gamma);
+    p256_fe_add(gamma, gamma, gamma);
+    p256_fe_add(gamma, gamma, gamma);
+    p256_fe_sub(r->y, t, gamma);
+}
+
+/** \brief r = a + b for an affine b (madd), r may alias a */
+static void p256_point_add_affine(p256_jacobian* r, const p256_jacobian* a, const p256_affine* b)
+{
+    uint32_t z1z1[P256_LIMBS];
+    uint32_t u2[P256_LIMBS];
+    uint32_t s2[P256_LIMBS];
+    uint32_t h[P256_LIMBS];
+    uint32_t rr[P256_LIMBS];
+    uint32_t hh[P256_LIMBS];
+    uint32_t hhh[P256_LIMBS];
+    uint32_t v[P256_LIMBS];
+
+    if (p256_bn_is_zero(a->z))
+    {
+        memcpy(r->x, b->x, sizeof(r->x));
+        memcpy(r->y, b->y, sizeof(r->y));
+        memcpy(r->z, p256_one, sizeof(r->z));
+        return;
+    }
+
+    p256_fe_sqr(z1z1, a->z);
+    p256_fe_mul(u2, b->x, z1z1);
+    p256_fe_mul(s2, b->y, a->z);
+    p256_fe_mul(s2, s2, z1z1);
+    p256_fe_sub(h, u2, a->x);
+    p256_fe_sub(rr, s2, a->y);
+
+    if (p256_bn_is_zero(h))
+    {
+        if (p256_bn_is_zero(rr))
+        {
+            p256_point_double(r, a);
+        }
+        else
+        {
+            memset(r, 0, sizeof(*r));
+        }
+        return;
+    }
+
+    p256_fe_sqr(hh, h);
+    p256_fe_mul(hhh, h, hh);
+    p256_fe_mul(v, a->x, hh);
+    p256_fe_mul(s2, a->y, hhh);
+    p256_fe_mul(r->z, a->z, h);
+
+    /* x3 = rr^2 - hhh - 2 v */
+    p256_fe_sqr(u2, rr);
+    p256_fe_sub(u2, u2, hhh);
+    p256_fe_sub(u2, u2, v);
+    p256_fe_sub(u2, u2, v);
+
+    /* y3 = rr (v - x3) - y1 hhh */
+    p256_fe_sub(v, v, u2);
+    p256_fe_mul(v, rr, v);
+    p256_fe_sub(r->y, v, s2);
+    memcpy(r->x, u2, sizeof(r->x));
+}
+
+/** \brief r = a + b (add-1998-cmo-2), r may alias a */
+static void p256_point_add(p256_jacobian* r, const p256_jacobian* a, const p256_jacobian* b)
+{
+    uint32_t z1z1[P256_LIMBS];
+    uint32_t z2z2[P256_LIMBS];
+    uint32_t u1[P256_LIMBS];
+    uint32_t u2[P256_LIMBS];
+    uint32_t s1[P256_LIMBS];
+    uint32_t s2[P256_LIMBS];
+    uint32_t h[P256_LIMBS];
+    uint32_t rr[P256_LIMBS];
+    uint32_t hh[P256_LIMBS];
+    uint32_t hhh[P256_LIMBS];
+
+    if (p256_bn_is_zero(b->z))
+    {
+        if (r != a)
+        {
+            memcpy(r, a, sizeof(*r));
+        }
+        return;
+    }
+    if (p256_bn_is_zero(a->z))
+    {
+        memcpy(r, b, sizeof(*r));
+        return;
+    }
+
+    p256_fe_sqr(z1z1, a->z);
+    p256_fe_sqr(z2z2, b->z);
+    p256_fe_mul(u1, a->x, z2z2);
+    p256_fe_mul(u2, b->x, z1z1);
+    p256_fe_mul(s1, a->y, b->z);
+    p256_fe_mul(s1, s1, z2z2);
+    p256_fe_mul(s2, b->y, a->z);
+    p256_fe_mul(s2, s2, z1z1);
+    p256_fe_sub(h, u2, u1);
+    p256_fe_sub(rr, s2, s1);
+
+    if (p256_bn_is_zero(h))
+    {
+        if (p256_bn_is_zero(rr))
+        {
+            p256_point_double(r, a);
+        }
+        else
+        {
+            memset(r, 0, sizeof(*r));
+        }
+        return;
+    }
+
+    p256_fe_sqr(hh, h);
+    p256_fe_mul(hhh, h, hh);
+    p256_fe_mul(u1, u1, hh);        /* v */
+    p256_fe_mul(s1, s1, hhh);
+    p256_fe_mul(r->z, a->z, b->z);
+    p256_fe_mul(r->z, r->z, h);
+
+    /* x3 = rr^2 - hhh - 2 v */
+    p256_fe_sqr(u2, rr);
+    p256_fe_sub(u2, u2, hhh);
+    p256_fe_sub(u2, u2, u1);
+    p256_fe_sub(u2, u2, u1);
+
+    /* y3 = rr (v - x3) - s1 hhh */
+    p256_fe_sub(u1, u1, u2);
+    p256_fe_mul(u1, rr, u1);
+    p256_fe_sub(r->y, u1, s1);
+    memcpy(r->x, u2, sizeof(r->x));
+}
+
+/** \brief Table of 1 .. 2^ATCAC_ECC_P256_KEY_WINDOW - 1 times a public key */
+typedef struct
+{
+    p256_affine   q;
+    p256_jacobian multiples[(1 << ATCAC_ECC_P256_KEY_WINDOW) - 1];
+} p256_key_table;
+
+/** \brief Loads and validates a public key and builds its table of multiples */
+static bool p256_load_key(p256_key_table* key, const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
+{
+    int i;
+
+    p256_bn_from_bytes(key->q.x, &public_key[0]);
+    p256_bn_from_bytes(key->q.y, &public_key[ATCA_ECC_P256_FIELD_SIZE]);
+    if (!p256_point_is_valid(&key->q))
+    {
+        return false;
+    }
+
+    memcpy(key->multiples[0].x, key->q.x, sizeof(key->q.x));
+    memcpy(key->multiples[0].y, key->q.y, sizeof(key->q.y));
+    memcpy(key->multiples[0].z, p256_one, sizeof(p256_one));
+    for (i = 1; i < (1 << ATCAC_ECC_P256_KEY_WINDOW) - 1; i++)
+    {
+        p256_point_add_affine(&key->multiples[i], &key->multiples[i - 1], &key->q);
+    }
+    return true;
+}
+
+/** \brief r = u1 G + u2 Q. Both scalars are walked from the top bit with one
+ *         shared doubling per bit (Shamir's trick); a window digit is added
+ *         at every multiple of its window width, from the precomputed
+ *         generator table and from the table of Q multiples. */
+static void p256_double_scalar_mul(p256_jacobian* r, const uint32_t u1[P256_LIMBS], const uint32_t u2[P256_LIMBS], const p256_key_table* key)
+{
+    uint32_t digit;
+    int bit;
+
+    memset(r, 0, sizeof(*r));
+    for (bit = 255; bit >= 0; bit--)
+    {
+        if (!p256_bn_is_zero(r->z))
+        {
+            p256_point_double(r, r);
+        }
+
+        if ((bit % ATCAC_ECC_P256_GEN_WINDOW) == 0)
+        {
+            if ((digit = p256_bn_bits(u1, bit, ATCAC_ECC_P256_GEN_WINDOW)) != 0)
+            {
+                p256_point_add_affine(r, r, &p256_gen_table[digit - 1]);
+            }
+        }
+
+        if ((bit % ATCAC_ECC_P256_KEY_WINDOW) == 0)
+        {
+            if ((digit = p256_bn_bits(u2, bit, ATCAC_ECC_P256_KEY_WINDOW)) != 0)
+            {
+                p256_point_add(r, r, &key->multiples[digit - 1]);
+            }
+        }
+    }
+}
+
+/** \brief Loads r and s of a signature, returns false when either is outside [1, n - 1] */
+static bool p256_load_signature(uint32_t r[P256_LIMBS], uint32_t s[P256_LIMBS], const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE])
+{
+    uint32_t t[P256_LIMBS];
+    uint32_t in_range;
+
+    p256_bn_from_bytes(r, &signature[0]);
+    p256_bn_from_bytes(s, &signature[ATCA_ECC_P256_FIELD_SIZE]);
+    in_range = p256_bn_sub(t, r, p256_n) & p256_bn_sub(t, s, p256_n);
+    in_range &= (p256_bn_is_zero(r) | p256_bn_is_zero(s)) ^ 1;
+
+    return in_range != 0;
+}
+
+/** \brief Checks a signature given r and w = s^-1 in Montgomery form
+ *  \return ATCA_SUCCESS or ATCA_CHECKMAC_VERIFY_FAILED
  */
+static int p256_verify_core(const uint8_t msg[ATCA_ECC_P256_FIELD_SIZE], const uint32_t r[P256_LIMBS], const uint32_t w[P256_LIMBS], const p256_key_table* key)
+{
+    p256_jacobian point;
+    uint32_t e[P256_LIMBS];
+    uint32_t u1[P256_LIMBS];
+    uint32_t u2[P256_LIMBS];
+    uint32_t t[P256_LIMBS];
+    uint32_t zz[P256_LIMBS];
+
+    /* The digest is below 2^256 < 2n, one subtraction reduces it */
+    p256_bn_from_bytes(e, msg);
+    p256_bn_select(e, e, t, 0u - p256_bn_sub(t, e, p256_n));
+
+    /* w is in Montgomery form, so multiplying by it leaves plain u1 and u2 */
+    p256_sc_mont_mul(u1, e, w);
+    p256_sc_mont_mul(u2, r, w);
 
+    p256_double_scalar_mul(&point, u1, u2, key);
+    if (p256_bn_is_zero(point.z))
+    {
+        return ATCA_CHECKMAC_VERIFY_FAILED;
+    }
+
+    /* x / z^2 mod n == r without an inversion: x is either r z^2 or, when
+     * r + n is still a field element, (r + n) z^2 */
+    p256_fe_sqr(zz, point.z);
+    p256_fe_mul(t, r, zz);
+    if (p256_bn_equal(t, point.x))
+    {
+        return ATCA_SUCCESS;
+    }
+
+    if (!p256_bn_add(t, r, p256_n) && p256_bn_sub(e, t, p256_p))
+    {
+        p256_fe_mul(t, t, zz);
+        if (p256_bn_equal(t, point.x))
+        {
+            return ATCA_SUCCESS;
+        }
+    }
+
+    return ATCA_CHECKMAC_VERIFY_FAILED;
+}
+
+/** \brief Verifies an ECDSA P-256 signature in software
+ * \param[in] msg         ptr to message or challenge
+ * \param[in] signature   ptr to the signature to verify, R and S
+ * \param[in] public_key  ptr to public key of device which signed the challenge, X and Y
+ * \return ATCA_SUCCESS if the signature is valid, ATCA_CHECKMAC_VERIFY_FAILED
+ *         if it isn't, ATCA_BAD_PARAM for a public key that is not on the curve
+ */
 int atcac_sw_ecdsa_verify_p256(const uint8_t msg[ATCA_ECC_P256_FIELD_SIZE],
                                const uint8_t signature[ATCA_ECC_P256_SIGNATURE_SIZE],
                                const uint8_t public_key[ATCA_ECC_P256_PUBLIC_KEY_SIZE])
 {
-    return ATCA_UNIMPLEMENTED;
-}
\ No newline at end of file
+    p256_key_table key;
+    uint32_t r[P256_LIMBS];
+    uint32_t s[P256_LIMBS];
+    uint32_t w[P256_LIMBS];
+
+    if (!msg || !signature || !public_key)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (!p256_load_key(&key, public_key))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if (!p256_load_signature(r, s, signature))
+    {
+        return ATCA_CHECKMAC_VERIFY_FAILED;
+    }
+
+    p256_sc_mont_mul(w, s, p256_n_r2);
+    p256_sc_mont_inv(w, w);
+
+    return p256_verify_core(msg, r, w, &key);
+}
+
+/** \brief Verifies a batch of ECDSA P-256 signatures in software. Item i
+ *         uses the 32 byte digest at msgs + 32 i and the 64 byte signature
+ *         and public key at signatures + 64 i and public_keys + 64 i.
+ *
+ *  Work shared between items:
+ *  - The s^-1 of up to ATCAC_ECC_P256_BATCH_CHUNK items come from a single
+ *    inversion (Montgomery's trick).
+ *  - Consecutive items with the same public key validate it and build its
+ *    table of multiples once.
+ *
+ * \param[in]  count        Number of items
+ * \param[in]  msgs         Digests, count * 32 bytes
+ * \param[in]  signatures   Signatures R and S, count * 64 bytes
+ * \param[in]  public_keys  Public keys X and Y, count * 64 bytes
+ * \param[out] is_verified  Per item result, true when the signature is valid.
+ *                          Signatures under a public key that is not on the
+ *                          curve are reported as not verified.
+ * \return ATCA_SUCCESS when every item was checked, otherwise an error code.
+ */
+int atcac_sw_ecdsa_verify_p256_batch(size_t count, const uint8_t* msgs, const uint8_t* signatures, const uint8_t* public_keys, bool* is_verified)
+{
+    p256_key_table key;
+    const uint8_t* key_bytes = NULL;
+    bool key_valid = false;
+    uint32_t r[ATCAC_ECC_P256_BATCH_CHUNK][P256_LIMBS];
+    uint32_t s[ATCAC_ECC_P256_BATCH_CHUNK][P256_LIMBS];
+    uint32_t prefix[ATCAC_ECC_P256_BATCH_CHUNK][P256_LIMBS];
+    bool valid[ATCAC_ECC_P256_BATCH_CHUNK];
+    int prev[ATCAC_ECC_P256_BATCH_CHUNK];
+    uint32_t inv[P256_LIMBS];
+    uint32_t w[P256_LIMBS];
+    size_t base;
+    size_t chunk;
+    size_t i;
+    int last;
+
+    if ((count && (!msgs || !signatures || !public_keys)) || (count && !is_verified))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    for (base = 0; base < count; base += chunk)
+    {
+        chunk = count - base;
+        chunk = (chunk > ATCAC_ECC_P256_BATCH_CHUNK) ? ATCAC_ECC_P256_BATCH_CHUNK : chunk;
+
+        /* Running products of s in Montgomery form over the items in range */
+        last = -1;
+        for (i = 0; i < chunk; i++)
+        {
+            valid[i] = p256_load_signature(r[i], s[i], &signatures[(base + i) * ATCA_ECC_P256_SIGNATURE_SIZE]);
+            prev[i] = last;
+            if (valid[i])
+            {
+                p256_sc_mont_mul(s[i], s[i], p256_n_r2);
+                if (last < 0)
+                {
+                    memcpy(prefix[i], s[i], sizeof(prefix[i]));
+                }
+                else
+                {
+                    p256_sc_mont_mul(prefix[i], prefix[last], s[i]);
+                }
+                last = (int)i;
+            }
+        }
+
+        if (last >= 0)
+        {
+            p256_sc_mont_inv(inv, prefix[last]);
+        }
+
+        /* Walk back, peeling one s^-1 off the inverted product per item */
+        for (i = chunk; i-- > 0;)
+        {
+            if (!valid[i])
+            {
+                continue;
+            }
+
+            if (prev[i] >= 0)
+            {
+                p256_sc_mont_mul(w, inv, prefix[prev[i]]);
+                p256_sc_mont_mul(inv, inv, s[i]);
+            }
+            else
+            {
+                memcpy(w, inv, sizeof(w));
+            }
+            memcpy(s[i], w, sizeof(w));
+        }
+
+        for (i = 0; i < chunk; i++)
+        {
+            const uint8_t* public_key = &public_keys[(base + i) * ATCA_ECC_P256_PUBLIC_KEY_SIZE];
+
+            is_verified[base + i] = false;
+            if (!valid[i])
+            {
+                continue;
+            }
+
+            if (!key_bytes || memcmp(key_bytes, public_key, ATCA_ECC_P256_PUBLIC_KEY_SIZE))
+            {
+                key_valid = p256_load_key(&key, public_key);
+                key_bytes = public_key;
+            }
+
+            if (key_valid)
+            {
+                is_verified[base + i] = (ATCA_SUCCESS == p256_verify_core(&msgs[(base + i) * ATCA_ECC_P256_FIELD_SIZE], r[i], s[i], &key));
+            }
+        }
+    }
+
+    return ATCA_SUCCESS;
+}
@@ -1,6 +1,7 @@
 /**
  * \file
- * \brief
+ * \brief Software random number generation backed by an HMAC_DRBG seeded
+ *        from the CryptoAuth device random number generator.
  *
  * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
  *
@@ -29,6 +30,7 @@
 #define ATCA_CRYPTO_SW_RAND_H
 
 #include "atca_crypto_sw.h"
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -43,7 +45,57 @@
 extern "C" {
 #endif
 
+#ifndef ATCAC_DRBG_RESEED_INTERVAL
+#define ATCAC_DRBG_RESEED_INTERVAL  (1024)  //!< Generate requests served between reseeds from the device
+#endif
+
+#ifndef ATCAC_DRBG_POOL_SIZE
+#define ATCAC_DRBG_POOL_SIZE        (64)    //!< Bytes of output buffered ahead by atcac_drbg_idle()
+#endif
+
+#define ATCAC_DRBG_SEED_SIZE        (32)    //!< Entropy input size, one device Random response
+#define ATCAC_DRBG_NONCE_SIZE       (16)    //!< Nonce size used at instantiation
+#define ATCAC_DRBG_MAX_REQUEST      (1024)  //!< Largest single generate request in bytes
+
+/** rief Entropy source callback used to seed and reseed a DRBG
+ *
+ * \param[in]  ctx           Source specific context
+ * \param[out] entropy       Entropy is returned here
+ * \param[in]  entropy_size  Number of bytes requested
+ *
+ * eturn ATCA_SUCCESS on success, otherwise an error code.
+ */
+typedef ATCA_STATUS (*atcac_drbg_entropy_cb)(void* ctx, uint8_t* entropy, size_t entropy_size);
+
+/** rief HMAC_DRBG (SHA-256) state as specified by NIST SP 800-90A */
+typedef struct atcac_drbg_ctx
+{
+    uint8_t               key[ATCA_SHA2_256_DIGEST_SIZE];
+    uint8_t               v[ATCA_SHA2_256_DIGEST_SIZE];
+    uint32_t              reseed_counter;   //!< Generate requests since the last (re)seed
+    uint32_t              reseed_interval;  //!< Generate requests allowed before a reseed is forced
+    uint32_t              reseeds;          //!< Number of reseeds performed since instantiation
+    uint32_t              health_failures;  //!< Entropy inputs rejected by the continuous health test
+    uint8_t               last_entropy[ATCAC_DRBG_SEED_SIZE];
+    uint8_t               pool[ATCAC_DRBG_POOL_SIZE];
+    size_t                pool_len;
+    atcac_drbg_entropy_cb entropy;
+    void*                 entropy_ctx;
+    bool                  instantiated;
+} atcac_drbg_ctx;
+
+ATCA_STATUS atcac_drbg_init(atcac_drbg_ctx* ctx, atcac_drbg_entropy_cb entropy, void* entropy_ctx, const uint8_t* pers, size_t pers_len);
+ATCA_STATUS atcac_drbg_reseed(atcac_drbg_ctx* ctx, const uint8_t* additional, size_t additional_len);
+ATCA_STATUS atcac_drbg_generate(atcac_drbg_ctx* ctx, uint8_t* data, size_t data_size);
+ATCA_STATUS atcac_drbg_random(atcac_drbg_ctx* ctx, uint8_t* data, size_t data_size);
+ATCA_STATUS atcac_drbg_idle(atcac_drbg_ctx* ctx);
+ATCA_STATUS atcac_drbg_free(atcac_drbg_ctx* ctx);
+ATCA_STATUS atcac_drbg_health_test(void);
+ATCA_STATUS atcac_drbg_device_entropy(void* ctx, uint8_t* entropy, size_t entropy_size);
+
 int atcac_sw_random(uint8_t* data, size_t data_size);
+ATCA_STATUS atcac_sw_random_idle(void);
+atcac_drbg_ctx* atcac_sw_random_drbg(void);
 
 #ifdef __cplusplus
 }
@@ -32,6 +32,9 @@
  */
 
 #include <stdint.h>
+#ifndef _UNIT_TEST_
+#include "device.h"
+#endif
 
 #ifndef CONF_CPU_FREQUENCY
 #define CONF_CPU_FREQUENCY 120000000
@@ -146,6 +149,163 @@ void _delay_cycles(void *const hw, uint32_t cycles)
 #endif
 }
 
+#if !defined(_UNIT_TEST_) && !defined(DWT_CTRL_CYCCNTENA_Msk) && !defined(ATCA_HAL_TICK_MS)
+static volatile uint32_t hal_systick_wraps;
+
+/**
+ * \brief Count SysTick wraps so gaps between two hal_timestamp_us() calls
+ *        longer than one SysTick period are still measured. Applications that
+ *        install their own SysTick handler define ATCA_HAL_TICK_MS instead.
+ */
+void SysTick_Handler(void)
+{
+    hal_systick_wraps++;
+}
+#endif
+
+/**
+ * \brief Retrieve a free running timestamp in us. The core cycle counter is
+ *        used when the core has one (Cortex-M3/M4/M7), otherwise SysTick is
+ *        run as a down counter whose wraps are counted by SysTick_Handler().
+ *        When the application owns the time base it defines
+ *        ATCA_HAL_TICK_MS() to return its millisecond tick; gaps the cycle
+ *        counter cannot represent are then taken from that tick. The value
+ *        wraps after about 71 minutes, so only differences between two values
+ *        are meaningful.
+ */
+uint32_t hal_timestamp_us(void)
+{
+    static uint32_t timestamp_us;
+    static uint32_t remainder_cycles;
+    static uint32_t last_count;
+    static uint8_t  started;
+    uint32_t        cycles_per_us = CONF_CPU_FREQUENCY / 1000000;
+    uint32_t        count;
+    uint64_t        elapsed;
+
+#if defined(ATCA_HAL_TICK_MS)
+    static uint32_t last_tick_ms;
+    uint32_t        tick_ms = (uint32_t)ATCA_HAL_TICK_MS();
+#endif
+
+#ifndef _UNIT_TEST_
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+    if (!started)
+    {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(__CORTEX_M) && (__CORTEX_M == 7U)
+        DWT->LAR = 0xC5ACCE55UL;
+#endif
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+        last_count = DWT->CYCCNT;
+        started = 1;
+    }
+    count = DWT->CYCCNT;
+    elapsed = (uint32_t)(count - last_count);
+#else
+    uint32_t reload;
+    uint32_t wraps = 0;
+
+#if !defined(ATCA_HAL_TICK_MS)
+    static uint32_t last_wraps;
+    uint32_t        pending;
+#endif
+
+    if (!started)
+    {
+        if (!(SysTick->CTRL & SysTick_CTRL_ENABLE_Msk))
+        {
+            // Nobody owns SysTick - run it over the full 24 bit range
+            SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+            SysTick->VAL = 0;
+#if defined(ATCA_HAL_TICK_MS)
+            SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+#else
+            SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+#endif
+        }
+        last_count = SysTick->VAL;
+        started = 1;
+    }
+    reload = SysTick->LOAD + 1;
+
+#if defined(ATCA_HAL_TICK_MS)
+    count = SysTick->VAL;
+#else
+    // Take a consistent wraps/count pair. With interrupts masked a wrap stays
+    // pending, in which case the count is re-read after the reload.
+    do
+    {
+        wraps = hal_systick_wraps;
+        count = SysTick->VAL;
+        pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) ? 1u : 0u;
+        if (pending)
+        {
+            count = SysTick->VAL;
+        }
+    }
+    while (wraps != hal_systick_wraps);
+    wraps += pending;
+
+    if (SysTick->CTRL & SysTick_CTRL_TICKINT_Msk)
+    {
+        uint32_t counted = wraps - last_wraps;
+
+        last_wraps = wraps;
+        wraps = counted;
+    }
+    else
+    {
+        // SysTick was started without its interrupt - only a gap of less
+        // than one period can be measured
+        wraps = 0;
+    }
+#endif
+
+    // SysTick counts down
+    if (last_count >= count)
+    {
+        elapsed = last_count - count;
+    }
+    else
+    {
+        elapsed = last_count + reload - count;
+        if (wraps > 0)
+        {
+            wraps--;
+        }
+    }
+    elapsed += (uint64_t)wraps * reload;
+#endif
+#else
+    count = 0;
+    elapsed = 0;
+    (void)started;
+#endif
+    last_count = count;
+
+    if (cycles_per_us == 0)
+    {
+        cycles_per_us = 1;
+    }
+
+#if defined(ATCA_HAL_TICK_MS)
+    // The cycle counter only covers one of its periods - trust the tick when
+    // it reports clearly more time than the counter did
+    if ((uint64_t)(uint32_t)(tick_ms - last_tick_ms) * 1000u > elapsed / cycles_per_us + 2000u)
+    {
+        elapsed = (uint64_t)(uint32_t)(tick_ms - last_tick_ms) * 1000u * cycles_per_us;
+    }
+    last_tick_ms = tick_ms;
+#endif
+
+    remainder_cycles += (uint32_t)(elapsed % cycles_per_us);
+    timestamp_us += (uint32_t)(elapsed / cycles_per_us) + remainder_cycles / cycles_per_us;
+    remainder_cycles %= cycles_per_us;
+
+    return timestamp_us;
+}
+
 /**
  * \brief Perform delay in us
  */
@@ -159,5 +319,16 @@ void hal_delay_us(const uint32_t us)
  */
 void hal_delay_ms(const uint32_t ms)
 {
-    _delay_cycles((void*)0,_get_cycles_for_ms(ms));
+    uint32_t remaining = ms;
+    uint32_t chunk;
+
+    // Delay in short chunks so the cycle counter is sampled well within its period
+    do
+    {
+        chunk = (remaining > 100) ? 100 : remaining;
+        _delay_cycles((void*)0, _get_cycles_for_ms(chunk));
+        (void)hal_timestamp_us();
+        remaining -= chunk;
+    }
+    while (remaining > 0);
 }
@@ -32,12 +32,32 @@
 
 #include "cryptoauthlib.h"
 
+/* Drive SDA (SERCOM7 PAD0) low as a GPIO for the ATCA_WAKE_GPIO wake pulse,
+   or hand it back to the SERCOM */
+static void sercom7_sda_drive(bool low)
+{
+    if (low)
+    {
+        PORT_PinClear(PORT_PIN_PD08);
+        PORT_PinOutputEnable(PORT_PIN_PD08);
+        PORT_REGS->GROUP[PORT_PIN_PD08 >> 5].PORT_PINCFG[PORT_PIN_PD08 & 0x1F] &= (uint8_t)~PORT_PINCFG_PMUXEN_Msk;
+    }
+    else
+    {
+        PORT_REGS->GROUP[PORT_PIN_PD08 >> 5].PORT_PINCFG[PORT_PIN_PD08 & 0x1F] |= (uint8_t)PORT_PINCFG_PMUXEN_Msk;
+        PORT_PinInputEnable(PORT_PIN_PD08);
+    }
+}
+
 atca_plib_i2c_api_t sercom7_plib_i2c_api = {
     .read = SERCOM7_I2C_Read,
     .write = SERCOM7_I2C_Write,
+    .write_read = SERCOM7_I2C_WriteRead,
     .is_busy = SERCOM7_I2C_IsBusy,
     .error_get = SERCOM7_I2C_ErrorGet,
-    .transfer_setup = SERCOM7_I2C_TransferSetup
+    .transfer_setup = SERCOM7_I2C_TransferSetup,
+    .callback_register = SERCOM7_I2C_CallbackRegister,
+    .sda_drive = sercom7_sda_drive
 };
 
 static void sercom4_select_pin(uint32_t pin, bool value)
@@ -48,8 +68,10 @@ static void sercom4_select_pin(uint32_t pin, bool value)
 atca_plib_spi_api_t sercom4_plib_spi_api = {
     .read = SERCOM4_SPI_Read,
     .write = SERCOM4_SPI_Write,
+    .write_read = SERCOM4_SPI_WriteRead,
     .is_busy = SERCOM4_SPI_IsBusy,
-    .select = &sercom4_select_pin
+    .select = &sercom4_select_pin,
+    .callback_register = SERCOM4_SPI_CallbackRegister
 };
 
 
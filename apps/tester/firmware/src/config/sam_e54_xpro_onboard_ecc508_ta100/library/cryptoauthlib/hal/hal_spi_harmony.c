@@ -53,6 +53,281 @@
     the HAL layer will not compile because the Harmony SPI drivers are a dependency *
  */
 
+/** \brief Maximum number of SPI peripherals completing transfers through the plib
+ *         callback. Transfers on further peripherals poll the plib.
+ */
+#ifndef ATCA_HAL_SPI_MAX_BUSES
+#define ATCA_HAL_SPI_MAX_BUSES      2
+#endif
+
+/** \brief Executed while waiting for the completion callback of a transfer,
+ *         between checks of the transfer timeout. Empty by default. Define it
+ *         as __asm__ volatile ("wfe") to sleep until the next event when a
+ *         periodic interrupt (e.g. SysTick) guarantees the timeout is still
+ *         checked, or to hook in other work.
+ */
+#ifndef ATCA_HAL_SPI_WAIT_HOOK
+#define ATCA_HAL_SPI_WAIT_HOOK()
+#endif
+
+/** \brief Time added to the duration of a transfer at the configured baud
+ *         rate before it is considered failed, covers interrupt latency.
+ */
+#ifndef ATCA_HAL_SPI_TIMEOUT_MARGIN_US
+#define ATCA_HAL_SPI_TIMEOUT_MARGIN_US  1000
+#endif
+
+/** \brief Steps of a chained transfer, all run under one CS assertion */
+typedef enum
+{
+    HAL_SPI_STAGE_IDLE,         // no transfer, CS deasserted
+    HAL_SPI_STAGE_SEND,         // writing a packet
+    HAL_SPI_STAGE_ADDRESS,      // writing the word address, header read follows
+    HAL_SPI_STAGE_HEADER,       // reading the status or length bytes
+    HAL_SPI_STAGE_PAYLOAD       // reading the rest of the packet
+} hal_spi_stage_t;
+
+/** \brief State of an SPI peripheral registered in hal_spi_init */
+typedef struct
+{
+    atca_plib_spi_api_t*    plib;
+    bool                    event;          // transfers complete through the plib callback
+    volatile uint8_t        stage;          // hal_spi_stage_t, advanced by the callback
+    volatile ATCA_STATUS    status;         // result of the last chained transfer
+    uint32_t                select_pin;     // CS of the device being accessed
+    uint8_t                 address;        // word address of a receive
+    uint8_t                 header[3];      // byte clocked in with the address, then status/length
+    uint8_t                 header_length;  // number of status/length bytes to read
+    uint8_t*                rxdata;         // caller's packet buffer
+    uint16_t                rxsize;         // size of rxdata
+    volatile uint16_t       length;         // number of bytes received
+} hal_spi_bus_t;
+
+static hal_spi_bus_t hal_spi_buses[ATCA_HAL_SPI_MAX_BUSES];
+
+/** \brief Start the next step of a chained transfer or finish it. Runs from the
+ *         plib callback, so the payload read follows the length read without
+ *         returning to the caller.
+ * \param[in] bus  bus state of the peripheral
+ */
+static void hal_spi_advance(hal_spi_bus_t* bus)
+{
+    atca_plib_spi_api_t* plib = bus->plib;
+    uint16_t length;
+
+    bus->status = ATCA_COMM_FAIL;
+
+    switch (bus->stage)
+    {
+    case HAL_SPI_STAGE_ADDRESS:
+        bus->stage = HAL_SPI_STAGE_HEADER;
+        if (true == plib->read(&bus->header[1], bus->header_length))
+        {
+            return;
+        }
+        break;
+
+    case HAL_SPI_STAGE_HEADER:
+        bus->rxdata[0] = bus->header[1];
+        if (1 == bus->header_length)
+        {
+            bus->status = ATCA_SUCCESS;
+            break;
+        }
+        bus->rxdata[1] = bus->header[2];
+
+        /* Calculate bytes to read based on device response */
+        length = ((uint16_t)bus->header[1] * 256) + bus->header[2];
+        bus->length = length;
+
+        if (length > bus->rxsize)
+        {
+            bus->status = ATCA_SMALL_BUFFER;
+        }
+        else if (length < 5)
+        {
+            bus->status = ATCA_RX_FAIL;
+        }
+        else
+        {
+            /* Read the rest of the packet straight into the caller's buffer */
+            bus->stage = HAL_SPI_STAGE_PAYLOAD;
+            if (true == plib->read(&bus->rxdata[2], length - 2))
+            {
+                return;
+            }
+        }
+        break;
+
+    case HAL_SPI_STAGE_SEND:
+    case HAL_SPI_STAGE_PAYLOAD:
+        bus->status = ATCA_SUCCESS;
+        break;
+
+    default:
+        return;
+    }
+
+    plib->select(bus->select_pin, 1);
+    bus->stage = HAL_SPI_STAGE_IDLE;
+}
+
+/** \brief plib transfer completion callback, executed from the SPI interrupt
+ * \param[in] context  hal_spi_bus_t of the peripheral
+ */
+static void hal_spi_event_callback(uintptr_t context)
+{
+    hal_spi_advance((hal_spi_bus_t*)context);
+}
+
+/** \brief Find the state of a plib registered in hal_spi_init
+ * \param[in] plib  plib api of the peripheral
+ * \return the bus state or NULL if the plib is not registered
+ */
+static hal_spi_bus_t* hal_spi_bus_get(atca_plib_spi_api_t* plib)
+{
+    int i;
+
+    for (i = 0; i < ATCA_HAL_SPI_MAX_BUSES; i++)
+    {
+        if (hal_spi_buses[i].plib == plib)
+        {
+            return &hal_spi_buses[i];
+        }
+    }
+    return NULL;
+}
+
+/** \brief Time allowed for transferring a number of bytes at the baud rate of
+ *         the interface
+ * \param[in] cfg     interface configuration
+ * \param[in] length  number of bytes of the transfer
+ * \return timeout in us
+ */
+static uint32_t hal_spi_timeout_us(ATCAIfaceCfg* cfg, size_t length)
+{
+    /* Maximum packet size is 1024 bytes so assume rate can be sub 1kHz */
+    uint32_t rate = cfg->atcaspi.baud / 1000;
+
+    if (0 == rate)
+    {
+        rate = 1;
+    }
+    return ((uint32_t)length * 8 * 1000) / rate + ATCA_HAL_SPI_TIMEOUT_MARGIN_US;
+}
+
+/** \brief Wait until the plib is no longer busy
+ * \param[in] plib        plib api of the peripheral
+ * \param[in] start_us    hal_timestamp_us() at the start of the wait
+ * \param[in] timeout_us  time allowed since start_us
+ * \return ATCA_SUCCESS on success, ATCA_COMM_FAIL on timeout.
+ */
+static ATCA_STATUS hal_spi_wait_ready(atca_plib_spi_api_t* plib, uint32_t start_us, uint32_t timeout_us)
+{
+    while (true == plib->is_busy())
+    {
+        if (hal_timestamp_us() - start_us > timeout_us)
+        {
+            return ATCA_COMM_FAIL;
+        }
+    }
+    return ATCA_SUCCESS;
+}
+
+/** \brief Wait until the chained transfer of the bus has completed. Plibs
+ *         without a callback are polled and advanced from here. A chain that
+ *         does not complete in time is abandoned with CS deasserted, a late
+ *         callback finds the bus idle and does nothing.
+ * \param[in] bus         bus state of the peripheral
+ * \param[in] timeout_us  time allowed for the whole chain
+ * \return ATCA_SUCCESS on success, ATCA_COMM_FAIL on timeout.
+ */
+static ATCA_STATUS hal_spi_wait(hal_spi_bus_t* bus, uint32_t timeout_us)
+{
+    uint32_t start_us = hal_timestamp_us();
+
+    while (HAL_SPI_STAGE_IDLE != bus->stage)
+    {
+        if (hal_timestamp_us() - start_us > timeout_us)
+        {
+            bus->stage = HAL_SPI_STAGE_IDLE;
+            bus->plib->select(bus->select_pin, 1);
+            return ATCA_COMM_FAIL;
+        }
+
+        if (bus->event)
+        {
+            ATCA_HAL_SPI_WAIT_HOOK();
+        }
+        else if (ATCA_SUCCESS == hal_spi_wait_ready(bus->plib, start_us, timeout_us))
+        {
+            hal_spi_advance(bus);
+        }
+    }
+    return ATCA_SUCCESS;
+}
+
+/** \brief Assert CS, start the first step of a chained transfer and wait for
+ *         the whole chain to complete
+ * \param[in] bus         bus state of the peripheral
+ * \param[in] cfg         interface configuration
+ * \param[in] stage       first step, HAL_SPI_STAGE_SEND or HAL_SPI_STAGE_HEADER
+ * \param[in] txdata      bytes to send for HAL_SPI_STAGE_SEND
+ * \param[in] txlength    number of bytes to send
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+static ATCA_STATUS hal_spi_transfer(hal_spi_bus_t* bus, ATCAIfaceCfg* cfg, uint8_t stage, uint8_t* txdata,
+                                    size_t txlength)
+{
+    atca_plib_spi_api_t* plib = bus->plib;
+    uint32_t timeout_us;
+    bool started;
+
+    /* Wait for the SPI bus to be ready */
+    if (ATCA_SUCCESS != hal_spi_wait_ready(plib, hal_timestamp_us(), hal_spi_timeout_us(cfg, 0)))
+    {
+        return ATCA_COMM_FAIL;
+    }
+
+    bus->select_pin = cfg->atcaspi.select_pin;
+    plib->select(bus->select_pin, 0);
+
+    /* The stage has to be set before the callback can fire */
+    if (HAL_SPI_STAGE_SEND == stage)
+    {
+        timeout_us = hal_spi_timeout_us(cfg, txlength);
+        bus->stage = HAL_SPI_STAGE_SEND;
+        started = plib->write(txdata, txlength);
+    }
+    else if (plib->write_read)
+    {
+        timeout_us = hal_spi_timeout_us(cfg, 1 + bus->header_length + bus->rxsize);
+        /* Word address and status/length bytes in one transfer */
+        bus->stage = HAL_SPI_STAGE_HEADER;
+        started = plib->write_read(&bus->address, 1, bus->header, 1 + bus->header_length);
+    }
+    else
+    {
+        timeout_us = hal_spi_timeout_us(cfg, 1 + bus->header_length + bus->rxsize);
+        bus->stage = HAL_SPI_STAGE_ADDRESS;
+        started = plib->write(&bus->address, 1);
+    }
+
+    if (true != started)
+    {
+        bus->stage = HAL_SPI_STAGE_IDLE;
+        plib->select(bus->select_pin, 1);
+        return ATCA_COMM_FAIL;
+    }
+
+    if (ATCA_SUCCESS != hal_spi_wait(bus, timeout_us))
+    {
+        return ATCA_COMM_FAIL;
+    }
+
+    return bus->status;
+}
+
 /** \brief discover spi buses available for this hardware
  * this maintains a list of logical to physical bus mappings freeing the application
  * of the a-priori knowledge
@@ -79,30 +354,12 @@ ATCA_STATUS hal_spi_discover_devices(int bus_num, ATCAIfaceCfg cfg[], int *found
     return ATCA_UNIMPLEMENTED;
 }
 
-static ATCA_STATUS hal_spi_wait(atca_plib_spi_api_t * plib, uint32_t rate, uint16_t length)
-{
-    /* Maximum packet size is 1024 bytes so assume rate can be sub 1kHz */
-    uint32_t timeout = (uint32_t)length * 8 * 1000;
-    rate /= 1000;
-    timeout /= rate;
-    timeout += 1;   /* Make sure the timeout value is non zero */
-
-    while ((true == plib->is_busy()) && (timeout--))
-    {
-        atca_delay_us(1);
-    }
-
-    if (0 == timeout)
-    {
-        return ATCA_COMM_FAIL;
-    }
-    else
-    {
-        return ATCA_SUCCESS;
-    }
-}
-
-/** \brief initialize an SPI interface using given config
+/** \brief initialize an SPI interface using given config. When the plib api
+ *         provides callback_register the HAL registers its own completion
+ *         callback, which replaces any callback the application registered
+ *         on that plib (Harmony plibs hold a single callback). For a plib
+ *         shared with other drivers leave callback_register NULL in its
+ *         atca_plib_spi_api_t so the HAL polls it instead.
  * \param[in] hal - opaque ptr to HAL data
  * \param[in] cfg - interface configuration
  * \return ATCA_SUCCESS on success, otherwise an error code.
@@ -110,6 +367,8 @@ static ATCA_STATUS hal_spi_wait(atca_plib_spi_api_t * plib, uint32_t rate, uint1
 ATCA_STATUS hal_spi_init(void *hal, ATCAIfaceCfg *cfg)
 {
     ATCA_STATUS status = ATCA_BAD_PARAM;
+    hal_spi_bus_t* bus;
+
     if (cfg)
     {
         atca_plib_spi_api_t * plib = (atca_plib_spi_api_t*)cfg->cfg_data;
@@ -120,7 +379,25 @@ ATCA_STATUS hal_spi_init(void *hal, ATCAIfaceCfg *cfg)
             plib->select(cfg->atcaspi.select_pin, 1);
 
             /* Wait for the SPI bus to be ready */
-            status = hal_spi_wait(plib, cfg->atcaspi.baud, 0);
+            if (ATCA_SUCCESS != hal_spi_wait_ready(plib, hal_timestamp_us(), hal_spi_timeout_us(cfg, 0)))
+            {
+                return ATCA_COMM_FAIL;
+            }
+
+            /* Take a free slot for a new bus */
+            if (!hal_spi_bus_get(plib) && NULL != (bus = hal_spi_bus_get(NULL)))
+            {
+                bus->stage = HAL_SPI_STAGE_IDLE;
+                bus->plib = plib;
+
+                /* Complete transfers from the plib interrupt when the plib provides a callback */
+                if (plib->callback_register)
+                {
+                    bus->event = true;
+                    plib->callback_register(hal_spi_event_callback, (uintptr_t)bus);
+                }
+            }
+            status = ATCA_SUCCESS;
         }
     }
     return status;
@@ -147,7 +424,9 @@ ATCA_STATUS hal_spi_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata,
 {
     ATCAIfaceCfg* cfg = atgetifacecfg(iface);
     atca_plib_spi_api_t * plib;
-    ATCA_STATUS status = !ATCA_SUCCESS;
+    hal_spi_bus_t* bus;
+    hal_spi_bus_t polled = { 0 };
+    ATCA_STATUS status;
 
     if (!cfg)
     {
@@ -163,39 +442,24 @@ ATCA_STATUS hal_spi_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata,
         return status;
     }
 
-    do
+    if (NULL == (bus = hal_spi_bus_get(plib)))
     {
-        if (0xFF != word_address)
-        {
-            txdata[0] = word_address; // insert the Word Address Value, Command token
-            txlength++;               // account for word address value byte.
-        }
-
-        plib->select(cfg->atcaspi.select_pin, 0);
-
-        /* Wait for the SPI bus to be ready */
-        if (ATCA_SUCCESS != (status = hal_spi_wait(plib, cfg->atcaspi.baud, 0)) )
-        {
-            break;
-        }
+        bus = &polled;
+        bus->plib = plib;
+    }
 
-        if (true == plib->write(txdata, txlength) )
-        {
-            /* Wait for the SPI transfer to complete */
-            status = hal_spi_wait(plib, cfg->atcaspi.baud, txlength);
-        }
-        else
-        {
-            status = ATCA_COMM_FAIL;
-        }
+    if (0xFF != word_address)
+    {
+        txdata[0] = word_address; // insert the Word Address Value, Command token
+        txlength++;               // account for word address value byte.
     }
-    while (0);
 
-    plib->select(cfg->atcaspi.select_pin, 1);
-    return status;
+    return hal_spi_transfer(bus, cfg, HAL_SPI_STAGE_SEND, txdata, txlength);
 }
 
-/** \brief HAL implementation of SPI receive function for HARMONY SPI
+/** \brief HAL implementation of SPI receive function for HARMONY SPI. The word
+ *         address, the length bytes and the packet are transferred as one
+ *         chain, the packet is read directly into rxdata.
  * \param[in]    iface          Device to interact with.
  * \param[in]    word_address   device transaction type
  * \param[out]   rxdata         Data received will be returned here.
@@ -205,11 +469,11 @@ ATCA_STATUS hal_spi_send(ATCAIface iface, uint8_t word_address, uint8_t *txdata,
  */
 ATCA_STATUS hal_spi_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxdata, uint16_t *rxlength)
 {
-    ATCA_STATUS status = ATCA_COMM_FAIL;
+    ATCA_STATUS status;
     ATCAIfaceCfg* cfg = atgetifacecfg(iface);
-    uint16_t rxdata_max_size;
-    uint16_t read_length = 2;
     atca_plib_spi_api_t * plib;
+    hal_spi_bus_t* bus;
+    hal_spi_bus_t polled = { 0 };
 
     if ((NULL == cfg) || (NULL == rxlength) || (NULL == rxdata))
     {
@@ -221,89 +485,38 @@ ATCA_STATUS hal_spi_receive(ATCAIface iface, uint8_t word_address, uint8_t *rxda
         return ATCA_TRACE(ATCA_INVALID_POINTER, "NULL pointer encountered");
     }
 
-    rxdata_max_size = *rxlength;
-    *rxlength = 0;
-
-    do
+    if (NULL == (bus = hal_spi_bus_get(plib)))
     {
+        bus = &polled;
+        bus->plib = plib;
+    }
 
-        /*Set read length.. Check for register reads or 1 byte reads*/
-        if ((ATCA_MAIN_PROCESSOR_RD_CSR == word_address) || (ATCA_FAST_CRYPTO_RD_FSR == word_address )
-            || ( 1  == rxdata_max_size))
-        {
-            read_length = 1;
-        }
-
-        plib->select(cfg->atcaspi.select_pin, 0);
-
-        /*Send Word address to device...*/
-        if (true == plib->write(&word_address, sizeof(word_address)))
-        {
-            /* Wait for the SPI transfer to complete */
-            status = hal_spi_wait(plib, cfg->atcaspi.baud, sizeof(word_address));
-
-        }
-        if (ATCA_SUCCESS != status)
-        {
-            ATCA_TRACE(status, "plib->write - failed");
-            break;
-        }
-
-        /* read status register/length bytes to know number of bytes to read */
-        status = ATCA_COMM_FAIL;
-        if (true == plib->read(rxdata, read_length) )
-        {
-            /* Wait for the SPI transfer to complete */
-            status = hal_spi_wait(plib, cfg->atcaspi.baud, read_length);
-
-        }
-        if (ATCA_SUCCESS != status)
-        {
-            ATCA_TRACE(status, "plib->read - failed");
-            break;
-        }
-
-        if (1 == read_length)
-        {
-            ATCA_TRACE(status, "1 byte read completed");
-            break;
-        }
-
-        /*Calculate bytes to read based on device response*/
-        read_length = ((uint16_t)rxdata[0] * 256) + rxdata[1];
-
-        if (read_length > rxdata_max_size)
-        {
-            status = ATCA_TRACE(ATCA_SMALL_BUFFER, "rxdata is small buffer");
-            break;
-        }
-
-        if (read_length < 5)
-        {
-            status = ATCA_TRACE(ATCA_RX_FAIL, "packet size is invalid");
-            break;
-        }
-
-        /* Read given length bytes from device */
-        status = ATCA_COMM_FAIL;
-        if (true == plib->read(&rxdata[2], read_length - 2))
-        {
-            /* Wait for the SPI transfer to complete */
-            status = hal_spi_wait(plib, cfg->atcaspi.baud, read_length - 2);
+    /* Wait for a transfer still completing from the interrupt before reusing the state */
+    if (ATCA_SUCCESS != hal_spi_wait(bus, hal_spi_timeout_us(cfg, *rxlength)))
+    {
+        return ATCA_TRACE(ATCA_COMM_FAIL, "hal_spi_receive - bus busy");
+    }
 
-        }
-        if (ATCA_SUCCESS != status)
-        {
-            ATCA_TRACE(status, "plib->read - failed");
-            break;
-        }
+    bus->address = word_address;
+    bus->rxdata = rxdata;
+    bus->rxsize = *rxlength;
+    bus->header_length = 2;
+    *rxlength = 0;
 
+    /*Set read length.. Check for register reads or 1 byte reads*/
+    if ((ATCA_MAIN_PROCESSOR_RD_CSR == word_address) || (ATCA_FAST_CRYPTO_RD_FSR == word_address )
+        || ( 1  == bus->rxsize))
+    {
+        bus->header_length = 1;
     }
-    while (0);
+    bus->length = bus->header_length;
 
-    plib->select(cfg->atcaspi.select_pin, 1);
+    if (ATCA_SUCCESS != (status = hal_spi_transfer(bus, cfg, HAL_SPI_STAGE_HEADER, NULL, 0)))
+    {
+        ATCA_TRACE(status, "hal_spi_receive - failed");
+    }
 
-    *rxlength = read_length;
+    *rxlength = bus->length;
     return status;
 }
 
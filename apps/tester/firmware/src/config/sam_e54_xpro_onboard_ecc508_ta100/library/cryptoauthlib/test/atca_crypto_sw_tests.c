@@ -25,16 +25,18 @@
  * THIS SOFTWARE.
  */
 
+#include <string.h>
 #ifdef _WIN32
 #include <stdio.h>
 #include <stdlib.h>
-#include <string.h>
 #endif
 
 #include "atca_crypto_sw_tests.h"
 #include "crypto/atca_crypto_sw.h"
 #include "crypto/atca_crypto_sw_sha1.h"
 #include "crypto/atca_crypto_sw_sha2.h"
+#include "crypto/atca_crypto_sw_rand.h"
+#include "crypto/atca_crypto_sw_ecdsa.h"
 
 
 #include "vectors/aes_gcm_nist_vectors.h"
@@ -62,11 +64,16 @@ int atca_crypto_sw_tests(int argc, char * argv[])
     RUN_TEST(test_atcac_sw_sha2_256_nist_short);
     RUN_TEST(test_atcac_sw_sha2_256_nist_long);
     RUN_TEST(test_atcac_sw_sha2_256_nist_monte);
+    RUN_TEST(test_atcac_sw_sha2_256_multi);
 
     RUN_TEST(test_atcac_aes128_gcm);
     RUN_TEST(test_atcac_aes128_cmac);
     RUN_TEST(test_atcac_sha256_hmac);
     RUN_TEST(test_atcac_sha256_hmac_nist);
+    RUN_TEST(test_atcac_drbg_health_test);
+    RUN_TEST(test_atcac_drbg_reseed);
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256);
+    RUN_TEST(test_atcac_sw_ecdsa_verify_p256_batch);
 
     return UnityEnd();
 }
@@ -499,6 +506,48 @@ void test_atcac_sw_sha2_256_nist_monte(void)
 #endif
 }
 
+void test_atcac_sw_sha2_256_multi(void)
+{
+    int ret = ATCA_GEN_FAIL;
+    // Sizes around the padding boundaries, in an order that refills lanes unevenly
+    static const size_t sizes[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 1000, 3, 200, 512, 64, 0, 777, 5, 128, 129, 2 };
+    static uint8_t data[2048];
+    const uint8_t* msgs[sizeof(sizes) / sizeof(sizes[0])];
+    uint8_t digests[sizeof(sizes) / sizeof(sizes[0])][ATCA_SHA2_256_DIGEST_SIZE];
+    uint8_t digest_ref[ATCA_SHA2_256_DIGEST_SIZE];
+    size_t i;
+
+    for (i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(i * 13 + 7);
+    }
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        msgs[i] = &data[i * 3];
+    }
+
+    ret = atcac_sw_sha2_256_multi(sizeof(sizes) / sizeof(sizes[0]), msgs, sizes, &digests[0][0]);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++)
+    {
+        ret = atcac_sw_sha2_256(msgs[i], sizes[i], digest_ref);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_MEMORY(digest_ref, digests[i], sizeof(digest_ref));
+    }
+
+    // A single message and no messages at all
+    ret = atcac_sw_sha2_256_multi(1, &msgs[9], &sizes[9], &digests[0][0]);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+    TEST_ASSERT_EQUAL_MEMORY(digests[9], digests[0], sizeof(digest_ref));
+
+    ret = atcac_sw_sha2_256_multi(0, NULL, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, ret);
+
+    ret = atcac_sw_sha2_256_multi(1, NULL, sizes, &digests[0][0]);
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, ret);
+}
+
 #if defined(ATCA_OPENSSL) || defined(ATCA_MBEDTLS) || defined(ATCA_WOLFSSL)
 
 void test_atcac_aes128_gcm(void)
@@ -784,4 +833,161 @@ void test_atcac_sha256_hmac_nist(void)
     } while (ret == ATCA_SUCCESS);
 
 #endif
-}
\ No newline at end of file
+}
+
+void test_atcac_drbg_health_test(void)
+{
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_drbg_health_test());
+}
+
+static uint8_t test_drbg_entropy_seed;
+static bool test_drbg_entropy_stuck;
+
+static ATCA_STATUS test_drbg_entropy(void* ctx, uint8_t* entropy, size_t entropy_size)
+{
+    size_t i;
+
+    (void)ctx;
+    for (i = 0; i < entropy_size; i++)
+    {
+        entropy[i] = test_drbg_entropy_stuck ? (uint8_t)((i & 2) ? 0x00 : 0xFF) : (uint8_t)(test_drbg_entropy_seed + i * 7);
+    }
+    test_drbg_entropy_seed++;
+    return ATCA_SUCCESS;
+}
+
+void test_atcac_drbg_reseed(void)
+{
+    ATCA_STATUS status;
+    atcac_drbg_ctx ctx;
+    uint8_t random1[48];
+    uint8_t random2[48];
+    uint32_t i;
+
+    test_drbg_entropy_seed = 0;
+    test_drbg_entropy_stuck = false;
+
+    status = atcac_drbg_init(&ctx, test_drbg_entropy, NULL, NULL, 0);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, ctx.reseed_counter);
+    ctx.reseed_interval = 4;
+
+    // Idle time fills the pool, which then serves requests
+    status = atcac_drbg_idle(&ctx);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(ATCAC_DRBG_POOL_SIZE, ctx.pool_len);
+
+    status = atcac_drbg_random(&ctx, random1, sizeof(random1));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(ATCAC_DRBG_POOL_SIZE - sizeof(random1), ctx.pool_len);
+    TEST_ASSERT_EQUAL(2, ctx.reseed_counter);
+
+    status = atcac_drbg_random(&ctx, random2, sizeof(random2));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(0, ctx.pool_len);
+    TEST_ASSERT_TRUE(memcmp(random1, random2, sizeof(random1)));
+
+    // Reseed is forced once the interval has been used up
+    for (i = 0; i < 4; i++)
+    {
+        status = atcac_drbg_generate(&ctx, random1, sizeof(random1));
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    }
+    TEST_ASSERT_EQUAL(1, ctx.reseeds);
+
+    // Stuck entropy fails the continuous health test
+    test_drbg_entropy_stuck = true;
+    status = atcac_drbg_reseed(&ctx, NULL, 0);
+    TEST_ASSERT_EQUAL(ATCA_HEALTH_TEST_ERROR, status);
+    TEST_ASSERT_EQUAL(1, ctx.health_failures);
+    TEST_ASSERT_EQUAL(1, ctx.reseeds);
+
+    (void)atcac_drbg_free(&ctx);
+    TEST_ASSERT_FALSE(ctx.instantiated);
+}
+
+/* RFC 6979 A.2.5, P-256 with SHA-256, messages "sample" and "test" */
+static const uint8_t rfc6979_p256_public_key[] = {
+    0x60, 0xfe, 0xd4, 0xba, 0x25, 0x5a, 0x9d, 0x31, 0xc9, 0x61, 0xeb, 0x74, 0xc6, 0x35, 0x6d, 0x68,
+    0xc0, 0x49, 0xb8, 0x92, 0x3b, 0x61, 0xfa, 0x6c, 0xe6, 0x69, 0x62, 0x2e, 0x60, 0xf2, 0x9f, 0xb6,
+    0x79, 0x03, 0xfe, 0x10, 0x08, 0xb8, 0xbc, 0x99, 0xa4, 0x1a, 0xe9, 0xe9, 0x56, 0x28, 0xbc, 0x64,
+    0xf2, 0xf1, 0xb2, 0x0c, 0x2d, 0x7e, 0x9f, 0x51, 0x77, 0xa3, 0xc2, 0x94, 0xd4, 0x46, 0x22, 0x99
+};
+
+static const uint8_t rfc6979_p256_digest_sample[] = {
+    0xaf, 0x2b, 0xdb, 0xe1, 0xaa, 0x9b, 0x6e, 0xc1, 0xe2, 0xad, 0xe1, 0xd6, 0x94, 0xf4, 0x1f, 0xc7,
+    0x1a, 0x83, 0x1d, 0x02, 0x68, 0xe9, 0x89, 0x15, 0x62, 0x11, 0x3d, 0x8a, 0x62, 0xad, 0xd1, 0xbf
+};
+
+static const uint8_t rfc6979_p256_signature_sample[] = {
+    0xef, 0xd4, 0x8b, 0x2a, 0xac, 0xb6, 0xa8, 0xfd, 0x11, 0x40, 0xdd, 0x9c, 0xd4, 0x5e, 0x81, 0xd6,
+    0x9d, 0x2c, 0x87, 0x7b, 0x56, 0xaa, 0xf9, 0x91, 0xc3, 0x4d, 0x0e, 0xa8, 0x4e, 0xaf, 0x37, 0x16,
+    0xf7, 0xcb, 0x1c, 0x94, 0x2d, 0x65, 0x7c, 0x41, 0xd4, 0x36, 0xc7, 0xa1, 0xb6, 0xe2, 0x9f, 0x65,
+    0xf3, 0xe9, 0x00, 0xdb, 0xb9, 0xaf, 0xf4, 0x06, 0x4d, 0xc4, 0xab, 0x2f, 0x84, 0x3a, 0xcd, 0xa8
+};
+
+static const uint8_t rfc6979_p256_digest_test[] = {
+    0x9f, 0x86, 0xd0, 0x81, 0x88, 0x4c, 0x7d, 0x65, 0x9a, 0x2f, 0xea, 0xa0, 0xc5, 0x5a, 0xd0, 0x15,
+    0xa3, 0xbf, 0x4f, 0x1b, 0x2b, 0x0b, 0x82, 0x2c, 0xd1, 0x5d, 0x6c, 0x15, 0xb0, 0xf0, 0x0a, 0x08
+};
+
+static const uint8_t rfc6979_p256_signature_test[] = {
+    0xf1, 0xab, 0xb0, 0x23, 0x51, 0x83, 0x51, 0xcd, 0x71, 0xd8, 0x81, 0x56, 0x7b, 0x1e, 0xa6, 0x63,
+    0xed, 0x3e, 0xfc, 0xf6, 0xc5, 0x13, 0x2b, 0x35, 0x4f, 0x28, 0xd3, 0xb0, 0xb7, 0xd3, 0x83, 0x67,
+    0x01, 0x9f, 0x41, 0x13, 0x74, 0x2a, 0x2b, 0x14, 0xbd, 0x25, 0x92, 0x6b, 0x49, 0xc6, 0x49, 0x15,
+    0x5f, 0x26, 0x7e, 0x60, 0xd3, 0x81, 0x4b, 0x4c, 0x0c, 0xc8, 0x42, 0x50, 0xe4, 0x6f, 0x00, 0x83
+};
+
+void test_atcac_sw_ecdsa_verify_p256(void)
+{
+    uint8_t buf[ATCA_ECC_P256_SIGNATURE_SIZE];
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256(rfc6979_p256_digest_sample, rfc6979_p256_signature_sample, rfc6979_p256_public_key));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256(rfc6979_p256_digest_test, rfc6979_p256_signature_test, rfc6979_p256_public_key));
+
+    // Signature for another message
+    TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, atcac_sw_ecdsa_verify_p256(rfc6979_p256_digest_test, rfc6979_p256_signature_sample, rfc6979_p256_public_key));
+
+    // Modified S
+    memcpy(buf, rfc6979_p256_signature_sample, sizeof(buf));
+    buf[63] ^= 0x01;
+    TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, atcac_sw_ecdsa_verify_p256(rfc6979_p256_digest_sample, buf, rfc6979_p256_public_key));
+
+    // R of zero and S out of range
+    memset(buf, 0x00, 32);
+    TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, atcac_sw_ecdsa_verify_p256(rfc6979_p256_digest_sample, buf, rfc6979_p256_public_key));
+    memcpy(buf, rfc6979_p256_signature_sample, sizeof(buf));
+    memset(&buf[32], 0xFF, 32);
+    TEST_ASSERT_EQUAL(ATCA_CHECKMAC_VERIFY_FAILED, atcac_sw_ecdsa_verify_p256(rfc6979_p256_digest_sample, buf, rfc6979_p256_public_key));
+
+    // Public key not on the curve
+    memcpy(buf, rfc6979_p256_public_key, sizeof(buf));
+    buf[63] ^= 0x01;
+    TEST_ASSERT_EQUAL(ATCA_BAD_PARAM, atcac_sw_ecdsa_verify_p256(rfc6979_p256_digest_sample, rfc6979_p256_signature_sample, buf));
+}
+
+void test_atcac_sw_ecdsa_verify_p256_batch(void)
+{
+    uint8_t msgs[4][ATCA_ECC_P256_FIELD_SIZE];
+    uint8_t signatures[4][ATCA_ECC_P256_SIGNATURE_SIZE];
+    uint8_t public_keys[4][ATCA_ECC_P256_PUBLIC_KEY_SIZE];
+    bool is_verified[4];
+    size_t i;
+
+    for (i = 0; i < 4; i++)
+    {
+        memcpy(msgs[i], (i & 1) ? rfc6979_p256_digest_test : rfc6979_p256_digest_sample, sizeof(msgs[i]));
+        memcpy(signatures[i], (i & 1) ? rfc6979_p256_signature_test : rfc6979_p256_signature_sample, sizeof(signatures[i]));
+        memcpy(public_keys[i], rfc6979_p256_public_key, sizeof(public_keys[i]));
+    }
+
+    // Signature for another message and a public key not on the curve
+    memcpy(signatures[2], rfc6979_p256_signature_test, sizeof(signatures[2]));
+    public_keys[3][63] ^= 0x01;
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcac_sw_ecdsa_verify_p256_batch(4, &msgs[0][0], &signatures[0][0], &public_keys[0][0], is_verified));
+    TEST_ASSERT_TRUE(is_verified[0]);
+    TEST_ASSERT_TRUE(is_verified[1]);
+    TEST_ASSERT_FALSE(is_verified[2]);
+    TEST_ASSERT_FALSE(is_verified[3]);
+}
@@ -0,0 +1,1125 @@
+/**
+ * \file
+ * \brief  Cryptoauthlib Testing: Performance Benchmarks
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "cryptoauthlib.h"
+#include "atca_test.h"
+#include "atcacert/atcacert_client.h"
+#include "atcacert/test_cert_def_0_device.h"
+#include "jwt/atca_jwt.h"
+#include "crypto/atca_crypto_sw_ecdsa.h"
+
+#ifndef ATCA_BENCH_ITERATIONS
+#define ATCA_BENCH_ITERATIONS       (50)
+#endif
+
+/** \brief Number of latency samples kept per case. Longer runs report the
+ *         percentiles of the first samples, the output says how many. */
+#ifndef ATCA_BENCH_MAX_SAMPLES
+#define ATCA_BENCH_MAX_SAMPLES      (200)
+#endif
+
+typedef ATCA_STATUS (*fp_bench_case)(void);
+
+/** \brief Single operation timed by bench_latency() */
+typedef ATCA_STATUS (*fp_bench_op)(void* param);
+
+typedef struct
+{
+    const char*   name;
+    fp_bench_case fp_bench;
+} t_bench_case_info;
+
+static int bench_iterations = ATCA_BENCH_ITERATIONS;
+static uint32_t bench_samples[ATCA_BENCH_MAX_SAMPLES];
+
+static int bench_compare_samples(const void* a, const void* b)
+{
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+
+    return (x > y) - (x < y);
+}
+
+/** \brief Nearest rank percentile of the sorted samples */
+static uint32_t bench_percentile(int count, int pct)
+{
+    int rank = (count * pct + 99) / 100;
+
+    return bench_samples[(rank > 0) ? rank - 1 : 0];
+}
+
+/** \brief Runs the operation bench_iterations times, timing each call, and
+ *         prints the rate and latency distribution of the case. bytes is the
+ *         amount of data one operation processes and is reported as bytes/sec
+ *         when non zero. The percentiles cover the first "samples" calls. */
+static ATCA_STATUS bench_latency(const char* name, size_t bytes, fp_bench_op op, void* param)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    int count = (bench_iterations < ATCA_BENCH_MAX_SAMPLES) ? bench_iterations : ATCA_BENCH_MAX_SAMPLES;
+    uint64_t total_us = 0;
+    uint64_t ops_per_ksec;
+    uint32_t start;
+    uint32_t elapsed;
+    int i;
+
+    for (i = 0; i < bench_iterations && status == ATCA_SUCCESS; i++)
+    {
+        start = hal_timestamp_us();
+        status = op(param);
+        elapsed = hal_timestamp_us() - start;
+        if (i < count)
+        {
+            bench_samples[i] = elapsed;
+        }
+        total_us += elapsed;
+    }
+
+    if (status == ATCA_SUCCESS)
+    {
+        // Slow operations run well below one per second, keep three decimals
+        ops_per_ksec = total_us ? (bench_iterations * 1000000000ULL) / total_us : 0;
+        qsort(bench_samples, (size_t)count, sizeof(bench_samples[0]), bench_compare_samples);
+        printf("{\"case\": \"%s\", \"bytes\": %lu, \"iterations\": %d, \"samples\": %d, \"total_us\": %lu, \"ops_per_sec\": %lu.%03lu, "
+               "\"p50_us\": %lu, \"p95_us\": %lu, \"p99_us\": %lu, \"bytes_per_sec\": %lu}\r\n",
+               name, (unsigned long)bytes, bench_iterations, count, (unsigned long)total_us,
+               (unsigned long)(ops_per_ksec / 1000), (unsigned long)(ops_per_ksec % 1000),
+               (unsigned long)bench_percentile(count, 50), (unsigned long)bench_percentile(count, 95),
+               (unsigned long)bench_percentile(count, 99),
+               (unsigned long)(total_us ? (bytes * bench_iterations * 1000000ULL) / total_us : 0));
+    }
+    return status;
+}
+
+#if ATCA_CA_SUPPORT
+/** \brief Typical short command sequence: Info plus the two reads used to
+ *         retrieve the serial number */
+static ATCA_STATUS bench_session_sequence(void)
+{
+    ATCA_STATUS status;
+    uint8_t revision[4];
+    uint8_t serial_number[ATCA_SERIAL_NUM_SIZE];
+
+    if ((status = atcab_info(revision)) == ATCA_SUCCESS)
+    {
+        status = atcab_read_serial_number(serial_number);
+    }
+    return status;
+}
+
+/** \brief Compares running the sequence with a wake/idle cycle around every
+ *         command against running it inside a single wake session */
+static ATCA_STATUS bench_session(void)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    uint32_t start;
+    uint32_t plain_us;
+    uint32_t session_us;
+    int i;
+
+    start = hal_timestamp_us();
+    for (i = 0; i < bench_iterations && status == ATCA_SUCCESS; i++)
+    {
+        status = bench_session_sequence();
+    }
+    plain_us = hal_timestamp_us() - start;
+
+    if (status == ATCA_SUCCESS)
+    {
+        start = hal_timestamp_us();
+        if ((status = atcab_session_begin()) == ATCA_SUCCESS)
+        {
+            for (i = 0; i < bench_iterations && status == ATCA_SUCCESS; i++)
+            {
+                status = bench_session_sequence();
+            }
+            (void)atcab_session_end();
+        }
+        session_us = hal_timestamp_us() - start;
+    }
+
+    if (status == ATCA_SUCCESS)
+    {
+        printf("{\"case\": \"session\", \"iterations\": %d, \"plain_us\": %lu, \"session_us\": %lu, \"saved_pct\": %lu}\r\n",
+               bench_iterations, (unsigned long)plain_us, (unsigned long)session_us,
+               (unsigned long)(plain_us > session_us ? ((plain_us - session_us) * 100ULL) / plain_us : 0));
+    }
+    return status;
+}
+
+/** \brief Compares the per command cost of the default wake against the
+ *         ATCA_WAKE_SESSION wake mode */
+static ATCA_STATUS bench_wake_mode(void)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCAIfaceCfg* cfg = atgetifacecfg(atGetIFace(atcab_get_device()));
+    uint8_t wake_mode = cfg->wake_mode;
+    uint8_t revision[4];
+    uint32_t start;
+    uint32_t default_us;
+    uint32_t session_us = 0;
+    int i;
+
+    start = hal_timestamp_us();
+    for (i = 0; i < bench_iterations && status == ATCA_SUCCESS; i++)
+    {
+        status = atcab_info(revision);
+    }
+    default_us = hal_timestamp_us() - start;
+
+    if (status == ATCA_SUCCESS)
+    {
+        cfg->wake_mode |= ATCA_WAKE_SESSION;
+        start = hal_timestamp_us();
+        for (i = 0; i < bench_iterations && status == ATCA_SUCCESS; i++)
+        {
+            status = atcab_info(revision);
+        }
+        session_us = hal_timestamp_us() - start;
+        (void)atcab_idle();
+        cfg->wake_mode = wake_mode;
+    }
+
+    if (status == ATCA_SUCCESS)
+    {
+        printf("{\"case\": \"wake_mode\", \"iterations\": %d, \"default_us_per_cmd\": %lu, \"session_us_per_cmd\": %lu}\r\n",
+               bench_iterations, (unsigned long)(default_us / bench_iterations), (unsigned long)(session_us / bench_iterations));
+    }
+    return status;
+}
+
+static void bench_async_callback(ATCA_STATUS status, void* param)
+{
+    *(ATCA_STATUS*)param = status;
+}
+
+/** \brief Signs asynchronously and counts how often the main loop got to run
+ *         while the device was busy, compared with the blocking sign */
+static ATCA_STATUS bench_async_sign(void)
+{
+    ATCA_STATUS status;
+    ATCA_STATUS async_status = ATCA_SUCCESS;
+    calib_async_ctx_t ctx;
+    uint8_t msg[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signature[ATCA_ECCP256_SIG_SIZE];
+    uint16_t key_id = 0;
+    uint32_t start;
+    uint32_t blocking_us;
+    uint32_t async_us = 0;
+    uint32_t loops = 0;
+    int i;
+
+    memset(msg, 0x5A, sizeof(msg));
+    if ((status = atca_test_config_get_id(TEST_TYPE_ECC_SIGN, &key_id)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+
+    start = hal_timestamp_us();
+    for (i = 0; i < bench_iterations && status == ATCA_SUCCESS; i++)
+    {
+        status = atcab_sign(key_id, msg, signature);
+    }
+    blocking_us = hal_timestamp_us() - start;
+
+    start = hal_timestamp_us();
+    for (i = 0; i < bench_iterations && status == ATCA_SUCCESS; i++)
+    {
+        if ((status = atcab_async_sign(&ctx, key_id, msg, signature, bench_async_callback, &async_status)) == ATCA_SUCCESS)
+        {
+            // Stand-in for the rest of SYS_Tasks()
+            for (; atcab_async_tasks(); loops++)
+            {
+                ;
+            }
+            status = async_status;
+        }
+    }
+    async_us = hal_timestamp_us() - start;
+
+    if (status == ATCA_SUCCESS)
+    {
+        printf("{\"case\": \"async_sign\", \"iterations\": %d, \"blocking_us\": %lu, \"async_us\": %lu, \"loops_per_op\": %lu}\r\n",
+               bench_iterations, (unsigned long)blocking_us, (unsigned long)async_us, (unsigned long)(loops / bench_iterations));
+    }
+    return status;
+}
+
+typedef struct
+{
+    calib_pool_request_t req;
+    bool                 busy;
+    bool                 used;
+    ATCA_STATUS          status;
+    uint8_t              signature[ATCA_ECCP256_SIG_SIZE];
+} t_bench_pool_slot;
+
+static void bench_pool_callback(ATCA_STATUS status, void* param)
+{
+    t_bench_pool_slot* slot = (t_bench_pool_slot*)param;
+
+    slot->status = status;
+    slot->busy = false;
+}
+
+/** \brief Keeps every device of a pool busy signing and reports the aggregate
+ *         rate and the utilization of each device. The pool holds the basic
+ *         API device, add further contexts from atcab_init_ext() to see the
+ *         rate scale with the number of devices. */
+static ATCA_STATUS bench_pool_sign(void)
+{
+    ATCA_STATUS status;
+    calib_pool_t pool;
+    calib_pool_stats_t stats;
+    t_bench_pool_slot slots[ATCA_POOL_MAX_DEVICES];
+    uint8_t msg[ATCA_SHA256_DIGEST_SIZE];
+    uint16_t key_id = 0;
+    uint32_t start;
+    uint32_t elapsed_us;
+    int submitted = 0;
+    int completed = 0;
+    int i;
+
+    memset(msg, 0x5A, sizeof(msg));
+    memset(slots, 0, sizeof(slots));
+    if ((status = atca_test_config_get_id(TEST_TYPE_ECC_SIGN, &key_id)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+    if ((status = calib_pool_init(&pool)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+    if ((status = calib_pool_add(&pool, atcab_get_device(), (uint16_t)(1u << key_id))) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+
+    start = hal_timestamp_us();
+    while (completed < bench_iterations && status == ATCA_SUCCESS)
+    {
+        // Keep one request per device in progress plus one queued
+        for (i = 0; i <= pool.count && i < ATCA_POOL_MAX_DEVICES; i++)
+        {
+            if (slots[i].busy)
+            {
+                continue;
+            }
+            if (slots[i].used)
+            {
+                slots[i].used = false;
+                status = slots[i].status;
+                completed++;
+            }
+            if (submitted < bench_iterations && status == ATCA_SUCCESS)
+            {
+                slots[i].busy = slots[i].used = true;
+                if ((status = calib_pool_sign(&pool, &slots[i].req, key_id, msg, slots[i].signature, bench_pool_callback, &slots[i])) != ATCA_SUCCESS)
+                {
+                    slots[i].busy = slots[i].used = false;
+                }
+                submitted++;
+            }
+        }
+        (void)calib_pool_tasks(&pool);
+    }
+    while (calib_pool_tasks(&pool))
+    {
+        ;
+    }
+    elapsed_us = hal_timestamp_us() - start;
+
+    if (status == ATCA_SUCCESS)
+    {
+        printf("{\"case\": \"pool_sign\", \"devices\": %u, \"iterations\": %d, \"elapsed_us\": %lu, \"ops_per_sec\": %lu}\r\n",
+               pool.count, bench_iterations, (unsigned long)elapsed_us,
+               (unsigned long)(elapsed_us ? (bench_iterations * 1000000ULL) / elapsed_us : 0));
+        for (i = 0; i < pool.count && calib_pool_get_stats(&pool, (uint8_t)i, &stats) == ATCA_SUCCESS; i++)
+        {
+            printf("{\"case\": \"pool_sign\", \"device\": %d, \"ops\": %lu, \"errors\": %lu, \"utilization_pct\": %u}\r\n",
+                   i, (unsigned long)stats.ops, (unsigned long)stats.errors, stats.utilization);
+        }
+    }
+    return status;
+}
+
+/** \brief Bit at a time CRC-16 the table driven atCRC replaced, kept as the
+ *         reference for bench_crc */
+static void bench_crc_bitwise(size_t length, const uint8_t* data, uint8_t* crc_le)
+{
+    size_t counter;
+    uint16_t crc_register = 0;
+    uint16_t polynom = 0x8005;
+    uint8_t shift_register;
+    uint8_t data_bit, crc_bit;
+
+    for (counter = 0; counter < length; counter++)
+    {
+        for (shift_register = 0x01; shift_register > 0x00; shift_register <<= 1)
+        {
+            data_bit = (data[counter] & shift_register) ? 1 : 0;
+            crc_bit = crc_register >> 15;
+            crc_register <<= 1;
+            if (data_bit != crc_bit)
+            {
+                crc_register ^= polynom;
+            }
+        }
+    }
+    crc_le[0] = (uint8_t)(crc_register & 0x00FF);
+    crc_le[1] = (uint8_t)(crc_register >> 8);
+}
+
+/** \brief Compares atCRC with the bit at a time loop over a command sized and
+ *         a TA100 frame sized buffer */
+static ATCA_STATUS bench_crc(void)
+{
+    static uint8_t data[1024];
+    const size_t sizes[] = { ATCA_CMD_SIZE_MAX, sizeof(data) };
+    uint8_t crc[ATCA_CRC_SIZE];
+    uint8_t crc_ref[ATCA_CRC_SIZE];
+    uint32_t start;
+    uint32_t bitwise_us;
+    uint32_t table_us;
+    size_t s;
+    size_t i;
+
+    for (i = 0; i < sizeof(data); i++)
+    {
+        data[i] = (uint8_t)(i * 37 + 11);
+    }
+
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        start = hal_timestamp_us();
+        for (i = 0; i < (size_t)bench_iterations; i++)
+        {
+            bench_crc_bitwise(sizes[s], data, crc_ref);
+        }
+        bitwise_us = hal_timestamp_us() - start;
+
+        start = hal_timestamp_us();
+        for (i = 0; i < (size_t)bench_iterations; i++)
+        {
+            atCRC(sizes[s], data, crc);
+        }
+        table_us = hal_timestamp_us() - start;
+
+        if (memcmp(crc, crc_ref, sizeof(crc)))
+        {
+            return ATCA_FUNC_FAIL;
+        }
+
+        printf("{\"case\": \"crc\", \"table\": %d, \"bytes\": %lu, \"iterations\": %d, \"bitwise_us\": %lu, \"table_us\": %lu}\r\n",
+               ATCA_CRC_TABLE, (unsigned long)sizes[s], bench_iterations, (unsigned long)bitwise_us, (unsigned long)table_us);
+    }
+    return ATCA_SUCCESS;
+}
+
+/** \brief Data buffer hashed, encrypted or MACed by the bulk cases */
+static uint8_t bench_data[1024];
+static uint8_t bench_out[1024];
+
+static void bench_fill_data(void)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(bench_data); i++)
+    {
+        bench_data[i] = (uint8_t)(i * 37 + 11);
+    }
+}
+
+typedef struct
+{
+    uint16_t key_id;
+    uint8_t  msg[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t  signature[ATCA_ECCP256_SIG_SIZE];
+    uint8_t  public_key[ATCA_ECCP256_PUBKEY_SIZE];
+} t_bench_ecc_param;
+
+static ATCA_STATUS bench_op_sign(void* param)
+{
+    t_bench_ecc_param* p = (t_bench_ecc_param*)param;
+
+    return atcab_sign(p->key_id, p->msg, p->signature);
+}
+
+static ATCA_STATUS bench_op_verify_extern(void* param)
+{
+    t_bench_ecc_param* p = (t_bench_ecc_param*)param;
+    ATCA_STATUS status;
+    bool is_verified = false;
+
+    if ((status = atcab_verify_extern(p->msg, p->signature, p->public_key, &is_verified)) == ATCA_SUCCESS && !is_verified)
+    {
+        status = ATCA_CHECKMAC_VERIFY_FAILED;
+    }
+    return status;
+}
+
+static ATCA_STATUS bench_op_ecdh(void* param)
+{
+    t_bench_ecc_param* p = (t_bench_ecc_param*)param;
+    uint8_t pms[ATCA_KEY_SIZE];
+
+    return atcab_ecdh(p->key_id, p->public_key, pms);
+}
+
+static ATCA_STATUS bench_op_genkey(void* param)
+{
+    t_bench_ecc_param* p = (t_bench_ecc_param*)param;
+
+    return atcab_genkey(p->key_id, p->public_key);
+}
+
+static ATCA_STATUS bench_op_random(void* param)
+{
+    (void)param;
+    return atcab_random(bench_out);
+}
+
+/** \brief Prepares a message, its signature and the public key of the sign
+ *         test slot */
+static ATCA_STATUS bench_ecc_setup(t_bench_ecc_param* p)
+{
+    ATCA_STATUS status;
+
+    memset(p, 0, sizeof(*p));
+    memset(p->msg, 0x5A, sizeof(p->msg));
+    if ((status = atca_test_config_get_id(TEST_TYPE_ECC_SIGN, &p->key_id)) == ATCA_SUCCESS)
+    {
+        if ((status = atcab_get_pubkey(p->key_id, p->public_key)) == ATCA_SUCCESS)
+        {
+            status = atcab_sign(p->key_id, p->msg, p->signature);
+        }
+    }
+    return status;
+}
+
+/** \brief ECDSA sign with the sign test slot */
+static ATCA_STATUS bench_sign(void)
+{
+    ATCA_STATUS status;
+    t_bench_ecc_param p;
+
+    if ((status = bench_ecc_setup(&p)) == ATCA_SUCCESS)
+    {
+        status = bench_latency("sign", 0, bench_op_sign, &p);
+    }
+    return status;
+}
+
+/** \brief ECDSA verify of a signature made by the sign test slot */
+static ATCA_STATUS bench_verify_extern(void)
+{
+    ATCA_STATUS status;
+    t_bench_ecc_param p;
+
+    if ((status = bench_ecc_setup(&p)) == ATCA_SUCCESS)
+    {
+        status = bench_latency("verify_extern", 0, bench_op_verify_extern, &p);
+    }
+    return status;
+}
+
+static ATCA_STATUS bench_op_verify_sw(void* param)
+{
+    t_bench_ecc_param* p = (t_bench_ecc_param*)param;
+
+    return (ATCA_STATUS)atcac_sw_ecdsa_verify_p256(p->msg, p->signature, p->public_key);
+}
+
+/** \brief Host software verify of the same signature as verify_extern, for
+ *         comparison with the device round trip */
+static ATCA_STATUS bench_verify_sw(void)
+{
+    ATCA_STATUS status;
+    t_bench_ecc_param p;
+
+    if ((status = bench_ecc_setup(&p)) == ATCA_SUCCESS)
+    {
+        status = bench_latency("verify_sw", 0, bench_op_verify_sw, &p);
+    }
+    return status;
+}
+
+typedef struct
+{
+    uint8_t msgs[ATCAC_ECC_P256_BATCH_CHUNK][ATCA_SHA256_DIGEST_SIZE];
+    uint8_t signatures[ATCAC_ECC_P256_BATCH_CHUNK][ATCA_ECCP256_SIG_SIZE];
+    uint8_t public_keys[ATCAC_ECC_P256_BATCH_CHUNK][ATCA_ECCP256_PUBKEY_SIZE];
+    bool    is_verified[ATCAC_ECC_P256_BATCH_CHUNK];
+} t_bench_batch_param;
+
+static ATCA_STATUS bench_op_verify_batch(void* param)
+{
+    t_bench_batch_param* p = (t_bench_batch_param*)param;
+    ATCA_STATUS status;
+    size_t i;
+
+    status = (ATCA_STATUS)atcac_sw_ecdsa_verify_p256_batch(ATCAC_ECC_P256_BATCH_CHUNK, &p->msgs[0][0],
+                                                           &p->signatures[0][0], &p->public_keys[0][0], p->is_verified);
+    for (i = 0; i < ATCAC_ECC_P256_BATCH_CHUNK && ATCA_SUCCESS == status; i++)
+    {
+        if (!p->is_verified[i])
+        {
+            status = ATCA_CHECKMAC_VERIFY_FAILED;
+        }
+    }
+    return status;
+}
+
+/** \brief Host software batch verify of ATCAC_ECC_P256_BATCH_CHUNK signatures
+ *         from the sign test slot; divide by the chunk size to compare with
+ *         verify_sw */
+static ATCA_STATUS bench_verify_batch(void)
+{
+    ATCA_STATUS status;
+    t_bench_ecc_param p;
+    static t_bench_batch_param batch;
+    size_t i;
+
+    if ((status = bench_ecc_setup(&p)) == ATCA_SUCCESS)
+    {
+        for (i = 0; i < ATCAC_ECC_P256_BATCH_CHUNK && ATCA_SUCCESS == status; i++)
+        {
+            memset(batch.msgs[i], (int)i, ATCA_SHA256_DIGEST_SIZE);
+            memcpy(batch.public_keys[i], p.public_key, ATCA_ECCP256_PUBKEY_SIZE);
+            status = atcab_sign(p.key_id, batch.msgs[i], batch.signatures[i]);
+        }
+    }
+    if (ATCA_SUCCESS == status)
+    {
+        status = bench_latency("verify_batch", 0, bench_op_verify_batch, &batch);
+    }
+    return status;
+}
+
+/** \brief ECDH between the ECDH test slot and the public key of the sign slot */
+static ATCA_STATUS bench_ecdh(void)
+{
+    ATCA_STATUS status;
+    t_bench_ecc_param p;
+
+    if ((status = bench_ecc_setup(&p)) == ATCA_SUCCESS)
+    {
+        if ((status = atca_test_config_get_id(TEST_TYPE_ECDH, &p.key_id)) == ATCA_SUCCESS)
+        {
+            status = bench_latency("ecdh", 0, bench_op_ecdh, &p);
+        }
+    }
+    return status;
+}
+
+/** \brief Private key generation in the genkey test slot */
+static ATCA_STATUS bench_genkey(void)
+{
+    ATCA_STATUS status;
+    t_bench_ecc_param p;
+
+    memset(&p, 0, sizeof(p));
+    if ((status = atca_test_config_get_id(TEST_TYPE_ECC_GENKEY, &p.key_id)) == ATCA_SUCCESS)
+    {
+        status = bench_latency("genkey", 0, bench_op_genkey, &p);
+    }
+    return status;
+}
+
+static ATCA_STATUS bench_random(void)
+{
+    return bench_latency("random", RANDOM_NUM_SIZE, bench_op_random, NULL);
+}
+
+static ATCA_STATUS bench_op_sha(void* param)
+{
+    size_t length = *(size_t*)param;
+    ATCA_STATUS status;
+    atca_sha256_ctx_t ctx;
+    size_t offset;
+
+    if ((status = atcab_hw_sha2_256_init(&ctx)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+    for (offset = 0; offset < length && status == ATCA_SUCCESS; offset += sizeof(bench_data))
+    {
+        status = atcab_hw_sha2_256_update(&ctx, bench_data, sizeof(bench_data));
+    }
+    if (status == ATCA_SUCCESS)
+    {
+        status = atcab_hw_sha2_256_finish(&ctx, bench_out);
+    }
+    return status;
+}
+
+/** \brief Device SHA-256 of 1 KB and 16 KB messages */
+static ATCA_STATUS bench_sha(void)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    size_t sizes[] = { 1024, 16384 };
+    size_t s;
+
+    bench_fill_data();
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && status == ATCA_SUCCESS; s++)
+    {
+        status = bench_latency("sha", sizes[s], bench_op_sha, &sizes[s]);
+    }
+    return status;
+}
+
+static ATCA_STATUS bench_op_sha_sw(void* param)
+{
+    size_t length = *(size_t*)param;
+    ATCA_STATUS status;
+    atcac_sha2_256_ctx ctx;
+    size_t offset;
+
+    if ((status = (ATCA_STATUS)atcac_sw_sha2_256_init(&ctx)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+    for (offset = 0; offset < length && status == ATCA_SUCCESS; offset += sizeof(bench_data))
+    {
+        status = (ATCA_STATUS)atcac_sw_sha2_256_update(&ctx, bench_data, sizeof(bench_data));
+    }
+    if (status == ATCA_SUCCESS)
+    {
+        status = (ATCA_STATUS)atcac_sw_sha2_256_finish(&ctx, bench_out);
+    }
+    return status;
+}
+
+/** \brief Host software SHA-256 of the same messages as the sha case,
+ *         cycles/byte is the CPU clock divided by bytes_per_sec */
+static ATCA_STATUS bench_sha_sw(void)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    size_t sizes[] = { 1024, 16384 };
+    size_t s;
+
+    bench_fill_data();
+    for (s = 0; s < sizeof(sizes) / sizeof(sizes[0]) && status == ATCA_SUCCESS; s++)
+    {
+        status = bench_latency("sha_sw", sizes[s], bench_op_sha_sw, &sizes[s]);
+    }
+    return status;
+}
+
+/** \brief Messages of the multi-buffer SHA-256 case, about the size of a
+ *         certificate TBS */
+#define BENCH_SHA_MULTI_COUNT       (32)
+#define BENCH_SHA_MULTI_SIZE        (256)
+
+typedef struct
+{
+    const uint8_t* msgs[BENCH_SHA_MULTI_COUNT];
+    size_t         sizes[BENCH_SHA_MULTI_COUNT];
+    uint8_t        digests[BENCH_SHA_MULTI_COUNT][ATCA_SHA256_DIGEST_SIZE];
+} t_bench_sha_multi_param;
+
+static ATCA_STATUS bench_op_sha_multi(void* param)
+{
+    t_bench_sha_multi_param* p = (t_bench_sha_multi_param*)param;
+
+    return (ATCA_STATUS)atcac_sw_sha2_256_multi(BENCH_SHA_MULTI_COUNT, p->msgs, p->sizes, &p->digests[0][0]);
+}
+
+static ATCA_STATUS bench_op_sha_serial(void* param)
+{
+    t_bench_sha_multi_param* p = (t_bench_sha_multi_param*)param;
+    ATCA_STATUS status = ATCA_SUCCESS;
+    size_t i;
+
+    for (i = 0; i < BENCH_SHA_MULTI_COUNT && status == ATCA_SUCCESS; i++)
+    {
+        status = (ATCA_STATUS)atcac_sw_sha2_256(p->msgs[i], p->sizes[i], p->digests[i]);
+    }
+    return status;
+}
+
+/** \brief Host software SHA-256 of many short messages, hashed together
+ *         (sha_multi) and one after the other (sha_serial) */
+static ATCA_STATUS bench_sha_multi(void)
+{
+    ATCA_STATUS status;
+    static t_bench_sha_multi_param p;
+    size_t i;
+
+    bench_fill_data();
+    for (i = 0; i < BENCH_SHA_MULTI_COUNT; i++)
+    {
+        p.msgs[i] = &bench_data[(i * 24) % (sizeof(bench_data) - BENCH_SHA_MULTI_SIZE)];
+        p.sizes[i] = BENCH_SHA_MULTI_SIZE;
+    }
+
+    status = bench_latency("sha_multi", BENCH_SHA_MULTI_COUNT * BENCH_SHA_MULTI_SIZE, bench_op_sha_multi, &p);
+    if (status == ATCA_SUCCESS)
+    {
+        status = bench_latency("sha_serial", BENCH_SHA_MULTI_COUNT * BENCH_SHA_MULTI_SIZE, bench_op_sha_serial, &p);
+    }
+    return status;
+}
+
+/** \brief Message sizes of the AES cases */
+static const size_t bench_aes_sizes[] = { 16, 64, 256, 1024 };
+
+static ATCA_STATUS bench_op_aes_gcm(void* param)
+{
+    size_t length = *(size_t*)param;
+    ATCA_STATUS status;
+    atca_aes_gcm_ctx_t ctx;
+    uint8_t iv[12] = { 0 };
+    uint8_t tag[AES_DATA_SIZE];
+
+    if ((status = atcab_aes_gcm_init(&ctx, ATCA_TEMPKEY_KEYID, 0, iv, sizeof(iv))) == ATCA_SUCCESS)
+    {
+        if ((status = atcab_aes_gcm_encrypt_update(&ctx, bench_data, (uint32_t)length, bench_out)) == ATCA_SUCCESS)
+        {
+            status = atcab_aes_gcm_encrypt_finish(&ctx, tag, sizeof(tag));
+        }
+    }
+    return status;
+}
+
+static ATCA_STATUS bench_op_aes_cmac(void* param)
+{
+    size_t length = *(size_t*)param;
+    ATCA_STATUS status;
+    atca_aes_cmac_ctx_t ctx;
+    uint8_t cmac[AES_DATA_SIZE];
+
+    if ((status = atcab_aes_cmac_init(&ctx, ATCA_TEMPKEY_KEYID, 0)) == ATCA_SUCCESS)
+    {
+        if ((status = atcab_aes_cmac_update(&ctx, bench_data, (uint32_t)length)) == ATCA_SUCCESS)
+        {
+            status = atcab_aes_cmac_finish(&ctx, cmac, sizeof(cmac));
+        }
+    }
+    return status;
+}
+
+static ATCA_STATUS bench_op_aes_ctr(void* param)
+{
+    size_t length = *(size_t*)param;
+    ATCA_STATUS status;
+    atca_aes_ctr_ctx_t ctx;
+    uint8_t iv[AES_DATA_SIZE] = { 0 };
+    size_t offset;
+
+    status = atcab_aes_ctr_init(&ctx, ATCA_TEMPKEY_KEYID, 0, 4, iv);
+    for (offset = 0; offset < length && status == ATCA_SUCCESS; offset += AES_DATA_SIZE)
+    {
+        status = atcab_aes_ctr_encrypt_block(&ctx, &bench_data[offset], &bench_out[offset]);
+    }
+    return status;
+}
+
+/** \brief Runs an AES mode over each of bench_aes_sizes with a key loaded into
+ *         TempKey. AES is an ATECC608A feature, other devices report
+ *         ATCA_UNIMPLEMENTED. */
+static ATCA_STATUS bench_aes(const char* name, fp_bench_op op)
+{
+    ATCA_STATUS status;
+    uint8_t key[ATCA_KEY_SIZE];
+    size_t length;
+    size_t s;
+
+    if (atcab_get_device_type() != ATECC608A)
+    {
+        return ATCA_UNIMPLEMENTED;
+    }
+
+    bench_fill_data();
+    memset(key, 0xA5, sizeof(key));
+    status = atcab_nonce_load(NONCE_MODE_TARGET_TEMPKEY, key, sizeof(key));
+    for (s = 0; s < sizeof(bench_aes_sizes) / sizeof(bench_aes_sizes[0]) && status == ATCA_SUCCESS; s++)
+    {
+        length = bench_aes_sizes[s];
+        status = bench_latency(name, length, op, &length);
+    }
+    return status;
+}
+
+static ATCA_STATUS bench_aes_gcm(void)
+{
+    return bench_aes("aes_gcm", bench_op_aes_gcm);
+}
+
+static ATCA_STATUS bench_aes_cmac(void)
+{
+    return bench_aes("aes_cmac", bench_op_aes_cmac);
+}
+
+static ATCA_STATUS bench_aes_ctr(void)
+{
+    return bench_aes("aes_ctr", bench_op_aes_ctr);
+}
+
+#define BENCH_CERT_MAX_LOCS         (16)
+#define BENCH_CERT_MAX_DATA         (1024)
+
+/** \brief Device data of a certificate, read once so the rebuild can be timed
+ *         without the device reads */
+typedef struct
+{
+    atcacert_device_loc_t locs[BENCH_CERT_MAX_LOCS];
+    size_t                count;
+    uint8_t               data[BENCH_CERT_MAX_DATA];
+    uint8_t               cert[512];
+    size_t                cert_size;
+} t_bench_cert_param;
+
+static t_bench_cert_param bench_cert;
+
+static ATCA_STATUS bench_op_cert_read(void* param)
+{
+    t_bench_cert_param* p = (t_bench_cert_param*)param;
+
+    p->cert_size = sizeof(p->cert);
+    return (ATCA_STATUS)atcacert_read_cert(&g_test_cert_def_0_device, NULL, p->cert, &p->cert_size);
+}
+
+static ATCA_STATUS bench_op_cert_rebuild(void* param)
+{
+    t_bench_cert_param* p = (t_bench_cert_param*)param;
+    atcacert_build_state_t state;
+    int ret;
+    size_t offset = 0;
+    size_t i;
+
+    p->cert_size = sizeof(p->cert);
+    ret = atcacert_cert_build_start(&state, &g_test_cert_def_0_device, p->cert, &p->cert_size, NULL);
+    for (i = 0; i < p->count && ret == ATCACERT_E_SUCCESS; i++)
+    {
+        ret = atcacert_cert_build_process(&state, &p->locs[i], &p->data[offset]);
+        offset += p->locs[i].count;
+    }
+    if (ret == ATCACERT_E_SUCCESS)
+    {
+        ret = atcacert_cert_build_finish(&state);
+    }
+    return (ATCA_STATUS)ret;
+}
+
+/** \brief Reads and rebuilds the test device certificate from the device */
+static ATCA_STATUS bench_cert_read(void)
+{
+    return bench_latency("cert_read", g_test_cert_def_0_device.cert_template_size, bench_op_cert_read, &bench_cert);
+}
+
+/** \brief Rebuilds the test device certificate from device data read in
+ *         advance, i.e. the host side cost of cert_read */
+static ATCA_STATUS bench_cert_rebuild(void)
+{
+    t_bench_cert_param* p = &bench_cert;
+    int ret;
+    size_t offset = 0;
+    size_t i;
+
+    ret = atcacert_get_device_locs(&g_test_cert_def_0_device, p->locs, &p->count, BENCH_CERT_MAX_LOCS, ATCA_BLOCK_SIZE);
+    for (i = 0; i < p->count && ret == ATCACERT_E_SUCCESS; i++)
+    {
+        if (offset + p->locs[i].count > sizeof(p->data))
+        {
+            return ATCA_INVALID_SIZE;
+        }
+        ret = atcacert_read_device_loc(&p->locs[i], &p->data[offset]);
+        offset += p->locs[i].count;
+    }
+    if (ret != ATCACERT_E_SUCCESS)
+    {
+        return (ATCA_STATUS)ret;
+    }
+    return bench_latency("cert_rebuild", g_test_cert_def_0_device.cert_template_size, bench_op_cert_rebuild, p);
+}
+
+static ATCA_STATUS bench_op_jwt(void* param)
+{
+    uint16_t key_id = *(uint16_t*)param;
+    ATCA_STATUS status;
+    atca_jwt_t jwt;
+
+    if ((status = atca_jwt_init(&jwt, (char*)bench_out, sizeof(bench_out))) == ATCA_SUCCESS)
+    {
+        if ((status = atca_jwt_add_claim_numeric(&jwt, "iat", 1577836800)) == ATCA_SUCCESS)
+        {
+            if ((status = atca_jwt_add_claim_numeric(&jwt, "exp", 1577840400)) == ATCA_SUCCESS)
+            {
+                if ((status = atca_jwt_add_claim_string(&jwt, "aud", "cryptoauthlib-bench")) == ATCA_SUCCESS)
+                {
+                    status = atca_jwt_finalize(&jwt, key_id);
+                }
+            }
+        }
+    }
+    return status;
+}
+
+/** \brief Creates a JWT signed with the sign test slot */
+static ATCA_STATUS bench_jwt(void)
+{
+    ATCA_STATUS status;
+    uint16_t key_id = 0;
+
+    if ((status = atca_test_config_get_id(TEST_TYPE_ECC_SIGN, &key_id)) == ATCA_SUCCESS)
+    {
+        status = bench_latency("jwt", 0, bench_op_jwt, &key_id);
+    }
+    return status;
+}
+#endif
+
+#ifdef ATCA_STATS
+/** \brief Prints the execution statistics the cases accumulated on the device */
+static void bench_print_stats(void)
+{
+    atca_stats_t stats;
+    uint8_t i;
+
+    if (atcab_get_stats(&stats) != ATCA_SUCCESS)
+    {
+        return;
+    }
+
+    printf("{\"stats\": \"iface\", \"wakes\": %lu, \"wake_failures\": %lu, \"crc_errors\": %lu, \"rx_no_response\": %lu, \"polls\": %lu, "
+           "\"tx_bytes\": %lu, \"rx_bytes\": %lu, \"wake_us\": %lu, \"transfer_us\": %lu, \"wait_us\": %lu}\r\n",
+           (unsigned long)stats.wakes, (unsigned long)stats.wake_failures, (unsigned long)stats.crc_errors,
+           (unsigned long)stats.rx_no_response, (unsigned long)stats.polls, (unsigned long)stats.tx_bytes,
+           (unsigned long)stats.rx_bytes, (unsigned long)stats.wake_us, (unsigned long)stats.transfer_us,
+           (unsigned long)stats.wait_us);
+    for (i = 0; i < stats.opcode_count; i++)
+    {
+        printf("{\"stats\": \"opcode\", \"opcode\": \"0x%02X\", \"count\": %lu, \"errors\": %lu, \"total_us\": %lu}\r\n",
+               stats.opcodes[i].opcode, (unsigned long)stats.opcodes[i].count, (unsigned long)stats.opcodes[i].errors,
+               (unsigned long)stats.opcodes[i].total_us);
+    }
+}
+#endif
+
+// *INDENT-OFF* - Preserve formatting
+static const t_bench_case_info bench_cases[] =
+{
+#if ATCA_CA_SUPPORT
+    { "session",       bench_session       },
+    { "async_sign",    bench_async_sign    },
+    { "wake_mode",     bench_wake_mode     },
+    { "pool_sign",     bench_pool_sign     },
+    { "crc",           bench_crc           },
+    { "sign",          bench_sign          },
+    { "verify_extern", bench_verify_extern },
+    { "verify_sw",     bench_verify_sw     },
+    { "verify_batch",  bench_verify_batch  },
+    { "ecdh",          bench_ecdh          },
+    { "genkey",        bench_genkey        },
+    { "random",        bench_random        },
+    { "sha",           bench_sha           },
+    { "sha_sw",        bench_sha_sw        },
+    { "sha_multi",     bench_sha_multi     },
+    { "aes_gcm",       bench_aes_gcm       },
+    { "aes_cmac",      bench_aes_cmac      },
+    { "aes_ctr",       bench_aes_ctr       },
+    { "cert_read",     bench_cert_read     },
+    { "cert_rebuild",  bench_cert_rebuild  },
+    { "jwt",           bench_jwt           },
+#endif
+    { NULL,            NULL                },
+};
+// *INDENT-ON*
+
+/** \brief Runs the named benchmark case, or every case when no name or "all"
+ *         is given, and prints one JSON result line per case followed by the
+ *         execution statistics of the run. An optional second argument
+ *         overrides ATCA_BENCH_ITERATIONS.
+ */
+int run_benchmarks(int argc, char* argv[])
+{
+    ATCA_STATUS status;
+    const t_bench_case_info* bench_case;
+    const char* args[2] = { NULL, NULL };
+    const char* name;
+    bool found = false;
+    int nargs = 0;
+    int i;
+
+    // Skip the options process_options() handled, all but -y take a value
+    for (i = 1; i < argc; i++)
+    {
+        if (argv[i][0] == '-')
+        {
+            i += strcmp(argv[i], "-y") ? 1 : 0;
+        }
+        else if (nargs < 2)
+        {
+            args[nargs++] = argv[i];
+        }
+    }
+    name = (args[0] && strcmp(args[0], "all")) ? args[0] : NULL;
+
+    bench_iterations = args[1] ? atoi(args[1]) : ATCA_BENCH_ITERATIONS;
+    if (bench_iterations <= 0)
+    {
+        printf("Invalid iteration count: %s\r\n", args[1]);
+        return ATCA_BAD_PARAM;
+    }
+
+    if ((status = atcab_init(gCfg)) != ATCA_SUCCESS)
+    {
+        printf("atcab_init() failed with ret=0x%08X\r\n", status);
+        return status;
+    }
+
+    for (bench_case = bench_cases; bench_case->name; bench_case++)
+    {
+        if (name && strcmp(name, bench_case->name))
+        {
+            continue;
+        }
+        found = true;
+        if ((status = bench_case->fp_bench()) != ATCA_SUCCESS)
+        {
+            printf("{\"case\": \"%s\", \"status\": %d}\r\n", bench_case->name, status);
+        }
+    }
+
+    if (name && !found)
+    {
+        printf("Unknown benchmark: %s\r\n", name);
+        status = ATCA_BAD_PARAM;
+    }
+#ifdef ATCA_STATS
+    else
+    {
+        bench_print_stats();
+    }
+#endif
+
+    atcab_release();
+
+    return status;
+}
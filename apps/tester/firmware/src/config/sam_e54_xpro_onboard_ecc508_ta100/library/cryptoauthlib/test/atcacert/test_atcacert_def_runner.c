@@ -228,6 +228,7 @@ TEST_GROUP_RUNNER(atcacert_get_tbs)
 TEST_GROUP_RUNNER(atcacert_get_tbs_digest)
 {
     RUN_TEST_CASE(atcacert_get_tbs_digest, good);
+    RUN_TEST_CASE(atcacert_get_tbs_digest, batch);
     RUN_TEST_CASE(atcacert_get_tbs_digest, bad_params);
 }
 
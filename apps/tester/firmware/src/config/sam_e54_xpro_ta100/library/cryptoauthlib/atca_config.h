@@ -42,20 +42,31 @@
 #define ATCA_POST_DELAY_MSEC 25
 #endif
 
+/** Keep traffic and per opcode execution statistics of the interfaces, see atcab_get_stats() */
+#ifndef ATCA_STATS
+#define ATCA_STATS
+#endif
+
 
 /* Define generic interfaces to the processor libraries */
 
+#define PLIB_SPI_CALLBACK       SERCOM_SPI_CALLBACK
+
 typedef bool (* atca_spi_plib_read)( void * , size_t );
 typedef bool (* atca_spi_plib_write)( void *, size_t );
+typedef bool (* atca_spi_plib_write_read)( void *, size_t, void *, size_t );
 typedef bool (* atca_spi_plib_is_busy)( void );
 typedef void (* atca_spi_plib_select)(uint32_t pin, bool value);
+typedef void (* atca_spi_plib_callback_register)(PLIB_SPI_CALLBACK callback, uintptr_t context);
 
 typedef struct atca_plib_spi_api
 {
     atca_spi_plib_read              read;
     atca_spi_plib_write             write;
+    atca_spi_plib_write_read        write_read;
     atca_spi_plib_is_busy           is_busy;
     atca_spi_plib_select            select;
+    atca_spi_plib_callback_register callback_register;
 } atca_plib_spi_api_t;
 
 extern atca_plib_spi_api_t sercom4_plib_spi_api;
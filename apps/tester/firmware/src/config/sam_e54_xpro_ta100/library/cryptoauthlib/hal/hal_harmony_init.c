@@ -40,8 +40,10 @@ static void sercom4_select_pin(uint32_t pin, bool value)
 atca_plib_spi_api_t sercom4_plib_spi_api = {
     .read = SERCOM4_SPI_Read,
     .write = SERCOM4_SPI_Write,
+    .write_read = SERCOM4_SPI_WriteRead,
     .is_busy = SERCOM4_SPI_IsBusy,
-    .select = &sercom4_select_pin
+    .select = &sercom4_select_pin,
+    .callback_register = SERCOM4_SPI_CallbackRegister
 };
 
 
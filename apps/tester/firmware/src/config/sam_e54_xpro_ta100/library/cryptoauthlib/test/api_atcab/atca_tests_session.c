@@ -0,0 +1,185 @@
+/**
+ * \file
+ * \brief Unity tests for the cryptoauthlib wake session API
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+#include <stdlib.h>
+#include "atca_test.h"
+
+#if ATCA_CA_SUPPORT
+
+TEST(atca_cmd_basic_test, session_nesting)
+{
+    ATCA_STATUS status;
+    uint8_t revision[4];
+    uint8_t randomnum[32];
+
+    status = atcab_session_begin();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_session_begin();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Inner end keeps the device awake for the outer session
+    status = atcab_session_end();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_random_ext(_gDevice, randomnum);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_session_end();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Unbalanced end
+    status = atcab_session_end();
+    TEST_ASSERT_EQUAL(ATCA_FUNC_FAIL, status);
+
+    // Commands outside of a session still manage wake/idle themselves
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+}
+
+TEST(atca_cmd_basic_test, session_watchdog_rewake)
+{
+    ATCA_STATUS status;
+    ATCADevice device = atcab_get_device();
+    uint16_t wake_budget_msec = device->wake_budget_msec;
+    uint32_t wake_timestamp_us;
+    uint8_t revision[4];
+
+#ifdef ATCA_STATS
+    atca_stats_t stats;
+
+    status = atcab_reset_stats();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+#endif
+
+    // Shrink the watchdog budget so it runs out between two commands
+    device->wake_budget_msec = 10;
+
+    status = atcab_session_begin();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    wake_timestamp_us = device->wake_timestamp_us;
+
+    // Let the watchdog budget run out - the next command has to wake the device again
+    atca_delay_ms(20);
+
+    status = atcab_info(revision);
+    device->wake_budget_msec = wake_budget_msec;
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_NOT_EQUAL(wake_timestamp_us, device->wake_timestamp_us);
+
+#ifdef ATCA_STATS
+    status = atcab_get_stats(&stats);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(2, stats.wakes);
+#endif
+
+    status = atcab_session_end();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+}
+
+TEST(atca_cmd_basic_test, session_idle_inside)
+{
+    ATCA_STATUS status;
+    uint8_t revision[4];
+
+    status = atcab_session_begin();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // An explicit idle ends the current wake but not the session
+    status = atcab_idle();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_session_end();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+}
+
+TEST(atca_cmd_basic_test, session_wake_mode)
+{
+    ATCA_STATUS status;
+    ATCADevice device = atcab_get_device();
+    ATCAIfaceCfg* cfg = atgetifacecfg(atGetIFace(device));
+    uint8_t wake_mode = cfg->wake_mode;
+    uint8_t revision[4];
+    uint8_t randomnum[32];
+
+    // The device stays awake between commands without an explicit session
+    cfg->wake_mode |= ATCA_WAKE_SESSION;
+
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, device->wake_active);
+
+    status = atcab_random_ext(_gDevice, randomnum);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, device->wake_active);
+
+    // Sessions nest inside the wake mode and do not idle the device
+    status = atcab_session_begin();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = atcab_session_end();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(1, device->wake_active);
+
+    status = atcab_idle();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(0, device->wake_active);
+
+    cfg->wake_mode = wake_mode;
+
+    status = atcab_info(revision);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(0, device->wake_active);
+}
+
+// *INDENT-OFF* - Preserve formatting
+t_test_case_info session_basic_test_info[] =
+{
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, session_nesting),         DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC },
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, session_watchdog_rewake), DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC },
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, session_idle_inside),     DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC },
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, session_wake_mode),       DEVICE_MASK(ATSHA204A) | DEVICE_MASK_ECC },
+    { (fp_test_case)NULL,                     (uint8_t)0 },/* Array Termination element*/
+};
+// *INDENT-ON*
+#else
+t_test_case_info session_basic_test_info[] =
+{
+    { (fp_test_case)NULL, (uint8_t)0 },
+};
+#endif
@@ -145,6 +145,201 @@ TEST(atca_cmd_basic_test, sign_internal)
 }
 #endif
 
+#if ATCA_CA_SUPPORT
+static void test_async_callback(ATCA_STATUS status, void* param)
+{
+    *(ATCA_STATUS*)param = status;
+}
+
+TEST(atca_cmd_basic_test, async_sign_verify)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCA_STATUS async_status;
+    calib_async_ctx_t ctx;
+    uint8_t msg[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t public_key[ATCA_ECCP256_PUBKEY_SIZE];
+    uint8_t signature[ATCA_ECCP256_SIG_SIZE];
+    uint16_t private_key_id = 0;
+    bool is_verified = false;
+    uint32_t loops;
+
+    test_assert_config_is_locked();
+    test_assert_data_is_locked();
+
+    status = atcab_random(msg);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atca_test_config_get_id(TEST_TYPE_ECC_GENKEY, &private_key_id);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_genkey(private_key_id, public_key);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Sign, the main loop keeps running while the device executes
+    async_status = ATCA_FUNC_FAIL;
+    status = atcab_async_sign(&ctx, private_key_id, msg, signature, test_async_callback, &async_status);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // Only one operation at a time per device
+    status = atcab_async_sign(&ctx, private_key_id, msg, signature, NULL, NULL);
+    TEST_ASSERT_EQUAL(ATCA_FUNC_FAIL, status);
+    status = atcab_random_ext(_gDevice, msg);
+    TEST_ASSERT_EQUAL(ATCA_FUNC_FAIL, status);
+
+    // Once the command is on the bus the main loop is free until the response is due
+    TEST_ASSERT(atcab_async_tasks());
+    TEST_ASSERT(atcab_async_idle_us() > 0);
+
+    for (loops = 0; atcab_async_tasks(); loops++)
+    {
+        ;
+    }
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, async_status);
+    TEST_ASSERT(loops > 1);
+
+    status = atcab_verify_extern(msg, signature, public_key, &is_verified);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(true, is_verified);
+
+#ifdef ATCA_STATS
+    // Every command of the operation is checked against the watchdog budget,
+    // with no budget left each of them starts from a fresh wake
+    {
+        ATCADevice device = atcab_get_device();
+        uint16_t wake_budget_msec = device->wake_budget_msec;
+        atca_stats_t stats;
+
+        device->wake_budget_msec = 1;
+        status = atcab_reset_stats();
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        status = atcab_async_sign(&ctx, private_key_id, msg, signature, test_async_callback, &async_status);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        while (atcab_async_tasks())
+        {
+            ;
+        }
+        device->wake_budget_msec = wake_budget_msec;
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, async_status);
+
+        status = atcab_get_stats(&stats);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        TEST_ASSERT_EQUAL(3, stats.wakes);
+    }
+#endif
+
+    // Verify the same signature asynchronously
+    async_status = ATCA_FUNC_FAIL;
+    status = atcab_async_verify_extern(&ctx, msg, signature, public_key, &is_verified, test_async_callback, &async_status);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    while (atcab_async_tasks())
+    {
+        ;
+    }
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, async_status);
+    TEST_ASSERT_EQUAL(true, is_verified);
+
+    // A modified signature has to fail verification
+    signature[0] ^= 0x01;
+    status = atcab_async_verify_extern(&ctx, msg, signature, public_key, &is_verified, test_async_callback, &async_status);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    while (atcab_async_tasks())
+    {
+        ;
+    }
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, async_status);
+    TEST_ASSERT_EQUAL(false, is_verified);
+}
+
+TEST(atca_cmd_basic_test, pool_sign_verify)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCA_STATUS async_status[3];
+    calib_pool_t pool;
+    calib_pool_request_t req[3];
+    calib_pool_stats_t stats;
+    uint8_t msg[ATCA_SHA256_DIGEST_SIZE];
+    uint8_t public_key[ATCA_ECCP256_PUBKEY_SIZE];
+    uint8_t signature[2][ATCA_ECCP256_SIG_SIZE];
+    uint8_t randomnum[RANDOM_NUM_SIZE];
+    uint16_t private_key_id = 0;
+    bool is_verified = false;
+    int i;
+
+    test_assert_config_is_locked();
+    test_assert_data_is_locked();
+
+    status = atcab_random(msg);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atca_test_config_get_id(TEST_TYPE_ECC_GENKEY, &private_key_id);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = atcab_genkey(private_key_id, public_key);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = calib_pool_init(&pool);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = calib_pool_add(&pool, atcab_get_device(), (uint16_t)(1u << private_key_id));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    // More requests than devices, the rest wait in the queue
+    for (i = 0; i < 3; i++)
+    {
+        async_status[i] = ATCA_FUNC_FAIL;
+    }
+    status = calib_pool_sign(&pool, &req[0], private_key_id, msg, signature[0], test_async_callback, &async_status[0]);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = calib_pool_sign(&pool, &req[1], private_key_id, msg, signature[1], test_async_callback, &async_status[1]);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    status = calib_pool_random(&pool, &req[2], randomnum, test_async_callback, &async_status[2]);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+
+    status = calib_pool_get_stats(&pool, 0, &stats);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(true, stats.busy);
+
+    while (calib_pool_tasks(&pool))
+    {
+        ;
+    }
+    for (i = 0; i < 3; i++)
+    {
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, async_status[i]);
+    }
+
+    for (i = 0; i < 2; i++)
+    {
+        status = atcab_verify_extern(msg, signature[i], public_key, &is_verified);
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+        TEST_ASSERT_EQUAL(true, is_verified);
+    }
+
+    // Verify runs on any device
+    async_status[0] = ATCA_FUNC_FAIL;
+    status = calib_pool_verify_extern(&pool, &req[0], msg, signature[0], public_key, &is_verified, test_async_callback, &async_status[0]);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    while (calib_pool_tasks(&pool))
+    {
+        ;
+    }
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, async_status[0]);
+    TEST_ASSERT_EQUAL(true, is_verified);
+
+    // No device holds the key
+    status = calib_pool_sign(&pool, &req[0], (uint16_t)(private_key_id ^ 1), msg, signature[0], test_async_callback, &async_status[0]);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(ATCA_NO_DEVICES, async_status[0]);
+
+    status = calib_pool_get_stats(&pool, 0, &stats);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, status);
+    TEST_ASSERT_EQUAL(4, stats.ops);
+    TEST_ASSERT_EQUAL(0, stats.errors);
+    TEST_ASSERT_EQUAL(true, stats.online);
+    TEST_ASSERT_EQUAL(false, stats.busy);
+    TEST_ASSERT(stats.utilization > 0);
+}
+#endif
+
 TEST(atca_cmd_basic_test, read_sig)
 {
     TEST_IGNORE_MESSAGE("Pending");
@@ -156,6 +351,10 @@ t_test_case_info sign_basic_test_info[] =
     { REGISTER_TEST_CASE(atca_cmd_basic_test, sign),          DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
 #ifdef ATCA_ECC_SUPPORT
     { REGISTER_TEST_CASE(atca_cmd_basic_test, sign_internal), DEVICE_MASK_ECC },
+#endif
+#if ATCA_CA_SUPPORT
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, async_sign_verify), DEVICE_MASK_ECC },
+    { REGISTER_TEST_CASE(atca_cmd_basic_test, pool_sign_verify),  DEVICE_MASK_ECC },
 #endif
     { REGISTER_TEST_CASE(atca_cmd_basic_test, read_sig),      DEVICE_MASK_ECC | DEVICE_MASK(TA100) },
     { (fp_test_case)NULL,                     (uint8_t)0 },   /* Array Termination element*/
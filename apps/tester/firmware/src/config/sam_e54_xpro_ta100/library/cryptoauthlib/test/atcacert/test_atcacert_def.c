@@ -3315,6 +3315,46 @@ TEST(atcacert_get_tbs_digest, good)
     TEST_ASSERT_EQUAL_MEMORY(tbs_digest_ref, tbs_digest, sizeof(tbs_digest_ref));
 }
 
+TEST(atcacert_get_tbs_digest, batch)
+{
+    int ret = 0;
+    uint8_t certs[3][512];
+    const uint8_t* cert_ptrs[3] = { certs[0], certs[1], certs[2] };
+    size_t cert_sizes[3] = { g_cert_def.cert_template_size, g_cert_def.cert_template_size, g_cert_def.cert_template_size };
+    uint8_t tbs_digests[3][32];
+    uint8_t tbs_digest[32];
+    size_t i;
+
+    TEST_ASSERT(sizeof(certs[0]) >= g_cert_def.cert_template_size);
+    for (i = 0; i < 3; i++)
+    {
+        memcpy(certs[i], g_cert_def_cert_template, g_cert_def.cert_template_size);
+        // Vary the TBS data between the certificates
+        certs[i][g_cert_def.tbs_cert_loc.offset + g_cert_def.tbs_cert_loc.count - 1] ^= (uint8_t)i;
+    }
+
+    ret = atcacert_get_tbs_digest_batch(&g_cert_def, 3, cert_ptrs, cert_sizes, &tbs_digests[0][0]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+
+    for (i = 0; i < 3; i++)
+    {
+        ret = atcacert_get_tbs_digest(&g_cert_def, certs[i], cert_sizes[i], tbs_digest);
+        TEST_ASSERT_EQUAL(ATCACERT_E_SUCCESS, ret);
+        TEST_ASSERT_EQUAL_MEMORY(tbs_digest, tbs_digests[i], sizeof(tbs_digest));
+    }
+
+    // One truncated certificate fails the whole batch
+    cert_sizes[1] = 10;
+    ret = atcacert_get_tbs_digest_batch(&g_cert_def, 3, cert_ptrs, cert_sizes, &tbs_digests[0][0]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_CERT, ret);
+
+    ret = atcacert_get_tbs_digest_batch(NULL, 3, cert_ptrs, cert_sizes, &tbs_digests[0][0]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+
+    ret = atcacert_get_tbs_digest_batch(&g_cert_def, 3, NULL, cert_sizes, &tbs_digests[0][0]);
+    TEST_ASSERT_EQUAL(ATCACERT_E_BAD_PARAMS, ret);
+}
+
 TEST(atcacert_get_tbs_digest, bad_params)
 {
     int ret = 0;
@@ -0,0 +1,227 @@
+/**
+ * \file
+ * \brief Host tests of the asynchronous execution and the device pool
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+
+#include <string.h>
+
+#include "cryptoauthlib.h"
+#include "calib/calib_async.h"
+#include "calib/calib_pool.h"
+#include "hal_sim.h"
+#include "third_party/unity/unity.h"
+#include "third_party/unity/unity_fixture.h"
+
+/* Two simulated ATECC608A, each with its own device context, for the cases
+ * that need more than the one device of the tester. */
+
+/* Referenced by the device selection commands of the simulator */
+ATCAIfaceCfg* gCfg;
+
+#define ASYNC_SIM_LOCK_CONFIG   (87)    //!< Configuration zone lock byte
+
+static hal_sim_device_t g_async_sim[2];
+static hal_sim_bus_t g_async_bus;
+static ATCAIfaceCfg g_async_cfg[2];
+static ATCADevice g_async_device[2];
+
+static void async_sim_init(void)
+{
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        hal_sim_reset(&g_async_sim[i], ATECC608A);
+        hal_sim_config(&g_async_cfg[i], ATECC608A, &g_async_sim[i]);
+        g_async_device[i] = NULL;
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_init_ext(&g_async_device[i], &g_async_cfg[i]));
+    }
+}
+
+static void async_sim_release(void)
+{
+    int i;
+
+    for (i = 0; i < 2; i++)
+    {
+        (void)atcab_release_ext(&g_async_device[i]);
+    }
+}
+
+static void async_test_callback(ATCA_STATUS status, void* param)
+{
+    *(ATCA_STATUS*)param = status;
+}
+
+TEST_GROUP(calib_pool);
+
+TEST_SETUP(calib_pool)
+{
+    async_sim_init();
+}
+
+TEST_TEAR_DOWN(calib_pool)
+{
+    async_sim_release();
+}
+
+TEST(calib_pool, failover)
+{
+    ATCA_STATUS async_status = ATCA_FUNC_FAIL;
+    calib_pool_t pool;
+    calib_pool_request_t req;
+    calib_pool_stats_t stats;
+    uint8_t randomnum[RANDOM_NUM_SIZE];
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_init(&pool));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_add(&pool, g_async_device[0], 0));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_add(&pool, g_async_device[1], 0));
+
+    // The request goes to the first device, which doesn't answer
+    g_async_sim[0].unresponsive = true;
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_random(&pool, &req, randomnum, async_test_callback, &async_status));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_get_stats(&pool, 0, &stats));
+    TEST_ASSERT_EQUAL(true, stats.busy);
+    while (calib_pool_tasks(&pool))
+    {
+        ;
+    }
+
+    // and completes on the second one
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, async_status);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_get_stats(&pool, 0, &stats));
+    TEST_ASSERT_EQUAL(0, stats.ops);
+    TEST_ASSERT_EQUAL(1, stats.errors);
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_get_stats(&pool, 1, &stats));
+    TEST_ASSERT_EQUAL(1, stats.ops);
+    TEST_ASSERT_EQUAL(0, stats.errors);
+}
+
+TEST(calib_pool, all_failed)
+{
+    ATCA_STATUS async_status = ATCA_FUNC_FAIL;
+    calib_pool_t pool;
+    calib_pool_request_t req;
+    uint8_t randomnum[RANDOM_NUM_SIZE];
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_init(&pool));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_add(&pool, g_async_device[0], 0));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_add(&pool, g_async_device[1], 0));
+
+    // The request reports why the devices failed rather than ATCA_NO_DEVICES
+    g_async_sim[0].unresponsive = true;
+    g_async_sim[1].unresponsive = true;
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_pool_random(&pool, &req, randomnum, async_test_callback, &async_status));
+    while (calib_pool_tasks(&pool))
+    {
+        ;
+    }
+    TEST_ASSERT_EQUAL(ATCA_WAKE_FAILED, async_status);
+}
+
+TEST_GROUP_RUNNER(calib_pool)
+{
+    RUN_TEST_CASE(calib_pool, failover);
+    RUN_TEST_CASE(calib_pool, all_failed);
+}
+
+TEST_GROUP(calib_async);
+
+TEST_SETUP(calib_async)
+{
+    async_sim_init();
+
+    // Both devices on one bus. Only the second one has a locked config
+    // zone, which makes its random numbers differ from the fixed pattern
+    // of the first one.
+    memset(&g_async_bus, 0, sizeof(g_async_bus));
+    hal_sim_bus_attach(&g_async_bus, &g_async_sim[0]);
+    hal_sim_bus_attach(&g_async_bus, &g_async_sim[1]);
+    g_async_sim[1].config[ASYNC_SIM_LOCK_CONFIG] = 0x00;
+}
+
+TEST_TEAR_DOWN(calib_async)
+{
+    async_sim_release();
+}
+
+TEST(calib_async, shared_bus)
+{
+    static const uint8_t pattern[4] = { 0xFF, 0xFF, 0x00, 0x00 };
+    ATCA_STATUS async_status[2] = { ATCA_FUNC_FAIL, ATCA_FUNC_FAIL };
+    calib_async_ctx_t ctx[2];
+    calib_async_ctx_t busy_ctx;
+    uint8_t randomnum[2][RANDOM_NUM_SIZE];
+    uint8_t busy_randomnum[RANDOM_NUM_SIZE];
+    int i;
+
+    memset(randomnum, 0, sizeof(randomnum));
+    for (i = 0; i < 2; i++)
+    {
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, calib_async_random(g_async_device[i], &ctx[i], randomnum[i], async_test_callback, &async_status[i]));
+    }
+
+    // A device runs one operation at a time
+    TEST_ASSERT_EQUAL(ATCA_FUNC_FAIL, calib_async_random(g_async_device[0], &busy_ctx, busy_randomnum, async_test_callback, NULL));
+
+    while (calib_async_tasks())
+    {
+        ;
+    }
+
+    // Every caller gets the result of its own device
+    for (i = 0; i < 2; i++)
+    {
+        TEST_ASSERT_EQUAL(ATCA_SUCCESS, async_status[i]);
+        TEST_ASSERT_EQUAL_PTR(g_async_device[i], ctx[i].device);
+        TEST_ASSERT_FALSE(calib_async_is_busy(g_async_device[i]));
+    }
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(pattern, randomnum[0], sizeof(pattern));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(&randomnum[0][0], &randomnum[0][sizeof(pattern)], sizeof(randomnum[0]) - sizeof(pattern));
+    TEST_ASSERT(memcmp(randomnum[0], randomnum[1], sizeof(randomnum[0])) != 0);
+
+    // One transfer at a time on the bus, and the second device got its
+    // command while the first one was executing
+    TEST_ASSERT(g_async_bus.transfers > 0);
+    TEST_ASSERT_EQUAL(0, g_async_bus.collisions);
+    TEST_ASSERT(g_async_bus.overlapped > 0);
+}
+
+TEST_GROUP_RUNNER(calib_async)
+{
+    RUN_TEST_CASE(calib_async, shared_bus);
+}
+
+static void async_run_tests(void)
+{
+    RUN_TEST_GROUP(calib_pool);
+    RUN_TEST_GROUP(calib_async);
+}
+
+int main(int argc, const char* argv[])
+{
+    return UnityMain(argc, argv, async_run_tests);
+}
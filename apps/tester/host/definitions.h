@@ -0,0 +1,56 @@
+/**
+ * \file
+ * \brief Host stand-in for the Harmony generated definitions.h
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#ifndef DEFINITIONS_H
+#define DEFINITIONS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/* The library's atca_config.h is generated for the SAM E54 Xplained Pro and
+ * describes its I2C plib. These types let the host build compile the I2C HAL,
+ * which stays unused as the host talks to the simulated device instead. */
+typedef enum
+{
+    SERCOM_I2C_ERROR_NONE,
+    SERCOM_I2C_ERROR_NAK,
+    SERCOM_I2C_ERROR_BUS
+} SERCOM_I2C_ERROR;
+
+typedef struct
+{
+    uint32_t clkSpeed;
+} SERCOM_I2C_TRANSFER_SETUP;
+
+typedef void (*SERCOM_I2C_CALLBACK)(uintptr_t contextHandle);
+
+void hal_delay_ms(uint32_t delay);
+void hal_delay_us(uint32_t delay);
+
+#endif /* DEFINITIONS_H */
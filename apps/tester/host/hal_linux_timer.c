@@ -0,0 +1,104 @@
+/**
+ * \file
+ * \brief Timer and delay functions for the Linux host build
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <time.h>
+
+#include "cryptoauthlib.h"
+
+/** \defgroup hal_ Hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ *
+   @{ */
+
+/** \brief Time added by delays that were skipped rather than slept */
+static uint64_t hal_virtual_us;
+
+/** \brief Set once the delay mode has been read from the environment */
+static int hal_realtime = -1;
+
+/** \brief Delays sleep when ATCA_HOST_REALTIME is set in the environment.
+ *         Otherwise a delay only advances hal_timestamp_us(), so test runs
+ *         against the simulated device still see the modeled latencies
+ *         without waiting for them.
+ */
+static bool hal_delay_realtime(void)
+{
+    if (hal_realtime < 0)
+    {
+        const char* env = getenv("ATCA_HOST_REALTIME");
+        hal_realtime = (env && *env && *env != '0') ? 1 : 0;
+    }
+    return hal_realtime ? true : false;
+}
+
+/** \brief Retrieve a free running timestamp in us. Skipped delays are
+ *         included, so differences between two values match what the device
+ *         would have taken.
+ */
+uint32_t hal_timestamp_us(void)
+{
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + (uint64_t)ts.tv_nsec / 1000 + hal_virtual_us);
+}
+
+/** \brief This function delays for a number of microseconds.
+ *
+ * \param[in] delay number of microseconds to delay
+ */
+void hal_delay_us(uint32_t delay)
+{
+    struct timespec ts;
+
+    if (hal_delay_realtime())
+    {
+        ts.tv_sec = delay / 1000000;
+        ts.tv_nsec = (long)(delay % 1000000) * 1000;
+        while (nanosleep(&ts, &ts) != 0)
+        {
+        }
+    }
+    else
+    {
+        hal_virtual_us += delay;
+    }
+}
+
+/** \brief This function delays for a number of milliseconds.
+ *
+ * \param[in] delay number of milliseconds to delay
+ */
+void hal_delay_ms(uint32_t delay)
+{
+    hal_delay_us(delay * 1000);
+}
+
+/** @} */
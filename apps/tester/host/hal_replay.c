@@ -0,0 +1,369 @@
+/**
+ * \file
+ * \brief Replay of a recorded HAL trace for host builds
+ *
+ * A trace dumped with the recdump command of the tester is played back
+ * through the custom HAL in place of a device. Every call the library makes
+ * is matched against the next record: sent packets have to be identical,
+ * responses are returned with the recorded data no earlier than the recorded
+ * time since the command was sent. The first call that doesn't match the
+ * trace is reported and fails along with every call after it.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cryptoauthlib.h"
+#include "hal/hal_recorder.h"
+#include "hal_replay.h"
+
+/** \defgroup hal_ Hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ *
+   @{ */
+
+#define REPLAY_BEGIN    "-----BEGIN ATCA TRACE-----"
+#define REPLAY_END      "-----END ATCA TRACE-----"
+
+static uint8_t* replay_trace;       // loaded trace including its header
+static size_t replay_size;
+static size_t replay_pos;           // offset of the next record
+static unsigned replay_index;       // number of the next record, for messages
+static bool replay_loaded;
+static bool replay_failed;          // set on the first call that doesn't match the trace
+
+static uint32_t replay_rec_send_us; // recorded start of the last send
+static uint32_t replay_send_us;     // hal_timestamp_us() when the last send was replayed
+
+static int replay_hexval(char c)
+{
+    return isdigit((unsigned char)c) ? c - '0' : tolower((unsigned char)c) - 'a' + 10;
+}
+
+static const char* replay_name(uint8_t type)
+{
+    static const char* names[] = { "?", "wake", "idle", "sleep", "send", "receive" };
+
+    return (type < sizeof(names) / sizeof(names[0])) ? names[type] : names[0];
+}
+
+/** \brief Report a call that doesn't match the trace. Replay stops here. */
+static ATCA_STATUS replay_diverged(const char* reason, uint8_t type)
+{
+    if (!replay_failed)
+    {
+        printf("Replay diverged at record %u (%s): %s\r\n", replay_index, replay_name(type), reason);
+        replay_failed = true;
+    }
+    return ATCA_COMM_FAIL;
+}
+
+/** \brief Decode the record at an offset into the trace
+ * \return Size of the record, 0 at the end of the trace
+ */
+static size_t replay_peek(size_t pos, hal_rec_t* rec)
+{
+    if (replay_trace == NULL || pos >= replay_size)
+    {
+        return 0;
+    }
+    return hal_recorder_decode(&replay_trace[pos], replay_size - pos, rec);
+}
+
+/** \brief Consume the next record, which has to be of the given type. The
+ *         call takes as long as it did when it was recorded.
+ */
+static bool replay_next(uint8_t type, hal_rec_t* rec)
+{
+    size_t size;
+
+    if (replay_failed)
+    {
+        return false;
+    }
+    if ((size = replay_peek(replay_pos, rec)) == 0)
+    {
+        (void)replay_diverged("end of trace", type);
+        return false;
+    }
+    if (rec->type != type)
+    {
+        printf("Replay expected %s, the library called %s\r\n", replay_name(rec->type), replay_name(type));
+        (void)replay_diverged("unexpected call", type);
+        return false;
+    }
+    replay_pos += size;
+    replay_index++;
+    atca_delay_us(rec->duration_us);
+    return true;
+}
+
+static ATCA_STATUS hal_replay_init(void* hal, void* cfg)
+{
+    (void)hal;
+    (void)cfg;
+    return ATCA_SUCCESS;
+}
+
+static ATCA_STATUS hal_replay_post_init(void* iface)
+{
+    (void)iface;
+    return ATCA_SUCCESS;
+}
+
+static ATCA_STATUS hal_replay_send(void* iface, uint8_t word_address, uint8_t* txdata, int txlength)
+{
+    hal_rec_t rec;
+    uint32_t start_us = hal_timestamp_us();
+
+    (void)iface;
+    if (!replay_next(HAL_REC_SEND, &rec))
+    {
+        return ATCA_COMM_FAIL;
+    }
+    // txdata[0] is reserved for the word address, the packet follows
+    if (rec.length != (size_t)txlength + 1 || rec.payload[0] != word_address ||
+        memcmp(&rec.payload[1], &txdata[1], (size_t)txlength) != 0)
+    {
+        replay_index--;
+        return replay_diverged("packet differs", HAL_REC_SEND);
+    }
+    replay_rec_send_us = rec.start_us;
+    replay_send_us = start_us;
+    return rec.status;
+}
+
+/** \brief Receives are matched by sequence. Polls that failed while the
+ *         command executed are skipped and the next recorded response is
+ *         returned, waiting for the rest of the time it took to arrive after
+ *         the send if the library asks early. The number of polls doesn't
+ *         have to match the recording, e.g. a trace recorded with polling
+ *         replays with ATCA_NO_POLL and the other way round.
+ */
+static ATCA_STATUS hal_replay_receive(void* iface, uint8_t word_address, uint8_t* rxdata, uint16_t* rxlength)
+{
+    hal_rec_t rec;
+    size_t pos = replay_pos;
+    size_t size;
+    unsigned skipped = 0;
+    uint16_t len;
+    int32_t early_us;
+
+    (void)iface;
+    (void)word_address;
+    if (replay_failed)
+    {
+        return ATCA_COMM_FAIL;
+    }
+    while ((size = replay_peek(pos, &rec)) > 0 && rec.type == HAL_REC_RECEIVE && rec.status != ATCA_SUCCESS)
+    {
+        pos += size;
+        skipped++;
+    }
+
+    if (size > 0 && rec.type == HAL_REC_RECEIVE)
+    {
+        early_us = (int32_t)((rec.start_us - replay_rec_send_us) - (hal_timestamp_us() - replay_send_us));
+        if (early_us > 0)
+        {
+            atca_delay_us((uint32_t)early_us);
+        }
+        replay_pos = pos;
+        replay_index += skipped;
+        (void)replay_next(HAL_REC_RECEIVE, &rec);
+
+        len = (uint16_t)(rec.length - 1);
+        if (len > *rxlength)
+        {
+            return replay_diverged("response larger than the receive buffer", HAL_REC_RECEIVE);
+        }
+        memcpy(rxdata, &rec.payload[1], len);
+        *rxlength = len;
+        return ATCA_SUCCESS;
+    }
+
+    // Polls that failed for good, e.g. before the library gave up on a command
+    if (!replay_next(HAL_REC_RECEIVE, &rec))
+    {
+        return ATCA_COMM_FAIL;
+    }
+    return rec.status;
+}
+
+static ATCA_STATUS hal_replay_wake(void* iface)
+{
+    hal_rec_t rec;
+
+    (void)iface;
+    return replay_next(HAL_REC_WAKE, &rec) ? rec.status : ATCA_COMM_FAIL;
+}
+
+static ATCA_STATUS hal_replay_idle(void* iface)
+{
+    hal_rec_t rec;
+
+    (void)iface;
+    return replay_next(HAL_REC_IDLE, &rec) ? rec.status : ATCA_COMM_FAIL;
+}
+
+static ATCA_STATUS hal_replay_sleep(void* iface)
+{
+    hal_rec_t rec;
+
+    (void)iface;
+    return replay_next(HAL_REC_SLEEP, &rec) ? rec.status : ATCA_COMM_FAIL;
+}
+
+static ATCA_STATUS hal_replay_release(void* hal_data)
+{
+    (void)hal_data;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Load a trace as printed by the recdump command. Text outside of the
+ *         BEGIN and END lines is ignored, so a captured console log can be
+ *         used as is.
+ * \param[in] path  File holding the trace
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS hal_replay_load(const char* path)
+{
+    FILE* fp;
+    char line[256];
+    bool in_trace = false;
+    bool found = false;
+    int nibble = -1;
+    char* c;
+
+    if (path == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+    if ((fp = fopen(path, "r")) == NULL)
+    {
+        return ATCA_FUNC_FAIL;
+    }
+    free(replay_trace);
+    if ((replay_trace = malloc(HAL_REPLAY_MAX_SIZE)) == NULL)
+    {
+        fclose(fp);
+        return ATCA_ALLOC_FAILURE;
+    }
+    replay_size = 0;
+
+    while (fgets(line, sizeof(line), fp))
+    {
+        if (strstr(line, REPLAY_BEGIN))
+        {
+            in_trace = found = true;
+            replay_size = 0;
+            continue;
+        }
+        if (strstr(line, REPLAY_END))
+        {
+            in_trace = false;
+            continue;
+        }
+        for (c = line; in_trace && *c; c++)
+        {
+            if (!isxdigit((unsigned char)*c))
+            {
+                continue;
+            }
+            if (nibble < 0)
+            {
+                nibble = replay_hexval(*c);
+            }
+            else if (replay_size < HAL_REPLAY_MAX_SIZE)
+            {
+                replay_trace[replay_size++] = (uint8_t)((nibble << 4) | replay_hexval(*c));
+                nibble = -1;
+            }
+        }
+    }
+    fclose(fp);
+
+    if (!found || replay_size < HAL_REC_TRACE_HEADER_SIZE || memcmp(replay_trace, HAL_REC_MAGIC, 4) != 0 ||
+        replay_trace[4] != HAL_REC_VERSION)
+    {
+        replay_size = 0;
+        return ATCA_PARSE_ERROR;
+    }
+
+    replay_pos = HAL_REC_TRACE_HEADER_SIZE;
+    replay_index = 0;
+    replay_failed = false;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Set up an interface configuration to replay the trace named by
+ *         ATCA_HOST_REPLAY. The trace is loaded on the first call and played
+ *         on from where it stopped when a device is selected again.
+ * \param[out] cfg      Interface configuration to fill in
+ * \param[in]  devtype  Device type to use when the trace doesn't name one
+ * \return true when a trace is replayed, false to use the simulated device
+ */
+bool hal_replay_config(ATCAIfaceCfg* cfg, ATCADeviceType devtype)
+{
+    const char* path = getenv(HAL_REPLAY_ENV);
+    ATCA_STATUS status;
+
+    if (path == NULL || *path == '\0')
+    {
+        return false;
+    }
+    if (!replay_loaded)
+    {
+        replay_loaded = true;
+        if ((status = hal_replay_load(path)) != ATCA_SUCCESS)
+        {
+            printf("Unable to load the trace %s (0x%02X)\r\n", path, status);
+            replay_failed = true;
+        }
+    }
+    if (replay_size >= HAL_REC_TRACE_HEADER_SIZE && replay_trace[5] != (uint8_t)ATCA_DEV_UNKNOWN)
+    {
+        devtype = (ATCADeviceType)replay_trace[5];
+    }
+
+    cfg->iface_type = ATCA_CUSTOM_IFACE;
+    cfg->devtype = devtype;
+    cfg->atcacustom.halinit = hal_replay_init;
+    cfg->atcacustom.halpostinit = hal_replay_post_init;
+    cfg->atcacustom.halsend = hal_replay_send;
+    cfg->atcacustom.halreceive = hal_replay_receive;
+    cfg->atcacustom.halwake = hal_replay_wake;
+    cfg->atcacustom.halidle = hal_replay_idle;
+    cfg->atcacustom.halsleep = hal_replay_sleep;
+    cfg->atcacustom.halrelease = hal_replay_release;
+    cfg->cfg_data = NULL;
+    return true;
+}
+
+/** @} */
@@ -0,0 +1,2730 @@
+/**
+ * \file
+ * \brief Software model of an ATECC508A/ATECC608A for host builds
+ *
+ * The model is attached to the library through the custom HAL. Commands are
+ * executed when they are sent, the response becomes readable once half of
+ * the maximum execution time of the command (calib_get_execution_time()) has
+ * passed on hal_timestamp_us(), so polling, the watchdog and wake sessions
+ * behave as they do on hardware.
+ * The symmetric MACs are computed with the host helpers in atca_host.c, the
+ * ECC and AES operations with OpenSSL.
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include <string.h>
+#include <stdio.h>
+
+#include <openssl/bn.h>
+#include <openssl/ec.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/obj_mac.h>
+#include <openssl/rand.h>
+#include <openssl/sha.h>
+
+#include "cryptoauthlib.h"
+#include "atca_test.h"
+#include "hal_sim.h"
+#include "hal_replay.h"
+
+/** \defgroup hal_ Hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ *
+   @{ */
+
+#define SIM_STATUS_MISCOMPARE   ((uint8_t)0x01)     //!< CheckMac, Verify or SecureBoot miscompare
+
+/* Configuration zone offsets */
+#define SIM_CFG_AES_ENABLE      (13)
+#define SIM_CFG_COUNT_MATCH     (18)
+#define SIM_CFG_CHIP_MODE       (19)
+#define SIM_CFG_SLOT_CONFIG     (20)
+#define SIM_CFG_COUNTER         (52)
+#define SIM_CFG_VOL_KEY_PERMIT  (68)
+#define SIM_CFG_SECURE_BOOT     (70)
+#define SIM_CFG_KDF_IV_LOC      (72)
+#define SIM_CFG_KDF_IV_STR      (73)
+#define SIM_CFG_USER_EXTRA      (84)
+#define SIM_CFG_LOCK_VALUE      (86)
+#define SIM_CFG_LOCK_CONFIG     (87)
+#define SIM_CFG_SLOT_LOCKED     (88)
+#define SIM_CFG_CHIP_OPTIONS    (90)
+#define SIM_CFG_KEY_CONFIG      (96)
+
+/* SlotConfig bits */
+#define SIM_SLOT_NOMAC          ((uint16_t)0x0010)
+#define SIM_SLOT_LIMITED_USE    ((uint16_t)0x0020)
+#define SIM_SLOT_ENCRYPT_READ   ((uint16_t)0x0040)
+#define SIM_SLOT_IS_SECRET      ((uint16_t)0x0080)
+
+/* KeyConfig bits */
+#define SIM_KEY_PRIVATE         ((uint16_t)0x0001)
+#define SIM_KEY_PUBINFO         ((uint16_t)0x0002)
+#define SIM_KEY_LOCKABLE        ((uint16_t)0x0020)
+#define SIM_KEY_PERSIST_DISABLE ((uint16_t)0x1000)
+#define SIM_KEY_TYPE_P256       (4)
+#define SIM_KEY_TYPE_AES        (6)
+
+/* Validity nibble of validated public keys */
+#define SIM_PUBKEY_VALID        (0x5)
+#define SIM_PUBKEY_INVALID      (0xA)
+
+#define SIM_WATCHDOG_USEC       (1300000)
+#define SIM_WATCHDOG_LONG_USEC  (13000000)
+
+/** \brief Device that interfaces without cfg_data talk to */
+static hal_sim_device_t hal_sim_default_device;
+static bool hal_sim_default_init;
+
+/** \brief Serial number and revision of the simulated devices */
+static const uint8_t hal_sim_sn[ATCA_SERIAL_NUM_SIZE] = { 0x01, 0x23, 0x84, 0x8A, 0x9D, 0x7C, 0xE9, 0x57, 0xEE };
+static const uint8_t hal_sim_rev_508[4] = { 0x00, 0x00, 0x50, 0x00 };
+static const uint8_t hal_sim_rev_608[4] = { 0x00, 0x00, 0x60, 0x02 };
+
+/** \brief Command handler. Returns the status byte of the response unless
+ *         the handler produced output, in which case out_len is set.
+ */
+typedef uint8_t (*hal_sim_handler_t)(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                                     const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len);
+
+typedef struct
+{
+    uint8_t           opcode;
+    uint8_t           devices;  // device mask, bit 0 ATECC508A, bit 1 ATECC608A
+    hal_sim_handler_t handler;
+} hal_sim_command_t;
+
+/*----------------------------------------------------------------------------
+ * Device state helpers
+ *--------------------------------------------------------------------------*/
+
+static uint32_t sim_le32(const uint8_t* buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+static void sim_put_le32(uint8_t* buf, uint32_t value)
+{
+    buf[0] = (uint8_t)value;
+    buf[1] = (uint8_t)(value >> 8);
+    buf[2] = (uint8_t)(value >> 16);
+    buf[3] = (uint8_t)(value >> 24);
+}
+
+static bool sim_is_608(const hal_sim_device_t* dev)
+{
+    return dev->devtype == ATECC608A;
+}
+
+static bool sim_config_locked(const hal_sim_device_t* dev)
+{
+    return dev->config[SIM_CFG_LOCK_CONFIG] != 0x55;
+}
+
+static bool sim_data_locked(const hal_sim_device_t* dev)
+{
+    return dev->config[SIM_CFG_LOCK_VALUE] != 0x55;
+}
+
+static uint16_t sim_slot_config(const hal_sim_device_t* dev, uint16_t slot)
+{
+    return (uint16_t)dev->config[SIM_CFG_SLOT_CONFIG + slot * 2] | ((uint16_t)dev->config[SIM_CFG_SLOT_CONFIG + slot * 2 + 1] << 8);
+}
+
+static uint16_t sim_key_config(const hal_sim_device_t* dev, uint16_t slot)
+{
+    return (uint16_t)dev->config[SIM_CFG_KEY_CONFIG + slot * 2] | ((uint16_t)dev->config[SIM_CFG_KEY_CONFIG + slot * 2 + 1] << 8);
+}
+
+static uint8_t sim_key_type(const hal_sim_device_t* dev, uint16_t slot)
+{
+    return (uint8_t)((sim_key_config(dev, slot) >> 2) & 0x07);
+}
+
+static uint8_t sim_write_config(const hal_sim_device_t* dev, uint16_t slot)
+{
+    return (uint8_t)(sim_slot_config(dev, slot) >> 12);
+}
+
+static bool sim_slot_locked(const hal_sim_device_t* dev, uint16_t slot)
+{
+    uint16_t slot_locked = (uint16_t)dev->config[SIM_CFG_SLOT_LOCKED] | ((uint16_t)dev->config[SIM_CFG_SLOT_LOCKED + 1] << 8);
+
+    return (slot_locked & (1 << slot)) ? false : true;
+}
+
+/** \brief Public key slots whose key has to be validated before Verify uses it */
+static bool sim_is_validated_pubkey(const hal_sim_device_t* dev, uint16_t slot)
+{
+    uint16_t key_config = sim_key_config(dev, slot);
+
+    return slot >= 8 && !(key_config & SIM_KEY_PRIVATE) && (key_config & SIM_KEY_PUBINFO)
+           && sim_key_type(dev, slot) == SIM_KEY_TYPE_P256;
+}
+
+static size_t sim_slot_size(uint16_t slot)
+{
+    return slot < 8 ? 36 : (slot == 8 ? 416 : 72);
+}
+
+static uint8_t* sim_slot(hal_sim_device_t* dev, uint16_t slot)
+{
+    return &dev->data[slot <= 8 ? slot * 36 : 704 + (slot - 9) * 72];
+}
+
+static void sim_sn(const hal_sim_device_t* dev, uint8_t* sn)
+{
+    memcpy(&sn[0], &dev->config[0], 4);
+    memcpy(&sn[4], &dev->config[8], 5);
+}
+
+/** \brief IO protection key used for encrypted outputs and MAC'd results */
+static uint8_t* sim_io_key(hal_sim_device_t* dev)
+{
+    return sim_slot(dev, (uint16_t)(dev->config[SIM_CFG_CHIP_OPTIONS + 1] >> 4));
+}
+
+/** \brief Random bytes. The RNG only produces a fixed pattern until the
+ *         configuration zone is locked.
+ */
+static void sim_random(const hal_sim_device_t* dev, uint8_t* buf, size_t len)
+{
+    static const uint8_t pattern[4] = { 0xFF, 0xFF, 0x00, 0x00 };
+    size_t i;
+
+    if (sim_config_locked(dev))
+    {
+        (void)RAND_bytes(buf, (int)len);
+    }
+    else
+    {
+        for (i = 0; i < len; i++)
+        {
+            buf[i] = pattern[i % sizeof(pattern)];
+        }
+    }
+}
+
+static void sim_sha256(const uint8_t* msg, size_t len, uint8_t* digest)
+{
+    (void)SHA256(msg, len, digest);
+}
+
+/** \brief Counter value in the encoding written by calib_write_config_counter() */
+static uint32_t sim_decode_counter(const uint8_t* bytes)
+{
+    uint32_t bin_a = ((uint32_t)bytes[4] << 8) | bytes[5];
+    uint32_t value;
+    uint32_t i;
+    uint16_t lin_a, lin_b;
+
+    for (i = 0; i < 32; i++)
+    {
+        value = bin_a * 32 + i;
+        lin_a = (uint16_t)(0xFFFF >> (value % 32));
+        lin_b = (uint16_t)(0xFFFF >> ((value >= 16) ? (value - 16) % 32 : 0));
+        if (bytes[0] == (lin_a >> 8) && bytes[1] == (lin_a & 0xFF) && bytes[2] == (lin_b >> 8) && bytes[3] == (lin_b & 0xFF))
+        {
+            return value > COUNTER_MAX_VALUE ? COUNTER_MAX_VALUE : value;
+        }
+    }
+    return 0;
+}
+
+/** \brief Clear everything the device loses when it goes to sleep */
+static void sim_clear_volatile(hal_sim_device_t* dev)
+{
+    memset(&dev->temp_key, 0, sizeof(dev->temp_key));
+    memset(dev->msg_dig_buf, 0, sizeof(dev->msg_dig_buf));
+    memset(dev->alt_key_buf, 0, sizeof(dev->alt_key_buf));
+    dev->sha_mode = 0;
+    dev->auth_valid = false;
+}
+
+/** \brief Set TempKey to a value that didn't come from a stored key */
+static void sim_set_temp_key(hal_sim_device_t* dev, const uint8_t* value, size_t len)
+{
+    memset(&dev->temp_key, 0, sizeof(dev->temp_key));
+    memcpy(dev->temp_key.value, value, len);
+    dev->temp_key.is_64 = (len == 64) ? 1 : 0;
+    dev->temp_key.source_flag = 1;
+    dev->temp_key.valid = 1;
+}
+
+/*----------------------------------------------------------------------------
+ * Cryptographic primitives
+ *--------------------------------------------------------------------------*/
+
+/** \brief P-256 context for one operation */
+typedef struct
+{
+    EC_GROUP* group;
+    BN_CTX*   bn;
+    BIGNUM*   order;
+} sim_ecc_t;
+
+static bool sim_ecc_open(sim_ecc_t* ecc)
+{
+    ecc->group = EC_GROUP_new_by_curve_name(NID_X9_62_prime256v1);
+    ecc->bn = BN_CTX_new();
+    ecc->order = BN_new();
+    if (!ecc->group || !ecc->bn || !ecc->order || !EC_GROUP_get_order(ecc->group, ecc->order, ecc->bn))
+    {
+        return false;
+    }
+    BN_CTX_start(ecc->bn);
+    return true;
+}
+
+static void sim_ecc_close(sim_ecc_t* ecc)
+{
+    if (ecc->bn)
+    {
+        BN_CTX_end(ecc->bn);
+        BN_CTX_free(ecc->bn);
+    }
+    BN_free(ecc->order);
+    EC_GROUP_free(ecc->group);
+}
+
+/** \brief Load an uncompressed X||Y public key, fails if it's not on the curve */
+static EC_POINT* sim_ecc_point(sim_ecc_t* ecc, const uint8_t* public_key)
+{
+    EC_POINT* point = EC_POINT_new(ecc->group);
+    BIGNUM* x = BN_CTX_get(ecc->bn);
+    BIGNUM* y = BN_CTX_get(ecc->bn);
+
+    if (!point || !y || !BN_bin2bn(&public_key[0], 32, x) || !BN_bin2bn(&public_key[32], 32, y)
+        || !EC_POINT_set_affine_coordinates(ecc->group, point, x, y, ecc->bn))
+    {
+        EC_POINT_free(point);
+        return NULL;
+    }
+    return point;
+}
+
+static bool sim_ecc_point_bytes(sim_ecc_t* ecc, const EC_POINT* point, uint8_t* xy)
+{
+    BIGNUM* x = BN_CTX_get(ecc->bn);
+    BIGNUM* y = BN_CTX_get(ecc->bn);
+
+    return y && EC_POINT_get_affine_coordinates(ecc->group, point, x, y, ecc->bn)
+           && BN_bn2binpad(x, &xy[0], 32) == 32 && BN_bn2binpad(y, &xy[32], 32) == 32;
+}
+
+/** \brief Create a private key, a random integer in [1, n-1] */
+static bool sim_ecc_genkey(uint8_t* private_key)
+{
+    sim_ecc_t ecc;
+    BIGNUM* d;
+    bool ok = false;
+
+    if (sim_ecc_open(&ecc) && (d = BN_CTX_get(ecc.bn)) != NULL)
+    {
+        do
+        {
+            ok = BN_priv_rand_range(d, ecc.order) && BN_bn2binpad(d, private_key, 32) == 32;
+        }
+        while (ok && BN_is_zero(d));
+    }
+    sim_ecc_close(&ecc);
+    return ok;
+}
+
+static bool sim_ecc_pubkey(const uint8_t* private_key, uint8_t* public_key)
+{
+    sim_ecc_t ecc;
+    EC_POINT* q = NULL;
+    BIGNUM* d;
+    bool ok = false;
+
+    if (sim_ecc_open(&ecc) && (d = BN_CTX_get(ecc.bn)) != NULL && BN_bin2bn(private_key, 32, d)
+        && (q = EC_POINT_new(ecc.group)) != NULL)
+    {
+        ok = !BN_is_zero(d) && BN_cmp(d, ecc.order) < 0 && EC_POINT_mul(ecc.group, q, d, NULL, NULL, ecc.bn)
+             && sim_ecc_point_bytes(&ecc, q, public_key);
+    }
+    EC_POINT_free(q);
+    sim_ecc_close(&ecc);
+    return ok;
+}
+
+/** \brief ECDSA signature (R||S) of a 32 byte digest */
+static bool sim_ecc_sign(const uint8_t* private_key, const uint8_t* digest, uint8_t* signature)
+{
+    sim_ecc_t ecc;
+    EC_POINT* kg = NULL;
+    BIGNUM *d, *e, *k, *r, *s, *x;
+    bool ok = false;
+
+    if (!sim_ecc_open(&ecc) || (kg = EC_POINT_new(ecc.group)) == NULL)
+    {
+        sim_ecc_close(&ecc);
+        return false;
+    }
+    d = BN_CTX_get(ecc.bn);
+    e = BN_CTX_get(ecc.bn);
+    k = BN_CTX_get(ecc.bn);
+    r = BN_CTX_get(ecc.bn);
+    s = BN_CTX_get(ecc.bn);
+    x = BN_CTX_get(ecc.bn);
+    if (x && BN_bin2bn(private_key, 32, d) && BN_bin2bn(digest, 32, e))
+    {
+        do
+        {
+            // r = (kG).x mod n, s = k^-1 (e + r d) mod n
+            if (!BN_priv_rand_range(k, ecc.order) || BN_is_zero(k)
+                || !EC_POINT_mul(ecc.group, kg, k, NULL, NULL, ecc.bn)
+                || !EC_POINT_get_affine_coordinates(ecc.group, kg, x, NULL, ecc.bn)
+                || !BN_nnmod(r, x, ecc.order, ecc.bn)
+                || !BN_mod_mul(s, r, d, ecc.order, ecc.bn)
+                || !BN_mod_add(s, s, e, ecc.order, ecc.bn)
+                || !BN_mod_inverse(k, k, ecc.order, ecc.bn)
+                || !BN_mod_mul(s, s, k, ecc.order, ecc.bn))
+            {
+                break;
+            }
+            ok = !BN_is_zero(r) && !BN_is_zero(s);
+        }
+        while (!ok);
+        ok = ok && BN_bn2binpad(r, &signature[0], 32) == 32 && BN_bn2binpad(s, &signature[32], 32) == 32;
+    }
+    EC_POINT_free(kg);
+    sim_ecc_close(&ecc);
+    return ok;
+}
+
+/** \brief Verify an ECDSA signature of a 32 byte digest
+ * \return CMD_STATUS_SUCCESS, SIM_STATUS_MISCOMPARE or CMD_STATUS_BYTE_EXEC
+ *         when the public key isn't a point on the curve
+ */
+static uint8_t sim_ecc_verify(const uint8_t* public_key, const uint8_t* digest, const uint8_t* signature)
+{
+    sim_ecc_t ecc;
+    EC_POINT* q = NULL;
+    EC_POINT* p = NULL;
+    BIGNUM *e, *r, *s, *w, *u1, *u2, *x;
+    uint8_t status = SIM_STATUS_MISCOMPARE;
+
+    if (!sim_ecc_open(&ecc))
+    {
+        sim_ecc_close(&ecc);
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    if ((q = sim_ecc_point(&ecc, public_key)) == NULL)
+    {
+        sim_ecc_close(&ecc);
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    e = BN_CTX_get(ecc.bn);
+    r = BN_CTX_get(ecc.bn);
+    s = BN_CTX_get(ecc.bn);
+    w = BN_CTX_get(ecc.bn);
+    u1 = BN_CTX_get(ecc.bn);
+    u2 = BN_CTX_get(ecc.bn);
+    x = BN_CTX_get(ecc.bn);
+    p = EC_POINT_new(ecc.group);
+    if (p && x && BN_bin2bn(digest, 32, e) && BN_bin2bn(&signature[0], 32, r) && BN_bin2bn(&signature[32], 32, s)
+        && !BN_is_zero(r) && !BN_is_zero(s) && BN_cmp(r, ecc.order) < 0 && BN_cmp(s, ecc.order) < 0)
+    {
+        // u1 = e s^-1, u2 = r s^-1, valid when (u1 G + u2 Q).x mod n == r
+        if (BN_mod_inverse(w, s, ecc.order, ecc.bn) && BN_mod_mul(u1, e, w, ecc.order, ecc.bn)
+            && BN_mod_mul(u2, r, w, ecc.order, ecc.bn) && EC_POINT_mul(ecc.group, p, u1, q, u2, ecc.bn)
+            && !EC_POINT_is_at_infinity(ecc.group, p)
+            && EC_POINT_get_affine_coordinates(ecc.group, p, x, NULL, ecc.bn) && BN_nnmod(x, x, ecc.order, ecc.bn)
+            && BN_cmp(x, r) == 0)
+        {
+            status = CMD_STATUS_SUCCESS;
+        }
+    }
+    EC_POINT_free(p);
+    EC_POINT_free(q);
+    sim_ecc_close(&ecc);
+    return status;
+}
+
+/** \brief ECDH shared secret, the X coordinate of d * Q */
+static uint8_t sim_ecc_ecdh(const uint8_t* private_key, const uint8_t* public_key, uint8_t* pms)
+{
+    sim_ecc_t ecc;
+    EC_POINT* q = NULL;
+    EC_POINT* p = NULL;
+    BIGNUM* d;
+    uint8_t xy[64];
+    uint8_t status = CMD_STATUS_BYTE_ECC;
+
+    if (sim_ecc_open(&ecc) && (q = sim_ecc_point(&ecc, public_key)) != NULL && (p = EC_POINT_new(ecc.group)) != NULL
+        && (d = BN_CTX_get(ecc.bn)) != NULL && BN_bin2bn(private_key, 32, d)
+        && EC_POINT_mul(ecc.group, p, NULL, q, d, ecc.bn) && sim_ecc_point_bytes(&ecc, p, xy))
+    {
+        memcpy(pms, xy, 32);
+        status = CMD_STATUS_SUCCESS;
+    }
+    EC_POINT_free(p);
+    EC_POINT_free(q);
+    sim_ecc_close(&ecc);
+    return status;
+}
+
+static bool sim_aes(const uint8_t* key, const uint8_t* in, uint8_t* out, bool encrypt)
+{
+    EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+    int len = 0;
+    bool ok;
+
+    ok = ctx && EVP_CipherInit_ex(ctx, EVP_aes_128_ecb(), NULL, key, NULL, encrypt ? 1 : 0)
+         && EVP_CIPHER_CTX_set_padding(ctx, 0) && EVP_CipherUpdate(ctx, out, &len, in, AES_DATA_SIZE)
+         && len == AES_DATA_SIZE;
+    EVP_CIPHER_CTX_free(ctx);
+    return ok;
+}
+
+/** \brief Multiplication in GF(2^128) as used by GHASH */
+static void sim_gfm(const uint8_t* h, const uint8_t* x, uint8_t* out)
+{
+    uint8_t z[16] = { 0 };
+    uint8_t v[16];
+    int i, j, lsb;
+
+    memcpy(v, h, sizeof(v));
+    for (i = 0; i < 128; i++)
+    {
+        if (x[i / 8] & (0x80 >> (i % 8)))
+        {
+            for (j = 0; j < 16; j++)
+            {
+                z[j] ^= v[j];
+            }
+        }
+        lsb = v[15] & 0x01;
+        for (j = 15; j > 0; j--)
+        {
+            v[j] = (uint8_t)((v[j] >> 1) | (v[j - 1] << 7));
+        }
+        v[0] >>= 1;
+        if (lsb)
+        {
+            v[0] ^= 0xE1;
+        }
+    }
+    memcpy(out, z, sizeof(z));
+}
+
+static void sim_hmac(const uint8_t* key, size_t key_len, const uint8_t* msg, size_t msg_len, uint8_t* mac)
+{
+    unsigned int mac_len = 32;
+
+    (void)HMAC(EVP_sha256(), key, (int)key_len, msg, msg_len, mac, &mac_len);
+}
+
+/** \brief Encrypt an output with the IO protection key, OutNonce is returned
+ *         after the data
+ */
+static void sim_io_encrypt(hal_sim_device_t* dev, uint8_t* data, size_t len, uint8_t* out_nonce)
+{
+    uint8_t msg[48];
+    uint8_t key[32];
+    size_t block, i;
+
+    (void)RAND_bytes(out_nonce, 32);
+    memcpy(msg, sim_io_key(dev), 32);
+    for (block = 0; block < len / 32; block++)
+    {
+        memcpy(&msg[32], &out_nonce[block * 16], 16);
+        sim_sha256(msg, sizeof(msg), key);
+        for (i = 0; i < 32; i++)
+        {
+            data[block * 32 + i] ^= key[i];
+        }
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * SHA command engine
+ *
+ * The context has the layout returned by the SHA(ReadContext) command: the
+ * number of message bytes (4 bytes LE), the state words (LE) and the bytes of
+ * the partial block.
+ *--------------------------------------------------------------------------*/
+
+static const uint32_t sim_sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+#define SIM_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void sim_sha256_block(uint32_t* state, const uint8_t* block)
+{
+    uint32_t w[64];
+    uint32_t a, b, c, d, e, f, g, h, t1, t2;
+    int i;
+
+    for (i = 0; i < 16; i++)
+    {
+        w[i] = ((uint32_t)block[i * 4] << 24) | ((uint32_t)block[i * 4 + 1] << 16) | ((uint32_t)block[i * 4 + 2] << 8) | block[i * 4 + 3];
+    }
+    for (i = 16; i < 64; i++)
+    {
+        w[i] = w[i - 16] + (SIM_ROTR(w[i - 15], 7) ^ SIM_ROTR(w[i - 15], 18) ^ (w[i - 15] >> 3))
+               + w[i - 7] + (SIM_ROTR(w[i - 2], 17) ^ SIM_ROTR(w[i - 2], 19) ^ (w[i - 2] >> 10));
+    }
+    a = state[0]; b = state[1]; c = state[2]; d = state[3];
+    e = state[4]; f = state[5]; g = state[6]; h = state[7];
+    for (i = 0; i < 64; i++)
+    {
+        t1 = h + (SIM_ROTR(e, 6) ^ SIM_ROTR(e, 11) ^ SIM_ROTR(e, 25)) + ((e & f) ^ (~e & g)) + sim_sha256_k[i] + w[i];
+        t2 = (SIM_ROTR(a, 2) ^ SIM_ROTR(a, 13) ^ SIM_ROTR(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+        h = g; g = f; f = e; e = d + t1;
+        d = c; c = b; b = a; a = t1 + t2;
+    }
+    state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+    state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+}
+
+static void sim_sha_start(hal_sim_device_t* dev)
+{
+    static const uint32_t init[8] = {
+        0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+    };
+    int i;
+
+    memset(dev->sha_context, 0, sizeof(dev->sha_context));
+    for (i = 0; i < 8; i++)
+    {
+        sim_put_le32(&dev->sha_context[4 + i * 4], init[i]);
+    }
+}
+
+static void sim_sha_update(hal_sim_device_t* dev, const uint8_t* msg, size_t len)
+{
+    uint32_t total = sim_le32(dev->sha_context);
+    uint8_t* partial = &dev->sha_context[36];
+    uint32_t state[8];
+    size_t used;
+    int i;
+
+    for (i = 0; i < 8; i++)
+    {
+        state[i] = sim_le32(&dev->sha_context[4 + i * 4]);
+    }
+    while (len > 0)
+    {
+        used = total % 64;
+        partial[used] = *msg++;
+        len--;
+        total++;
+        if (total % 64 == 0)
+        {
+            sim_sha256_block(state, partial);
+        }
+    }
+    sim_put_le32(dev->sha_context, total);
+    for (i = 0; i < 8; i++)
+    {
+        sim_put_le32(&dev->sha_context[4 + i * 4], state[i]);
+    }
+}
+
+static void sim_sha_final(hal_sim_device_t* dev, uint8_t* digest)
+{
+    uint32_t total = sim_le32(dev->sha_context);
+    uint8_t pad[72];
+    size_t pad_len = 64 - ((total + 8) % 64) + 8;
+    uint64_t bits = (uint64_t)total * 8;
+    int i;
+
+    memset(pad, 0, sizeof(pad));
+    pad[0] = 0x80;
+    for (i = 0; i < 8; i++)
+    {
+        pad[pad_len - 1 - i] = (uint8_t)(bits >> (i * 8));
+    }
+    sim_sha_update(dev, pad, pad_len);
+    for (i = 0; i < 8; i++)
+    {
+        uint32_t word = sim_le32(&dev->sha_context[4 + i * 4]);
+        digest[i * 4] = (uint8_t)(word >> 24);
+        digest[i * 4 + 1] = (uint8_t)(word >> 16);
+        digest[i * 4 + 2] = (uint8_t)(word >> 8);
+        digest[i * 4 + 3] = (uint8_t)word;
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * Zone access
+ *--------------------------------------------------------------------------*/
+
+/** \brief Decode the address of a Read or Write command. A 32 byte access to
+ *         the last block of a slot only reaches the bytes the slot has.
+ * \return pointer to the addressed bytes or NULL when out of range
+ */
+static uint8_t* sim_zone_address(hal_sim_device_t* dev, uint8_t zone, uint16_t address, size_t len, uint16_t* slot,
+                                 size_t* offset, size_t* avail)
+{
+    size_t block, word, size;
+    uint8_t* base;
+
+    *slot = 0;
+    word = (len == 32) ? 0 : (address & 0x07);
+    if (zone == ATCA_ZONE_DATA)
+    {
+        *slot = (address >> 3) & 0x1F;
+        if (*slot > 15)
+        {
+            return NULL;
+        }
+        block = address >> 8;
+        base = sim_slot(dev, *slot);
+        size = sim_slot_size(*slot);
+    }
+    else
+    {
+        block = (address >> 3) & 0x03;
+        base = (zone == ATCA_ZONE_CONFIG) ? dev->config : dev->otp;
+        size = (zone == ATCA_ZONE_CONFIG) ? sizeof(dev->config) : sizeof(dev->otp);
+        if (zone != ATCA_ZONE_CONFIG && zone != ATCA_ZONE_OTP)
+        {
+            return NULL;
+        }
+    }
+    *offset = block * 32 + word * 4;
+    if (*offset >= size)
+    {
+        return NULL;
+    }
+    *avail = (size - *offset) < len ? (size - *offset) : len;
+    return base + *offset;
+}
+
+static uint8_t sim_cmd_read(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                            const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    uint8_t zone = param1 & ATCA_ZONE_MASK;
+    size_t len = (param1 & ATCA_ZONE_READWRITE_32) ? 32 : 4;
+    uint16_t slot, slot_config;
+    size_t offset, avail, i;
+    uint8_t* src;
+
+    (void)data;
+    (void)data_len;
+    if ((src = sim_zone_address(dev, zone, param2, len, &slot, &offset, &avail)) == NULL)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    if (zone != ATCA_ZONE_CONFIG && !sim_data_locked(dev))
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    memset(out, 0, len);
+    memcpy(out, src, avail);
+
+    if (zone == ATCA_ZONE_DATA)
+    {
+        slot_config = sim_slot_config(dev, slot);
+        if (sim_key_config(dev, slot) & SIM_KEY_PRIVATE)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        if (slot_config & SIM_SLOT_IS_SECRET)
+        {
+            // Secrets can only be read encrypted with the key from a prior GenDig
+            if (!(slot_config & SIM_SLOT_ENCRYPT_READ) || len != 32 || !dev->temp_key.valid
+                || !dev->temp_key.gen_dig_data || dev->temp_key.source_flag || dev->temp_key.no_mac_flag)
+            {
+                return CMD_STATUS_BYTE_EXEC;
+            }
+            for (i = 0; i < len; i++)
+            {
+                out[i] ^= dev->temp_key.value[i];
+            }
+        }
+    }
+    *out_len = len;
+    return CMD_STATUS_SUCCESS;
+}
+
+/** \brief Write into the configuration zone, which is only possible while it
+ *         is unlocked. The serial number and revision, UserExtra, Selector
+ *         and lock bytes are read only.
+ */
+static uint8_t sim_write_config_zone(hal_sim_device_t* dev, size_t offset, const uint8_t* data, size_t len)
+{
+    size_t i;
+
+    if (sim_config_locked(dev))
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    if (len == 4 && (offset < 16 || offset == SIM_CFG_USER_EXTRA))
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    for (i = 0; i < len; i++)
+    {
+        if (offset + i >= 16 && (offset + i < SIM_CFG_USER_EXTRA || offset + i >= SIM_CFG_SLOT_LOCKED))
+        {
+            dev->config[offset + i] = data[i];
+        }
+    }
+    // Counters are kept in the configuration zone
+    dev->counter[0] = sim_decode_counter(&dev->config[SIM_CFG_COUNTER]);
+    dev->counter[1] = sim_decode_counter(&dev->config[SIM_CFG_COUNTER + 8]);
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_write(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                             const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    uint8_t zone = param1 & ATCA_ZONE_MASK;
+    size_t len = (param1 & ATCA_ZONE_READWRITE_32) ? 32 : 4;
+    uint8_t plain[32];
+    uint8_t mac[32];
+    uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+    atca_write_mac_in_out_t write_mac;
+    uint16_t slot;
+    size_t offset, avail, i;
+    uint8_t* dst;
+    uint8_t write_config;
+    bool encrypted;
+
+    (void)out;
+    (void)out_len;
+    if (data_len < len || (dst = sim_zone_address(dev, zone, param2, len, &slot, &offset, &avail)) == NULL)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+
+    if (zone == ATCA_ZONE_CONFIG)
+    {
+        return sim_write_config_zone(dev, offset, data, len);
+    }
+
+    if (zone == ATCA_ZONE_OTP)
+    {
+        if (sim_data_locked(dev))
+        {
+            // ATECC608A OTP is read only once locked, ATECC508A in consumption
+            // mode only allows clearing bits
+            if (sim_is_608(dev) || dev->config[SIM_CFG_COUNT_MATCH] != 0x55)
+            {
+                return CMD_STATUS_BYTE_EXEC;
+            }
+            for (i = 0; i < len; i++)
+            {
+                dst[i] &= data[i];
+            }
+            return CMD_STATUS_SUCCESS;
+        }
+        memcpy(dst, data, len);
+        return CMD_STATUS_SUCCESS;
+    }
+
+    if (sim_key_config(dev, slot) & SIM_KEY_PRIVATE)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    if (!sim_data_locked(dev))
+    {
+        // Slots are written in 32 byte blocks until the data zone is locked,
+        // the zone flag alone decides whether the data is encrypted
+        if (len != 32)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        encrypted = (param1 & ATCA_ZONE_ENCRYPTED) ? true : false;
+    }
+    else
+    {
+        write_config = sim_write_config(dev, slot);
+        if (sim_slot_locked(dev, slot))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        encrypted = (write_config & 0x04) ? true : false;
+        if (!encrypted && write_config != 0x00 && !(write_config == 0x01 && sim_is_validated_pubkey(dev, slot)))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+    }
+
+    memcpy(plain, data, len);
+    if (encrypted)
+    {
+        // Encrypted write authorized by a GenDig with the WriteKey
+        if (len != 32 || !(param1 & ATCA_ZONE_ENCRYPTED) || data_len < 64 || !dev->temp_key.valid || !dev->temp_key.gen_dig_data
+            || (sim_data_locked(dev) && dev->temp_key.key_id != ((sim_slot_config(dev, slot) >> 8) & 0x0F)))
+        {
+            dev->temp_key.valid = 0;
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        for (i = 0; i < 32; i++)
+        {
+            plain[i] = data[i] ^ dev->temp_key.value[i];
+        }
+        sim_sn(dev, sn);
+        memset(&write_mac, 0, sizeof(write_mac));
+        write_mac.zone = param1;
+        write_mac.key_id = param2;
+        write_mac.sn = sn;
+        write_mac.input_data = plain;
+        write_mac.encrypted_data = mac;     // recomputed ciphertext, discarded
+        write_mac.auth_mac = mac;
+        write_mac.temp_key = &dev->temp_key;
+        if (atcah_write_auth_mac(&write_mac) != ATCA_SUCCESS)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        dev->temp_key.valid = 0;
+        if (memcmp(mac, &data[32], 32) != 0)
+        {
+            return SIM_STATUS_MISCOMPARE;
+        }
+    }
+
+    memcpy(dst, plain, avail);
+    if (offset == 0 && sim_is_validated_pubkey(dev, slot))
+    {
+        // Writing a validated public key invalidates it
+        dst[0] = (uint8_t)((SIM_PUBKEY_INVALID << 4) | (dst[0] & 0x0F));
+    }
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_lock(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                            const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    uint8_t zone = param1 & 0x03;
+    uint16_t slot = (param1 >> 2) & 0x0F;
+    uint8_t crc[2];
+    uint8_t zones[HAL_SIM_DATA_SIZE + ATCA_OTP_SIZE];
+    uint16_t slot_locked;
+
+    (void)data;
+    (void)data_len;
+    (void)out;
+    (void)out_len;
+    switch (zone)
+    {
+    case LOCK_ZONE_CONFIG:
+        if (sim_config_locked(dev))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        atCRC(sizeof(dev->config), dev->config, crc);
+        if (!(param1 & LOCK_ZONE_NO_CRC) && (crc[0] != (uint8_t)param2 || crc[1] != (uint8_t)(param2 >> 8)))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        dev->config[SIM_CFG_LOCK_CONFIG] = 0x00;
+        break;
+
+    case LOCK_ZONE_DATA:
+        if (!sim_config_locked(dev) || sim_data_locked(dev))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        memcpy(zones, dev->data, HAL_SIM_DATA_SIZE);
+        memcpy(&zones[HAL_SIM_DATA_SIZE], dev->otp, ATCA_OTP_SIZE);
+        atCRC(sizeof(zones), zones, crc);
+        if (!(param1 & LOCK_ZONE_NO_CRC) && (crc[0] != (uint8_t)param2 || crc[1] != (uint8_t)(param2 >> 8)))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        dev->config[SIM_CFG_LOCK_VALUE] = 0x00;
+        break;
+
+    case LOCK_ZONE_DATA_SLOT:
+        if (!sim_data_locked(dev) || sim_slot_locked(dev, slot) || !(sim_key_config(dev, slot) & SIM_KEY_LOCKABLE))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        // The summary isn't checked for single slots, calib_lock_data_slot() passes 0
+        slot_locked = (uint16_t)dev->config[SIM_CFG_SLOT_LOCKED] | ((uint16_t)dev->config[SIM_CFG_SLOT_LOCKED + 1] << 8);
+        slot_locked &= (uint16_t)~(1 << slot);
+        dev->config[SIM_CFG_SLOT_LOCKED] = (uint8_t)slot_locked;
+        dev->config[SIM_CFG_SLOT_LOCKED + 1] = (uint8_t)(slot_locked >> 8);
+        break;
+
+    default:
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_update_extra(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                                    const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    uint8_t* extra;
+
+    (void)data;
+    (void)data_len;
+    (void)out;
+    (void)out_len;
+    if (param1 != UPDATE_MODE_USER_EXTRA && param1 != UPDATE_MODE_SELECTOR)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    // UserExtra and Selector can only be updated while they are 0
+    extra = &dev->config[SIM_CFG_USER_EXTRA + param1];
+    if (*extra != 0)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    *extra = (uint8_t)param2;
+    return CMD_STATUS_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------
+ * TempKey and message digest buffer
+ *--------------------------------------------------------------------------*/
+
+static uint8_t sim_cmd_random(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                              const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    (void)param1;
+    (void)param2;
+    (void)data;
+    (void)data_len;
+    sim_random(dev, out, RANDOM_NUM_SIZE);
+    *out_len = RANDOM_NUM_SIZE;
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_nonce(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                             const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    atca_nonce_in_out_t nonce;
+    uint8_t rand_out[RANDOM_NUM_SIZE];
+    size_t len;
+
+    switch (param1 & NONCE_MODE_MASK)
+    {
+    case NONCE_MODE_SEED_UPDATE:
+    case NONCE_MODE_NO_SEED_UPDATE:
+        if (data_len < NONCE_NUMIN_SIZE)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        sim_random(dev, rand_out, sizeof(rand_out));
+        memset(&nonce, 0, sizeof(nonce));
+        nonce.mode = param1;
+        nonce.zero = param2;
+        nonce.num_in = data;
+        nonce.rand_out = rand_out;
+        nonce.temp_key = &dev->temp_key;
+        if (atcah_nonce(&nonce) != ATCA_SUCCESS)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        dev->temp_key.gen_key_data = 0;
+        memcpy(out, rand_out, sizeof(rand_out));
+        *out_len = sizeof(rand_out);
+        return CMD_STATUS_SUCCESS;
+
+    case NONCE_MODE_PASSTHROUGH:
+        len = (param1 & NONCE_MODE_INPUT_LEN_64) ? 64 : 32;
+        if (data_len < len)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        switch (param1 & NONCE_MODE_TARGET_MASK)
+        {
+        case NONCE_MODE_TARGET_TEMPKEY:
+            sim_set_temp_key(dev, data, len);
+            break;
+        case NONCE_MODE_TARGET_MSGDIGBUF:
+            memcpy(dev->msg_dig_buf, data, len);
+            break;
+        case NONCE_MODE_TARGET_ALTKEYBUF:
+            memcpy(dev->alt_key_buf, data, 32);
+            break;
+        default:
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        return CMD_STATUS_SUCCESS;
+
+    default:
+        return CMD_STATUS_BYTE_PARSE;
+    }
+}
+
+static uint8_t sim_cmd_gendig(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                              const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    atca_gen_dig_in_out_t gen_dig;
+    uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+    uint8_t stored[32];
+    uint16_t slot = param2 & 0x0F;
+
+    (void)out;
+    (void)out_len;
+    if (!dev->temp_key.valid)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    memset(&gen_dig, 0, sizeof(gen_dig));
+    memset(stored, 0, sizeof(stored));
+    sim_sn(dev, sn);
+    gen_dig.zone = param1;
+    gen_dig.key_id = param2;
+    gen_dig.sn = sn;
+    gen_dig.stored_value = stored;
+    gen_dig.temp_key = &dev->temp_key;
+
+    switch (param1)
+    {
+    case GENDIG_ZONE_CONFIG:
+        if (param2 > 3)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        memcpy(stored, &dev->config[param2 * 32], 32);
+        break;
+    case GENDIG_ZONE_OTP:
+        if (param2 > 1)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        memcpy(stored, &dev->otp[param2 * 32], 32);
+        break;
+    case GENDIG_ZONE_DATA:
+        if (param2 > 15 || (sim_key_config(dev, slot) & SIM_KEY_PRIVATE))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        memcpy(stored, sim_slot(dev, slot), 32);
+        gen_dig.slot_conf = sim_slot_config(dev, slot);
+        gen_dig.key_conf = sim_key_config(dev, slot);
+        gen_dig.is_key_nomac = (gen_dig.slot_conf & SIM_SLOT_NOMAC) ? true : false;
+        if (gen_dig.is_key_nomac)
+        {
+            if (data_len < 4)
+            {
+                return CMD_STATUS_BYTE_PARSE;
+            }
+            gen_dig.other_data = data;
+        }
+        break;
+    case GENDIG_ZONE_SHARED_NONCE:
+        if (!(param2 & 0x8000) && data_len < 32)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        gen_dig.other_data = data;
+        break;
+    case GENDIG_ZONE_COUNTER:
+        if (param2 > 1)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        gen_dig.counter = dev->counter[param2];
+        break;
+    case GENDIG_ZONE_KEY_CONFIG:
+        if (param2 > 15)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        gen_dig.slot_conf = sim_slot_config(dev, slot);
+        gen_dig.key_conf = sim_key_config(dev, slot);
+        gen_dig.slot_locked = sim_slot_locked(dev, slot) ? 0 : 1;
+        break;
+    default:
+        return CMD_STATUS_BYTE_PARSE;
+    }
+
+    if (atcah_gen_dig(&gen_dig) != ATCA_SUCCESS)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    dev->temp_key.gen_key_data = 0;
+    return CMD_STATUS_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------
+ * Symmetric key commands
+ *--------------------------------------------------------------------------*/
+
+static uint8_t sim_cmd_mac(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                           const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    atca_mac_in_out_t mac;
+    uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+
+    if (param2 > 15 || (!(param1 & MAC_MODE_BLOCK2_TEMPKEY) && data_len < MAC_CHALLENGE_SIZE))
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    if (!(param1 & MAC_MODE_BLOCK1_TEMPKEY)
+        && ((sim_slot_config(dev, param2) & SIM_SLOT_NOMAC) || (sim_key_config(dev, param2) & SIM_KEY_PRIVATE)))
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    sim_sn(dev, sn);
+    memset(&mac, 0, sizeof(mac));
+    mac.mode = param1;
+    mac.key_id = param2;
+    mac.challenge = data;
+    mac.key = sim_slot(dev, param2);
+    mac.otp = dev->otp;
+    mac.sn = sn;
+    mac.response = out;
+    mac.temp_key = &dev->temp_key;
+    if (atcah_mac(&mac) != ATCA_SUCCESS)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    *out_len = MAC_SIZE;
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_checkmac(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                                const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    atca_check_mac_in_out_t check_mac;
+    uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+    uint8_t response[32];
+
+    (void)out;
+    (void)out_len;
+    if (param2 > 15 || data_len < CHECKMAC_CLIENT_CHALLENGE_SIZE + CHECKMAC_CLIENT_RESPONSE_SIZE + CHECKMAC_OTHER_DATA_SIZE)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    if (sim_key_config(dev, param2) & SIM_KEY_PRIVATE)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    sim_sn(dev, sn);
+    memset(&check_mac, 0, sizeof(check_mac));
+    check_mac.mode = param1;
+    check_mac.key_id = param2;
+    check_mac.sn = sn;
+    check_mac.client_chal = data;
+    check_mac.client_resp = response;
+    check_mac.other_data = &data[CHECKMAC_CLIENT_CHALLENGE_SIZE + CHECKMAC_CLIENT_RESPONSE_SIZE];
+    check_mac.otp = dev->otp;
+    check_mac.slot_key = sim_slot(dev, param2);
+    check_mac.temp_key = &dev->temp_key;
+    if (atcah_check_mac(&check_mac) != ATCA_SUCCESS)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    dev->temp_key.valid = 0;
+    if (memcmp(response, &data[CHECKMAC_CLIENT_CHALLENGE_SIZE], sizeof(response)) != 0)
+    {
+        return SIM_STATUS_MISCOMPARE;
+    }
+    if ((dev->config[SIM_CFG_VOL_KEY_PERMIT + 1] & 0x80) && (dev->config[SIM_CFG_VOL_KEY_PERMIT + 1] & 0x0F) == param2)
+    {
+        dev->auth_valid = true;
+    }
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_hmac(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                            const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    struct atca_hmac_in_out hmac;
+    uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+
+    (void)data;
+    (void)data_len;
+    if (param2 > 15)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    if (sim_key_config(dev, param2) & SIM_KEY_PRIVATE)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    sim_sn(dev, sn);
+    memset(&hmac, 0, sizeof(hmac));
+    hmac.mode = param1 & HMAC_MODE_MASK;     // other bits are ignored
+    hmac.key_id = param2;
+    hmac.key = sim_slot(dev, param2);
+    hmac.otp = dev->otp;
+    hmac.sn = sn;
+    hmac.response = out;
+    hmac.temp_key = &dev->temp_key;
+    if (atcah_hmac(&hmac) != ATCA_SUCCESS)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    *out_len = HMAC_DIGEST_SIZE;
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_derive_key(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                                  const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    struct atca_derive_key_in_out derive_key;
+    struct atca_derive_key_mac_in_out derive_key_mac;
+    uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+    uint8_t parent[32];
+    uint8_t target[32];
+    uint8_t mac[32];
+    uint16_t slot_config;
+    uint8_t write_config;
+
+    (void)out;
+    (void)out_len;
+    if (param2 > 15)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    slot_config = sim_slot_config(dev, param2);
+    write_config = sim_write_config(dev, param2);
+    if (!(write_config & 0x02) || sim_slot_locked(dev, param2) || (sim_key_config(dev, param2) & SIM_KEY_PRIVATE))
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    // Create derives from the WriteKey, Roll from the current value of the slot
+    memcpy(parent, sim_slot(dev, (write_config & 0x01) ? (uint16_t)((slot_config >> 8) & 0x0F) : param2), 32);
+    sim_sn(dev, sn);
+
+    if (write_config & 0x08)
+    {
+        if (data_len < DERIVE_KEY_MAC_SIZE)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        memset(&derive_key_mac, 0, sizeof(derive_key_mac));
+        derive_key_mac.mode = param1;
+        derive_key_mac.target_key_id = param2;
+        derive_key_mac.sn = sn;
+        derive_key_mac.parent_key = parent;
+        derive_key_mac.mac = mac;
+        if (atcah_derive_key_mac(&derive_key_mac) != ATCA_SUCCESS || memcmp(mac, data, sizeof(mac)) != 0)
+        {
+            dev->temp_key.valid = 0;
+            return SIM_STATUS_MISCOMPARE;
+        }
+    }
+
+    memset(&derive_key, 0, sizeof(derive_key));
+    derive_key.mode = param1;
+    derive_key.target_key_id = param2;
+    derive_key.sn = sn;
+    derive_key.parent_key = parent;
+    derive_key.target_key = target;
+    derive_key.temp_key = &dev->temp_key;
+    if (atcah_derive_key(&derive_key) != ATCA_SUCCESS)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    memcpy(sim_slot(dev, param2), target, sizeof(target));
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_privwrite(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                                 const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    atca_write_mac_in_out_t write_mac;
+    uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+    uint8_t plain[ATCA_PRIVWRITE_PLAIN_TEXT_SIZE];
+    uint8_t encrypted[ATCA_PRIVWRITE_PLAIN_TEXT_SIZE];
+    uint8_t mac[32];
+    size_t i;
+
+    (void)out;
+    (void)out_len;
+    if (param2 > 15 || data_len < ATCA_PRIVWRITE_PLAIN_TEXT_SIZE + 32)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    if (!(sim_key_config(dev, param2) & SIM_KEY_PRIVATE) || sim_slot_locked(dev, param2))
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    memcpy(plain, data, sizeof(plain));
+
+    if (sim_data_locked(dev))
+    {
+        // Once locked the key has to be encrypted with the WriteKey
+        if (!(param1 & PRIVWRITE_MODE_ENCRYPT) || !(sim_write_config(dev, param2) & 0x04) || !dev->temp_key.valid
+            || !dev->temp_key.gen_dig_data || dev->temp_key.key_id != ((sim_slot_config(dev, param2) >> 8) & 0x0F))
+        {
+            dev->temp_key.valid = 0;
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        // First 32 bytes are XORed with TempKey, the last 4 with its digest
+        sim_sha256(dev->temp_key.value, 32, mac);
+        for (i = 0; i < sizeof(plain); i++)
+        {
+            plain[i] = data[i] ^ (i < 32 ? dev->temp_key.value[i] : mac[i - 32]);
+        }
+        sim_sn(dev, sn);
+        memset(&write_mac, 0, sizeof(write_mac));
+        write_mac.zone = param1;
+        write_mac.key_id = param2;
+        write_mac.sn = sn;
+        write_mac.input_data = plain;
+        write_mac.encrypted_data = encrypted;
+        write_mac.auth_mac = mac;
+        write_mac.temp_key = &dev->temp_key;
+        if (atcah_privwrite_auth_mac(&write_mac) != ATCA_SUCCESS)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        dev->temp_key.valid = 0;
+        if (memcmp(mac, &data[ATCA_PRIVWRITE_PLAIN_TEXT_SIZE], sizeof(mac)) != 0)
+        {
+            return SIM_STATUS_MISCOMPARE;
+        }
+    }
+    memcpy(sim_slot(dev, param2), plain, sizeof(plain));
+    return CMD_STATUS_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------
+ * Counters
+ *--------------------------------------------------------------------------*/
+
+static uint8_t sim_cmd_counter(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                               const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    (void)data;
+    (void)data_len;
+    if (param2 > 1 || param1 > COUNTER_MODE_INCREMENT)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    if (param1 == COUNTER_MODE_INCREMENT)
+    {
+        if (dev->counter[param2] >= COUNTER_MAX_VALUE)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        dev->counter[param2]++;
+    }
+    sim_put_le32(out, dev->counter[param2]);
+    *out_len = 4;
+    return CMD_STATUS_SUCCESS;
+}
+
+/** \brief Limited use keys advance counter 0 with each use. On the ATECC608A
+ *         the use is refused once the counter reaches the counter match value.
+ */
+static bool sim_use_limited_key(hal_sim_device_t* dev, uint16_t slot)
+{
+    uint8_t count_match = dev->config[SIM_CFG_COUNT_MATCH];
+
+    if (!(sim_slot_config(dev, slot) & SIM_SLOT_LIMITED_USE))
+    {
+        return true;
+    }
+    if (sim_is_608(dev) && (count_match & 0x01))
+    {
+        if (dev->counter[0] >= sim_le32(sim_slot(dev, count_match >> 4)))
+        {
+            return false;
+        }
+    }
+    if (dev->counter[0] >= COUNTER_MAX_VALUE)
+    {
+        return false;
+    }
+    dev->counter[0]++;
+    return true;
+}
+
+/*----------------------------------------------------------------------------
+ * ECC commands
+ *--------------------------------------------------------------------------*/
+
+/** \brief Public key stored in a slot, removing the padding of the 72 byte
+ *         slot format
+ */
+static void sim_stored_pubkey(hal_sim_device_t* dev, uint16_t slot, uint8_t* public_key)
+{
+    const uint8_t* stored = sim_slot(dev, slot);
+
+    memcpy(&public_key[0], &stored[4], 32);
+    memcpy(&public_key[32], &stored[40], 32);
+}
+
+static uint8_t sim_cmd_genkey(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                              const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    atca_gen_key_in_out_t gen_key;
+    uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+    uint8_t public_key[ATCA_PUB_KEY_SIZE];
+    uint8_t private_key[ATCA_PRIV_KEY_SIZE];
+    uint8_t other_data[GENKEY_OTHER_DATA_SIZE];
+    uint8_t* slot;
+
+    if (param1 & GENKEY_MODE_PUBKEY_DIGEST)
+    {
+        // Digest of a public key stored in a slot
+        if (param2 > 15 || data_len < GENKEY_OTHER_DATA_SIZE || !dev->temp_key.valid)
+        {
+            return param2 > 15 ? CMD_STATUS_BYTE_PARSE : CMD_STATUS_BYTE_EXEC;
+        }
+        memcpy(other_data, data, sizeof(other_data));
+        sim_stored_pubkey(dev, param2, public_key);
+    }
+    else if (param2 == GENKEY_PRIVATE_TO_TEMPKEY && sim_is_608(dev))
+    {
+        // Ephemeral private key in TempKey for ECDH
+        if (!(param1 & GENKEY_MODE_PRIVATE) || !sim_ecc_genkey(private_key) || !sim_ecc_pubkey(private_key, public_key))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        memset(&dev->temp_key, 0, sizeof(dev->temp_key));
+        memcpy(dev->temp_key.value, private_key, sizeof(private_key));
+        dev->temp_key.valid = 1;
+        dev->temp_key.gen_key_data = 1;
+        memcpy(out, public_key, sizeof(public_key));
+        *out_len = sizeof(public_key);
+        return CMD_STATUS_SUCCESS;
+    }
+    else
+    {
+        if (param2 > 15)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        if (!(sim_key_config(dev, param2) & SIM_KEY_PRIVATE) || sim_key_type(dev, param2) != SIM_KEY_TYPE_P256)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        slot = sim_slot(dev, param2);
+        if (param1 & GENKEY_MODE_PRIVATE)
+        {
+            if (sim_data_locked(dev) && (sim_slot_locked(dev, param2) || !(sim_write_config(dev, param2) & 0x02)))
+            {
+                return CMD_STATUS_BYTE_EXEC;
+            }
+            if (!sim_ecc_genkey(private_key))
+            {
+                return CMD_STATUS_BYTE_EXEC;
+            }
+            memset(slot, 0, 4);
+            memcpy(&slot[4], private_key, sizeof(private_key));
+        }
+        if (!sim_ecc_pubkey(&slot[4], public_key))
+        {
+            return CMD_STATUS_BYTE_ECC;
+        }
+        memcpy(out, public_key, sizeof(public_key));
+        *out_len = sizeof(public_key);
+        if (!(param1 & GENKEY_MODE_DIGEST))
+        {
+            return CMD_STATUS_SUCCESS;
+        }
+        if (!dev->temp_key.valid)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+    }
+
+    sim_sn(dev, sn);
+    memset(&gen_key, 0, sizeof(gen_key));
+    gen_key.mode = param1;
+    gen_key.key_id = param2;
+    gen_key.public_key = public_key;
+    gen_key.public_key_size = sizeof(public_key);
+    gen_key.other_data = other_data;
+    gen_key.sn = sn;
+    gen_key.temp_key = &dev->temp_key;
+    if (atcah_gen_key_msg(&gen_key) != ATCA_SUCCESS)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_sign(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                            const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    atca_sign_internal_in_out_t sign_internal;
+    uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+    uint8_t digest[32];
+    uint16_t read_key;
+
+    (void)data;
+    (void)data_len;
+    if (param2 > 15)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    read_key = sim_slot_config(dev, param2) & 0x0F;
+    if (!(sim_key_config(dev, param2) & SIM_KEY_PRIVATE) || sim_key_type(dev, param2) != SIM_KEY_TYPE_P256)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+
+    if (param1 & SIGN_MODE_EXTERNAL)
+    {
+        if (!(read_key & 0x01))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        if (param1 & SIGN_MODE_SOURCE_MSGDIGBUF)
+        {
+            memcpy(digest, dev->msg_dig_buf, 32);
+        }
+        else if (dev->temp_key.valid)
+        {
+            memcpy(digest, dev->temp_key.value, 32);
+        }
+        else
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+    }
+    else
+    {
+        // Sign a message built from TempKey (GenDig or GenKey) and the device state
+        if (!(read_key & 0x02) || !dev->temp_key.valid || (!dev->temp_key.gen_dig_data && !dev->temp_key.gen_key_data))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        sim_sn(dev, sn);
+        memset(&sign_internal, 0, sizeof(sign_internal));
+        sign_internal.mode = param1;
+        sign_internal.key_id = param2;
+        sign_internal.sn = sn;
+        sign_internal.temp_key = &dev->temp_key;
+        sign_internal.for_invalidate = (param1 & SIGN_MODE_INVALIDATE) ? true : false;
+        sign_internal.digest = digest;
+        if (atcah_config_to_sign_internal(dev->devtype, &sign_internal, dev->config) != ATCA_SUCCESS
+            || atcah_sign_internal_msg(dev->devtype, &sign_internal) != ATCA_SUCCESS)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+    }
+
+    if (!sim_use_limited_key(dev, param2))
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    if (!sim_ecc_sign(&sim_slot(dev, param2)[4], digest, out))
+    {
+        return CMD_STATUS_BYTE_ECC;
+    }
+    dev->temp_key.valid = 0;
+    *out_len = ATCA_SIG_SIZE;
+    return CMD_STATUS_SUCCESS;
+}
+
+/** \brief Update the validity nibble of a validated public key */
+static void sim_set_pubkey_validity(hal_sim_device_t* dev, uint16_t slot, uint8_t validity)
+{
+    uint8_t* stored = sim_slot(dev, slot);
+
+    stored[0] = (uint8_t)((validity << 4) | (stored[0] & 0x0F));
+}
+
+static uint8_t sim_cmd_verify(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                              const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    atca_verify_mac_in_out_t verify_mac;
+    uint8_t sn[ATCA_SERIAL_NUM_SIZE];
+    uint8_t public_key[ATCA_PUB_KEY_SIZE];
+    uint8_t message[32];
+    uint8_t msg[55];
+    uint8_t mode = param1 & VERIFY_MODE_MASK;
+    uint8_t status;
+    const uint8_t* other_data = NULL;
+
+    if (data_len < ATCA_SIG_SIZE)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    sim_sn(dev, sn);
+
+    switch (mode)
+    {
+    case VERIFY_MODE_EXTERNAL:
+        if (param2 != 0x0004 || data_len < ATCA_SIG_SIZE + ATCA_PUB_KEY_SIZE)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        memcpy(public_key, &data[ATCA_SIG_SIZE], sizeof(public_key));
+        break;
+
+    case VERIFY_MODE_STORED:
+        if (param2 > 15 || (sim_key_config(dev, param2) & SIM_KEY_PRIVATE))
+        {
+            return param2 > 15 ? CMD_STATUS_BYTE_PARSE : CMD_STATUS_BYTE_EXEC;
+        }
+        if (sim_is_validated_pubkey(dev, param2) && (sim_slot(dev, param2)[0] >> 4) != SIM_PUBKEY_VALID)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        sim_stored_pubkey(dev, param2, public_key);
+        break;
+
+    case VERIFY_MODE_VALIDATE:
+    case VERIFY_MODE_INVALIDATE:
+        // The key in param2 is validated by a signature from its ReadKey slot
+        // over a message built from the PubKey digest in TempKey
+        if (param2 < 8 || param2 > 15 || data_len < ATCA_SIG_SIZE + VERIFY_OTHER_DATA_SIZE)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        if (!sim_is_validated_pubkey(dev, param2) || !dev->temp_key.valid || !dev->temp_key.gen_key_data
+            || dev->temp_key.key_id != param2)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        other_data = &data[ATCA_SIG_SIZE];
+        memcpy(&msg[0], dev->temp_key.value, 32);
+        msg[32] = ATCA_SIGN;
+        memcpy(&msg[33], &other_data[0], 10);
+        msg[43] = sn[8];
+        memcpy(&msg[44], &other_data[10], 4);
+        memcpy(&msg[48], &sn[0], 2);
+        memcpy(&msg[50], &other_data[14], 5);
+        sim_sha256(msg, sizeof(msg), message);
+        sim_stored_pubkey(dev, sim_slot_config(dev, param2) & 0x0F, public_key);
+        break;
+
+    default:
+        return CMD_STATUS_BYTE_PARSE;
+    }
+
+    if (other_data == NULL)
+    {
+        if (param1 & VERIFY_MODE_SOURCE_MSGDIGBUF)
+        {
+            memcpy(message, dev->msg_dig_buf, 32);
+        }
+        else if (dev->temp_key.valid)
+        {
+            memcpy(message, dev->temp_key.value, 32);
+        }
+        else
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+    }
+
+    if ((status = sim_ecc_verify(public_key, message, data)) != CMD_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (mode == VERIFY_MODE_VALIDATE || mode == VERIFY_MODE_INVALIDATE)
+    {
+        sim_set_pubkey_validity(dev, param2, mode == VERIFY_MODE_VALIDATE ? SIM_PUBKEY_VALID : SIM_PUBKEY_INVALID);
+    }
+
+    if (param1 & VERIFY_MODE_MAC_FLAG)
+    {
+        memset(&verify_mac, 0, sizeof(verify_mac));
+        verify_mac.mode = param1;
+        verify_mac.key_id = param2;
+        verify_mac.signature = data;
+        verify_mac.other_data = other_data;
+        verify_mac.msg_dig_buf = dev->msg_dig_buf;
+        verify_mac.io_key = sim_io_key(dev);
+        verify_mac.sn = sn;
+        verify_mac.temp_key = &dev->temp_key;
+        verify_mac.mac = out;
+        if (atcah_verify_mac(&verify_mac) != ATCA_SUCCESS)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        *out_len = MAC_SIZE;
+    }
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_ecdh(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                            const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    uint8_t pms[ECDH_KEY_SIZE];
+    const uint8_t* private_key;
+    uint16_t read_key = 0;
+    uint8_t status;
+    uint8_t copy = param1 & ECDH_MODE_COPY_MASK;
+
+    if (data_len < ATCA_PUB_KEY_SIZE || (!sim_is_608(dev) && param1 != ECDH_PREFIX_MODE))
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    if ((param1 & ECDH_MODE_SOURCE_MASK) == ECDH_MODE_SOURCE_TEMPKEY)
+    {
+        if (!dev->temp_key.valid || !dev->temp_key.gen_key_data)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        private_key = dev->temp_key.value;
+    }
+    else
+    {
+        if (param2 > 15)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        read_key = sim_slot_config(dev, param2) & 0x0F;
+        if (!sim_data_locked(dev) || !(sim_key_config(dev, param2) & SIM_KEY_PRIVATE) || !(read_key & 0x04))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        private_key = &sim_slot(dev, param2)[4];
+    }
+
+    if ((status = sim_ecc_ecdh(private_key, data, pms)) != CMD_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (copy == ECDH_MODE_COPY_COMPATIBLE)
+    {
+        if (read_key & 0x08)
+        {
+            // Result is stored in the next slot
+            memcpy(sim_slot(dev, param2 | 0x01), pms, sizeof(pms));
+            return CMD_STATUS_SUCCESS;
+        }
+        copy = ECDH_MODE_COPY_OUTPUT_BUFFER;
+    }
+
+    switch (copy)
+    {
+    case ECDH_MODE_COPY_EEPROM_SLOT:
+        memcpy(sim_slot(dev, (param2 >> 8) & 0x0F), pms, sizeof(pms));
+        return CMD_STATUS_SUCCESS;
+    case ECDH_MODE_COPY_TEMP_KEY:
+        sim_set_temp_key(dev, pms, sizeof(pms));
+        return CMD_STATUS_SUCCESS;
+    default:
+        memcpy(out, pms, sizeof(pms));
+        *out_len = sizeof(pms);
+        if (param1 & ECDH_MODE_OUTPUT_ENC)
+        {
+            sim_io_encrypt(dev, out, sizeof(pms), &out[sizeof(pms)]);
+            *out_len += 32;
+        }
+        return CMD_STATUS_SUCCESS;
+    }
+}
+
+/*----------------------------------------------------------------------------
+ * SHA, AES and KDF
+ *--------------------------------------------------------------------------*/
+
+/** \brief Key of a slot or of TempKey (key id 0xFFFF) */
+static const uint8_t* sim_key(hal_sim_device_t* dev, uint16_t key_id)
+{
+    if (key_id == 0xFFFF)
+    {
+        return dev->temp_key.valid ? dev->temp_key.value : NULL;
+    }
+    if (key_id > 15 || (sim_key_config(dev, key_id) & SIM_KEY_PRIVATE))
+    {
+        return NULL;
+    }
+    return sim_slot(dev, key_id);
+}
+
+static uint8_t sim_cmd_sha(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                           const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    uint8_t mode = param1 & SHA_MODE_MASK;
+    uint8_t pad[64];
+    uint8_t digest[32];
+    uint8_t public_key[ATCA_PUB_KEY_SIZE];
+    const uint8_t* key;
+    size_t len, i;
+
+    switch (mode)
+    {
+    case SHA_MODE_SHA256_START:
+        sim_sha_start(dev);
+        dev->sha_mode = SHA_MODE_SHA256_START + 1;
+        return CMD_STATUS_SUCCESS;
+
+    case SHA_MODE_HMAC_START:
+        if ((key = sim_key(dev, param2)) == NULL)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        memcpy(dev->hmac_key, key, sizeof(dev->hmac_key));
+        memset(pad, 0x36, sizeof(pad));
+        for (i = 0; i < sizeof(dev->hmac_key); i++)
+        {
+            pad[i] ^= dev->hmac_key[i];
+        }
+        sim_sha_start(dev);
+        sim_sha_update(dev, pad, sizeof(pad));
+        dev->sha_mode = SHA_MODE_HMAC_START + 1;
+        return CMD_STATUS_SUCCESS;
+
+    case SHA_MODE_SHA256_UPDATE:
+        len = param2;
+        if (!dev->sha_mode || len > SHA_DATA_MAX || data_len < len || (!sim_is_608(dev) && len != SHA_DATA_MAX))
+        {
+            return dev->sha_mode ? CMD_STATUS_BYTE_PARSE : CMD_STATUS_BYTE_EXEC;
+        }
+        sim_sha_update(dev, data, len);
+        return CMD_STATUS_SUCCESS;
+
+    case SHA_MODE_SHA256_PUBLIC:
+        if (!dev->sha_mode || param2 < 8 || param2 > 15)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        sim_stored_pubkey(dev, param2, public_key);
+        sim_sha_update(dev, public_key, sizeof(public_key));
+        return CMD_STATUS_SUCCESS;
+
+    case SHA_MODE_SHA256_END:
+    case SHA_MODE_HMAC_END:
+        len = param2;
+        if (!dev->sha_mode || len >= SHA_DATA_MAX || data_len < len
+            || (mode == SHA_MODE_HMAC_END && (sim_is_608(dev) || dev->sha_mode != SHA_MODE_HMAC_START + 1))
+            || (mode == SHA_MODE_SHA256_END && !sim_is_608(dev) && dev->sha_mode != SHA_MODE_SHA256_START + 1))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        sim_sha_update(dev, data, len);
+        sim_sha_final(dev, digest);
+        if (dev->sha_mode == SHA_MODE_HMAC_START + 1)
+        {
+            memset(pad, 0x5C, sizeof(pad));
+            for (i = 0; i < sizeof(dev->hmac_key); i++)
+            {
+                pad[i] ^= dev->hmac_key[i];
+            }
+            sim_sha_start(dev);
+            sim_sha_update(dev, pad, sizeof(pad));
+            sim_sha_update(dev, digest, sizeof(digest));
+            sim_sha_final(dev, digest);
+        }
+        dev->sha_mode = 0;
+
+        switch (param1 & SHA_MODE_TARGET_MASK)
+        {
+        case SHA_MODE_TARGET_TEMPKEY:
+            sim_set_temp_key(dev, digest, sizeof(digest));
+            break;
+        case SHA_MODE_TARGET_MSGDIGBUF:
+            memcpy(dev->msg_dig_buf, digest, sizeof(digest));
+            break;
+        default:
+            break;
+        }
+        memcpy(out, digest, sizeof(digest));
+        *out_len = sizeof(digest);
+        return CMD_STATUS_SUCCESS;
+
+    case SHA_MODE_READ_CONTEXT:
+        if (!sim_is_608(dev) || !dev->sha_mode)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        len = 36 + sim_le32(dev->sha_context) % 64;
+        memcpy(out, dev->sha_context, len);
+        *out_len = len;
+        return CMD_STATUS_SUCCESS;
+
+    case SHA_MODE_WRITE_CONTEXT:
+        if (!sim_is_608(dev) || param2 < 36 || data_len < param2 || param2 != 36 + sim_le32(data) % 64)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        memset(dev->sha_context, 0, sizeof(dev->sha_context));
+        memcpy(dev->sha_context, data, param2);
+        dev->sha_mode = SHA_MODE_SHA256_START + 1;
+        return CMD_STATUS_SUCCESS;
+
+    default:
+        return CMD_STATUS_BYTE_PARSE;
+    }
+}
+
+static uint8_t sim_cmd_aes(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                           const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    uint8_t op = param1 & AES_MODE_OP_MASK;
+    size_t key_block = (param1 & AES_MODE_KEY_BLOCK_MASK) >> AES_MODE_KEY_BLOCK_POS;
+    const uint8_t* key;
+
+    if (op == AES_MODE_GFM)
+    {
+        if (data_len < 2 * AES_DATA_SIZE)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        sim_gfm(&data[0], &data[AES_DATA_SIZE], out);
+        *out_len = AES_DATA_SIZE;
+        return CMD_STATUS_SUCCESS;
+    }
+    if ((op != AES_MODE_ENCRYPT && op != AES_MODE_DECRYPT) || data_len < AES_DATA_SIZE)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    if (!(dev->config[SIM_CFG_AES_ENABLE] & 0x01))
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    if ((key = sim_key(dev, param2)) == NULL)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    if (param2 != 0xFFFF)
+    {
+        if (sim_key_type(dev, param2) != SIM_KEY_TYPE_AES
+            || ((sim_key_config(dev, param2) & SIM_KEY_PERSIST_DISABLE) && !dev->persistent_latch)
+            || (param2 < 8 && key_block > 1))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+    }
+    if (!sim_aes(&key[key_block * AES_DATA_SIZE], data, out, op == AES_MODE_ENCRYPT))
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    *out_len = AES_DATA_SIZE;
+    return CMD_STATUS_SUCCESS;
+}
+
+/** \brief TLS 1.2 PRF (P_SHA256) */
+static void sim_kdf_prf(const uint8_t* key, size_t key_len, const uint8_t* msg, size_t msg_len, uint8_t* out, size_t out_len)
+{
+    uint8_t a[32];
+    uint8_t buf[32 + 128];
+    uint8_t block[32];
+    size_t done;
+
+    sim_hmac(key, key_len, msg, msg_len, a);
+    for (done = 0; done < out_len; done += 32)
+    {
+        memcpy(buf, a, 32);
+        memcpy(&buf[32], msg, msg_len);
+        sim_hmac(key, key_len, buf, 32 + msg_len, block);
+        memcpy(&out[done], block, (out_len - done) < 32 ? (out_len - done) : 32);
+        sim_hmac(key, key_len, a, 32, a);
+    }
+}
+
+static uint8_t sim_cmd_kdf(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                           const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    uint8_t source[64];
+    uint8_t result[64];
+    uint8_t zero_key[32];
+    const uint8_t* key = source;
+    const uint8_t* msg;
+    uint32_t details;
+    size_t key_len = 32;
+    size_t msg_len;
+    size_t result_len = 32;
+    uint16_t source_slot = param2 & 0xFF;
+    uint16_t target_slot = param2 >> 8;
+    uint8_t iv_loc;
+
+    if (data_len < KDF_DETAILS_SIZE)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    details = sim_le32(data);
+    msg = &data[KDF_DETAILS_SIZE];
+    msg_len = ((param1 & KDF_MODE_ALG_MASK) == KDF_MODE_ALG_AES) ? AES_DATA_SIZE : (details >> 24);
+    if (msg_len > 128 || data_len < KDF_DETAILS_SIZE + msg_len)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+
+    switch (param1 & KDF_MODE_SOURCE_MASK)
+    {
+    case KDF_MODE_SOURCE_TEMPKEY:
+    case KDF_MODE_SOURCE_TEMPKEY_UP:
+        if (!dev->temp_key.valid)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        memcpy(source, &dev->temp_key.value[(param1 & KDF_MODE_SOURCE_MASK) == KDF_MODE_SOURCE_TEMPKEY ? 0 : 32], 32);
+        memcpy(&source[32], &dev->temp_key.value[32], 32);
+        break;
+    case KDF_MODE_SOURCE_SLOT:
+        if (source_slot > 15 || (sim_key_config(dev, source_slot) & SIM_KEY_PRIVATE))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        memset(source, 0, sizeof(source));
+        memcpy(source, sim_slot(dev, source_slot), source_slot < 8 ? 32 : 64);
+        break;
+    default:
+        memset(source, 0, sizeof(source));
+        memcpy(source, dev->alt_key_buf, 32);
+        break;
+    }
+
+    switch (param1 & KDF_MODE_ALG_MASK)
+    {
+    case KDF_MODE_ALG_PRF:
+        key_len = 16 * ((details & KDF_DETAILS_PRF_KEY_LEN_MASK) + 1);
+        result_len = (details & KDF_DETAILS_PRF_TARGET_LEN_64) ? 64 : 32;
+        sim_kdf_prf(key, key_len, msg, msg_len, result, result_len);
+        break;
+
+    case KDF_MODE_ALG_AES:
+        memset(result, 0, sizeof(result));
+        if (!sim_aes(&source[(details & KDF_DETAILS_AES_KEY_LOC_MASK) * 16], msg, result, true))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        break;
+
+    case KDF_MODE_ALG_HKDF:
+        if (details & KDF_DETAILS_HKDF_ZERO_KEY)
+        {
+            memset(zero_key, 0, sizeof(zero_key));
+            key = zero_key;
+        }
+        switch (details & KDF_DETAILS_HKDF_MSG_LOC_MASK)
+        {
+        case KDF_DETAILS_HKDF_MSG_LOC_SLOT:
+            if (source_slot > 15 || msg_len > sim_slot_size(source_slot))
+            {
+                return CMD_STATUS_BYTE_EXEC;
+            }
+            msg = sim_slot(dev, source_slot);
+            break;
+        case KDF_DETAILS_HKDF_MSG_LOC_TEMPKEY:
+            if (!dev->temp_key.valid || msg_len > 64)
+            {
+                return CMD_STATUS_BYTE_EXEC;
+            }
+            msg = dev->temp_key.value;
+            break;
+        case KDF_DETAILS_HKDF_MSG_LOC_IV:
+            // The message has to carry KdfIvStr at KdfIvLoc
+            iv_loc = dev->config[SIM_CFG_KDF_IV_LOC];
+            if ((size_t)iv_loc + 2 > msg_len || memcmp(&msg[iv_loc], &dev->config[SIM_CFG_KDF_IV_STR], 2) != 0)
+            {
+                return CMD_STATUS_BYTE_EXEC;
+            }
+            break;
+        default:
+            break;
+        }
+        sim_hmac(key, key_len, msg, msg_len, result);
+        break;
+
+    default:
+        return CMD_STATUS_BYTE_PARSE;
+    }
+
+    switch (param1 & KDF_MODE_TARGET_MASK)
+    {
+    case KDF_MODE_TARGET_TEMPKEY:
+        sim_set_temp_key(dev, result, result_len);
+        break;
+    case KDF_MODE_TARGET_TEMPKEY_UP:
+        memcpy(&dev->temp_key.value[32], result, 32);
+        break;
+    case KDF_MODE_TARGET_SLOT:
+        if (target_slot > 15 || !sim_data_locked(dev) || sim_slot_locked(dev, target_slot)
+            || (sim_key_config(dev, target_slot) & SIM_KEY_PRIVATE))
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        memcpy(sim_slot(dev, target_slot), result, 32);
+        break;
+    case KDF_MODE_TARGET_ALTKEYBUF:
+        memcpy(dev->alt_key_buf, result, 32);
+        break;
+    case KDF_MODE_TARGET_OUTPUT:
+        memcpy(out, result, result_len);
+        *out_len = result_len;
+        break;
+    case KDF_MODE_TARGET_OUTPUT_ENC:
+        memcpy(out, result, result_len);
+        sim_io_encrypt(dev, out, result_len, &out[result_len]);
+        *out_len = result_len + 32;
+        break;
+    default:
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    return CMD_STATUS_SUCCESS;
+}
+
+/*----------------------------------------------------------------------------
+ * Device management commands
+ *--------------------------------------------------------------------------*/
+
+static uint8_t sim_cmd_secureboot(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                                  const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    atca_secureboot_enc_in_out_t sb_enc;
+    atca_secureboot_mac_in_out_t sb_mac;
+    uint16_t sb_config = (uint16_t)dev->config[SIM_CFG_SECURE_BOOT] | ((uint16_t)dev->config[SIM_CFG_SECURE_BOOT + 1] << 8);
+    uint16_t digest_slot = (sb_config >> 8) & 0x0F;
+    uint16_t pubkey_slot = (sb_config >> 12) & 0x0F;
+    uint8_t mode = param1 & SECUREBOOT_MODE_MASK;
+    uint8_t digest[SECUREBOOT_DIGEST_SIZE];
+    uint8_t hashed_key[32];
+    uint8_t public_key[ATCA_PUB_KEY_SIZE];
+    const uint8_t* signature = NULL;
+    uint8_t status = CMD_STATUS_SUCCESS;
+    bool digest_only = (mode == SECUREBOOT_MODE_FULL_STORE
+                        && (sb_config & SECUREBOOTCONFIG_MODE_MASK) == SECUREBOOTCONFIG_MODE_FULL_DIG);
+    size_t i;
+
+    if ((sb_config & SECUREBOOTCONFIG_MODE_MASK) == SECUREBOOTCONFIG_MODE_DISABLED)
+    {
+        return CMD_STATUS_BYTE_EXEC;
+    }
+    if ((mode != SECUREBOOT_MODE_FULL && mode != SECUREBOOT_MODE_FULL_STORE && mode != SECUREBOOT_MODE_FULL_COPY)
+        || data_len < SECUREBOOT_DIGEST_SIZE + (digest_only ? 0 : SECUREBOOT_SIGNATURE_SIZE))
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    memcpy(digest, data, sizeof(digest));
+    if (!digest_only)
+    {
+        signature = &data[SECUREBOOT_DIGEST_SIZE];
+    }
+
+    if (param1 & SECUREBOOT_MODE_ENC_MAC_FLAG)
+    {
+        // Digest is encrypted with a key derived from the IO key and TempKey
+        if (!dev->temp_key.valid)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        memset(&sb_enc, 0, sizeof(sb_enc));
+        sb_enc.io_key = sim_io_key(dev);
+        sb_enc.temp_key = &dev->temp_key;
+        sb_enc.digest = data;
+        sb_enc.hashed_key = hashed_key;
+        sb_enc.digest_enc = digest;
+        if (atcah_secureboot_enc(&sb_enc) != ATCA_SUCCESS)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+    }
+
+    if (digest_only)
+    {
+        // The digest is compared with the one stored by a previous FullCopy
+        status = memcmp(digest, sim_slot(dev, digest_slot), sizeof(digest)) ? SIM_STATUS_MISCOMPARE : CMD_STATUS_SUCCESS;
+    }
+    else
+    {
+        sim_stored_pubkey(dev, pubkey_slot, public_key);
+        status = sim_ecc_verify(public_key, digest, signature);
+        if (status == CMD_STATUS_SUCCESS && mode != SECUREBOOT_MODE_FULL)
+        {
+            memcpy(sim_slot(dev, digest_slot), digest, sizeof(digest));
+        }
+    }
+    if (status != CMD_STATUS_SUCCESS)
+    {
+        return status;
+    }
+
+    if (param1 & SECUREBOOT_MODE_ENC_MAC_FLAG)
+    {
+        memset(&sb_mac, 0, sizeof(sb_mac));
+        sb_mac.mode = param1;
+        sb_mac.param2 = param2;
+        sb_mac.secure_boot_config = sb_config;
+        sb_mac.hashed_key = hashed_key;
+        sb_mac.digest = digest;
+        sb_mac.signature = signature;
+        sb_mac.mac = out;
+        if (atcah_secureboot_mac(&sb_mac) != ATCA_SUCCESS)
+        {
+            return CMD_STATUS_BYTE_EXEC;
+        }
+        *out_len = SECUREBOOT_MAC_SIZE;
+        for (i = 0; i < sizeof(hashed_key); i++)
+        {
+            hashed_key[i] = 0;
+        }
+    }
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_info(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                            const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    (void)data;
+    (void)data_len;
+    memset(out, 0, 4);
+    *out_len = 4;
+    switch (param1)
+    {
+    case INFO_MODE_REVISION:
+        memcpy(out, sim_is_608(dev) ? hal_sim_rev_608 : hal_sim_rev_508, 4);
+        break;
+    case INFO_MODE_KEY_VALID:
+        if (param2 > 15)
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        out[0] = (sim_key_type(dev, param2) == SIM_KEY_TYPE_P256) ? 1 : 0;
+        break;
+    case INFO_MODE_STATE:
+        out[0] = (uint8_t)(dev->temp_key.key_id | (dev->temp_key.source_flag << 4) | (dev->temp_key.gen_dig_data << 5)
+                           | (dev->temp_key.gen_key_data << 6) | (dev->temp_key.no_mac_flag << 7));
+        out[1] = (uint8_t)(dev->temp_key.valid << 7);
+        break;
+    case INFO_MODE_GPIO:
+        break;
+    case INFO_MODE_VOL_KEY_PERMIT:
+        if (!sim_is_608(dev))
+        {
+            return CMD_STATUS_BYTE_PARSE;
+        }
+        if (param2 & INFO_PARAM2_SET_LATCH_STATE)
+        {
+            // Setting the latch needs a CheckMac with the VolatileKeyPermission slot
+            if (!(dev->config[SIM_CFG_VOL_KEY_PERMIT + 1] & 0x80) || !dev->auth_valid)
+            {
+                return CMD_STATUS_BYTE_EXEC;
+            }
+            dev->persistent_latch = (param2 & INFO_PARAM2_LATCH_SET) ? true : false;
+            return CMD_STATUS_SUCCESS;
+        }
+        out[0] = dev->persistent_latch ? 1 : 0;
+        break;
+    default:
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_pause(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                             const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    (void)dev;
+    (void)param1;
+    (void)param2;
+    (void)data;
+    (void)data_len;
+    (void)out;
+    (void)out_len;
+    return CMD_STATUS_SUCCESS;
+}
+
+static uint8_t sim_cmd_selftest(hal_sim_device_t* dev, uint8_t param1, uint16_t param2,
+                                const uint8_t* data, size_t data_len, uint8_t* out, size_t* out_len)
+{
+    (void)dev;
+    (void)param2;
+    (void)data;
+    (void)data_len;
+    if (param1 & ~SELFTEST_MODE_ALL)
+    {
+        return CMD_STATUS_BYTE_PARSE;
+    }
+    // All tests pass, the result is a single byte of failed test bits
+    out[0] = 0x00;
+    *out_len = 1;
+    return CMD_STATUS_SUCCESS;
+}
+
+#define SIM_508     (0x01)
+#define SIM_608     (0x02)
+
+// *INDENT-OFF* - Preserve formatting
+static const hal_sim_command_t hal_sim_commands[] = {
+    { ATCA_AES,          SIM_608,           sim_cmd_aes          },
+    { ATCA_CHECKMAC,     SIM_508 | SIM_608, sim_cmd_checkmac     },
+    { ATCA_COUNTER,      SIM_508 | SIM_608, sim_cmd_counter      },
+    { ATCA_DERIVE_KEY,   SIM_508 | SIM_608, sim_cmd_derive_key   },
+    { ATCA_ECDH,         SIM_508 | SIM_608, sim_cmd_ecdh         },
+    { ATCA_GENDIG,       SIM_508 | SIM_608, sim_cmd_gendig       },
+    { ATCA_GENKEY,       SIM_508 | SIM_608, sim_cmd_genkey       },
+    { ATCA_HMAC,         SIM_508,           sim_cmd_hmac         },
+    { ATCA_INFO,         SIM_508 | SIM_608, sim_cmd_info         },
+    { ATCA_KDF,          SIM_608,           sim_cmd_kdf          },
+    { ATCA_LOCK,         SIM_508 | SIM_608, sim_cmd_lock         },
+    { ATCA_MAC,          SIM_508 | SIM_608, sim_cmd_mac          },
+    { ATCA_NONCE,        SIM_508 | SIM_608, sim_cmd_nonce        },
+    { ATCA_PAUSE,        SIM_508,           sim_cmd_pause        },
+    { ATCA_PRIVWRITE,    SIM_508 | SIM_608, sim_cmd_privwrite    },
+    { ATCA_RANDOM,       SIM_508 | SIM_608, sim_cmd_random       },
+    { ATCA_READ,         SIM_508 | SIM_608, sim_cmd_read         },
+    { ATCA_SECUREBOOT,   SIM_608,           sim_cmd_secureboot   },
+    { ATCA_SELFTEST,     SIM_608,           sim_cmd_selftest     },
+    { ATCA_SHA,          SIM_508 | SIM_608, sim_cmd_sha          },
+    { ATCA_SIGN,         SIM_508 | SIM_608, sim_cmd_sign         },
+    { ATCA_UPDATE_EXTRA, SIM_508 | SIM_608, sim_cmd_update_extra },
+    { ATCA_VERIFY,       SIM_508 | SIM_608, sim_cmd_verify       },
+    { ATCA_WRITE,        SIM_508 | SIM_608, sim_cmd_write        },
+};
+// *INDENT-ON*
+
+/** \brief Build the response packet: count, data or status, CRC */
+static void sim_respond(hal_sim_device_t* dev, const uint8_t* data, size_t len)
+{
+    dev->response[ATCA_COUNT_IDX] = (uint8_t)(len + ATCA_PACKET_OVERHEAD);
+    memcpy(&dev->response[ATCA_RSP_DATA_IDX], data, len);
+    atCRC(len + 1, dev->response, &dev->response[len + 1]);
+    dev->response_len = (uint16_t)(len + ATCA_PACKET_OVERHEAD);
+}
+
+/** \brief Execute a command packet (count, opcode, param1, param2, data, CRC)
+ * \return execution time of the command in us
+ */
+static uint32_t sim_execute(hal_sim_device_t* dev, const uint8_t* packet, size_t len)
+{
+    uint8_t out[HAL_SIM_RESPONSE_SIZE];
+    size_t out_len = 0;
+    uint8_t status = CMD_STATUS_BYTE_PARSE;
+    uint8_t crc[2];
+    uint8_t mask = sim_is_608(dev) ? SIM_608 : SIM_508;
+    struct atca_command timing;
+    size_t i;
+
+    if (len < ATCA_CMD_SIZE_MIN || packet[ATCA_COUNT_IDX] != len)
+    {
+        sim_respond(dev, &status, 1);
+        return 0;
+    }
+    atCRC(len - ATCA_CRC_SIZE, packet, crc);
+    if (memcmp(crc, &packet[len - ATCA_CRC_SIZE], ATCA_CRC_SIZE) != 0)
+    {
+        status = CMD_STATUS_BYTE_COMM;
+        sim_respond(dev, &status, 1);
+        return 0;
+    }
+
+    for (i = 0; i < sizeof(hal_sim_commands) / sizeof(hal_sim_commands[0]); i++)
+    {
+        if (hal_sim_commands[i].opcode == packet[1] && (hal_sim_commands[i].devices & mask))
+        {
+            status = hal_sim_commands[i].handler(dev, packet[2], (uint16_t)(packet[3] | (packet[4] << 8)),
+                                                 &packet[5], len - ATCA_CMD_SIZE_MIN, out, &out_len);
+            break;
+        }
+    }
+
+    if (status == CMD_STATUS_SUCCESS && out_len > 0)
+    {
+        sim_respond(dev, out, out_len);
+    }
+    else
+    {
+        sim_respond(dev, &status, 1);
+    }
+
+    // Commands complete in half of their maximum execution time, which is
+    // what the execution time table holds (msec * 1000 / 2 in usec)
+    memset(&timing, 0, sizeof(timing));
+    timing.dt = dev->devtype;
+    timing.clock_divider = dev->config[SIM_CFG_CHIP_MODE] & ATCA_CHIPMODE_CLOCK_DIV_MASK;
+    if (calib_get_execution_time(packet[1], &timing) != ATCA_SUCCESS)
+    {
+        return 0;
+    }
+    return (uint32_t)timing.execution_time_msec * 500;
+}
+
+/*----------------------------------------------------------------------------
+ * Interface
+ *--------------------------------------------------------------------------*/
+
+static hal_sim_device_t* sim_device(ATCAIface iface)
+{
+    return (hal_sim_device_t*)iface->hal_data;
+}
+
+/** \brief The device falls asleep, losing its volatile state, when the
+ *         watchdog expires
+ */
+static void sim_check_watchdog(hal_sim_device_t* dev)
+{
+    uint32_t watchdog = (dev->config[SIM_CFG_CHIP_MODE] & ATCA_CHIPMODE_WATCHDOG_LONG) ? SIM_WATCHDOG_LONG_USEC : SIM_WATCHDOG_USEC;
+
+    if (dev->power == HAL_SIM_ACTIVE && hal_timestamp_us() - dev->wake_us >= watchdog)
+    {
+        dev->power = HAL_SIM_SLEEP;
+        sim_clear_volatile(dev);
+    }
+}
+
+/** \brief Take the bus of a device for a transfer, a transfer that starts
+ *         while another one holds the bus is counted as a collision
+ */
+static void sim_bus_lock(hal_sim_device_t* dev)
+{
+    if (dev->bus)
+    {
+        if (dev->bus->locked)
+        {
+            dev->bus->collisions++;
+        }
+        dev->bus->locked = true;
+        dev->bus->transfers++;
+    }
+}
+
+static void sim_bus_unlock(hal_sim_device_t* dev)
+{
+    if (dev->bus)
+    {
+        dev->bus->locked = false;
+    }
+}
+
+/** \brief Count a command sent while another device on the bus is executing */
+static void sim_bus_check_overlap(hal_sim_device_t* dev)
+{
+    uint32_t now = hal_timestamp_us();
+    uint8_t i;
+
+    if (dev->bus)
+    {
+        for (i = 0; i < dev->bus->count; i++)
+        {
+            hal_sim_device_t* other = dev->bus->devices[i];
+            if (other != dev && other->response_len && (int32_t)(now - other->ready_us) < 0)
+            {
+                dev->bus->overlapped++;
+                break;
+            }
+        }
+    }
+}
+
+/** \brief Attach an interface to its simulated device, given in cfg_data or
+ *         the default device
+ */
+ATCA_STATUS hal_sim_init(void* hal, void* cfg)
+{
+    ATCAIfaceCfg* iface_cfg = (ATCAIfaceCfg*)cfg;
+    hal_sim_device_t* dev = iface_cfg->cfg_data ? (hal_sim_device_t*)iface_cfg->cfg_data : hal_sim_default();
+
+    if (dev->devtype != iface_cfg->devtype)
+    {
+        hal_sim_reset(dev, iface_cfg->devtype);
+    }
+    ((ATCAHAL_t*)hal)->hal_data = dev;
+    return ATCA_SUCCESS;
+}
+
+ATCA_STATUS hal_sim_post_init(void* iface)
+{
+    (void)iface;
+    return ATCA_SUCCESS;
+}
+
+ATCA_STATUS hal_sim_send(void* iface, uint8_t word_address, uint8_t* txdata, int txlength)
+{
+    hal_sim_device_t* dev = sim_device((ATCAIface)iface);
+
+    (void)word_address;
+    sim_check_watchdog(dev);
+    if (dev->power != HAL_SIM_ACTIVE || dev->unresponsive)
+    {
+        return ATCA_COMM_FAIL;
+    }
+    sim_bus_lock(dev);
+    sim_bus_check_overlap(dev);
+    // txdata[0] is reserved for the word address, the packet follows
+    dev->ready_us = hal_timestamp_us() + sim_execute(dev, &txdata[1], (size_t)txlength);
+    sim_bus_unlock(dev);
+    return ATCA_SUCCESS;
+}
+
+ATCA_STATUS hal_sim_receive(void* iface, uint8_t word_address, uint8_t* rxdata, uint16_t* rxlength)
+{
+    hal_sim_device_t* dev = sim_device((ATCAIface)iface);
+    uint16_t len;
+
+    (void)word_address;
+    sim_check_watchdog(dev);
+    sim_bus_lock(dev);
+    if (dev->power != HAL_SIM_ACTIVE || dev->unresponsive || dev->response_len == 0 || (int32_t)(hal_timestamp_us() - dev->ready_us) < 0)
+    {
+        // Busy or asleep, the device doesn't acknowledge
+        sim_bus_unlock(dev);
+        return ATCA_RX_NO_RESPONSE;
+    }
+    len = dev->response_len < *rxlength ? dev->response_len : *rxlength;
+    memcpy(rxdata, dev->response, len);
+    *rxlength = len;
+    dev->response_len = 0;
+    sim_bus_unlock(dev);
+    return ATCA_SUCCESS;
+}
+
+ATCA_STATUS hal_sim_wake(void* iface)
+{
+    hal_sim_device_t* dev = sim_device((ATCAIface)iface);
+    ATCAIfaceCfg* cfg = atgetifacecfg((ATCAIface)iface);
+
+    sim_check_watchdog(dev);
+    sim_bus_lock(dev);
+    atca_delay_us(cfg->wake_delay);
+    sim_bus_unlock(dev);
+    if (dev->unresponsive)
+    {
+        return ATCA_WAKE_FAILED;
+    }
+    if (dev->power != HAL_SIM_ACTIVE)
+    {
+        dev->power = HAL_SIM_ACTIVE;
+        dev->wake_us = hal_timestamp_us();
+        dev->response_len = 0;
+    }
+    return ATCA_SUCCESS;
+}
+
+ATCA_STATUS hal_sim_idle(void* iface)
+{
+    hal_sim_device_t* dev = sim_device((ATCAIface)iface);
+
+    sim_check_watchdog(dev);
+    sim_bus_lock(dev);
+    if (dev->power == HAL_SIM_ACTIVE)
+    {
+        dev->power = HAL_SIM_IDLE;
+    }
+    sim_bus_unlock(dev);
+    return ATCA_SUCCESS;
+}
+
+ATCA_STATUS hal_sim_sleep(void* iface)
+{
+    hal_sim_device_t* dev = sim_device((ATCAIface)iface);
+
+    dev->power = HAL_SIM_SLEEP;
+    sim_clear_volatile(dev);
+    return ATCA_SUCCESS;
+}
+
+ATCA_STATUS hal_sim_release(void* hal_data)
+{
+    (void)hal_data;
+    return ATCA_SUCCESS;
+}
+
+/** \brief Return a device to its factory state: unlocked, empty slots and a
+ *         configuration zone holding only the serial number and revision
+ * \param[in] device   Device to reset
+ * \param[in] devtype  ATECC508A or ATECC608A
+ */
+void hal_sim_reset(hal_sim_device_t* device, ATCADeviceType devtype)
+{
+    memset(device, 0, sizeof(*device));
+    device->devtype = devtype;
+    memcpy(&device->config[0], &hal_sim_sn[0], 4);
+    memcpy(&device->config[4], devtype == ATECC608A ? hal_sim_rev_608 : hal_sim_rev_508, 4);
+    memcpy(&device->config[8], &hal_sim_sn[4], 5);
+    device->config[SIM_CFG_AES_ENABLE] = (devtype == ATECC608A) ? 0x01 : 0x00;
+    device->config[14] = 0x01;   // I2C enable
+    device->config[16] = 0xC0;   // I2C address
+    device->config[SIM_CFG_LOCK_VALUE] = 0x55;
+    device->config[SIM_CFG_LOCK_CONFIG] = 0x55;
+    device->config[SIM_CFG_SLOT_LOCKED] = 0xFF;
+    device->config[SIM_CFG_SLOT_LOCKED + 1] = 0xFF;
+    memset(device->data, 0xFF, sizeof(device->data));
+    memset(device->otp, 0xFF, sizeof(device->otp));
+    device->power = HAL_SIM_SLEEP;
+}
+
+/** \brief Device used by interfaces that don't name one in cfg_data */
+hal_sim_device_t* hal_sim_default(void)
+{
+    if (!hal_sim_default_init)
+    {
+        hal_sim_reset(&hal_sim_default_device, ATECC608A);
+        hal_sim_default_init = true;
+    }
+    return &hal_sim_default_device;
+}
+
+/** \brief Put a simulated device on a bus shared with other devices
+ * \param[in] bus     Bus, zeroed before the first device is attached
+ * \param[in] device  Device to attach
+ */
+void hal_sim_bus_attach(hal_sim_bus_t* bus, hal_sim_device_t* device)
+{
+    if (bus->count < HAL_SIM_BUS_DEVICES)
+    {
+        bus->devices[bus->count++] = device;
+        device->bus = bus;
+    }
+}
+
+/** \brief Set up an interface configuration to talk to a simulated device
+ * \param[out] cfg      Interface configuration to fill in
+ * \param[in]  devtype  ATECC508A or ATECC608A
+ * \param[in]  device   Simulated device or NULL for the default device
+ */
+void hal_sim_config(ATCAIfaceCfg* cfg, ATCADeviceType devtype, hal_sim_device_t* device)
+{
+    cfg->iface_type = ATCA_CUSTOM_IFACE;
+    cfg->devtype = devtype;
+    cfg->atcacustom.halinit = hal_sim_init;
+    cfg->atcacustom.halpostinit = hal_sim_post_init;
+    cfg->atcacustom.halsend = hal_sim_send;
+    cfg->atcacustom.halreceive = hal_sim_receive;
+    cfg->atcacustom.halwake = hal_sim_wake;
+    cfg->atcacustom.halidle = hal_sim_idle;
+    cfg->atcacustom.halsleep = hal_sim_sleep;
+    cfg->atcacustom.halrelease = hal_sim_release;
+    cfg->cfg_data = device;
+}
+
+int select_508_custom(int argc, char* argv[])
+{
+    (void)argc;
+    if (!hal_replay_config(gCfg, ATECC508A))
+    {
+        hal_sim_config(gCfg, ATECC508A, NULL);
+    }
+    if (argv)
+    {
+        printf("Device Selected.\r\n");
+    }
+    return 0;
+}
+
+int select_608_custom(int argc, char* argv[])
+{
+    (void)argc;
+    if (!hal_replay_config(gCfg, ATECC608A))
+    {
+        hal_sim_config(gCfg, ATECC608A, NULL);
+    }
+    if (argv)
+    {
+        printf("Device Selected.\r\n");
+    }
+    return 0;
+}
+
+/** @} */
@@ -0,0 +1,119 @@
+/**
+ * \file
+ * \brief Software model of an ATECC508A/ATECC608A for host builds
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#ifndef HAL_SIM_H_
+#define HAL_SIM_H_
+
+#include "cryptoauthlib.h"
+#include "host/atca_host.h"
+
+/** \defgroup hal_ Hardware abstraction layer (hal_)
+ *
+ * \brief
+ * These methods define the hardware abstraction layer for communicating with a CryptoAuth device
+ *
+   @{ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define HAL_SIM_DATA_SIZE       (1208)  //!< Size of the data zone of the simulated devices
+#define HAL_SIM_RESPONSE_SIZE   (151)   //!< Largest response the simulated device returns
+#define HAL_SIM_BUS_DEVICES     (4)     //!< Devices a simulated bus can hold
+
+/** \brief Power state of a simulated device */
+typedef enum
+{
+    HAL_SIM_SLEEP,
+    HAL_SIM_IDLE,
+    HAL_SIM_ACTIVE
+} hal_sim_power_t;
+
+struct hal_sim_device;
+
+/** \brief I2C bus shared by simulated devices. A transfer holds the bus until
+ *         it returns, the counters tell whether transfers overlapped and
+ *         whether the devices executed their commands at the same time.
+ */
+typedef struct
+{
+    struct hal_sim_device* devices[HAL_SIM_BUS_DEVICES];
+    uint8_t         count;
+    bool            locked;                     // a transfer is in progress
+    uint32_t        transfers;                  // wakes, sends, receives and idles on the bus
+    uint32_t        collisions;                 // transfers started while another one held the bus
+    uint32_t        overlapped;                 // commands sent while another device was executing
+} hal_sim_bus_t;
+
+/** \brief State of a simulated ATECC508A or ATECC608A. EEPROM contents are kept
+ *         until hal_sim_reset() is called, the volatile state is cleared by the
+ *         sleep command or when the watchdog expires.
+ */
+typedef struct hal_sim_device
+{
+    ATCADeviceType  devtype;
+    uint8_t         config[ATCA_ECC_CONFIG_SIZE];
+    uint8_t         otp[ATCA_OTP_SIZE];
+    uint8_t         data[HAL_SIM_DATA_SIZE];
+    uint32_t        counter[2];
+
+    /* Volatile state */
+    atca_temp_key_t temp_key;
+    uint8_t         msg_dig_buf[64];
+    uint8_t         alt_key_buf[ATCA_KEY_SIZE];
+    uint8_t         sha_context[4 + 32 + 64];   // length, state and partial block of the SHA command
+    uint8_t         sha_mode;                   // 0 when no SHA command is in progress
+    uint8_t         hmac_key[ATCA_KEY_SIZE];
+    bool            auth_valid;                 // CheckMac with the VolatileKeyPermission slot succeeded
+    bool            persistent_latch;
+
+    /* Interface state */
+    hal_sim_bus_t*  bus;                        // bus shared with other devices, NULL if the device is alone
+    bool            unresponsive;               // the device doesn't answer on the bus, as if it were removed
+    hal_sim_power_t power;
+    uint32_t        wake_us;                    // time of the wake, the watchdog runs from here
+    uint32_t        ready_us;                   // time the current command completes
+    uint8_t         response[HAL_SIM_RESPONSE_SIZE];
+    uint16_t        response_len;
+} hal_sim_device_t;
+
+void hal_sim_reset(hal_sim_device_t* device, ATCADeviceType devtype);
+hal_sim_device_t* hal_sim_default(void);
+void hal_sim_config(ATCAIfaceCfg* cfg, ATCADeviceType devtype, hal_sim_device_t* device);
+void hal_sim_bus_attach(hal_sim_bus_t* bus, hal_sim_device_t* device);
+
+int select_508_custom(int argc, char* argv[]);
+int select_608_custom(int argc, char* argv[]);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} */
+
+#endif /* HAL_SIM_H_ */
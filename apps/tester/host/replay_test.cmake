@@ -0,0 +1,34 @@
+# Runs the tester against the simulated device with the HAL recorder on, then
+# again replaying the dumped trace. The random numbers and the revision have
+# to match what was recorded. The config zone is locked first so the device
+# returns real random numbers. The exit command always ends the interactive
+# tester with 1, so only the output is checked.
+file(MAKE_DIRECTORY ${WORK_DIR})
+file(WRITE ${WORK_DIR}/commands.txt "lockcfg -d ecc608 -y\nrecdump clear\ninfo -d ecc608\nrand -d ecc608\nrecdump\nexit\n")
+
+execute_process(COMMAND ${ATCA_TEST_HOST}
+    INPUT_FILE ${WORK_DIR}/commands.txt
+    OUTPUT_FILE ${WORK_DIR}/record.log)
+
+file(WRITE ${WORK_DIR}/replay.txt "info -d ecc608\nrand -d ecc608\nexit\n")
+set(ENV{ATCA_HOST_REPLAY} ${WORK_DIR}/record.log)
+execute_process(COMMAND ${ATCA_TEST_HOST}
+    INPUT_FILE ${WORK_DIR}/replay.txt
+    OUTPUT_FILE ${WORK_DIR}/replay.log)
+
+file(READ ${WORK_DIR}/record.log recorded)
+file(READ ${WORK_DIR}/replay.log replayed)
+string(REGEX MATCH "revision:\r?\n[0-9A-F ]+" recorded_rev "${recorded}")
+string(REGEX MATCH "revision:\r?\n[0-9A-F ]+" replayed_rev "${replayed}")
+string(REGEX MATCH "Random Numbers:\r?\n[0-9A-F \r\n]+" recorded_rand "${recorded}")
+string(REGEX MATCH "Random Numbers:\r?\n[0-9A-F \r\n]+" replayed_rand "${replayed}")
+
+if(replayed MATCHES "Replay diverged|Unable to load")
+    message(FATAL_ERROR "Replay diverged:\n${replayed}")
+endif()
+if(NOT recorded_rand OR NOT recorded_rev)
+    message(FATAL_ERROR "Nothing recorded:\n${recorded}")
+endif()
+if(NOT recorded_rev STREQUAL replayed_rev OR NOT recorded_rand STREQUAL replayed_rand)
+    message(FATAL_ERROR "Replay differs:\n${recorded_rev}\n${recorded_rand}\n--\n${replayed_rev}\n${replayed_rand}")
+endif()
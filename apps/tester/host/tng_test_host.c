@@ -0,0 +1,139 @@
+/**
+ * \file
+ * \brief Host tests of the TNG device context
+ *
+ * \copyright (c) 2015-2020 Microchip Technology Inc. and its subsidiaries.
+ *
+ * \page License
+ *
+ * Subject to your compliance with these terms, you may use Microchip software
+ * and any derivatives exclusively with Microchip products. It is your
+ * responsibility to comply with third party license terms applicable to your
+ * use of third party software (including open source software) that may
+ * accompany Microchip software.
+ *
+ * THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+ * EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+ * WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+ * PARTICULAR PURPOSE. IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT,
+ * SPECIAL, PUNITIVE, INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE
+ * OF ANY KIND WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF
+ * MICROCHIP HAS BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE
+ * FORESEEABLE. TO THE FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL
+ * LIABILITY ON ALL CLAIMS IN ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED
+ * THE AMOUNT OF FEES, IF ANY, THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR
+ * THIS SOFTWARE.
+ */
+
+#include <string.h>
+
+#include "cryptoauthlib.h"
+#include "hal_sim.h"
+#include "tng/tng_atca.h"
+#include "tng/tngtls_cert_def_3_device.h"
+#include "tng/tnglora_cert_def_4_device.h"
+#include "third_party/unity/unity.h"
+#include "third_party/unity/unity_fixture.h"
+
+/* The TNG code of the trust platform application runs against two simulated
+ * ATECC608A provisioned as a TNGTLS and a TNGLORA part. */
+
+#define TNG_SIM_LOCK_VALUE      (86)    //!< Data and OTP zone lock byte
+#define TNG_SIM_LOCK_CONFIG     (87)    //!< Configuration zone lock byte
+
+/* Referenced by the device selection commands of the simulator */
+ATCAIfaceCfg* gCfg;
+
+static hal_sim_device_t g_tng_sim_tls;
+static hal_sim_device_t g_tng_sim_lora;
+static ATCAIfaceCfg g_tng_cfg_tls;
+static ATCAIfaceCfg g_tng_cfg_lora;
+
+static void tng_sim_provision(hal_sim_device_t* dev, ATCAIfaceCfg* cfg, const char* otpcode)
+{
+    hal_sim_reset(dev, ATECC608A);
+    dev->config[TNG_SIM_LOCK_VALUE] = 0x00;
+    dev->config[TNG_SIM_LOCK_CONFIG] = 0x00;
+    memcpy(dev->otp, otpcode, strlen(otpcode));
+    hal_sim_config(cfg, ATECC608A, dev);
+}
+
+static uint32_t tng_commands(void)
+{
+    atca_stats_t stats;
+    uint32_t commands = 0;
+    size_t i;
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_get_stats(&stats));
+    for (i = 0; i < stats.opcode_count; i++)
+    {
+        commands += stats.opcodes[i].count;
+    }
+    return commands;
+}
+
+TEST_GROUP(tng_ctx);
+
+TEST_SETUP(tng_ctx)
+{
+    tng_sim_provision(&g_tng_sim_tls, &g_tng_cfg_tls, "KQp2ZkD8");
+    tng_sim_provision(&g_tng_sim_lora, &g_tng_cfg_lora, "jsMu7iYO");
+    tng_ctx_invalidate();
+}
+
+TEST_TEAR_DOWN(tng_ctx)
+{
+    atcab_release();
+}
+
+TEST(tng_ctx, cached)
+{
+    const atcacert_def_t* cert_def = NULL;
+    uint32_t commands;
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_init(&g_tng_cfg_tls));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, tng_get_device_cert_def(&cert_def));
+    TEST_ASSERT_EQUAL_PTR(&g_tngtls_cert_def_3_device, cert_def);
+
+    // Resolved once, later lookups don't talk to the device
+    commands = tng_commands();
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, tng_get_device_cert_def(&cert_def));
+    TEST_ASSERT_EQUAL_PTR(&g_tngtls_cert_def_3_device, cert_def);
+    TEST_ASSERT_EQUAL(commands, tng_commands());
+}
+
+TEST(tng_ctx, reinit_other_device)
+{
+    const atcacert_def_t* cert_def = NULL;
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_init(&g_tng_cfg_tls));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, tng_get_device_cert_def(&cert_def));
+    TEST_ASSERT_EQUAL_PTR(&g_tngtls_cert_def_3_device, cert_def);
+
+    // atcab_init() releases the context first and the new one is usually
+    // allocated at the same address
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_init(&g_tng_cfg_lora));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, tng_get_device_cert_def(&cert_def));
+    TEST_ASSERT_EQUAL_PTR(&g_tnglora_cert_def_4_device, cert_def);
+
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_release());
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, atcab_init(&g_tng_cfg_tls));
+    TEST_ASSERT_EQUAL(ATCA_SUCCESS, tng_get_device_cert_def(&cert_def));
+    TEST_ASSERT_EQUAL_PTR(&g_tngtls_cert_def_3_device, cert_def);
+}
+
+TEST_GROUP_RUNNER(tng_ctx)
+{
+    RUN_TEST_CASE(tng_ctx, cached);
+    RUN_TEST_CASE(tng_ctx, reinit_other_device);
+}
+
+static void tng_run_tests(void)
+{
+    RUN_TEST_GROUP(tng_ctx);
+}
+
+int main(int argc, const char* argv[])
+{
+    return UnityMain(argc, argv, tng_run_tests);
+}
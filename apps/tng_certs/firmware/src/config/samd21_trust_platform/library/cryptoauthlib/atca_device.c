@@ -137,6 +137,22 @@ ATCA_STATUS initATCADevice(ATCAIfaceCfg *cfg, ATCADevice ca_dev)
         return status;
     }
 
+    ca_dev->wake_depth = 0;
+    ca_dev->wake_active = 0;
+    ca_dev->wake_budget_msec = 0;
+    ca_dev->wake_timestamp_us = 0;
+    ca_dev->async_ctx = NULL;
+#ifdef ATCA_CONFIG_CACHE
+    memset(&ca_dev->config_cache, 0, sizeof(ca_dev->config_cache));
+    ca_dev->config_cache.enabled = 1;
+#endif
+#ifdef ATCA_DATA_CACHE
+    memset(&ca_dev->data_cache, 0, sizeof(ca_dev->data_cache));
+#endif
+#if !defined(ATCA_NO_POLL) && !defined(ATCA_NO_ADAPTIVE_POLL)
+    memset(&ca_dev->poll_table, 0, sizeof(ca_dev->poll_table));
+#endif
+
     return ATCA_SUCCESS;
 }
 
@@ -27,10 +27,22 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "atca_iface.h"
 #include "hal/atca_hal.h"
+#include "hal/hal_recorder.h"
 #include "atca_config.h"
 
+#if defined(ATCA_STATS) || defined(ATCA_HAL_RECORDER)
+#define ATCA_IFACE_TIMED
+#endif
+
+#ifdef ATCA_HAL_RECORDER
+#define ATCA_IFACE_RECORD(...)      hal_recorder_log(__VA_ARGS__)
+#else
+#define ATCA_IFACE_RECORD(...)      ((void)0)
+#endif
+
 /** \defgroup interface ATCAIface (atca_)
  *  \brief Abstract interface to all CryptoAuth device types.  This interface
  *  connects to the HAL implementation and abstracts the physical details of the
@@ -74,6 +86,9 @@ ATCA_STATUS initATCAIface(ATCAIfaceCfg *cfg, ATCAIface ca_iface)
 
     ca_iface->mType = cfg->iface_type;
     ca_iface->mIfaceCFG = cfg;
+#ifdef ATCA_STATS
+    atresetstats(ca_iface);
+#endif
 
     status = atinit(ca_iface);
     if (status != ATCA_SUCCESS)
@@ -153,7 +168,21 @@ ATCA_STATUS atsend(ATCAIface ca_iface, uint8_t word_address, uint8_t *txdata, in
 
     if (ca_iface->atsend)
     {
-        return ca_iface->atsend(ca_iface, word_address, txdata, txlength);
+#ifdef ATCA_IFACE_TIMED
+        uint32_t start_us = hal_timestamp_us();
+#endif
+        ATCA_STATUS status = ca_iface->atsend(ca_iface, word_address, txdata, txlength);
+
+        // txdata[0] is reserved for the word address, the data follows
+        ATCA_IFACE_RECORD(ca_iface, HAL_REC_SEND, status, start_us, word_address, &txdata[1], (size_t)txlength);
+#ifdef ATCA_STATS
+        ca_iface->stats.transfer_us += hal_timestamp_us() - start_us;
+        if (ATCA_SUCCESS == status)
+        {
+            ca_iface->stats.tx_bytes += (uint32_t)txlength;
+        }
+#endif
+        return status;
     }
     else
     {
@@ -179,7 +208,28 @@ ATCA_STATUS atreceive(ATCAIface ca_iface, uint8_t word_address, uint8_t *rxdata,
 
     if (ca_iface->atreceive)
     {
-        return ca_iface->atreceive(ca_iface, word_address, rxdata, rxlength);
+#ifdef ATCA_IFACE_TIMED
+        uint32_t start_us = hal_timestamp_us();
+#endif
+        ATCA_STATUS status = ca_iface->atreceive(ca_iface, word_address, rxdata, rxlength);
+
+        ATCA_IFACE_RECORD(ca_iface, HAL_REC_RECEIVE, status, start_us, word_address, rxdata, (ATCA_SUCCESS == status) ? *rxlength : 0);
+#ifdef ATCA_STATS
+        ca_iface->stats.transfer_us += hal_timestamp_us() - start_us;
+        if (ATCA_SUCCESS == status)
+        {
+            ca_iface->stats.rx_bytes += *rxlength;
+        }
+        else if (ATCA_RX_NO_RESPONSE == status)
+        {
+            ca_iface->stats.rx_no_response++;
+        }
+        else if (ATCA_RX_CRC_ERROR == status)
+        {
+            ca_iface->stats.crc_errors++;
+        }
+#endif
+        return status;
     }
     else
     {
@@ -202,16 +252,36 @@ ATCA_STATUS atwake(ATCAIface ca_iface)
 
     if (ca_iface->atwake)
     {
+#ifdef ATCA_IFACE_TIMED
+        uint32_t start_us = hal_timestamp_us();
+#endif
         ATCA_STATUS status = ca_iface->atwake(ca_iface);
 
+        ATCA_IFACE_RECORD(ca_iface, HAL_REC_WAKE, status, start_us, 0, NULL, 0);
         if (ATCA_WAKE_FAILED == status)
         {
             // The device might be performing a POST. Wait for it to complete
             // and try again.
             atca_delay_ms(ATCA_POST_DELAY_MSEC);
 
+#ifdef ATCA_HAL_RECORDER
+            uint32_t retry_us = hal_timestamp_us();
+#endif
             status = ca_iface->atwake(ca_iface);
+            ATCA_IFACE_RECORD(ca_iface, HAL_REC_WAKE, status, retry_us, 0, NULL, 0);
+        }
+#ifdef ATCA_STATS
+        ca_iface->stats.wakes++;
+        ca_iface->stats.wake_us += hal_timestamp_us() - start_us;
+        if (ATCA_SUCCESS != status)
+        {
+            ca_iface->stats.wake_failures++;
+        }
+        if (ATCA_RX_CRC_ERROR == status)
+        {
+            ca_iface->stats.crc_errors++;
         }
+#endif
         return status;
     }
     else
@@ -236,7 +306,11 @@ ATCA_STATUS atidle(ATCAIface ca_iface)
 
     if (ca_iface->atidle)
     {
+#ifdef ATCA_HAL_RECORDER
+        uint32_t start_us = hal_timestamp_us();
+#endif
         ATCA_STATUS status = ca_iface->atidle(ca_iface);
+        ATCA_IFACE_RECORD(ca_iface, HAL_REC_IDLE, status, start_us, 0, NULL, 0);
         atca_delay_ms(1);
         return status;
     }
@@ -261,7 +335,11 @@ ATCA_STATUS atsleep(ATCAIface ca_iface)
 
     if (ca_iface->atsleep)
     {
+#ifdef ATCA_HAL_RECORDER
+        uint32_t start_us = hal_timestamp_us();
+#endif
         ATCA_STATUS status = ca_iface->atsleep(ca_iface);
+        ATCA_IFACE_RECORD(ca_iface, HAL_REC_SLEEP, status, start_us, 0, NULL, 0);
         atca_delay_ms(1);
         return status;
     }
@@ -291,6 +369,78 @@ void* atgetifacehaldat(ATCAIface ca_iface)
     return ca_iface ? ca_iface->hal_data : NULL;
 }
 
+#ifdef ATCA_STATS
+/** \brief Copies the traffic counters of the interface.
+ * \param[in]  ca_iface  Device interface.
+ * \param[out] stats     Receives the counters.
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS atgetstats(ATCAIface ca_iface, atca_stats_t *stats)
+{
+    if (ca_iface == NULL || stats == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    memcpy(stats, &ca_iface->stats, sizeof(*stats));
+    return ATCA_SUCCESS;
+}
+
+/** \brief Clears the traffic counters of the interface.
+ * \param[in] ca_iface  Device interface.
+ */
+void atresetstats(ATCAIface ca_iface)
+{
+    if (ca_iface)
+    {
+        memset(&ca_iface->stats, 0, sizeof(ca_iface->stats));
+    }
+}
+
+/** \brief Counts an executed command against its opcode. Once
+ *         ATCA_STATS_OPCODES different opcodes have been seen further opcodes
+ *         are not counted.
+ * \param[in] ca_iface    Device interface.
+ * \param[in] opcode      Opcode of the command.
+ * \param[in] status      Result of the command.
+ * \param[in] elapsed_us  Time the command took.
+ */
+void atrecordcommand(ATCAIface ca_iface, uint8_t opcode, ATCA_STATUS status, uint32_t elapsed_us)
+{
+    atca_opcode_stats_t* entry = NULL;
+    uint8_t i;
+
+    if (ca_iface == NULL)
+    {
+        return;
+    }
+
+    for (i = 0; i < ca_iface->stats.opcode_count; i++)
+    {
+        if (ca_iface->stats.opcodes[i].opcode == opcode)
+        {
+            entry = &ca_iface->stats.opcodes[i];
+            break;
+        }
+    }
+    if (entry == NULL && ca_iface->stats.opcode_count < ATCA_STATS_OPCODES)
+    {
+        entry = &ca_iface->stats.opcodes[ca_iface->stats.opcode_count++];
+        entry->opcode = opcode;
+    }
+
+    if (entry)
+    {
+        entry->count++;
+        entry->total_us += elapsed_us;
+        if (ATCA_SUCCESS != status)
+        {
+            entry->errors++;
+        }
+    }
+}
+#endif
+
 /** \brief Instruct the HAL driver to release any resources associated with
  *         this interface.
  *  \param[in] ca_iface  Device interface.
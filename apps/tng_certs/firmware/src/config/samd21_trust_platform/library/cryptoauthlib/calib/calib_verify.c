@@ -258,7 +258,7 @@ ATCA_STATUS calib_verify_extern(ATCADevice device, const uint8_t *message, const
     do
     {
         // Load message into device
-        if (_gDevice->mCommands->dt == ATECC608A)
+        if (device->mCommands->dt == ATECC608A)
         {
             // Use the Message Digest Buffer for the ATECC608A
             nonce_target = NONCE_MODE_TARGET_MSGDIGBUF;
@@ -282,6 +282,49 @@ ATCA_STATUS calib_verify_extern(ATCADevice device, const uint8_t *message, const
     return status;
 }
 
+/** \brief Verifies a batch of signatures with all components supplied, see
+ *          calib_verify_extern(). All verifies run inside one wake session so
+ *          the device is woken and idled once for the batch rather than once
+ *          per command.
+ *
+ * \param[in]  device       Device context pointer
+ * \param[in]  count        Number of signatures to verify
+ * \param[in]  messages     32 byte messages, count * 32 bytes
+ * \param[in]  signatures   R and S of each signature, count * 64 bytes
+ * \param[in]  public_keys  X and Y of each public key, count * 64 bytes
+ * \param[out] is_verified  Per signature result, count entries
+ *
+ * \return ATCA_SUCCESS when every signature was checked, whether it verified
+ *         or not, otherwise an error code.
+ */
+ATCA_STATUS calib_verify_extern_batch(ATCADevice device, uint16_t count, const uint8_t* messages, const uint8_t* signatures,
+                                      const uint8_t* public_keys, bool* is_verified)
+{
+    ATCA_STATUS status = ATCA_SUCCESS;
+    ATCA_STATUS end_status;
+    uint16_t i;
+
+    if (device == NULL || (count && (messages == NULL || signatures == NULL || public_keys == NULL || is_verified == NULL)))
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    if ((status = calib_session_begin(device)) != ATCA_SUCCESS)
+    {
+        return status;
+    }
+
+    for (i = 0; i < count && status == ATCA_SUCCESS; i++)
+    {
+        status = calib_verify_extern(device, &messages[i * ATCA_SHA256_DIGEST_SIZE], &signatures[i * ATCA_ECCP256_SIG_SIZE],
+                                     &public_keys[i * ATCA_ECCP256_PUBKEY_SIZE], &is_verified[i]);
+    }
+
+    end_status = calib_session_end(device);
+
+    return (status != ATCA_SUCCESS) ? status : end_status;
+}
+
 /** \brief Executes the Verify command with verification MAC, which verifies a
  *          signature (ECDSA verify operation) with all components (message,
  *          signature, and public key) supplied. This function is only available
@@ -348,7 +391,7 @@ ATCA_STATUS calib_verify_stored(ATCADevice device, const uint8_t *message, const
     do
     {
         // Load message into device
-        if (_gDevice->mCommands->dt == ATECC608A)
+        if (device->mCommands->dt == ATECC608A)
         {
             // Use the Message Digest Buffer for the ATECC608A
             nonce_target = NONCE_MODE_TARGET_MSGDIGBUF;
@@ -181,6 +181,9 @@ void hal_rtos_delay_ms(uint32_t ms);
 void hal_delay_ms(uint32_t ms);
 void hal_delay_us(uint32_t us);
 
+/** \brief Free running microsecond timestamp implemented at the HAL level */
+uint32_t hal_timestamp_us(void);
+
 /** \brief Optional hal interfaces */
 ATCA_STATUS hal_create_mutex(void ** ppMutex, char* pName);
 ATCA_STATUS hal_destroy_mutex(void * pMutex);
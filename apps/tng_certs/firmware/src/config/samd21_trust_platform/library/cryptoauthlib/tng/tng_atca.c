@@ -34,6 +34,7 @@
 #include "tngtls_cert_def_3_device.h"
 #include "tflxtls_cert_def_4_device.h"
 #include "atcacert/atcacert_def.h"
+#include "atcacert/atcacert_client.h"
 
 
 typedef struct {
@@ -76,17 +77,15 @@ const atcacert_def_t* tng_map_get_device_cert_def(int index)
     }
 }
 
-ATCA_STATUS tng_get_device_cert_def(const atcacert_def_t **cert_def)
+static tng_ctx_t g_tng_ctx;
+
+// Resolve the device certificate definition from the code in the OTP zone
+static ATCA_STATUS tng_resolve_cert_def(tng_ctx_t* ctx)
 {
     ATCA_STATUS status;
     char otpcode[32];
     uint8_t i;
 
-    if (cert_def == NULL)
-    {
-        return ATCA_BAD_PARAM;
-    }
-
     status = atcab_read_zone(ATCA_ZONE_OTP, 0, 0, 0, (uint8_t*)otpcode, 32);
     if (ATCA_SUCCESS == status)
     {
@@ -94,7 +93,7 @@ ATCA_STATUS tng_get_device_cert_def(const atcacert_def_t **cert_def)
         {
             if (0 == strncmp(g_tng_cert_def_map[i].otpcode, otpcode, 8))
             {
-                *cert_def = g_tng_cert_def_map[i].cert_def;
+                ctx->cert_def = g_tng_cert_def_map[i].cert_def;
                 break;
             }
         }
@@ -105,20 +104,138 @@ ATCA_STATUS tng_get_device_cert_def(const atcacert_def_t **cert_def)
         }
     }
 
+    if (ATCA_SUCCESS == status)
+    {
+        status = atcacert_max_cert_size(ctx->cert_def, &ctx->device_cert_size);
+    }
+    if (ATCA_SUCCESS == status)
+    {
+        status = atcacert_max_cert_size(ctx->cert_def->ca_cert_def, &ctx->signer_cert_size);
+    }
+
+    return status;
+}
+
+ATCA_STATUS tng_get_ctx(tng_ctx_t** ctx)
+{
+    ATCA_STATUS status;
+    ATCADevice device = atcab_get_device();
+    uint32_t generation = atcab_get_device_generation();
+
+    if (ctx == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    // A context released and initialized again is usually at the same address
+    if (g_tng_ctx.device != device || g_tng_ctx.generation != generation || g_tng_ctx.cert_def == NULL)
+    {
+        memset(&g_tng_ctx, 0, sizeof(g_tng_ctx));
+        if ((status = tng_resolve_cert_def(&g_tng_ctx)) != ATCA_SUCCESS)
+        {
+            memset(&g_tng_ctx, 0, sizeof(g_tng_ctx));
+            return status;
+        }
+        g_tng_ctx.device = device;
+        g_tng_ctx.generation = generation;
+    }
+
+    *ctx = &g_tng_ctx;
+
+    return ATCA_SUCCESS;
+}
+
+void tng_ctx_invalidate(void)
+{
+    memset(&g_tng_ctx, 0, sizeof(g_tng_ctx));
+}
+
+ATCA_STATUS tng_get_device_cert_def(const atcacert_def_t **cert_def)
+{
+    ATCA_STATUS status;
+    tng_ctx_t* ctx = NULL;
+
+    if (cert_def == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    status = tng_get_ctx(&ctx);
+    if (ATCA_SUCCESS == status)
+    {
+        *cert_def = ctx->cert_def;
+    }
+
     return status;
 }
 
 ATCA_STATUS tng_get_device_pubkey(uint8_t *public_key)
 {
     ATCA_STATUS status;
-    const atcacert_def_t* cert_def = NULL;
+    tng_ctx_t* ctx = NULL;
+
+    if (public_key == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    status = tng_get_ctx(&ctx);
+    if (ATCA_SUCCESS == status && !(ctx->flags & TNG_CTX_DEVICE_PUBKEY))
+    {
+        status = atcab_get_pubkey(ctx->cert_def->private_key_slot, ctx->device_public_key);
+        if (ATCA_SUCCESS == status)
+        {
+            ctx->flags |= TNG_CTX_DEVICE_PUBKEY;
+        }
+    }
+    if (ATCA_SUCCESS == status)
+    {
+        memcpy(public_key, ctx->device_public_key, 64);
+    }
+
+    return status;
+}
+
+ATCA_STATUS tng_get_signer_pubkey(uint8_t *public_key)
+{
+    ATCA_STATUS status;
+    tng_ctx_t* ctx = NULL;
+    const atcacert_device_loc_t* device_loc;
+    uint8_t raw_public_key[72];
 
-    status = tng_get_device_cert_def(&cert_def);
+    if (public_key == NULL)
+    {
+        return ATCA_BAD_PARAM;
+    }
+
+    status = tng_get_ctx(&ctx);
+    if (ATCA_SUCCESS == status && !(ctx->flags & TNG_CTX_SIGNER_PUBKEY))
+    {
+        device_loc = &ctx->cert_def->ca_cert_def->public_key_dev_loc;
+        if (device_loc->count > sizeof(raw_public_key))
+        {
+            return ATCACERT_E_BAD_CERT;
+        }
 
+        status = atcacert_read_device_loc(device_loc, raw_public_key);
+        if (ATCACERT_E_SUCCESS == status)
+        {
+            if (device_loc->count == 72)
+            {
+                // Public key is formatted with padding bytes in front of the X and Y components
+                atcacert_public_key_remove_padding(raw_public_key, ctx->signer_public_key);
+            }
+            else
+            {
+                memcpy(ctx->signer_public_key, raw_public_key, 64);
+            }
+            ctx->flags |= TNG_CTX_SIGNER_PUBKEY;
+        }
+    }
     if (ATCA_SUCCESS == status)
     {
-        status = atcab_get_pubkey(cert_def->private_key_slot, public_key);
+        memcpy(public_key, ctx->signer_public_key, 64);
     }
 
     return status;
-}
\ No newline at end of file
+}
@@ -43,6 +43,41 @@ extern "C" {
  *
    @{ */
 
+#define TNG_CTX_DEVICE_PUBKEY   (0x01)  //!< tng_ctx_t device_public_key is valid
+#define TNG_CTX_SIGNER_PUBKEY   (0x02)  //!< tng_ctx_t signer_public_key is valid
+
+/** \brief What the TNG functions resolved for a device. The certificate
+ *         definition and sizes are resolved on first use, the public keys
+ *         when they are first needed. */
+typedef struct tng_ctx_s
+{
+    ATCADevice            device;                   //!< Device the context belongs to
+    uint32_t              generation;               //!< atcab_get_device_generation() when the context was resolved
+    const atcacert_def_t* cert_def;                 //!< Device certificate definition
+    size_t                device_cert_size;         //!< Largest device certificate of cert_def
+    size_t                signer_cert_size;         //!< Largest signer certificate of cert_def->ca_cert_def
+    uint8_t               flags;                    //!< TNG_CTX_* flags of the valid public keys
+    uint8_t               device_public_key[64];    //!< Device public key, X and Y integers in big-endian format
+    uint8_t               signer_public_key[64];    //!< Signer public key, X and Y integers in big-endian format
+} tng_ctx_t;
+
+/** \brief Get the TNG context of the current device, resolving the
+ *         certificate definition the first time it is asked for. The context
+ *         is resolved again after every atcab_init() or atcab_release(), even
+ *         when the new device context is at the same address.
+ *
+ * \param[out] ctx  Context is returned here.
+ *
+ * \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS tng_get_ctx(tng_ctx_t** ctx);
+
+/** \brief Forget everything resolved for the current device, needed when the
+ *         device behind the current device context was changed without
+ *         initializing the context again.
+ */
+void tng_ctx_invalidate(void);
+
 /** \brief Helper function to iterate through all trust cert definitions
  *
  * \param[in] index Map index
@@ -71,6 +106,16 @@ ATCA_STATUS tng_get_device_cert_def(const atcacert_def_t **cert_def);
  */
 ATCA_STATUS tng_get_device_pubkey(uint8_t *public_key);
 
+/** \brief Get the signer public key stored on the device.
+ *
+ *  \param[out] public_key  Public key will be returned here. Format will be
+ *                          the X and Y integers in big-endian format.
+ *                          64 bytes for P256 curve.
+ *
+ *  \return ATCA_SUCCESS on success, otherwise an error code.
+ */
+ATCA_STATUS tng_get_signer_pubkey(uint8_t *public_key);
+
 /** @} */
 
 #ifdef __cplusplus
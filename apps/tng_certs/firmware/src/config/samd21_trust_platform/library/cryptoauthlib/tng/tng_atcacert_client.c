@@ -57,10 +57,10 @@ int tng_atcacert_max_device_cert_size(size_t* max_cert_size)
 int tng_atcacert_read_device_cert(uint8_t* cert, size_t* cert_size, const uint8_t* signer_cert)
 {
     int ret;
-    const atcacert_def_t* cert_def = NULL;
-    uint8_t ca_public_key[72];
+    tng_ctx_t* ctx = NULL;
+    uint8_t ca_public_key[64];
 
-    ret = tng_get_device_cert_def(&cert_def);
+    ret = tng_get_ctx(&ctx);
     if (ret != ATCA_SUCCESS)
     {
         return ret;
@@ -70,66 +70,53 @@ int tng_atcacert_read_device_cert(uint8_t* cert, size_t* cert_size, const uint8_
     {
         // Signer certificate is supplied, get the public key from there
         ret = atcacert_get_subj_public_key(
-            cert_def->ca_cert_def,
+            ctx->cert_def->ca_cert_def,
             signer_cert,
-            cert_def->ca_cert_def->cert_template_size,  // Cert size doesn't need to be accurate
+            ctx->cert_def->ca_cert_def->cert_template_size,  // Cert size doesn't need to be accurate
             ca_public_key);
-        if (ret != ATCACERT_E_SUCCESS)
-        {
-            return ret;
-        }
     }
     else
     {
-        // No signer certificate supplied, read from the device
-        ret = atcacert_read_device_loc(&cert_def->ca_cert_def->public_key_dev_loc, ca_public_key);
-        if (ret != ATCACERT_E_SUCCESS)
-        {
-            return ret;
-        }
-        if (cert_def->ca_cert_def->public_key_dev_loc.count == 72)
-        {
-            // Public key is formatted with padding bytes in front of the X and Y components
-            atcacert_public_key_remove_padding(ca_public_key, ca_public_key);
-        }
+        // No signer certificate supplied, read from the device once
+        ret = tng_get_signer_pubkey(ca_public_key);
+    }
+    if (ret != ATCACERT_E_SUCCESS)
+    {
+        return ret;
     }
 
-    return atcacert_read_cert(cert_def, ca_public_key, cert, cert_size);
+    return atcacert_read_cert(ctx->cert_def, ca_public_key, cert, cert_size);
 }
 
 int tng_atcacert_device_public_key(uint8_t* public_key, uint8_t* cert)
 {
     int ret;
-    const atcacert_def_t* cert_def = NULL;
-    uint8_t raw_public_key[72];
+    tng_ctx_t* ctx = NULL;
 
     if (public_key == NULL)
     {
         return ATCACERT_E_BAD_PARAMS;
     }
 
-    ret = tng_get_device_cert_def(&cert_def);
-    if (ret != ATCA_SUCCESS)
-    {
-        return ret;
-    }
-
-    ret = atcacert_read_device_loc(&cert_def->public_key_dev_loc, raw_public_key);
-    if (ret != ATCACERT_E_SUCCESS)
-    {
-        return ret;
-    }
-    if (cert_def->public_key_dev_loc.count == 72)
+    if (cert != NULL)
     {
-        // Public key is formatted with padding bytes in front of the X and Y components
-        atcacert_public_key_remove_padding(raw_public_key, public_key);
+        // Device certificate is supplied, get the public key from there
+        ret = tng_get_ctx(&ctx);
+        if (ATCA_SUCCESS == ret)
+        {
+            ret = atcacert_get_subj_public_key(
+                ctx->cert_def,
+                cert,
+                ctx->cert_def->cert_template_size,  // Cert size doesn't need to be accurate
+                public_key);
+        }
     }
     else
     {
-        memcpy(public_key, raw_public_key, 64);
+        ret = tng_get_device_pubkey(public_key);
     }
 
-    return ATCACERT_E_SUCCESS;
+    return ret;
 }
 
 int tng_atcacert_max_signer_cert_size(size_t* max_cert_size)
@@ -140,18 +127,16 @@ int tng_atcacert_max_signer_cert_size(size_t* max_cert_size)
 int tng_atcacert_read_signer_cert(uint8_t* cert, size_t* cert_size)
 {
     int ret;
-    const atcacert_def_t* cert_def = NULL;
+    tng_ctx_t* ctx = NULL;
     const uint8_t* ca_public_key = NULL;
 
-    ret = tng_get_device_cert_def(&cert_def);
+    ret = tng_get_ctx(&ctx);
     if (ATCA_SUCCESS == ret)
     {
-        cert_def = cert_def->ca_cert_def;
-
         // Get the CA (root) public key
         ca_public_key = &g_cryptoauth_root_ca_002_cert[CRYPTOAUTH_ROOT_CA_002_PUBLIC_KEY_OFFSET];
 
-        ret = atcacert_read_cert(cert_def, ca_public_key, cert, cert_size);
+        ret = atcacert_read_cert(ctx->cert_def->ca_cert_def, ca_public_key, cert, cert_size);
     }
 
     return ret;
@@ -160,8 +145,6 @@ int tng_atcacert_read_signer_cert(uint8_t* cert, size_t* cert_size)
 int tng_atcacert_signer_public_key(uint8_t* public_key, uint8_t* cert)
 {
     int ret;
-    const atcacert_def_t* cert_def = NULL;
-    uint8_t raw_public_key[72];
 
     if (public_key == NULL)
     {
@@ -179,25 +162,7 @@ int tng_atcacert_signer_public_key(uint8_t* public_key, uint8_t* cert)
     }
     else
     {
-        ret = tng_get_device_cert_def(&cert_def);
-        if (ATCA_SUCCESS == ret)
-        {
-            cert_def = cert_def->ca_cert_def;
-
-            ret = atcacert_read_device_loc(&cert_def->public_key_dev_loc, raw_public_key);
-            if (ATCACERT_E_SUCCESS == ret)
-            {
-                if (cert_def->public_key_dev_loc.count == 72)
-                {
-                    // Public key is formatted with padding bytes in front of the X and Y components
-                    atcacert_public_key_remove_padding(raw_public_key, public_key);
-                }
-                else
-                {
-                    memcpy(public_key, raw_public_key, 64);
-                }
-            }
-        }
+        ret = tng_get_signer_pubkey(public_key);
     }
 
     return ret;